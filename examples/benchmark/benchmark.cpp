@@ -0,0 +1,1220 @@
+#include <OTL/Core/Conversion.h>
+#include <OTL/Core/EnckePropagator.h>
+#include <OTL/Core/ForceModel.h>
+#include <OTL/Core/J2SecularPropagator.h>
+#include <OTL/Core/KeplersEquations.h>
+#include <OTL/Core/KeplerSolver.h>
+#include <OTL/Core/LagrangianPropagator.h>
+#include <OTL/Core/LambertCache.h>
+#include <OTL/Core/LambertExponentialSinusoid.h>
+#include <OTL/Core/LambertExponentialSinusoidSingleRev.h>
+#include <OTL/Core/LambertHouseholder.h>
+#include <OTL/Core/Planet.h>
+#include <OTL/Core/Porkchop.h>
+#include <OTL/Core/PreparedLambertGeometry.h>
+#include <OTL/Core/RungeKuttaPropagator.h>
+#include <OTL/Core/TabulatedKeplerSolver.h>
+#include <OTL/Core/UserDefinedBody.h>
+#include <OTL/Core/WisdomHolmanIntegrator.h>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <thread>
+
+using namespace std;
+using namespace otl;
+
+// Directory of the OTL data files, set by the build
+#ifndef OTL_DATA_DIRECTORY
+#define OTL_DATA_DIRECTORY "data"
+#endif
+
+////////////////////////////////////////////////////////////
+// Returns the wall clock time in seconds taken to call function()
+template<typename Function>
+double Measure(Function function)
+{
+   auto start = chrono::steady_clock::now();
+   function();
+   auto stop = chrono::steady_clock::now();
+   return chrono::duration<double>(stop - start).count();
+}
+
+////////////////////////////////////////////////////////////
+void PrintResult(const string& name, size_t count, double seconds)
+{
+   cout << "  " << name << ": "
+        << seconds * 1.0e3 << " ms, "
+        << 1.0e9 * seconds / count << " ns/solve, "
+        << count / seconds / 1.0e6 << " M solves/s" << endl;
+}
+
+////////////////////////////////////////////////////////////
+// Random heliocentric transfers between roughly 0.7 and 1.7 AU stored as structure-of-arrays
+struct TransferSet
+{
+   explicit TransferSet(size_t count) :
+   r1x(count), r1y(count), r1z(count, 0.0),
+   r2x(count), r2y(count), r2z(count, 0.0),
+   v1x(count), v1y(count), v1z(count),
+   v2x(count), v2y(count), v2z(count),
+   timeDeltas(count),
+   numRevolutions(count, 0)
+   {
+      mt19937 generator(12345);
+      uniform_real_distribution<double> radius(0.7 * ASTRO_AU_TO_KM, 1.7 * ASTRO_AU_TO_KM);
+      uniform_real_distribution<double> angle(0.2, 2.9);
+      uniform_real_distribution<double> days(60.0, 400.0);
+      for (size_t i = 0; i < count; ++i)
+      {
+         double r1 = radius(generator), r2 = radius(generator), theta = angle(generator);
+         r1x[i] = r1;
+         r1y[i] = 0.0;
+         r2x[i] = r2 * cos(theta);
+         r2y[i] = r2 * sin(theta);
+         timeDeltas[i] = days(generator) * MATH_DAY_TO_SEC;
+      }
+   }
+
+   size_t Size() const { return timeDeltas.size(); }
+
+   vector<double> r1x, r1y, r1z;
+   vector<double> r2x, r2y, r2z;
+   vector<double> v1x, v1y, v1z;
+   vector<double> v2x, v2y, v2z;
+   vector<double> timeDeltas;
+   vector<int> numRevolutions;
+};
+
+////////////////////////////////////////////////////////////
+double MeasureScalarLambert(keplerian::ILambertAlgorithm& lambert, TransferSet& set)
+{
+   return Measure([&]()
+   {
+      Vector3d v1, v2;
+      for (size_t i = 0; i < set.Size(); ++i)
+      {
+         lambert.Evaluate(Vector3d(set.r1x[i], set.r1y[i], set.r1z[i]),
+                          Vector3d(set.r2x[i], set.r2y[i], set.r2z[i]),
+                          Time::Seconds(set.timeDeltas[i]),
+                          keplerian::Orbit::Direction::Prograde,
+                          set.numRevolutions[i],
+                          ASTRO_MU_SUN,
+                          v1,
+                          v2);
+         set.v1x[i] = v1.x();
+      }
+   });
+}
+
+////////////////////////////////////////////////////////////
+void BenchmarkLambertAlgorithms(size_t count)
+{
+   cout << "Lambert algorithms, " << count << " zero revolution transfers:" << endl;
+
+   TransferSet set(count);
+
+   keplerian::LambertExponentialSinusoid exponentialSinusoid;
+   PrintResult("ExponentialSinusoid", count, MeasureScalarLambert(exponentialSinusoid, set));
+
+   keplerian::LambertExponentialSinusoidSingleRev exponentialSinusoidSingleRev;
+   PrintResult("ExponentialSinusoidSingleRev", count, MeasureScalarLambert(exponentialSinusoidSingleRev, set));
+
+   keplerian::LambertHouseholder householder;
+   PrintResult("Householder", count, MeasureScalarLambert(householder, set));
+   cout << endl;
+}
+
+////////////////////////////////////////////////////////////
+void BenchmarkLambertBatch(size_t count)
+{
+   cout << "Lambert (ExponentialSinusoid), " << count << " zero revolution transfers:" << endl;
+
+   TransferSet set(count);
+
+   keplerian::LambertExponentialSinusoid lambert;
+   double scalar = MeasureScalarLambert(lambert, set);
+   PrintResult("Evaluate (scalar loop)", count, scalar);
+
+   double batch = Measure([&]()
+   {
+      lambert.EvaluateBatch(Vector3Span<const double>(set.r1x, set.r1y, set.r1z),
+                            Vector3Span<const double>(set.r2x, set.r2y, set.r2z),
+                            set.timeDeltas,
+                            set.numRevolutions,
+                            keplerian::Orbit::Direction::Prograde,
+                            ASTRO_MU_SUN,
+                            Vector3Span<double>(set.v1x, set.v1y, set.v1z),
+                            Vector3Span<double>(set.v2x, set.v2y, set.v2z));
+   });
+   PrintResult("EvaluateBatch", count, batch);
+   cout << endl;
+}
+
+////////////////////////////////////////////////////////////
+void BenchmarkLambertWarmStart(size_t rows, size_t columns)
+{
+   cout << "Lambert warm start, " << rows << " x " << columns << " grid of transfer angle and time of flight:" << endl;
+
+   const Vector3d r1(ASTRO_AU_TO_KM, 0.0, 0.0);
+   auto sweep = [&](keplerian::ILambertAlgorithm& lambert, bool warm, double& meanIterations)
+   {
+      size_t iterations = 0;
+      double seconds = Measure([&]()
+      {
+         Vector3d v1, v2;
+         for (size_t row = 0; row < rows; ++row)
+         {
+            double theta = 0.3 + 2.5 * row / rows;
+            Vector3d r2(1.5 * ASTRO_AU_TO_KM * cos(theta), 1.5 * ASTRO_AU_TO_KM * sin(theta), 0.0);
+            keplerian::LambertSolverState state;
+            for (size_t column = 0; column < columns; ++column)
+            {
+               if (!warm)
+               {
+                  state.valid = false;
+               }
+               Time timeDelta = Time::Days(100.0 + 300.0 * column / columns);
+               lambert.EvaluateWarmStart(r1, r2, timeDelta, keplerian::Orbit::Direction::Prograde, 0, ASTRO_MU_SUN, state, v1, v2);
+               iterations += state.iterations;
+            }
+         }
+      });
+      meanIterations = static_cast<double>(iterations) / (rows * columns);
+      return seconds;
+   };
+
+   double meanIterations;
+   keplerian::LambertExponentialSinusoid exponentialSinusoid;
+   PrintResult("ExponentialSinusoid (cold)", rows * columns, sweep(exponentialSinusoid, false, meanIterations));
+   cout << "    mean iterations: " << meanIterations << endl;
+   PrintResult("ExponentialSinusoid (warm)", rows * columns, sweep(exponentialSinusoid, true, meanIterations));
+   cout << "    mean iterations: " << meanIterations << endl;
+
+   keplerian::LambertHouseholder householder;
+   PrintResult("Householder (cold)", rows * columns, sweep(householder, false, meanIterations));
+   cout << "    mean iterations: " << meanIterations << endl;
+   PrintResult("Householder (warm)", rows * columns, sweep(householder, true, meanIterations));
+   cout << "    mean iterations: " << meanIterations << endl;
+   cout << endl;
+}
+
+////////////////////////////////////////////////////////////
+void BenchmarkPreparedLambertGeometry(size_t count)
+{
+   cout << "Lambert time of flight sweep, " << count << " times of flight between fixed positions:" << endl;
+
+   const Vector3d r1(ASTRO_AU_TO_KM, 0.0, 0.0);
+   const Vector3d r2(-0.9 * ASTRO_AU_TO_KM, 1.2 * ASTRO_AU_TO_KM, 0.05 * ASTRO_AU_TO_KM);
+   const auto direction = keplerian::Orbit::Direction::Prograde;
+
+   vector<double> timeDeltas(count);
+   for (size_t i = 0; i < count; ++i)
+   {
+      timeDeltas[i] = (100.0 + 400.0 * i / count) * MATH_DAY_TO_SEC;
+   }
+   vector<double> v1x(count), v1y(count), v1z(count);
+   vector<double> v2x(count), v2y(count), v2z(count);
+
+   keplerian::LambertExponentialSinusoid lambert;
+   PrintResult("LambertExponentialSinusoid::Evaluate", count, Measure([&]()
+   {
+      Vector3d v1, v2;
+      for (size_t i = 0; i < count; ++i)
+      {
+         lambert.Evaluate(r1, r2, Time::Seconds(timeDeltas[i]), direction, 0, ASTRO_MU_SUN, v1, v2);
+         v1x[i] = v1.x();
+      }
+   }));
+
+   keplerian::PreparedLambertGeometry geometry(r1, r2, direction, ASTRO_MU_SUN);
+   PrintResult("PreparedLambertGeometry::Solve(tof)", count, Measure([&]()
+   {
+      Vector3d v1, v2;
+      for (size_t i = 0; i < count; ++i)
+      {
+         geometry.Solve(Time::Seconds(timeDeltas[i]), 0, v1, v2);
+         v1x[i] = v1.x();
+      }
+   }));
+
+   PrintResult("PreparedLambertGeometry::Solve(span)", count, Measure([&]()
+   {
+      geometry.Solve(timeDeltas, 0, Vector3Span<double>(v1x, v1y, v1z), Vector3Span<double>(v2x, v2y, v2z));
+   }));
+   cout << endl;
+}
+
+////////////////////////////////////////////////////////////
+void BenchmarkLambertJacobian(size_t count)
+{
+   cout << "Lambert (ExponentialSinusoid) Jacobian, " << count << " zero revolution transfers:" << endl;
+
+   TransferSet set(count);
+
+   keplerian::LambertExponentialSinusoid lambert;
+   PrintResult("Evaluate", count, MeasureScalarLambert(lambert, set));
+   PrintResult("EvaluateJacobian", count, Measure([&]()
+   {
+      Vector3d v1, v2;
+      keplerian::LambertJacobian jacobian;
+      for (size_t i = 0; i < set.Size(); ++i)
+      {
+         const Vector3d r1(set.r1x[i], set.r1y[i], set.r1z[i]);
+         const Vector3d r2(set.r2x[i], set.r2y[i], set.r2z[i]);
+         lambert.EvaluateJacobian(r1, r2, Time::Seconds(set.timeDeltas[i]), keplerian::Orbit::Direction::Prograde, 0, ASTRO_MU_SUN, v1, v2, jacobian);
+         set.v1x[i] = jacobian(0, 6);
+      }
+   }));
+   cout << endl;
+}
+
+////////////////////////////////////////////////////////////
+void BenchmarkPorkchop(double days)
+{
+   UserDefinedBody earth("Earth", PhysicalProperties(), ASTRO_MU_SUN,
+                         OrbitalElements(1.0 * ASTRO_AU_TO_KM, 0.0167, 0.1, 0.0, 1.8, 0.0), Epoch::MJD2000(0.0));
+   UserDefinedBody mars("Mars", PhysicalProperties(), ASTRO_MU_SUN,
+                        OrbitalElements(1.524 * ASTRO_AU_TO_KM, 0.0934, 2.5, 0.032, 5.0, 0.86), Epoch::MJD2000(0.0));
+
+   const Epoch departureBegin = Epoch::MJD2000(0.0), departureEnd = Epoch::MJD2000(days);
+   const Epoch arrivalBegin = Epoch::MJD2000(100.0), arrivalEnd = Epoch::MJD2000(100.0 + days);
+   const Time resolution = Time::Days(1.0);
+   const size_t count = static_cast<size_t>(days + 1.0) * static_cast<size_t>(days + 1.0);
+
+   cout << "Porkchop Earth to Mars, " << count << " cells on " << thread::hardware_concurrency() << " core(s):" << endl;
+
+   PrintResult("Nested loops", count, Measure([&]()
+   {
+      keplerian::LambertExponentialSinusoid lambert;
+      Vector3d v1, v2;
+      double sum = 0.0;
+      for (Epoch departure = departureBegin; departure <= departureEnd; departure += resolution)
+      {
+         for (Epoch arrival = arrivalBegin; arrival <= arrivalEnd; arrival += resolution)
+         {
+            if (arrival <= departure)
+            {
+               continue;
+            }
+            const StateVector departureState = earth.GetStateVectorAt(departure);
+            const StateVector arrivalState = mars.GetStateVectorAt(arrival);
+            lambert.Evaluate(departureState.position, arrivalState.position, arrival - departure,
+                             keplerian::Orbit::Direction::Prograde, 0, ASTRO_MU_SUN, v1, v2);
+            sum += (v1 - departureState.velocity).norm() + (arrivalState.velocity - v2).norm();
+         }
+      }
+      return sum;
+   }));
+
+   keplerian::PorkchopEngine engine;
+   PrintResult("PorkchopEngine", count, Measure([&]()
+   {
+      engine.Evaluate(earth, mars, departureBegin, departureEnd, arrivalBegin, arrivalEnd, resolution);
+   }));
+   cout << endl;
+}
+
+////////////////////////////////////////////////////////////
+void BenchmarkScreening(size_t count)
+{
+   cout << "Screening accuracy, " << count << " zero revolution transfers and Kepler solves:" << endl;
+
+   TransferSet set(count);
+   const char* names[] = { "Full", "Reduced", "Single" };
+   const SolverAccuracy accuracies[] = { SolverAccuracy::Full, SolverAccuracy::Reduced, SolverAccuracy::Single };
+
+   keplerian::LambertExponentialSinusoid exponentialSinusoid;
+   keplerian::LambertHouseholder householder;
+   keplerian::ILambertAlgorithm* lamberts[] = { &exponentialSinusoid, &householder };
+   const char* lambertNames[] = { "ExponentialSinusoid", "Householder" };
+   for (int l = 0; l < 2; ++l)
+   {
+      for (int a = 0; a < 3; ++a)
+      {
+         PrintResult(string(lambertNames[l]) + " " + names[a], count, Measure([&]()
+         {
+            Vector3d v1, v2;
+            for (size_t i = 0; i < set.Size(); ++i)
+            {
+               lamberts[l]->EvaluateScreening(Vector3d(set.r1x[i], set.r1y[i], set.r1z[i]),
+                                              Vector3d(set.r2x[i], set.r2y[i], set.r2z[i]),
+                                              Time::Seconds(set.timeDeltas[i]),
+                                              keplerian::Orbit::Direction::Prograde,
+                                              0,
+                                              ASTRO_MU_SUN,
+                                              accuracies[a],
+                                              MATH_SCREENING_TOLERANCE,
+                                              v1,
+                                              v2);
+               set.v1x[i] = v1.x();
+            }
+         }));
+      }
+   }
+
+   mt19937 generator(12345);
+   uniform_real_distribution<double> eccentricity(0.0, 0.95);
+   uniform_real_distribution<double> meanAnomaly(0.0, MATH_2_PI);
+   vector<double> e(count), M(count), E(count);
+   for (size_t i = 0; i < count; ++i)
+   {
+      e[i] = eccentricity(generator);
+      M[i] = meanAnomaly(generator);
+   }
+   for (int a = 0; a < 3; ++a)
+   {
+      PrintResult(string("SolveKeplersEquation ") + names[a], count, Measure([&]()
+      {
+         for (size_t i = 0; i < count; ++i)
+         {
+            E[i] = keplerian::SolveKeplersEquation(e[i], M[i], accuracies[a], MATH_SCREENING_TOLERANCE);
+         }
+      }));
+   }
+   cout << endl;
+}
+
+////////////////////////////////////////////////////////////
+void BenchmarkLambertCache(size_t populationSize, size_t generations)
+{
+   const size_t count = populationSize * generations;
+   cout << "Lambert cache, population of " << populationSize << " over " << generations << " generations:" << endl;
+
+   // Each generation keeps most individuals and mutates the rest, as evolutionary algorithms do
+   TransferSet population(populationSize);
+   TransferSet mutations(count);
+   mt19937 generator(54321);
+   uniform_real_distribution<double> uniform(0.0, 1.0);
+   vector<size_t> sequence(count);
+   vector<bool> mutated(count);
+   for (size_t i = 0; i < count; ++i)
+   {
+      sequence[i] = i % populationSize;
+      mutated[i] = (uniform(generator) < 0.2);
+   }
+
+   auto run = [&](keplerian::ILambertAlgorithm& lambert)
+   {
+      TransferSet individuals = population;
+      return Measure([&]()
+      {
+         Vector3d v1, v2;
+         for (size_t i = 0; i < count; ++i)
+         {
+            const size_t j = sequence[i];
+            if (mutated[i])
+            {
+               individuals.r2x[j] = mutations.r2x[i];
+               individuals.r2y[j] = mutations.r2y[i];
+               individuals.timeDeltas[j] = mutations.timeDeltas[i];
+            }
+            lambert.Evaluate(Vector3d(individuals.r1x[j], individuals.r1y[j], individuals.r1z[j]),
+                             Vector3d(individuals.r2x[j], individuals.r2y[j], individuals.r2z[j]),
+                             Time::Seconds(individuals.timeDeltas[j]),
+                             keplerian::Orbit::Direction::Prograde,
+                             0,
+                             ASTRO_MU_SUN,
+                             v1,
+                             v2);
+         }
+      });
+   };
+
+   auto lambert = make_shared<keplerian::LambertExponentialSinusoidSingleRev>();
+   PrintResult("Uncached", count, run(*lambert));
+
+   keplerian::LambertCache cache(lambert, 4 * populationSize);
+   PrintResult("LambertCache", count, run(cache));
+   cout << "  Hit rate: " << 100.0 * cache.GetHits() / (cache.GetHits() + cache.GetMisses()) << "%" << endl;
+   cout << endl;
+}
+
+////////////////////////////////////////////////////////////
+void BenchmarkKeplerSolver(size_t count)
+{
+   cout << "Kepler's Equation, " << count << " elliptical solves:" << endl;
+
+   mt19937 generator(12345);
+   uniform_real_distribution<double> eccentricity(0.0, 0.95);
+   uniform_real_distribution<double> meanAnomaly(0.0, MATH_2_PI);
+   vector<double> e(count), M(count), E(count);
+   for (size_t i = 0; i < count; ++i)
+   {
+      e[i] = eccentricity(generator);
+      M[i] = meanAnomaly(generator);
+   }
+
+   PrintResult("IKeplersEquation (virtual)", count, Measure([&]()
+   {
+      for (size_t i = 0; i < count; ++i)
+      {
+         keplerian::KeplersEquationElliptical kepler;
+         E[i] = kepler.Evaluate(e[i], M[i]);
+      }
+   }));
+   PrintResult("KeplerSolverElliptical", count, Measure([&]()
+   {
+      for (size_t i = 0; i < count; ++i)
+      {
+         E[i] = keplerian::KeplerSolverElliptical::Solve(e[i], M[i]).anomaly;
+      }
+   }));
+   PrintResult("ConvertMeanAnomaly2TrueAnomaly", count, Measure([&]()
+   {
+      for (size_t i = 0; i < count; ++i)
+      {
+         E[i] = ConvertMeanAnomaly2TrueAnomaly(e[i], M[i]);
+      }
+   }));
+   cout << endl;
+}
+
+////////////////////////////////////////////////////////////
+template<typename Solver>
+void BenchmarkKeplerSolverModes(const string& name, const vector<double>& e, const vector<double>& M)
+{
+   const size_t count = e.size();
+   vector<double> anomalies(count);
+   size_t newtonIterations = 0, highOrderIterations = 0;
+   int newtonMaxIterations = 0, highOrderMaxIterations = 0;
+   for (size_t i = 0; i < count; ++i)
+   {
+      const int newton = Solver::Solve(e[i], M[i]).iterations;
+      const int highOrder = Solver::SolveHighOrder(e[i], M[i]).iterations;
+      newtonIterations += newton;
+      highOrderIterations += highOrder;
+      newtonMaxIterations = max(newtonMaxIterations, newton);
+      highOrderMaxIterations = max(highOrderMaxIterations, highOrder);
+   }
+
+   PrintResult(name + " Newton", count, Measure([&]()
+   {
+      for (size_t i = 0; i < count; ++i)
+      {
+         anomalies[i] = Solver::Solve(e[i], M[i]).anomaly;
+      }
+   }));
+   cout << "  Iterations: mean " << static_cast<double>(newtonIterations) / count << ", max " << newtonMaxIterations << endl;
+   PrintResult(name + " HighOrder", count, Measure([&]()
+   {
+      for (size_t i = 0; i < count; ++i)
+      {
+         anomalies[i] = Solver::SolveHighOrder(e[i], M[i]).anomaly;
+      }
+   }));
+   cout << "  Iterations: mean " << static_cast<double>(highOrderIterations) / count << ", max " << highOrderMaxIterations << endl;
+}
+
+////////////////////////////////////////////////////////////
+void BenchmarkKeplerSolverHighOrder(size_t count)
+{
+   cout << "Kepler's Equation solver modes, " << count << " solves:" << endl;
+
+   mt19937 generator(12345);
+   uniform_real_distribution<double> ellipticalEccentricity(0.0, 0.999);
+   uniform_real_distribution<double> hyperbolicEccentricity(1.001, 10.0);
+   uniform_real_distribution<double> meanAnomaly(0.0, MATH_2_PI);
+   uniform_real_distribution<double> logHyperbolicMeanAnomaly(-3.0, 3.0);
+   vector<double> e(count), M(count), eh(count), Mh(count);
+   for (size_t i = 0; i < count; ++i)
+   {
+      e[i] = ellipticalEccentricity(generator);
+      M[i] = meanAnomaly(generator);
+      eh[i] = hyperbolicEccentricity(generator);
+      Mh[i] = pow(10.0, logHyperbolicMeanAnomaly(generator));
+   }
+
+   BenchmarkKeplerSolverModes<keplerian::KeplerSolverElliptical>("Elliptical", e, M);
+   BenchmarkKeplerSolverModes<keplerian::KeplerSolverHyperbolic>("Hyperbolic", eh, Mh);
+   cout << endl;
+}
+
+////////////////////////////////////////////////////////////
+void BenchmarkKeplersEquationBatch(size_t count)
+{
+   cout << "Kepler's Equation batch, " << count << " solves:" << endl;
+
+   mt19937 generator(12345);
+   uniform_real_distribution<double> ellipticalEccentricity(0.0, 0.95);
+   uniform_real_distribution<double> hyperbolicEccentricity(1.05, 3.0);
+   uniform_real_distribution<double> meanAnomaly(0.0, MATH_2_PI);
+   uniform_real_distribution<double> uniform(0.0, 1.0);
+   vector<double> e(count), mixed(count), M(count), E(count);
+   for (size_t i = 0; i < count; ++i)
+   {
+      e[i] = ellipticalEccentricity(generator);
+      mixed[i] = (uniform(generator) < 0.1 ? hyperbolicEccentricity(generator) : e[i]);
+      M[i] = meanAnomaly(generator);
+   }
+
+   const char* names[] = { "Elliptical", "Mixed" };
+   const vector<double>* eccentricities[] = { &e, &mixed };
+   for (int k = 0; k < 2; ++k)
+   {
+      const vector<double>& ecc = *eccentricities[k];
+      PrintResult(string(names[k]) + " scalar", count, Measure([&]()
+      {
+         for (size_t i = 0; i < count; ++i)
+         {
+            E[i] = keplerian::SolveKeplersEquation(ecc[i], M[i]);
+         }
+      }));
+      PrintResult(string(names[k]) + " batch", count, Measure([&]()
+      {
+         keplerian::SolveKeplersEquationBatch(ecc, M, E);
+      }));
+   }
+   cout << endl;
+}
+
+////////////////////////////////////////////////////////////
+void BenchmarkTabulatedKeplerSolver(size_t count)
+{
+   cout << "Tabulated Kepler's Equation, " << count << " solves and Mars state vector conversions:" << endl;
+
+   const double eccentricity = 0.0934;
+   mt19937 generator(12345);
+   uniform_real_distribution<double> meanAnomaly(-MATH_PI, MATH_PI);
+   vector<double> M(count), E(count);
+   for (size_t i = 0; i < count; ++i)
+   {
+      M[i] = meanAnomaly(generator);
+   }
+
+   PrintResult("KeplerSolverElliptical", count, Measure([&]()
+   {
+      for (size_t i = 0; i < count; ++i)
+      {
+         E[i] = keplerian::KeplerSolverElliptical::Solve(eccentricity, M[i]).anomaly;
+      }
+   }));
+   keplerian::TabulatedKeplerSolver kepler(eccentricity);
+   PrintResult("TabulatedKeplerSolver", count, Measure([&]()
+   {
+      for (size_t i = 0; i < count; ++i)
+      {
+         E[i] = kepler.Solve(M[i]);
+      }
+   }));
+
+   // Mars elements at daily epochs across a twenty year window, as
+   // produced by JplApproximateEphemeris::GetOrbitalElements()
+   vector<OrbitalElements> elements(count);
+   for (size_t i = 0; i < count; ++i)
+   {
+      const double T = static_cast<double>(i % 7300) / 36525.0;
+      elements[i] = OrbitalElements(1.52371243 * ASTRO_AU_TO_KM,
+                                    0.09336511 + 0.00009149 * T,
+                                    Modulo((-19.39 + 19140.29934243 * T) * MATH_DEG_TO_RAD, MATH_2_PI) - MATH_PI,
+                                    1.85181869 * MATH_DEG_TO_RAD,
+                                    286.5 * MATH_DEG_TO_RAD,
+                                    49.71320984 * MATH_DEG_TO_RAD);
+   }
+   keplerian::TabulatedKeplerSolver marsKepler(elements[0].eccentricity);
+   StateVector stateVector;
+   PrintResult("ConvertOrbitalElements2StateVector", count, Measure([&]()
+   {
+      for (size_t i = 0; i < count; ++i)
+      {
+         stateVector = ConvertOrbitalElements2StateVector(elements[i], ASTRO_MU_SUN);
+      }
+   }));
+   PrintResult("ConvertOrbitalElements2StateVector (tabulated)", count, Measure([&]()
+   {
+      for (size_t i = 0; i < count; ++i)
+      {
+         stateVector = ConvertOrbitalElements2StateVector(elements[i], ASTRO_MU_SUN, marsKepler);
+      }
+   }));
+   cout << endl;
+}
+
+////////////////////////////////////////////////////////////
+void BenchmarkLagrangianPropagatorBatch(size_t count)
+{
+   cout << "Lagrangian propagator batch, " << count << " state vectors:" << endl;
+
+   // Earth orbits from low orbit to beyond geostationary, about a fifth of them hyperbolic
+   mt19937 generator(12345);
+   uniform_real_distribution<double> radius(6700.0, 42000.0);
+   uniform_real_distribution<double> speedFraction(0.7, 1.6);
+   uniform_real_distribution<double> angle(0.0, MATH_2_PI);
+   uniform_real_distribution<double> timeOfFlight(-86400.0, 86400.0);
+   const double mu = ASTRO_MU_EARTH;
+   vector<StateVector> stateVectors(count), propagatedStateVectors(count);
+   vector<double> timeDeltas(count);
+   vector<double> rx(count), ry(count), rz(count), vx(count), vy(count), vz(count);
+   for (size_t i = 0; i < count; ++i)
+   {
+      const double r = radius(generator);
+      const double theta = angle(generator);
+      const double inclination = 0.5 * angle(generator);
+      const double v = speedFraction(generator) * sqrt(mu / r);
+      stateVectors[i].position = Vector3d(r * cos(theta), r * sin(theta), 0.0);
+      stateVectors[i].velocity = Vector3d(-v * sin(theta) * cos(inclination), v * cos(theta) * cos(inclination), v * sin(inclination));
+      timeDeltas[i] = timeOfFlight(generator);
+      rx[i] = stateVectors[i].position.x(); ry[i] = stateVectors[i].position.y(); rz[i] = stateVectors[i].position.z();
+      vx[i] = stateVectors[i].velocity.x(); vy[i] = stateVectors[i].velocity.y(); vz[i] = stateVectors[i].velocity.z();
+   }
+
+   keplerian::LagrangianPropagator propagator;
+   PrintResult("Scalar", count, Measure([&]()
+   {
+      for (size_t i = 0; i < count; ++i)
+      {
+         propagatedStateVectors[i] = propagator.PropagateStateVector(stateVectors[i], mu, Time::Seconds(timeDeltas[i]));
+      }
+   }));
+   PrintResult("Batch", count, Measure([&]()
+   {
+      propagator.PropagateStateVectors(stateVectors, mu, timeDeltas, propagatedStateVectors);
+   }));
+   vector<double> frx(count), fry(count), frz(count), fvx(count), fvy(count), fvz(count);
+   PrintResult("Batch (structure of arrays)", count, Measure([&]()
+   {
+      propagator.PropagateStateVectors(Vector3Span<const double>(rx, ry, rz), Vector3Span<const double>(vx, vy, vz), mu, timeDeltas,
+                                       Vector3Span<double>(frx, fry, frz), Vector3Span<double>(fvx, fvy, fvz));
+   }));
+   cout << endl;
+}
+
+////////////////////////////////////////////////////////////
+void BenchmarkLagrangianPropagatorSampling(size_t orbits, size_t samples)
+{
+   cout << "Lagrangian propagator sampling, " << orbits << " orbits of " << samples << " samples:" << endl;
+
+   const double mu = ASTRO_MU_EARTH;
+   StateVector stateVector;
+   stateVector.position = Vector3d(7000.0, -1000.0, 500.0);
+   stateVector.velocity = Vector3d(0.2, 9.0, 1.0);
+   const double period = MATH_2_PI * sqrt(pow(1.0 / (2.0 / stateVector.position.norm() - stateVector.velocity.squaredNorm() / mu), 3.0) / mu);
+   vector<double> timeDeltas(samples);
+   for (size_t i = 0; i < samples; ++i)
+   {
+      timeDeltas[i] = period * (i + 1) / samples;
+   }
+   vector<StateVector> sampledStateVectors(samples);
+
+   keplerian::LagrangianPropagator propagator;
+   PrintResult("Repeated PropagateStateVector", orbits * samples, Measure([&]()
+   {
+      for (size_t k = 0; k < orbits; ++k)
+      {
+         for (size_t i = 0; i < samples; ++i)
+         {
+            sampledStateVectors[i] = propagator.PropagateStateVector(stateVector, mu, Time::Seconds(timeDeltas[i]));
+         }
+      }
+   }));
+   PrintResult("SampleStateVectors", orbits * samples, Measure([&]()
+   {
+      for (size_t k = 0; k < orbits; ++k)
+      {
+         propagator.SampleStateVectors(stateVector, mu, timeDeltas, sampledStateVectors);
+      }
+   }));
+   cout << endl;
+}
+
+////////////////////////////////////////////////////////////
+void BenchmarkStateTransitionMatrix(size_t count)
+{
+   cout << "State transition matrix, " << count << " propagations:" << endl;
+
+   mt19937 generator(12345);
+   uniform_real_distribution<double> speed(6.0, 9.5);
+   uniform_real_distribution<double> timeOfFlight(-86400.0, 86400.0);
+   const double mu = ASTRO_MU_EARTH;
+   vector<StateVector> stateVectors(count);
+   vector<double> timeDeltas(count);
+   for (size_t i = 0; i < count; ++i)
+   {
+      stateVectors[i].position = Vector3d(7000.0, -1000.0, 500.0);
+      stateVectors[i].velocity = Vector3d(0.3, speed(generator), 1.0);
+      timeDeltas[i] = timeOfFlight(generator);
+   }
+
+   keplerian::LagrangianPropagator propagator;
+   vector<StateVector> finalStateVectors(count);
+   vector<keplerian::StateTransitionMatrix, Eigen::aligned_allocator<keplerian::StateTransitionMatrix>> stms(count);
+   PrintResult("Finite difference", count, Measure([&]()
+   {
+      for (size_t i = 0; i < count; ++i)
+      {
+         const Time timeDelta = Time::Seconds(timeDeltas[i]);
+         finalStateVectors[i] = propagator.PropagateStateVector(stateVectors[i], mu, timeDelta);
+         for (int j = 0; j < 6; ++j)
+         {
+            const double step = (j < 3 ? 1.0e-3 : 1.0e-6);
+            StateVector plus = stateVectors[i], minus = stateVectors[i];
+            (j < 3 ? plus.position : plus.velocity)[j % 3] += step;
+            (j < 3 ? minus.position : minus.velocity)[j % 3] -= step;
+            const StateVector finalPlus = propagator.PropagateStateVector(plus, mu, timeDelta);
+            const StateVector finalMinus = propagator.PropagateStateVector(minus, mu, timeDelta);
+            stms[i].block<3, 1>(0, j) = (finalPlus.position - finalMinus.position) / (2.0 * step);
+            stms[i].block<3, 1>(3, j) = (finalPlus.velocity - finalMinus.velocity) / (2.0 * step);
+         }
+      }
+   }));
+   PrintResult("Analytic", count, Measure([&]()
+   {
+      for (size_t i = 0; i < count; ++i)
+      {
+         finalStateVectors[i] = propagator.PropagateStateVector(stateVectors[i], mu, Time::Seconds(timeDeltas[i]), stms[i]);
+      }
+   }));
+   cout << endl;
+}
+
+////////////////////////////////////////////////////////////
+void BenchmarkRungeKuttaPropagator(size_t count, size_t samples)
+{
+   cout << "Runge-Kutta propagator, " << count << " one day propagations:" << endl;
+
+   const double mu = ASTRO_MU_EARTH;
+   const StateVector stateVector(Vector3d(7000.0, -1000.0, 500.0), Vector3d(0.3, 9.0, 1.0));
+   const double seconds = 86400.0;
+   vector<StateVector> finalStateVectors(count);
+
+   RungeKuttaPropagator propagator;
+   keplerian::LagrangianPropagator lagrangian;
+   PrintResult("Lagrangian", count, Measure([&]()
+   {
+      for (size_t i = 0; i < count; ++i)
+      {
+         finalStateVectors[i] = lagrangian.PropagateStateVector(stateVector, mu, Time::Seconds(seconds * (i + 1) / count));
+      }
+   }));
+   PrintResult("Runge-Kutta 8(5,3)", count, Measure([&]()
+   {
+      for (size_t i = 0; i < count; ++i)
+      {
+         finalStateVectors[i] = propagator.PropagateStateVector(stateVector, mu, Time::Seconds(seconds * (i + 1) / count));
+      }
+   }));
+
+   vector<double> timeDeltas(samples);
+   for (size_t i = 0; i < samples; ++i)
+   {
+      timeDeltas[i] = seconds * (i + 1) / samples;
+   }
+   vector<StateVector> sampledStateVectors(samples);
+   PrintResult("Runge-Kutta 8(5,3) dense output, one day", samples, Measure([&]()
+   {
+      propagator.SampleStateVectors(stateVector, mu, timeDeltas, sampledStateVectors);
+   }));
+   cout << "  " << propagator.GetNumSteps() << " steps per day" << endl << endl;
+}
+
+////////////////////////////////////////////////////////////
+void CompareEnckeToCowell(const string& name, size_t count, const StateVector& stateVector, double mu, const Time& timeDelta,
+                          const vector<ForceModelPointer>& forceModels)
+{
+   RungeKuttaPropagator cowell;
+   EnckePropagator encke;
+   for (const auto& forceModel : forceModels)
+   {
+      cowell.AddForceModel(forceModel);
+      encke.AddForceModel(forceModel);
+   }
+
+   vector<StateVector> finalStateVectors(count);
+   PrintResult(name + " Cowell", count, Measure([&]()
+   {
+      for (size_t i = 0; i < count; ++i)
+      {
+         finalStateVectors[i] = cowell.PropagateStateVector(stateVector, mu, timeDelta);
+      }
+   }));
+   PrintResult(name + " Encke", count, Measure([&]()
+   {
+      for (size_t i = 0; i < count; ++i)
+      {
+         finalStateVectors[i] = encke.PropagateStateVector(stateVector, mu, timeDelta);
+      }
+   }));
+   cout << "  " << cowell.GetNumSteps() << " Cowell steps, " << encke.GetNumSteps() << " Encke steps" << endl;
+}
+
+////////////////////////////////////////////////////////////
+void BenchmarkEnckePropagator(size_t count)
+{
+   cout << "Encke propagator, " << count << " perturbed arcs:" << endl;
+
+   // Solar pressure and Jupiter are cheap, so the reference conic costs more than the steps Encke saves
+   JplApproximateEphemeris ephemeris(string(OTL_DATA_DIRECTORY) + "/jpl/approx/approx1800_2050.data");
+   auto sun = [](const Epoch&) -> Vector3d { return Vector3d::Zero(); };
+   auto solarPressure = make_shared<SolarPressureModel>(sun, 4.56e-6, 100.0, 1.3, 500.0);
+   auto jupiter = make_shared<GravityModel>();
+   jupiter->AddExternalBody(make_shared<Planet>("Jupiter", ephemeris, Epoch::MJD2000(0.0)));
+   CompareEnckeToCowell("Heliocentric 1000 days", count,
+                        StateVector(Vector3d(ASTRO_AU_TO_KM, 1.0e7, 0.0), Vector3d(-2.0, 31.0, 1.0)),
+                        ASTRO_MU_SUN, Time::Days(1000.0), { solarPressure, jupiter });
+
+   // A degree 8 gravity field is expensive, so every step saved skips twelve field evaluations
+   const int degree = 8;
+   auto field = make_shared<SphericalHarmonicGravityModel>();
+   field->SetMaxDegree(degree);
+   field->SetCoefficient(2, 0, -4.841652e-4, 0.0);
+   for (int n = 3; n <= degree; ++n)
+   {
+      for (int m = 0; m <= n; ++m)
+      {
+         field->SetCoefficient(n, m, 1.0e-6 / (n * n) * cos(n + 3.0 * m), 1.0e-6 / (n * n) * sin(2.0 * n + m));
+      }
+   }
+   CompareEnckeToCowell("Geostationary 30 days", count / 10,
+                        StateVector(Vector3d(42164.0, 0.0, 0.0), Vector3d(0.0, 3.0747, 0.01)),
+                        ASTRO_MU_EARTH, Time::Days(30.0), { field });
+   cout << endl;
+}
+
+////////////////////////////////////////////////////////////
+void BenchmarkWisdomHolmanIntegrator(size_t count, size_t steps)
+{
+   cout << "Wisdom-Holman integrator, " << count << " asteroids perturbed by Jupiter and Saturn for "
+        << steps << " steps on " << thread::hardware_concurrency() << " core(s):" << endl;
+
+   const double mu = ASTRO_MU_SUN;
+   mt19937 generator(12345);
+   uniform_real_distribution<double> radius(2.1 * ASTRO_AU_TO_KM, 3.3 * ASTRO_AU_TO_KM);
+   uniform_real_distribution<double> angle(0.0, 2.0 * MATH_PI);
+   uniform_real_distribution<double> perturbation(-0.05, 0.05);
+   vector<StateVector> asteroids(count);
+   for (auto& asteroid : asteroids)
+   {
+      const double r = radius(generator), theta = angle(generator);
+      const double speed = sqrt(mu / r) * (1.0 + perturbation(generator));
+      asteroid.position = Vector3d(r * cos(theta), r * sin(theta), 0.0);
+      asteroid.velocity = Vector3d(-speed * sin(theta), speed * cos(theta), speed * perturbation(generator));
+   }
+
+   const char* names[] = { "Single thread", "All threads" };
+   const int numThreads[] = { 1, 0 };
+   for (int k = 0; k < 2; ++k)
+   {
+      WisdomHolmanIntegrator integrator(mu);
+      integrator.SetNumThreads(numThreads[k]);
+      integrator.AddBody(ASTRO_MU_JUPITER, StateVector(Vector3d(5.2 * ASTRO_AU_TO_KM, 0.0, 0.0), Vector3d(0.0, 13.06, 0.0)));
+      integrator.AddBody(ASTRO_MU_SATURN, StateVector(Vector3d(0.0, 9.5 * ASTRO_AU_TO_KM, 0.0), Vector3d(-9.66, 0.0, 0.0)));
+      integrator.AddTestParticles(asteroids);
+      PrintResult(names[k], count * steps, Measure([&]()
+      {
+         integrator.Integrate(Time::Days(10.0 * steps), Time::Days(10.0));
+      }));
+   }
+   cout << endl;
+}
+
+////////////////////////////////////////////////////////////
+void BenchmarkBarnesHutGravity(size_t count)
+{
+   cout << "N-body gravity, " << count << " bodies on " << thread::hardware_concurrency() << " core(s):" << endl;
+
+   mt19937 generator(12345);
+   uniform_real_distribution<double> radius(2.1 * ASTRO_AU_TO_KM, 3.3 * ASTRO_AU_TO_KM);
+   uniform_real_distribution<double> angle(0.0, 2.0 * MATH_PI);
+   uniform_real_distribution<double> height(-1.0e7, 1.0e7);
+   uniform_real_distribution<double> mass(0.1, 10.0);
+   vector<double> mu(count);
+   vector<Vector3d> positions(count), accelerations(count), directAccelerations(count);
+   for (size_t i = 0; i < count; ++i)
+   {
+      const double r = radius(generator), theta = angle(generator);
+      mu[i] = mass(generator);
+      positions[i] = Vector3d(r * cos(theta), r * sin(theta), height(generator));
+   }
+
+   // Body-body interactions only, as the indirect term is the same for both methods
+   PrintResult("Direct sum", count, Measure([&]()
+   {
+      for (size_t i = 0; i < count; ++i)
+      {
+         Vector3d acceleration = Vector3d::Zero();
+         for (size_t j = 0; j < count; ++j)
+         {
+            if (j != i)
+            {
+               const Vector3d separation = positions[j] - positions[i];
+               const double distance = separation.norm();
+               acceleration += mu[j] / (distance * distance * distance) * separation;
+            }
+         }
+         directAccelerations[i] = acceleration;
+      }
+   }));
+
+   BarnesHutGravityModel gravity;
+   const char* names[] = { "Barnes-Hut 0.3", "Barnes-Hut 0.5", "Barnes-Hut 1.0" };
+   const double openingAngles[] = { 0.3, 0.5, 1.0 };
+   for (int k = 0; k < 3; ++k)
+   {
+      gravity.SetOpeningAngle(openingAngles[k]);
+      PrintResult(names[k], count, Measure([&]()
+      {
+         gravity.SetBodies(mu, positions);
+         gravity.GetAccelerations(positions, accelerations);
+      }));
+
+      double maxError = 0.0;
+      for (size_t i = 0; i < count; ++i)
+      {
+         // The tree model also subtracts the acceleration of the central body
+         const Vector3d direct = accelerations[i] + gravity.GetIndirectAcceleration();
+         maxError = max(maxError, (direct - directAccelerations[i]).norm() / directAccelerations[i].norm());
+      }
+      cout << "  max relative error " << maxError << endl;
+   }
+   cout << endl;
+}
+
+////////////////////////////////////////////////////////////
+void BenchmarkNBodyIntegration(size_t count, size_t steps)
+{
+   cout << "N-body integration, " << count << " massive bodies for " << steps << " steps on "
+        << thread::hardware_concurrency() << " core(s):" << endl;
+
+   const double mu = ASTRO_MU_SUN;
+   mt19937 generator(12345);
+   uniform_real_distribution<double> radius(2.1 * ASTRO_AU_TO_KM, 3.3 * ASTRO_AU_TO_KM);
+   uniform_real_distribution<double> angle(0.0, 2.0 * MATH_PI);
+   uniform_real_distribution<double> height(-1.0e7, 1.0e7);
+   uniform_real_distribution<double> mass(0.1, 10.0);
+   vector<double> bodyMu(count);
+   vector<StateVector> bodies(count);
+   for (size_t i = 0; i < count; ++i)
+   {
+      const double r = radius(generator), theta = angle(generator);
+      const double speed = sqrt(mu / r);
+      bodyMu[i] = mass(generator);
+      bodies[i].position = Vector3d(r * cos(theta), r * sin(theta), height(generator));
+      bodies[i].velocity = Vector3d(-speed * sin(theta), speed * cos(theta), 0.0);
+   }
+
+   // Every body is massive, so the interaction kicks dominate the step
+   const char* names[] = { "Direct kicks", "Barnes-Hut 0.5 kicks" };
+   const double openingAngles[] = { 0.0, 0.5 };
+   for (int k = 0; k < 2; ++k)
+   {
+      WisdomHolmanIntegrator integrator(mu);
+      integrator.SetOpeningAngle(openingAngles[k]);
+      for (size_t i = 0; i < count; ++i)
+      {
+         integrator.AddBody(bodyMu[i], bodies[i]);
+      }
+      PrintResult(names[k], count * steps, Measure([&]()
+      {
+         integrator.Integrate(Time::Days(10.0 * steps), Time::Days(10.0));
+      }));
+   }
+   cout << endl;
+}
+
+////////////////////////////////////////////////////////////
+void BenchmarkSphericalHarmonicGravity(size_t count)
+{
+   cout << "Spherical harmonic gravity, " << count << " low orbit accelerations per degree:" << endl;
+
+   const int maxDegree = 120;
+   SphericalHarmonicGravityModel gravity;
+   gravity.SetMaxDegree(maxDegree);
+   for (int n = 2; n <= maxDegree; ++n)
+   {
+      for (int m = 0; m <= n; ++m)
+      {
+         gravity.SetCoefficient(n, m, 1.0e-5 / (n * n) * cos(n + 3.0 * m), 1.0e-5 / (n * n) * sin(2.0 * n + m));
+      }
+   }
+
+   mt19937 generator(12345);
+   uniform_real_distribution<double> direction(-1.0, 1.0);
+   vector<Vector3d> positions(count), accelerations(count);
+   for (auto& position : positions)
+   {
+      position = Vector3d(direction(generator), direction(generator), direction(generator)).normalized() * (ASTRO_RADIUS_EARTH + 400.0);
+   }
+
+   const int degrees[] = { 2, 8, 20, 70, 120 };
+   for (int degree : degrees)
+   {
+      PrintResult("Degree " + to_string(degree), count, Measure([&]()
+      {
+         for (size_t i = 0; i < count; ++i)
+         {
+            accelerations[i] = gravity.GetAcceleration(positions[i], degree);
+         }
+      }));
+   }
+   cout << endl;
+}
+
+////////////////////////////////////////////////////////////
+void BenchmarkJ2SecularPropagator(size_t count)
+{
+   cout << "J2 secular propagator, " << count << " element sets propagated 1 year:" << endl;
+
+   mt19937 generator(12345);
+   uniform_real_distribution<double> altitude(300.0, 2000.0);
+   uniform_real_distribution<double> eccentricity(0.0, 0.05);
+   uniform_real_distribution<double> angle(0.0, MATH_PI);
+   vector<OrbitalElements> catalog(count), propagatedCatalog(count);
+   for (auto& orbitalElements : catalog)
+   {
+      orbitalElements = OrbitalElements(ASTRO_RADIUS_EARTH + altitude(generator), eccentricity(generator),
+                                        2.0 * angle(generator), angle(generator), 2.0 * angle(generator), 2.0 * angle(generator));
+   }
+   const vector<double> timeDeltas(count, 365.25 * 86400.0);
+   const Time timeDelta = Time::Days(365.25);
+
+   keplerian::LagrangianPropagator keplerian;
+   keplerian::J2SecularPropagator j2Secular;
+   PrintResult("Keplerian", count, Measure([&]()
+   {
+      for (size_t i = 0; i < count; ++i)
+      {
+         propagatedCatalog[i] = keplerian.PropagateOrbitalElements(catalog[i], ASTRO_MU_EARTH, timeDelta);
+      }
+   }));
+   PrintResult("J2 secular", count, Measure([&]()
+   {
+      for (size_t i = 0; i < count; ++i)
+      {
+         propagatedCatalog[i] = j2Secular.PropagateOrbitalElements(catalog[i], ASTRO_MU_EARTH, timeDelta);
+      }
+   }));
+   PrintResult("J2 secular batch", count, Measure([&]()
+   {
+      j2Secular.PropagateOrbitalElements(catalog, ASTRO_MU_EARTH, timeDeltas, propagatedCatalog);
+   }));
+   cout << endl;
+}
+
+////////////////////////////////////////////////////////////
+void BenchmarkPlanetStateVector(size_t count)
+{
+   JplApproximateEphemeris ephemeris(string(OTL_DATA_DIRECTORY) + "/jpl/approx/approx1800_2050.data");
+   Planet earth("Earth", ephemeris, Epoch::MJD2000(0.0));
+   Planet mars("Mars", ephemeris, Epoch::MJD2000(0.0));
+   const size_t rows = static_cast<size_t>(sqrt(static_cast<double>(count)));
+
+   cout << "Planet state vectors, " << count << " queries:" << endl;
+
+   double sum = 0.0;
+   PrintResult("Distinct epochs", count, Measure([&]()
+   {
+      for (size_t i = 0; i < count; ++i)
+      {
+         sum += earth.GetStateVectorAt(Epoch::MJD2000(0.01 * i)).position.x();
+      }
+   }));
+   PrintResult("Distinct epochs with properties", count, Measure([&]()
+   {
+      for (size_t i = 0; i < count; ++i)
+      {
+         sum += earth.GetStateVectorAt(Epoch::MJD2000(0.01 * i)).position.x();
+         sum += earth.GetOrbitProperties().trueAnomaly + earth.GetOrbitProperties().radius;
+      }
+   }));
+   PrintResult("Departure x arrival grid", 2 * rows * rows, Measure([&]()
+   {
+      for (size_t i = 0; i < rows; ++i)
+      {
+         for (size_t j = 0; j < rows; ++j)
+         {
+            sum += earth.GetStateVectorAt(Epoch::MJD2000(static_cast<double>(i))).position.x();
+            sum += mars.GetStateVectorAt(Epoch::MJD2000(100.0 + j)).position.x();
+         }
+      }
+   }));
+   cout << endl;
+}
+
+////////////////////////////////////////////////////////////
+void BenchmarkConversionBatch(size_t count)
+{
+   cout << "Element and state vector conversions, " << count << " orbits:" << endl;
+
+   mt19937 generator(12345);
+   uniform_real_distribution<double> altitude(300.0, 36000.0);
+   uniform_real_distribution<double> eccentricity(0.001, 0.7);
+   uniform_real_distribution<double> angle(0.1, 3.0);
+   vector<double> a(count), e(count), M(count), incl(count), aop(count), lan(count);
+   vector<OrbitalElements> catalog(count);
+   for (size_t i = 0; i < count; ++i)
+   {
+      a[i] = (ASTRO_RADIUS_EARTH + altitude(generator)) / (1.0 - 0.5 * eccentricity(generator));
+      e[i] = eccentricity(generator);
+      M[i] = 2.0 * angle(generator) - MATH_PI;
+      incl[i] = angle(generator);
+      aop[i] = 2.0 * angle(generator);
+      lan[i] = 2.0 * angle(generator);
+      catalog[i] = OrbitalElements(a[i], e[i], M[i], incl[i], aop[i], lan[i]);
+   }
+   const OrbitalElementsSpan<double> orbitalElements(a, e, M, incl, aop, lan);
+   vector<double> rx(count), ry(count), rz(count), vx(count), vy(count), vz(count);
+   const Vector3Span<double> positions(rx, ry, rz), velocities(vx, vy, vz);
+   vector<StateVector> stateVectors(count);
+
+   PrintResult("Elements to state vector", count, Measure([&]()
+   {
+      for (size_t i = 0; i < count; ++i)
+      {
+         stateVectors[i] = ConvertOrbitalElements2StateVector(catalog[i], ASTRO_MU_EARTH);
+      }
+   }));
+   PrintResult("Elements to state vector batch", count, Measure([&]()
+   {
+      ConvertOrbitalElements2StateVectorBatch(orbitalElements, ASTRO_MU_EARTH, positions, velocities);
+   }));
+   PrintResult("State vector to elements", count, Measure([&]()
+   {
+      for (size_t i = 0; i < count; ++i)
+      {
+         catalog[i] = ConvertStateVector2OrbitalElements(stateVectors[i], ASTRO_MU_EARTH);
+      }
+   }));
+   PrintResult("State vector to elements batch", count, Measure([&]()
+   {
+      ConvertStateVector2OrbitalElementsBatch(positions, velocities, ASTRO_MU_EARTH, orbitalElements);
+   }));
+   cout << endl;
+}
+
+int main()
+{
+   cout << endl;
+   cout << "-----------------------------" << endl;
+   cout << "-    Benchmark Example      -" << endl;
+   cout << "-----------------------------" << endl;
+   cout << endl;
+
+   BenchmarkLambertBatch(1000000);
+   BenchmarkLambertAlgorithms(1000000);
+   BenchmarkLambertWarmStart(1000, 1000);
+   BenchmarkPreparedLambertGeometry(1000000);
+   BenchmarkLambertJacobian(100000);
+   BenchmarkPorkchop(400.0);
+   BenchmarkScreening(1000000);
+   BenchmarkLambertCache(1000, 1000);
+   BenchmarkKeplerSolver(1000000);
+   BenchmarkKeplerSolverHighOrder(1000000);
+   BenchmarkKeplersEquationBatch(1000000);
+   BenchmarkTabulatedKeplerSolver(1000000);
+   BenchmarkLagrangianPropagatorBatch(100000);
+   BenchmarkLagrangianPropagatorBatch(1000000);
+   BenchmarkLagrangianPropagatorBatch(10000000);
+   BenchmarkLagrangianPropagatorSampling(1000, 1000);
+   BenchmarkStateTransitionMatrix(100000);
+   BenchmarkRungeKuttaPropagator(1000, 10000);
+   BenchmarkEnckePropagator(1000);
+   BenchmarkWisdomHolmanIntegrator(10000, 1000);
+   BenchmarkBarnesHutGravity(20000);
+   BenchmarkNBodyIntegration(20000, 2);
+   BenchmarkSphericalHarmonicGravity(10000);
+   BenchmarkJ2SecularPropagator(1000000);
+   BenchmarkPlanetStateVector(1000000);
+   BenchmarkConversionBatch(1000000);
+
+   return 0;
+}
@@ -64,7 +64,7 @@ int main()
 
       keplerian::Orbit transferOrbit(ASTRO_MU_SUN, sv1);
 
-      double period = 10 * transferOrbit.GetOrbitProperties().period; // [TODO] off by a factor of 10 somewhere??
+      double period = transferOrbit.GetPeriod();
 
       int nRevs = static_cast<int>(timeDelta.Seconds() / period);
 
@@ -57,6 +57,7 @@ enum class PropagatorType
 {
    Invalid = -1,
    Keplerian,
+   RungeKutta,
    Count
 };
 
@@ -65,6 +66,16 @@ enum class LambertType
    Invalid = -1,
    MultiRev,
    SingleRev,
+   Householder,
+   Count
+};
+
+enum class SolverAccuracy
+{
+   Invalid = -1,
+   Full,          ///< Converge to MATH_TOLERANCE in double precision
+   Reduced,       ///< Converge to a caller supplied tolerance in double precision
+   Single,        ///< Converge to a caller supplied tolerance in single precision; SolveKeplersEquation() returns an unconverged result without a warning
    Count
 };
 
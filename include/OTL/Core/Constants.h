@@ -33,6 +33,7 @@ const double MATH_DEG_TO_RAD = 0.0174532925;
 const double MATH_RAD_TO_DEG = 57.29577951;
 const double MATH_NEAR_ZERO = 2.0e-37;
 const double MATH_TOLERANCE = 1.0e-8;
+const double MATH_SCREENING_TOLERANCE = 1.0e-4;
 const double MATH_INFINITY = std::numeric_limits<double>::infinity();
 const double MATH_EPSILON = std::numeric_limits<double>::epsilon();
 const double MATH_E = 2.71828182845904523536;
@@ -79,5 +80,6 @@ const double ASTRO_RADIUS_SATURN = 60268.0;
 const double ASTRO_RADIUS_URANUS = 25559.0;
 const double ASTRO_RADIUS_NEPTUNE = 24764.0;
 const double ASTRO_RADIUS_PLUTO = 1151.0;
+const double ASTRO_J2_EARTH = 1.08262668e-3;     // Second zonal harmonic of the Earth
 
 } // namespace otl
\ No newline at end of file
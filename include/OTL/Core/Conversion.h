@@ -24,10 +24,17 @@
 
 #pragma once
 #include <OTL/Core/Base.h>
+#include <OTL/Core/Span.h>
 
 namespace otl
 {
 
+// Forward declarations
+namespace keplerian
+{
+class TabulatedKeplerSolver;
+}
+
 ////////////////////////////////////////////////////////////
 /// \brief Calculate canonical unit conversion factors
 /// \ingroup otl
@@ -97,6 +104,78 @@ OTL_CORE_API OrbitalElements ConvertStateVector2OrbitalElements(const StateVecto
 ////////////////////////////////////////////////////////////
 OTL_CORE_API StateVector ConvertOrbitalElements2StateVector(const OrbitalElements& orbitalElements, double mu);
 
+////////////////////////////////////////////////////////////
+/// \brief Convert orbital elements to cartesian state vectors with a tabulated Kepler solver
+/// \ingroup otl
+///
+/// Fast path for repeated conversions of the same body. The
+/// eccentric anomaly is taken from the TabulatedKeplerSolver
+/// and the perifocal state vectors are built from it directly,
+/// without converting to true anomaly. Falls back to
+/// ConvertOrbitalElements2StateVector() if the solver is not
+/// valid for the eccentricity of the orbital elements.
+///
+/// \param orbitalElements OrbitalElements before conversion
+/// \param mu Gravitational parameter of the central body
+/// \param kepler Kepler's Equation solver tabulated near the eccentricity of the orbital elements
+/// \returns StateVector after conversion
+///
+////////////////////////////////////////////////////////////
+OTL_CORE_API StateVector ConvertOrbitalElements2StateVector(const OrbitalElements& orbitalElements, double mu,
+                                                            const keplerian::TabulatedKeplerSolver& kepler);
+
+////////////////////////////////////////////////////////////
+/// \brief Convert a batch of cartesian state vectors to orbital elements
+/// \ingroup otl
+///
+/// Catalog-scale variant of ConvertStateVector2OrbitalElements()
+/// over structure-of-arrays storage. Elliptical orbits are
+/// converted in lockstep groups of lanes: the mean anomaly is
+/// computed directly from the eccentric anomaly, which follows
+/// from the position and velocity without going through the
+/// true anomaly, and the angles use atan2() so no quadrant
+/// checks are needed. The results agree with the scalar
+/// conversion to round-off. Circular, equatorial, parabolic
+/// and hyperbolic orbits fall back to the scalar conversion.
+///
+/// \param positions Position vectors before conversion
+/// \param velocities Velocity vectors before conversion
+/// \param mu Gravitational parameter of the central body
+/// \param orbitalElements Output OrbitalElements after conversion
+///
+////////////////////////////////////////////////////////////
+OTL_CORE_API void ConvertStateVector2OrbitalElementsBatch(const Vector3Span<const double>& positions,
+                                                          const Vector3Span<const double>& velocities,
+                                                          double mu,
+                                                          const OrbitalElementsSpan<double>& orbitalElements);
+
+////////////////////////////////////////////////////////////
+/// \brief Convert a batch of orbital elements to cartesian state vectors
+/// \ingroup otl
+///
+/// Catalog-scale variant of ConvertOrbitalElements2StateVector()
+/// over structure-of-arrays storage. Each group of orbits is
+/// solved for the eccentric anomaly with
+/// keplerian::SolveKeplersEquationBatch() and immediately rotated
+/// into inertial coordinates while still in cache. The state
+/// vectors are built directly from the eccentric anomaly and the
+/// first two columns of the perifocal to inertial rotation,
+/// without converting to true anomaly or building a Matrix3d.
+/// The results agree with the scalar conversion to within the
+/// Kepler's Equation tolerance. Parabolic and hyperbolic orbits
+/// fall back to the scalar conversion.
+///
+/// \param orbitalElements OrbitalElements before conversion
+/// \param mu Gravitational parameter of the central body
+/// \param positions Output position vectors after conversion
+/// \param velocities Output velocity vectors after conversion
+///
+////////////////////////////////////////////////////////////
+OTL_CORE_API void ConvertOrbitalElements2StateVectorBatch(const OrbitalElementsSpan<const double>& orbitalElements,
+                                                          double mu,
+                                                          const Vector3Span<double>& positions,
+                                                          const Vector3Span<double>& velocities);
+
 ////////////////////////////////////////////////////////////
 /// \brief Converts normalized spherical coordinates into a Cartesian vector
 /// \ingroup otl
@@ -0,0 +1,204 @@
+////////////////////////////////////////////////////////////
+//
+// OTL - Orbital Trajectory Library
+// Copyright (C) 2013-2018 Jason Bryan (Jmbryan10@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#pragma once
+#include <OTL/Core/RungeKuttaPropagator.h>
+#include <OTL/Core/LagrangianPropagator.h>
+
+namespace otl
+{
+
+class OTL_CORE_API EnckePropagator : public RungeKuttaPropagator
+{
+public:
+   ////////////////////////////////////////////////////////////
+   /// \brief Default Constructor
+   ////////////////////////////////////////////////////////////
+   EnckePropagator();
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Destructor
+   ////////////////////////////////////////////////////////////
+   virtual ~EnckePropagator();
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Set the deviation at which the reference orbit is rectified
+   ///
+   /// The reference conic is replaced by the osculating conic
+   /// of the current state whenever the position deviation
+   /// exceeds this fraction of the position magnitude at the
+   /// last rectification. The default is 0.01.
+   ///
+   /// \param threshold Ratio of the position deviation to the reference position magnitude
+   ///
+   ////////////////////////////////////////////////////////////
+   void SetRectificationThreshold(double threshold);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the number of rectifications performed by the last propagation
+   ///
+   /// \returns Number of times the reference orbit was replaced
+   ///
+   ////////////////////////////////////////////////////////////
+   int GetNumRectifications() const;
+
+protected:
+   ////////////////////////////////////////////////////////////
+   /// \brief Set the reference orbit to the initial state vector with zero deviation
+   ////////////////////////////////////////////////////////////
+   virtual void InitializeState(const StateVector& stateVector, double mu, double* state) override;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Add the deviation to the reference orbit
+   ////////////////////////////////////////////////////////////
+   virtual StateVector GetStateVector(double seconds, double mu, const double* state) override;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Evaluate the derivative of the deviation from the reference orbit
+   ///
+   /// The difference of the two-body accelerations of the true
+   /// and reference orbits is evaluated with Battin's f(q) to
+   /// avoid cancellation.
+   ///
+   /// \reference R. Battin. An Introduction to the Mathematics and Methods of Astrodynamics, Revised Edition 1999. Section 10.2
+   ///
+   ////////////////////////////////////////////////////////////
+   virtual void EvaluateDerivative(double seconds, double mu, const double* state, double* derivative) override;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Measure the error of the deviation against the magnitude of the reference orbit
+   ////////////////////////////////////////////////////////////
+   virtual void GetErrorScale(const double* state, const double* nextState, double* scale) override;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Rectify the reference orbit when the deviation exceeds the threshold
+   ////////////////////////////////////////////////////////////
+   virtual bool Rectify(double seconds, double mu, double* state) override;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Propagate the reference orbit to all stage times of the step at once
+   ///
+   /// The reference conic is sampled at the distinct stage times
+   /// in increasing order with LagrangianPropagator::SampleStateVectors(),
+   /// so each Universal Variable solve starts from the previous
+   /// one and converges in one or two iterations.
+   ///
+   ////////////////////////////////////////////////////////////
+   virtual void PrepareStep(double mu, const Span<const double>& stageTimes) override;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Propagate the reference orbit to the extra stage times of the dense output
+   ///
+   /// The samples are added to those of PrepareStep(), so the
+   /// state at the end of the step is still cached for the
+   /// samples, the rectification and the final state vector.
+   ///
+   ////////////////////////////////////////////////////////////
+   virtual void PrepareDenseStages(double mu, const Span<const double>& stageTimes) override;
+
+private:
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the reference orbit state vector
+   ///
+   /// Returns the state vector sampled by PrepareStep() or
+   /// PrepareDenseStages() when the time is a stage time of the
+   /// current step, and propagates the reference conic otherwise.
+   ///
+   /// \param seconds Time since the start of the propagation in seconds
+   /// \param mu Gravitational parameter of the central body
+   /// \returns StateVector of the reference orbit at the given time
+   ///
+   ////////////////////////////////////////////////////////////
+   StateVector GetReferenceStateVector(double seconds, double mu);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Add reference state vectors at the given times to the cache
+   ///
+   /// Times that are already cached, and the reference time
+   /// itself, are skipped.
+   ///
+   /// \param mu Gravitational parameter of the central body
+   /// \param stageTimes Times since the start of the propagation in seconds
+   ///
+   ////////////////////////////////////////////////////////////
+   void SampleReferenceStates(double mu, const Span<const double>& stageTimes);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Discard all cached reference state vectors
+   ////////////////////////////////////////////////////////////
+   void ClearReferenceCache();
+
+   keplerian::LagrangianPropagator m_lagrangian; ///< Propagator for the reference conic
+   StateVector m_referenceStateVector;          ///< State vector of the reference conic at the reference time
+   double m_referenceTime;                      ///< Time of the last rectification since the start of the propagation
+   double m_referenceRadius;                    ///< Position magnitude of the reference conic at the reference time
+   double m_referenceSpeed;                     ///< Velocity magnitude of the reference conic at the reference time
+   double m_rectificationThreshold;             ///< Ratio of the position deviation to the reference position triggering rectification
+   int m_numRectifications;                     ///< Number of rectifications performed by the last propagation
+   std::vector<double> m_stageTimes;            ///< Distinct stage times of the current step, dense output stages last
+   std::vector<double> m_sampleTimes;           ///< Stage times not yet cached, in increasing order
+   std::vector<double> m_stageTimeDeltas;       ///< Sample times relative to the reference time
+   std::vector<StateVector> m_stageStateVectors; ///< Reference state vectors at the stage times
+};
+
+} // namespace otl
+
+////////////////////////////////////////////////////////////
+/// \class otl::EnckePropagator
+/// \ingroup otl
+///
+/// Propagates a state vector forward or backwards in time by
+/// numerically integrating only the deviation from a reference
+/// conic, which is evaluated analytically with the
+/// LagrangianPropagator. When the perturbations are small the
+/// deviation varies slowly, so the Dormand-Prince 8(5,3)
+/// integrator takes far larger steps than when integrating
+/// the full motion (Cowell's method) for the same accuracy.
+/// The reference conic is rectified to the osculating orbit
+/// whenever the deviation grows too large.
+///
+/// The reference conic is sampled once per step at all stage
+/// times, which still costs more than a point mass evaluation.
+/// Encke's method is therefore faster than Cowell's when the
+/// force models are expensive, e.g. a gravity field of degree
+/// 8 or more, rather than for cheap perturbations.
+///
+/// The relative tolerance is applied to the position and
+/// velocity magnitudes of the reference orbit.
+///
+/// Usage example:
+/// \code
+/// auto propagator = otl::EnckePropagator();
+///
+/// // Position of the Sun relative to the Earth at an epoch
+/// auto earth = std::make_shared<otl::Planet>("Earth");
+/// auto sunPosition = [earth](const otl::Epoch& epoch) -> otl::Vector3d { return -earth->GetStateVectorAt(epoch).position; };
+/// propagator.AddForceModel(std::make_shared<otl::SolarPressureModel>(sunPosition, 4.56e-6, 20.0, 1.3, 1000.0));
+/// propagator.SetEpoch(initialEpoch);
+///
+/// auto finalStateVector = propagator.PropagateStateVector(initialStateVector, otl::ASTRO_MU_EARTH, otl::Time::Days(30.0));
+/// \endcode
+///
+////////////////////////////////////////////////////////////
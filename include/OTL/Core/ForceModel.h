@@ -1,93 +1,577 @@
+////////////////////////////////////////////////////////////
+//
+// OTL - Orbital Trajectory Library
+// Copyright (C) 2013-2018 Jason Bryan (Jmbryan10@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
 #pragma once
 #include <OTL/Core/Base.h>
-
-#include <OTL/Core/OrbitalBody.h>
+#include <OTL/Core/Epoch.h>
+#include <OTL/Core/Span.h>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace otl
 {
 
-//class OrbitalBody;
-//typedef std::shared_ptr<OrbitalBody> OrbitalBodyPointer;
+// Forward declarations
+class OrbitalBody;
+class WorkerPool;
+typedef std::shared_ptr<OrbitalBody> OrbitalBodyPointer;
 
+// Position relative to the central body (km) at an epoch
+typedef std::function<Vector3d(const Epoch& epoch)> PositionFunction;
 
-class OTL_CORE_API Spacecraft
+class OTL_CORE_API IForceModel
 {
 public:
-	Spacecraft();
-
-    double GetRadiationPressureArea() { return m_RadiationPressureArea; }
-    double GetRadiationPressureCoefficient() { return m_RadiationPressureCoefficient; }
-    const Vector3d& GetPosition() const { return m_StateVector.position; }
+   ////////////////////////////////////////////////////////////
+   /// \brief Default constructor
+   ////////////////////////////////////////////////////////////
+   IForceModel() {}
 
-private:
-	double m_Mass;
-	CartesianStateVector m_StateVector;
+   ////////////////////////////////////////////////////////////
+   /// \brief Destructor
+   ////////////////////////////////////////////////////////////
+   virtual ~IForceModel() {}
 
-	double m_RadiationPressureArea;
-    double m_RadiationPressureCoefficient;
-};
-typedef std::shared_ptr<Spacecraft> SpacecraftPointer;
+   ////////////////////////////////////////////////////////////
+   /// \brief Set the epoch at the start of the propagation
+   ///
+   /// Time dependent force models evaluate their sources at this
+   /// epoch plus the seconds passed to GetAcceleration. The
+   /// RungeKuttaPropagator sets it before every propagation.
+   ///
+   /// \param epoch Epoch of the initial state vector
+   ///
+   ////////////////////////////////////////////////////////////
+   void SetEpoch(const Epoch& epoch);
 
-class OTL_CORE_API IForceModel
-{
-public:
-   IForceModel();
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the epoch at the start of the propagation
+   ////////////////////////////////////////////////////////////
+   const Epoch& GetEpoch() const;
 
-   virtual void Update(const Time& deltaTime) = 0;
-   Vector3d GetForces() const;
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the perturbing acceleration acting on the body
+   ///
+   /// Calculates the acceleration in addition to the point mass
+   /// gravity of the central body. The position and velocity
+   /// are relative to the central body.
+   ///
+   /// \param seconds Time since the start of the propagation in seconds
+   /// \param position Cartesian position of the body (km)
+   /// \param velocity Cartesian velocity of the body (km/s)
+   /// \returns Perturbing acceleration (km/s^2)
+   ///
+   ////////////////////////////////////////////////////////////
+   virtual Vector3d GetAcceleration(double seconds, const Vector3d& position, const Vector3d& velocity) = 0;
 
 protected:
-   Vector3d m_Forces;
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the epoch of a time since the start of the propagation
+   ///
+   /// \param seconds Time since the start of the propagation in seconds
+   /// \returns Epoch of the given time
+   ///
+   ////////////////////////////////////////////////////////////
+   Epoch GetEpochAt(double seconds) const;
+
+private:
+   Epoch m_epoch; ///< Epoch at the start of the propagation
 };
 
+typedef std::shared_ptr<IForceModel> ForceModelPointer;
+
 class OTL_CORE_API GravityModel : public IForceModel
 {
 public:
-	GravityModel(const OrbitalBodyPointer& orbitalBody);
+   ////////////////////////////////////////////////////////////
+   /// \brief Default constructor
+   ////////////////////////////////////////////////////////////
+   GravityModel();
 
-	void AddExternalBody(const OrbitalBodyPointer& orbitalBody);
+   ////////////////////////////////////////////////////////////
+   /// \brief Add a perturbing orbital body
+   ///
+   /// The position of the body is taken from its state vector at
+   /// every evaluation, so it must orbit the central body of the
+   /// propagation, e.g. a Planet for heliocentric propagation.
+   /// The gravitational parameter is taken from its physical
+   /// properties.
+   ///
+   /// \param orbitalBody Smart pointer to the perturbing body
+   ///
+   ////////////////////////////////////////////////////////////
+   void AddExternalBody(const OrbitalBodyPointer& orbitalBody);
 
-   virtual void Update(const Time& deltaTime);
+   ////////////////////////////////////////////////////////////
+   /// \brief Add a perturbing body with a user supplied position
+   ///
+   /// \param mu Gravitational parameter of the body (km^3/s^2)
+   /// \param position Function returning the cartesian position of the body relative to the central body (km) at an epoch
+   ///
+   ////////////////////////////////////////////////////////////
+   void AddExternalBody(double mu, const PositionFunction& position);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the third body acceleration of all external bodies
+   ///
+   /// Includes the indirect term due to the acceleration of the
+   /// central body towards each external body. The bodies are
+   /// evaluated at the epoch of the given time.
+   ///
+   /// \param seconds Time since the start of the propagation in seconds
+   /// \param position Cartesian position of the body (km)
+   /// \param velocity Cartesian velocity of the body (km/s)
+   /// \returns Perturbing acceleration (km/s^2)
+   ///
+   ////////////////////////////////////////////////////////////
+   virtual Vector3d GetAcceleration(double seconds, const Vector3d& position, const Vector3d& velocity) override;
 
 private:
-   double m_GravitationalParameter;
-   OrbitalBodyPointer m_OrbitalBody;
-   std::vector<OrbitalBodyPointer> m_ExternalBodies;
+   struct ExternalBody
+   {
+      double mu;                 ///< Gravitational parameter of the body
+      PositionFunction position; ///< Position relative to the central body at an epoch
+   };
+   std::vector<ExternalBody> m_externalBodies; ///< Perturbing bodies
 };
 
-class OTL_CORE_API RadiationSource : public OrbitalBody
+class OTL_CORE_API BarnesHutGravityModel : public IForceModel
 {
 public:
-    //RadiationSource(double radiationPressure) : OrbitalBody("RadiationSource", 1.0) { m_RadiationPressure = radiationPressure; }
-    virtual ~RadiationSource() {}
+   ////////////////////////////////////////////////////////////
+   /// \brief Create a tree code gravity model
+   ///
+   /// \param openingAngle Ratio of cell size to distance below which a cell is approximated by its multipole expansion
+   ///
+   ////////////////////////////////////////////////////////////
+   explicit BarnesHutGravityModel(double openingAngle = 0.5);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Copy the bodies and octree, but not the worker threads
+   ////////////////////////////////////////////////////////////
+   BarnesHutGravityModel(const BarnesHutGravityModel& other);
+   BarnesHutGravityModel& operator=(const BarnesHutGravityModel& other);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Destructor, joins the worker threads
+   ////////////////////////////////////////////////////////////
+   ~BarnesHutGravityModel();
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Set the opening angle
+   ///
+   /// Controls the trade between accuracy and speed. Zero opens
+   /// every cell and reproduces the direct sum. For a uniform
+   /// disk of bodies the median relative acceleration error is
+   /// about 3e-5 at 0.3, 1e-4 at 0.5 and 1e-3 at 1.0.
+   ///
+   /// \param openingAngle Ratio of cell size to distance below which a cell is approximated by its multipole expansion
+   ///
+   ////////////////////////////////////////////////////////////
+   void SetOpeningAngle(double openingAngle);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Set the number of worker threads for batch evaluation
+   ///
+   /// \param numThreads Number of worker threads, zero selects one per hardware core
+   ///
+   ////////////////////////////////////////////////////////////
+   void SetNumThreads(int numThreads);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Set the perturbing bodies and rebuild the octree
+   ///
+   /// Should be called whenever the bodies move, typically once
+   /// per integration step. The bodies are sorted along a Morton
+   /// curve so that each cell of the octree references a
+   /// contiguous range of bodies, and the cells are stored
+   /// depth first in a single array that is traversed without
+   /// a stack. Storage is reused between rebuilds.
+   ///
+   /// \param mu Gravitational parameters of the bodies (km^3/s^2)
+   /// \param positions Cartesian positions of the bodies relative to the central body (km)
+   ///
+   ////////////////////////////////////////////////////////////
+   void SetBodies(const Span<const double>& mu, const Span<const Vector3d>& positions);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the third body acceleration of all bodies
+   ///
+   /// Includes the indirect term due to the acceleration of the
+   /// central body towards the bodies. A body at exactly the
+   /// given position is ignored, so a body can be queried at its
+   /// own position.
+   ///
+   /// \param seconds Time since the start of the propagation in seconds
+   /// \param position Cartesian position of the body (km)
+   /// \param velocity Cartesian velocity of the body (km/s)
+   /// \returns Perturbing acceleration (km/s^2)
+   ///
+   ////////////////////////////////////////////////////////////
+   virtual Vector3d GetAcceleration(double seconds, const Vector3d& position, const Vector3d& velocity) override;
 
-    virtual void Update(const Time& deltaTime) {}
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the third body accelerations at many positions
+   ///
+   /// Same as GetAcceleration, evaluated in parallel over
+   /// contiguous chunks of positions. The worker threads are
+   /// started by the first call and kept for the later ones.
+   ///
+   /// \param positions Cartesian positions relative to the central body (km)
+   /// \param accelerations Output perturbing accelerations (km/s^2)
+   ///
+   ////////////////////////////////////////////////////////////
+   void GetAccelerations(const Span<const Vector3d>& positions, const Span<Vector3d>& accelerations);
 
-    double GetRadiationPressure() const { return m_RadiationPressure; }
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the indirect term of the accelerations
+   ///
+   /// Acceleration of the central body towards the bodies, which
+   /// is subtracted from every acceleration. Adding it back gives
+   /// the direct attraction of the bodies alone, as required by
+   /// N-body integrators that treat the central body separately.
+   ///
+   /// \returns Acceleration of the central body (km/s^2)
+   ///
+   ////////////////////////////////////////////////////////////
+   const Vector3d& GetIndirectAcceleration() const;
 
 private:
-    double m_RadiationPressure;
+   struct Cell
+   {
+      Vector3d centerOfMass;     ///< Center of mass of the bodies in the cell
+      double mu;                 ///< Total gravitational parameter of the bodies in the cell
+      Matrix3d quadrupole;       ///< Traceless quadrupole moment about the center of mass
+      Vector3d center;           ///< Geometric center of the cell
+      double halfSize;           ///< Half the side length of the cell
+      double centerOffset;       ///< Distance from the geometric center to the center of mass
+      std::size_t begin;         ///< First body of the cell in Morton order
+      std::size_t end;           ///< One past the last body of the cell in Morton order
+      std::size_t next;          ///< Index of the next cell after this subtree
+      bool leaf;                 ///< True if the bodies are summed directly
+   };
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Recursively append the cell for a range of Morton ordered bodies
+   ////////////////////////////////////////////////////////////
+   void BuildCell(std::size_t begin, std::size_t end, int level, const Vector3d& center, double halfSize);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Traverse the octree to get the direct acceleration at a position
+   ////////////////////////////////////////////////////////////
+   Vector3d Traverse(const Vector3d& position) const;
+
+   double m_openingAngle;              ///< Ratio of cell size to distance below which a cell is approximated
+   int m_numThreads;                   ///< Number of worker threads, zero selects one per hardware core
+   Vector3d m_indirect;                ///< Acceleration of the central body towards the bodies
+   std::vector<std::pair<std::uint64_t, std::size_t>> m_keys; ///< Morton keys and input indices of the bodies in Morton order
+   std::vector<double> m_mu;           ///< Gravitational parameters of the bodies in Morton order
+   std::vector<Vector3d> m_positions;  ///< Positions of the bodies in Morton order
+   std::vector<Cell> m_cells;          ///< Octree cells in depth first order
+   std::unique_ptr<WorkerPool> m_workers; ///< Worker threads of GetAccelerations(), kept between calls
 };
-typedef std::shared_ptr<RadiationSource> RadiationSourcePointer;
 
-class OTL_CORE_API Sun : public RadiationSource
+class OTL_CORE_API SphericalHarmonicGravityModel : public IForceModel
 {
 public:
-    //Sun() : RadiationSource(1.0) {}
+   ////////////////////////////////////////////////////////////
+   /// \brief Create an empty gravity field
+   ///
+   /// \param mu Gravitational parameter of the central body (km^3/s^2)
+   /// \param referenceRadius Reference radius of the coefficients (km)
+   ///
+   ////////////////////////////////////////////////////////////
+   SphericalHarmonicGravityModel(double mu = ASTRO_MU_EARTH, double referenceRadius = ASTRO_RADIUS_EARTH);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Load fully normalized coefficients from a data file
+   ///
+   /// Reads ICGEM gravity field files (.gfc), taking the
+   /// gravitational parameter and reference radius from the
+   /// header, as well as plain text files with one
+   /// "n m C S" entry per line. Lines that do not hold an entry
+   /// are skipped. ICGEM files with "norm unnormalized" are
+   /// converted to fully normalized coefficients, and other
+   /// normalizations are rejected. Plain text files must be
+   /// fully normalized. The maximum degree is set to the
+   /// highest degree in the file, and a degree set by
+   /// SetDegree() is kept.
+   ///
+   /// \param dataFilename Full path to the coefficient data file
+   ///
+   ////////////////////////////////////////////////////////////
+   void LoadDataFile(const std::string& dataFilename);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Set the maximum degree and order of the field
+   ///
+   /// Allocates the coefficients and scratch storage and
+   /// precomputes the normalized recursion factors. Existing
+   /// coefficients up to the new degree are kept.
+   ///
+   /// \param maxDegree Maximum degree and order
+   ///
+   ////////////////////////////////////////////////////////////
+   void SetMaxDegree(int maxDegree);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the maximum degree and order of the field
+   ////////////////////////////////////////////////////////////
+   int GetMaxDegree() const;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Set a fully normalized coefficient
+   ///
+   /// Increases the maximum degree if required.
+   ///
+   /// \param degree Degree n
+   /// \param order Order m (0 <= m <= n)
+   /// \param c Cosine coefficient
+   /// \param s Sine coefficient
+   ///
+   ////////////////////////////////////////////////////////////
+   void SetCoefficient(int degree, int order, double c, double s);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Set the degree used by GetAcceleration
+   ///
+   /// By default the full field is evaluated. The degree is
+   /// kept when the maximum degree changes, and is limited to
+   /// the maximum degree when the field is evaluated.
+   ///
+   /// \param degree Degree and order to evaluate
+   ///
+   ////////////////////////////////////////////////////////////
+   void SetDegree(int degree);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Set the rotation of the body fixed frame about the z axis
+   ///
+   /// The angle of the body fixed x axis from the propagation
+   /// frame x axis is angle + rate * seconds. By default the
+   /// frames coincide.
+   ///
+   /// \param rate Rotation rate of the body (rad/s)
+   /// \param angle Rotation angle at the start of the propagation (rad)
+   ///
+   ////////////////////////////////////////////////////////////
+   void SetRotation(double rate, double angle = 0.0);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the acceleration due to the non-spherical field
+   ///
+   /// Evaluates degrees 2 through the degree set by SetDegree in
+   /// the rotating body fixed frame.
+   ///
+   /// \param seconds Time since the start of the propagation in seconds
+   /// \param position Cartesian position of the body (km)
+   /// \param velocity Cartesian velocity of the body (km/s)
+   /// \returns Perturbing acceleration (km/s^2)
+   ///
+   ////////////////////////////////////////////////////////////
+   virtual Vector3d GetAcceleration(double seconds, const Vector3d& position, const Vector3d& velocity) override;
 
-    virtual void Update(const Time& deltaTime) {}
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the acceleration due to the non-spherical field up to a given degree
+   ///
+   /// Uses the fully normalized Cunningham recursion for the
+   /// solid spherical harmonics, which stays bounded to high
+   /// degree and has no singularity at the poles. Only the
+   /// harmonics up to degree + 1 are recursed, so lower degrees
+   /// are cheaper. No memory is allocated.
+   ///
+   /// \param position Cartesian position in the body fixed frame (km)
+   /// \param degree Degree and order to evaluate, limited to the maximum degree
+   /// \returns Perturbing acceleration in the body fixed frame (km/s^2)
+   ///
+   /// \reference O. Montenbruck, E. Gill. Satellite Orbits. Springer, 2000, Section 3.2
+   ///
+   ////////////////////////////////////////////////////////////
+   Vector3d GetAcceleration(const Vector3d& position, int degree);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the potential of the non-spherical field up to a given degree
+   ///
+   /// \param position Cartesian position in the body fixed frame (km)
+   /// \param degree Degree and order to evaluate, limited to the maximum degree
+   /// \returns Perturbing potential (km^2/s^2)
+   ///
+   ////////////////////////////////////////////////////////////
+   double GetPotential(const Vector3d& position, int degree);
+
+private:
+   ////////////////////////////////////////////////////////////
+   /// \brief Recurse the normalized solid spherical harmonics up to a degree
+   ////////////////////////////////////////////////////////////
+   void EvaluateHarmonics(const Vector3d& position, int degree);
+
+   double m_mu;                        ///< Gravitational parameter of the central body
+   double m_referenceRadius;           ///< Reference radius of the coefficients
+   int m_maxDegree;                    ///< Maximum degree and order of the coefficients
+   int m_degree;                       ///< Degree evaluated by GetAcceleration
+   int m_requestedDegree;              ///< Degree set by SetDegree, negative for the full field
+   double m_rotationRate;              ///< Rotation rate of the body fixed frame
+   double m_rotationAngle;             ///< Rotation angle of the body fixed frame at the start of the propagation
+   std::vector<double> m_c;            ///< Normalized cosine coefficients
+   std::vector<double> m_s;            ///< Normalized sine coefficients
+   std::vector<double> m_sectoral;     ///< Sectoral recursion factors
+   std::vector<double> m_recursionA;   ///< Recursion factors of the previous degree
+   std::vector<double> m_recursionB;   ///< Recursion factors of the degree before the previous
+   std::vector<double> m_factorLower;  ///< Normalization ratios to the next degree and lower order
+   std::vector<double> m_factorEqual;  ///< Normalization ratios to the next degree and same order
+   std::vector<double> m_factorHigher; ///< Normalization ratios to the next degree and higher order
+   std::vector<double> m_v;            ///< Scratch storage for the real solid harmonics
+   std::vector<double> m_w;            ///< Scratch storage for the imaginary solid harmonics
 };
 
 class OTL_CORE_API SolarPressureModel : public IForceModel
 {
 public:
-    SolarPressureModel(const RadiationSourcePointer& radiationSource, const SpacecraftPointer& spacecraft);
+   ////////////////////////////////////////////////////////////
+   /// \brief Create a cannonball solar radiation pressure model
+   ///
+   /// \param sourcePosition Function returning the cartesian position of the radiation source relative to the central body (km) at an epoch
+   /// \param radiationPressure Radiation pressure at 1 AU from the source (N/m^2)
+   /// \param area Cross sectional area of the body (m^2)
+   /// \param coefficient Radiation pressure coefficient of the body (1 for absorption, 2 for specular reflection)
+   /// \param mass Mass of the body (kg)
+   ///
+   ////////////////////////////////////////////////////////////
+   SolarPressureModel(const PositionFunction& sourcePosition, double radiationPressure, double area, double coefficient, double mass);
 
-   virtual void Update(const Time& deltaTime);
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the acceleration due to radiation pressure
+   ///
+   /// The pressure falls off with the inverse square of the
+   /// distance from the source and acts directly away from it.
+   /// The source is evaluated at the epoch of the given time.
+   /// Shadowing is not modelled.
+   ///
+   /// \param seconds Time since the start of the propagation in seconds
+   /// \param position Cartesian position of the body (km)
+   /// \param velocity Cartesian velocity of the body (km/s)
+   /// \returns Perturbing acceleration (km/s^2)
+   ///
+   ////////////////////////////////////////////////////////////
+   virtual Vector3d GetAcceleration(double seconds, const Vector3d& position, const Vector3d& velocity) override;
 
 private:
-   RadiationSourcePointer m_RadiationSource;
-	SpacecraftPointer m_Spacecraft;
+   PositionFunction m_sourcePosition; ///< Position of the radiation source relative to the central body at an epoch
+   double m_scale;               ///< Acceleration magnitude at 1 AU (km/s^2) times 1 AU squared (km^2)
 };
 
-}
\ No newline at end of file
+} // namespace otl
+
+////////////////////////////////////////////////////////////
+/// \class otl::IForceModel
+///
+/// Interface class for perturbing forces acting on a body
+/// during numerical propagation. Force models are shared
+/// between propagators via ForceModelPointer.
+///
+/// This class is an abstract base class and cannot be instantiated.
+///
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+/// \class otl::GravityModel
+///
+/// Third body point mass gravity perturbations. The perturbing
+/// bodies move along their ephemerides during the propagation.
+/// Orbital bodies are not thread safe, so an instance must not
+/// be shared between threads.
+///
+/// Usage example:
+/// \code
+/// auto jupiter = std::make_shared<otl::Planet>("Jupiter");
+/// auto gravity = std::make_shared<otl::GravityModel>();
+/// gravity->AddExternalBody(jupiter);
+/// propagator.AddForceModel(gravity);
+/// propagator.SetEpoch(otl::Epoch::MJD2000(0.0));
+/// \endcode
+///
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+/// \class otl::BarnesHutGravityModel
+///
+/// Third body gravity of a large number of point masses using
+/// the Barnes-Hut tree code with quadrupole moments. Reduces
+/// the cost of an N-body acceleration sweep from O(N^2) to
+/// O(N log N).
+///
+/// Full system N-body steps, which previously looped over every
+/// external body for every body, are taken by the
+/// WisdomHolmanIntegrator. Its interaction kicks between
+/// massive bodies use this model when given an opening angle.
+///
+/// Usage example:
+/// \code
+/// auto gravity = std::make_shared<otl::BarnesHutGravityModel>(0.5);
+/// gravity->SetBodies(mu, positions);
+/// gravity->GetAccelerations(positions, accelerations);
+/// \endcode
+///
+/// \reference J. Barnes, P. Hut. A Hierarchical O(N log N) Force-Calculation Algorithm. Nature 324, 1986
+///
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+/// \class otl::SphericalHarmonicGravityModel
+///
+/// Non-spherical gravity field of the central body expanded in
+/// fully normalized spherical harmonics. The evaluation degree
+/// trades accuracy for speed, for example a full field for low
+/// orbits and only the zonal J2 term for quick surveys.
+/// GetAcceleration reuses internal scratch storage, so an
+/// instance must not be shared between threads.
+///
+/// Usage example:
+/// \code
+/// auto gravity = std::make_shared<otl::SphericalHarmonicGravityModel>();
+/// gravity->LoadDataFile("EGM2008.gfc");
+/// gravity->SetDegree(20);
+/// gravity->SetRotation(7.292115e-5);
+/// propagator.AddForceModel(gravity);
+/// \endcode
+///
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+/// \class otl::SolarPressureModel
+///
+/// Cannonball solar radiation pressure perturbation.
+///
+/// Usage example:
+/// \code
+/// // Heliocentric propagation, so the Sun stays at the origin
+/// auto sun = [](const otl::Epoch&) -> otl::Vector3d { return otl::Vector3d::Zero(); };
+/// propagator.AddForceModel(std::make_shared<otl::SolarPressureModel>(sun, 4.56e-6, 20.0, 1.3, 1000.0));
+/// \endcode
+///
+////////////////////////////////////////////////////////////
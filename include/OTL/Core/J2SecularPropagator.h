@@ -0,0 +1,137 @@
+////////////////////////////////////////////////////////////
+//
+// OTL - Orbital Trajectory Library
+// Copyright (C) 2013-2018 Jason Bryan (Jmbryan10@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#pragma once
+#include <OTL/Core/KeplerianPropagator.h>
+#include <OTL/Core/Span.h>
+
+namespace otl
+{
+
+namespace keplerian
+{
+
+class OTL_CORE_API J2SecularPropagator : public KeplerianPropagator
+{
+public:
+   ////////////////////////////////////////////////////////////
+   /// \brief Create a propagator for an oblate central body
+   ///
+   /// \param j2 Second zonal harmonic of the central body
+   /// \param referenceRadius Reference radius of the zonal harmonic (km)
+   ///
+   ////////////////////////////////////////////////////////////
+   J2SecularPropagator(double j2 = ASTRO_J2_EARTH, double referenceRadius = ASTRO_RADIUS_EARTH);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Set the oblateness of the central body
+   ///
+   /// \param j2 Second zonal harmonic of the central body
+   /// \param referenceRadius Reference radius of the zonal harmonic (km)
+   ///
+   ////////////////////////////////////////////////////////////
+   void SetJ2(double j2, double referenceRadius);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Propagate the StateVector in time
+   ///
+   /// Converts the StateVector to OrbitalElements, applies the
+   /// secular drift and converts back. The osculating elements
+   /// of the StateVector are treated as mean elements.
+   ///
+   /// \param stateVector StateVector before propagation
+   /// \param mu Gravitational parameter of the central body
+   /// \param timeDelta Propagation time (may be negative)
+   /// \returns StateVector after propagation
+   ///
+   ////////////////////////////////////////////////////////////
+   virtual StateVector PropagateStateVector(const StateVector& stateVector, double mu, const Time& timeDelta) override;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Propagate the mean Orbital Elements in time
+   ///
+   /// Adds the first order secular rates due to J2 to the
+   /// right ascension of the ascending node, the argument of
+   /// periapsis and the mean anomaly. The semi-major axis,
+   /// eccentricity and inclination have no secular change.
+   /// Orbits that are not elliptical only follow Keplerian
+   /// motion.
+   ///
+   /// \param orbitalElements Mean OrbitalElements before propagation
+   /// \param mu Gravitational parameter of the central body
+   /// \param timeDelta Propagation time (may be negative)
+   /// \returns Mean OrbitalElements after propagation
+   ///
+   /// \reference D. Vallado. Fundamentals of Astrodynamics and Applications 4th Edition. Section 9.6
+   ///
+   ////////////////////////////////////////////////////////////
+   virtual OrbitalElements PropagateOrbitalElements(const OrbitalElements& orbitalElements, double mu, const Time& timeDelta) override;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Propagate many mean Orbital Elements in time
+   ///
+   /// Same as the single OrbitalElements overload for each
+   /// entry, without virtual dispatch or Time conversions.
+   /// The input and output may be the same span.
+   ///
+   /// \param orbitalElements Mean OrbitalElements before propagation
+   /// \param mu Gravitational parameter of the central body
+   /// \param timeDeltas Propagation times in seconds (may be negative)
+   /// \param propagatedOrbitalElements Output mean OrbitalElements after propagation
+   ///
+   ////////////////////////////////////////////////////////////
+   void PropagateOrbitalElements(const Span<const OrbitalElements>& orbitalElements,
+                                 double mu,
+                                 const Span<const double>& timeDeltas,
+                                 const Span<OrbitalElements>& propagatedOrbitalElements);
+
+private:
+   double m_j2;                  ///< Second zonal harmonic of the central body
+   double m_referenceRadius;     ///< Reference radius of the zonal harmonic
+};
+
+} // namespace keplerian
+
+} // namespace otl
+
+////////////////////////////////////////////////////////////
+/// \class otl::keplerian::J2SecularPropagator
+/// \ingroup keplerian
+///
+/// Analytic propagator for the long term motion of orbits
+/// about an oblate central body. The node regresses and the
+/// periapsis rotates at constant rates, which is sufficient for
+/// coverage, lighting and conjunction screening studies over
+/// months to years. Short periodic J2 effects and all other
+/// perturbations are ignored. The cost is the same as the
+/// KeplerianPropagator.
+///
+/// Usage example:
+/// \code
+/// otl::keplerian::J2SecularPropagator propagator;
+/// auto elements = propagator.PropagateOrbitalElements(catalogElements, otl::ASTRO_MU_EARTH, otl::Time::Days(365.0));
+/// \endcode
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,433 @@
+////////////////////////////////////////////////////////////
+//
+// OTL - Orbital Trajectory Library
+// Copyright (C) 2013-2018 Jason Bryan (Jmbryan10@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#pragma once
+#include <OTL/Core/Base.h>
+#include <algorithm>
+
+namespace otl
+{
+
+namespace keplerian
+{
+
+////////////////////////////////////////////////////////////
+/// \brief Outcome of a KeplerSolver iteration
+////////////////////////////////////////////////////////////
+enum class KeplerSolverStatus
+{
+   Invalid = -1,     ///< Invalid status
+   Converged,        ///< Newton step fell below the tolerance
+   MaxIterations,    ///< Iteration limit reached before converging
+   ZeroDerivative,   ///< Derivative of the inverse equation vanished
+   Count             ///< Number of statuses
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Result of solving Kepler's Equation with KeplerSolver
+////////////////////////////////////////////////////////////
+struct KeplerSolution
+{
+   double anomaly;            ///< Orbit-type anomaly of the orbit
+   int iterations;            ///< Number of Newton-Raphson steps taken
+   double derivative;         ///< Last derivative of the inverse equation
+   KeplerSolverStatus status; ///< Convergence status of the solve
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Returns true if the iteration converged
+   ////////////////////////////////////////////////////////////
+   bool IsConverged() const { return status == KeplerSolverStatus::Converged; }
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Policy for Kepler's Equation of elliptical orbits
+///
+/// \f$ M = E - e\sin(E) \f$
+///
+////////////////////////////////////////////////////////////
+struct EllipticalAnomalyPolicy
+{
+   static double InitialGuess(double eccentricity, double meanAnomaly)
+   {
+      return (meanAnomaly < MATH_PI ? meanAnomaly + eccentricity / 2.0 : meanAnomaly - eccentricity / 2.0);
+   }
+
+   static double InverseEquation(double eccentricity, double eccentricAnomaly)
+   {
+      return (eccentricAnomaly - eccentricity * sin(eccentricAnomaly));
+   }
+
+   static double InverseDerivative(double eccentricity, double eccentricAnomaly)
+   {
+      return (1.0 - eccentricity * cos(eccentricAnomaly));
+   }
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Whole revolutions removed from the mean anomaly
+   ///
+   /// SolveHighOrder() iterates on M - offset in [-pi, pi), where
+   /// the starter is valid and E stays small near e = 1.
+   ///
+   ////////////////////////////////////////////////////////////
+   static double MeanAnomalyOffset(double meanAnomaly)
+   {
+      return MATH_2_PI * floor((meanAnomaly + MATH_PI) / MATH_2_PI);
+   }
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Markley (1995) starter for M in [-pi, pi), accurate to about 1e-4
+   ////////////////////////////////////////////////////////////
+   static double HighOrderGuess(double eccentricity, double meanAnomaly)
+   {
+      const double M = fabs(meanAnomaly);
+      if (M == 0.0)
+      {
+         return 0.0;
+      }
+      const double pi2 = MATH_PI * MATH_PI;
+      const double alpha = (3.0 * pi2 + 1.6 * MATH_PI * (MATH_PI - M) / (1.0 + eccentricity)) / (pi2 - 6.0);
+      const double d = 3.0 * (1.0 - eccentricity) + alpha * eccentricity;
+      const double q = 2.0 * alpha * d * (1.0 - eccentricity) - M * M;
+      const double r = 3.0 * alpha * d * (d - 1.0 + eccentricity) * M + M * M * M;
+      double w = cbrt(fabs(r) + sqrt(q * q * q + r * r));
+      w *= w;
+      const double E = (2.0 * r * w / (w * w + w * q + q * q) + M) / d;
+      return (meanAnomaly < 0.0 ? -E : E);
+   }
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Residual of Kepler's Equation and its first three derivatives
+   ///
+   /// For |E| < 1 the residual is evaluated as
+   /// (1 - e)sin(E) + (E - sin(E)) - M so that it keeps full
+   /// relative precision near e = 1, E = 0.
+   ///
+   ////////////////////////////////////////////////////////////
+   static void HighOrderResidual(double eccentricity, double eccentricAnomaly, double meanAnomaly, double residual[4])
+   {
+      const double sinE = sin(eccentricAnomaly);
+      const double cosE = cos(eccentricAnomaly);
+      if (fabs(eccentricAnomaly) < 1.0)
+      {
+         const double sinHalfE = sin(0.5 * eccentricAnomaly);
+         residual[0] = (1.0 - eccentricity) * sinE + IdentityMinusSin(eccentricAnomaly) - meanAnomaly;
+         residual[1] = (1.0 - eccentricity) + 2.0 * eccentricity * sinHalfE * sinHalfE;
+      }
+      else
+      {
+         residual[0] = eccentricAnomaly - eccentricity * sinE - meanAnomaly;
+         residual[1] = 1.0 - eccentricity * cosE;
+      }
+      residual[2] = eccentricity * sinE;
+      residual[3] = eccentricity * cosE;
+   }
+
+   ////////////////////////////////////////////////////////////
+   /// \brief x - sin(x), using its Taylor series for |x| < 1
+   ////////////////////////////////////////////////////////////
+   static double IdentityMinusSin(double x)
+   {
+      if (fabs(x) >= 1.0)
+      {
+         return x - sin(x);
+      }
+      const double x2 = x * x;
+      double term = x * x2 / 6.0;
+      double sum = term;
+      for (int k = 2; k <= 9; ++k)
+      {
+         term *= -x2 / ((2 * k) * (2 * k + 1));
+         sum += term;
+      }
+      return sum;
+   }
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Policy for Kepler's Equation of hyperbolic orbits
+///
+/// \f$ M = e\sinh(H) - H \f$
+///
+////////////////////////////////////////////////////////////
+struct HyperbolicAnomalyPolicy
+{
+   ////////////////////////////////////////////////////////////
+   /// \brief Hyperbolic orbits have no revolutions to remove
+   ////////////////////////////////////////////////////////////
+   static double MeanAnomalyOffset(double /*meanAnomaly*/)
+   {
+      return 0.0;
+   }
+
+   static double InitialGuess(double eccentricity, double meanAnomaly)
+   {
+      return meanAnomaly;
+   }
+
+   static double InverseEquation(double eccentricity, double hyperbolicAnomaly)
+   {
+      return (eccentricity * sinh(hyperbolicAnomaly) - hyperbolicAnomaly);
+   }
+
+   static double InverseDerivative(double eccentricity, double hyperbolicAnomaly)
+   {
+      return (eccentricity * cosh(hyperbolicAnomaly) - 1.0);
+   }
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Bracketing starter for the hyperbolic anomaly
+   ///
+   /// The root of the cubic (e - 1)H + eH^3/6 = |M| is an upper
+   /// bound and asinh((|M| + asinh(|M|/e))/e) a lower bound on |H|;
+   /// whichever has the smaller residual is returned.
+   ///
+   ////////////////////////////////////////////////////////////
+   static double HighOrderGuess(double eccentricity, double meanAnomaly)
+   {
+      const double M = fabs(meanAnomaly);
+      const double p = 6.0 * (eccentricity - 1.0) / eccentricity;
+      const double q = -6.0 * M / eccentricity;
+      const double discriminant = sqrt(0.25 * q * q + p * p * p / 27.0);
+      const double upper = cbrt(-0.5 * q + discriminant) + cbrt(-0.5 * q - discriminant);
+      const double lower = asinh((M + asinh(M / eccentricity)) / eccentricity);
+      const double upperResidual = eccentricity * sinh(upper) - upper - M;
+      const double lowerResidual = eccentricity * sinh(lower) - lower - M;
+      const double H = (fabs(upperResidual) < fabs(lowerResidual) ? upper : lower);
+      return (meanAnomaly < 0.0 ? -H : H);
+   }
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Residual of Kepler's Equation and its first three derivatives
+   ///
+   /// For |H| < 1 the residual is evaluated as
+   /// (e - 1)sinh(H) + (sinh(H) - H) - M so that it keeps full
+   /// relative precision near e = 1, H = 0.
+   ///
+   ////////////////////////////////////////////////////////////
+   static void HighOrderResidual(double eccentricity, double hyperbolicAnomaly, double meanAnomaly, double residual[4])
+   {
+      const double sinhH = sinh(hyperbolicAnomaly);
+      const double coshH = cosh(hyperbolicAnomaly);
+      if (fabs(hyperbolicAnomaly) < 1.0)
+      {
+         const double sinhHalfH = sinh(0.5 * hyperbolicAnomaly);
+         residual[0] = (eccentricity - 1.0) * sinhH + SinhMinusIdentity(hyperbolicAnomaly) - meanAnomaly;
+         residual[1] = (eccentricity - 1.0) + 2.0 * eccentricity * sinhHalfH * sinhHalfH;
+      }
+      else
+      {
+         residual[0] = eccentricity * sinhH - hyperbolicAnomaly - meanAnomaly;
+         residual[1] = eccentricity * coshH - 1.0;
+      }
+      residual[2] = eccentricity * sinhH;
+      residual[3] = eccentricity * coshH;
+   }
+
+   ////////////////////////////////////////////////////////////
+   /// \brief sinh(x) - x, using its Taylor series for |x| < 1
+   ////////////////////////////////////////////////////////////
+   static double SinhMinusIdentity(double x)
+   {
+      if (fabs(x) >= 1.0)
+      {
+         return sinh(x) - x;
+      }
+      const double x2 = x * x;
+      double term = x * x2 / 6.0;
+      double sum = term;
+      for (int k = 2; k <= 9; ++k)
+      {
+         term *= x2 / ((2 * k) * (2 * k + 1));
+         sum += term;
+      }
+      return sum;
+   }
+};
+
+template<typename AnomalyPolicy>
+class KeplerSolver
+{
+public:
+   ////////////////////////////////////////////////////////////
+   /// \brief Solve Kepler's Equation for the policy's orbit type
+   ///
+   /// Performs the same Newton-Raphson iteration as
+   /// IKeplersEquation::Evaluate() but with the policy functions
+   /// resolved at compile time so the whole loop can be inlined.
+   /// Nothing is logged; check KeplerSolution::status instead.
+   ///
+   /// \param eccentricity The eccentricity of the orbit
+   /// \param meanAnomaly The mean anomaly of the orbit
+   /// \param maxIterations Maximum number of iteration attempts
+   /// \param tolerance Tolerance for convergence
+   /// \returns The anomaly together with the convergence status
+   ///
+   ////////////////////////////////////////////////////////////
+   static KeplerSolution Solve(double eccentricity, double meanAnomaly, int maxIterations = 1000, double tolerance = MATH_TOLERANCE)
+   {
+      KeplerSolution solution;
+      solution.anomaly = AnomalyPolicy::InitialGuess(eccentricity, meanAnomaly);
+      solution.iterations = 0;
+      solution.derivative = 0.0;
+      solution.status = KeplerSolverStatus::MaxIterations;
+
+      double ratio = MATH_INFINITY;
+      while (solution.iterations < maxIterations)
+      {
+         if (fabs(ratio) <= tolerance)
+         {
+            solution.status = KeplerSolverStatus::Converged;
+            break;
+         }
+         const double numerator = AnomalyPolicy::InverseEquation(eccentricity, solution.anomaly) - meanAnomaly;
+         const double denominator = AnomalyPolicy::InverseDerivative(eccentricity, solution.anomaly);
+         solution.derivative = denominator;
+         if (fabs(denominator) <= MATH_NEAR_ZERO)
+         {
+            solution.status = KeplerSolverStatus::ZeroDerivative;
+            break;
+         }
+         ratio = numerator / denominator;
+         solution.anomaly -= ratio;
+         ++solution.iterations;
+      }
+      if (solution.status == KeplerSolverStatus::MaxIterations && fabs(ratio) <= tolerance)
+      {
+         solution.status = KeplerSolverStatus::Converged;
+      }
+
+      return solution;
+   }
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Solve Kepler's Equation to full double precision
+   ///
+   /// Starts from the policy's high-order guess and applies
+   /// Danby's quartic correction, which uses the first three
+   /// derivatives of Kepler's Equation. The starters are accurate
+   /// enough that three corrections reach the rounding floor for
+   /// 0 <= e < 1 and e > 1, so the iteration is capped at
+   /// HIGH_ORDER_MAX_ITERATIONS instead of a large safety limit.
+   ///
+   /// \param eccentricity The eccentricity of the orbit
+   /// \param meanAnomaly The mean anomaly of the orbit
+   /// \param tolerance Relative tolerance on the correction
+   /// \returns The anomaly together with the convergence status
+   ///
+   ////////////////////////////////////////////////////////////
+   static KeplerSolution SolveHighOrder(double eccentricity, double meanAnomaly, double tolerance = 4.0 * MATH_EPSILON)
+   {
+      const double offset = AnomalyPolicy::MeanAnomalyOffset(meanAnomaly);
+      const double reducedMeanAnomaly = meanAnomaly - offset;
+
+      KeplerSolution solution;
+      solution.anomaly = AnomalyPolicy::HighOrderGuess(eccentricity, reducedMeanAnomaly);
+      solution.iterations = 0;
+      solution.derivative = 0.0;
+      solution.status = KeplerSolverStatus::MaxIterations;
+
+      double f[4];
+      while (solution.iterations < HIGH_ORDER_MAX_ITERATIONS)
+      {
+         AnomalyPolicy::HighOrderResidual(eccentricity, solution.anomaly, reducedMeanAnomaly, f);
+         solution.derivative = f[1];
+         if (fabs(f[1]) <= MATH_NEAR_ZERO)
+         {
+            solution.status = KeplerSolverStatus::ZeroDerivative;
+            break;
+         }
+         const double d3 = HighOrderCorrection(f);
+         solution.anomaly += d3;
+         ++solution.iterations;
+         if (fabs(d3) <= tolerance * std::max(1.0, fabs(solution.anomaly)))
+         {
+            solution.status = KeplerSolverStatus::Converged;
+            break;
+         }
+      }
+      solution.anomaly += offset;
+
+      return solution;
+   }
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Danby's quartic correction to the anomaly
+   ///
+   /// \param residual Residual and first three derivatives from HighOrderResidual()
+   /// \returns The correction to add to the anomaly
+   ///
+   ////////////////////////////////////////////////////////////
+   static double HighOrderCorrection(const double residual[4])
+   {
+      const double d1 = -residual[0] / residual[1];
+      const double d2 = -residual[0] / (residual[1] + 0.5 * d1 * residual[2]);
+      return -residual[0] / (residual[1] + 0.5 * d2 * residual[2] + d2 * d2 * residual[3] / 6.0);
+   }
+
+   static const int HIGH_ORDER_MAX_ITERATIONS = 4; ///< Iteration cap for SolveHighOrder()
+};
+
+template<typename AnomalyPolicy>
+const int KeplerSolver<AnomalyPolicy>::HIGH_ORDER_MAX_ITERATIONS;
+
+typedef KeplerSolver<EllipticalAnomalyPolicy> KeplerSolverElliptical;
+typedef KeplerSolver<HyperbolicAnomalyPolicy> KeplerSolverHyperbolic;
+
+} // namespace keplerian
+
+} // namespace otl
+
+////////////////////////////////////////////////////////////
+/// \class otl::keplerian::KeplerSolver
+/// \ingroup keplerian
+///
+/// Header-only, policy-templated Kepler's Equation solver.
+///
+/// The AnomalyPolicy supplies static InitialGuess(),
+/// InverseEquation() and InverseDerivative() functions,
+/// so the Newton-Raphson loop contains no virtual calls.
+/// SolveKeplersEquation() is a thin wrapper around
+/// KeplerSolverElliptical and KeplerSolverHyperbolic which adds
+/// the warning log. KeplersEquationElliptical and
+/// KeplersEquationHyperbolic implement their virtual hooks with
+/// the same policy functions but still iterate through
+/// IKeplersEquation::Evaluate(), so derived classes that
+/// override a hook keep working.
+///
+/// SolveHighOrder() is a second mode for callers that need full
+/// double precision in a bounded number of steps. Policies used
+/// with it also supply MeanAnomalyOffset(), HighOrderGuess() and
+/// HighOrderResidual().
+///
+/// Usage example:
+/// \code
+/// using namespace otl::keplerian;
+/// KeplerSolution solution = KeplerSolverElliptical::Solve(0.1, 1.0);
+/// if (solution.IsConverged())
+/// {
+///    double eccentricAnomaly = solution.anomaly;
+/// }
+/// \endcode
+///
+////////////////////////////////////////////////////////////
@@ -24,6 +24,7 @@
 
 #pragma once
 #include <OTL/Core/Base.h>
+#include <OTL/Core/Span.h>
 
 namespace otl
 {
@@ -378,6 +379,59 @@ protected:
 ////////////////////////////////////////////////////////////
 double SolveKeplersEquation(double eccentricity, double meanAnomaly, int maxIterations = 1000, double tolerance = MATH_TOLERANCE);
 
+////////////////////////////////////////////////////////////
+/// \brief Helper function for solving Kepler's Equation to a reduced accuracy
+///
+/// Screening mode for large sweeps where most candidates are
+/// discarded. SolverAccuracy::Full and SolverAccuracy::Reduced
+/// call SolveKeplersEquation() with MATH_TOLERANCE and the given
+/// tolerance respectively. SolverAccuracy::Single solves the
+/// elliptical and hyperbolic equations with Newton-Raphson
+/// iterations in single precision, clamping the tolerance to
+/// what single precision can resolve. The single precision
+/// iteration stops after a fixed number of steps, and if it has
+/// not converged by then the last iterate is returned without
+/// a warning.
+///
+/// \param eccentricity The eccentricity of the orbit
+/// \param meanAnomaly The mean anomaly of the orbit
+/// \param accuracy SolverAccuracy of the solve
+/// \param tolerance Tolerance for convergence, e.g. MATH_SCREENING_TOLERANCE
+/// \returns The elliptical, hyperbolic, parabolic, or circular anomaly of the orbit
+///
+////////////////////////////////////////////////////////////
+double SolveKeplersEquation(double eccentricity, double meanAnomaly, SolverAccuracy accuracy, double tolerance);
+
+////////////////////////////////////////////////////////////
+/// \brief Solve Kepler's Equation for a batch of orbits
+///
+/// Catalog-scale variant of SolveKeplersEquation(). The batch
+/// is processed in groups of lanes whose Newton-Raphson
+/// iterations advance in lockstep, and each lane is masked out
+/// as soon as it converges. Once the steps are small, sin(E)
+/// and cos(E) are advanced with the angle addition formulas
+/// rather than recomputed, so the results agree with
+/// SolveKeplersEquation() to within the tolerance but are not
+/// bit-identical. Batches containing only circular or
+/// elliptical orbits take a dedicated path; mixed batches
+/// select the elliptical or hyperbolic equation per lane and
+/// handle parabolic orbits as SolveKeplersEquation() does.
+///
+/// A single warning is logged if any element fails to converge.
+///
+/// \param eccentricities The eccentricities of the orbits
+/// \param meanAnomalies The mean anomalies of the orbits
+/// \param anomalies Output elliptical, hyperbolic, parabolic, or circular anomalies
+/// \param maxIterations Maximum number of iteration attempts
+/// \param tolerance Tolerance for convergence
+///
+////////////////////////////////////////////////////////////
+void SolveKeplersEquationBatch(const Span<const double>& eccentricities,
+                               const Span<const double>& meanAnomalies,
+                               const Span<double>& anomalies,
+                               int maxIterations = 1000,
+                               double tolerance = MATH_TOLERANCE);
+
 } // namespace keplerian
 
 } // namespace otl
\ No newline at end of file
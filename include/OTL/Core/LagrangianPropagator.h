@@ -24,6 +24,7 @@
 
 #pragma once
 #include <OTL/Core/KeplerianPropagator.h>
+#include <OTL/Core/Span.h>
 
 namespace otl
 {
@@ -31,6 +32,8 @@ namespace otl
 namespace keplerian
 {
 
+using StateTransitionMatrix = Matrix6d; ///< Partials of the final [position; velocity] with respect to the initial [position; velocity]
+
 class OTL_CORE_API LagrangianPropagator : public KeplerianPropagator
 {
 public:
@@ -92,6 +95,133 @@ public:
    ////////////////////////////////////////////////////////////
    virtual StateVector PropagateStateVector(const StateVector& stateVector, double mu, const Time& timeDelta) override;
 
+   ////////////////////////////////////////////////////////////
+   /// \brief Propagate the state vector and compute its state transition matrix
+   ///
+   /// Calculates the final state vector as in PropagateStateVector()
+   /// together with the 6x6 state transition matrix of the final
+   /// [position; velocity] with respect to the initial
+   /// [position; velocity]. The matrix is computed analytically
+   /// by differentiating the Lagrange coefficients through the
+   /// converged Universal Variable, so it costs a single solve
+   /// instead of the twelve extra propagations of central finite
+   /// differences.
+   ///
+   /// \param stateVector StateVector before propagation
+   /// \param mu Gravitational parameter of the central body
+   /// \param timeDelta Propgation time (may be negative)
+   /// \param [out] stateTransitionMatrix Partial derivatives of the final state with respect to the initial state
+   /// \returns StateVector after propagation
+   ///
+   ////////////////////////////////////////////////////////////
+   StateVector PropagateStateVector(const StateVector& stateVector,
+                                    double mu,
+                                    const Time& timeDelta,
+                                    StateTransitionMatrix& stateTransitionMatrix);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Compute the state transition matrix of a known arc
+   ///
+   /// Same matrix as PropagateStateVector() with a state
+   /// transition matrix, for callers that already have both ends
+   /// of the arc (e.g. a converged Lambert solution). The
+   /// Universal Variable follows in closed form from
+   /// \f$ x = \alpha \sqrt{\mu} t + \sigma - \sigma_0 \f$, where
+   /// \f$ \sigma = r \cdot v / \sqrt{\mu} \f$, so Kepler's Equation
+   /// is not solved again.
+   ///
+   /// \param initialStateVector StateVector at the start of the arc
+   /// \param finalStateVector StateVector at the end of the arc
+   /// \param mu Gravitational parameter of the central body
+   /// \param timeDelta Time of flight along the arc (may be negative)
+   /// \param [out] stateTransitionMatrix Partial derivatives of the final state with respect to the initial state
+   ///
+   ////////////////////////////////////////////////////////////
+   void CalculateStateTransitionMatrix(const StateVector& initialStateVector,
+                                       const StateVector& finalStateVector,
+                                       double mu,
+                                       const Time& timeDelta,
+                                       StateTransitionMatrix& stateTransitionMatrix);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Propagate a batch of state vectors in time
+   ///
+   /// Catalog-scale variant of PropagateStateVector(). The batch
+   /// is processed in groups of lanes whose Universal Variable
+   /// iterations advance in lockstep, and each lane is masked
+   /// out as soon as it converges. The Stumpff functions are
+   /// evaluated without trigonometric or hyperbolic calls, by
+   /// reducing psi and rebuilding them with the angle doubling
+   /// identities, so the results agree with
+   /// PropagateStateVector() to within rounding rather than
+   /// bit for bit. A single warning is logged if any element
+   /// fails to converge.
+   ///
+   /// The input and output spans may be the same. Each group of
+   /// lanes is copied before it is propagated and is written only
+   /// after its own propagation, so propagating in place gives
+   /// the same result as separate input and output spans.
+   ///
+   /// \param stateVectors StateVectors before propagation
+   /// \param mu Gravitational parameter of the central body
+   /// \param timeDeltas Propagation times in seconds (may be negative)
+   /// \param propagatedStateVectors Output StateVectors after propagation
+   ///
+   ////////////////////////////////////////////////////////////
+   void PropagateStateVectors(const Span<const StateVector>& stateVectors,
+                              double mu,
+                              const Span<const double>& timeDeltas,
+                              const Span<StateVector>& propagatedStateVectors);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Propagate a batch of state vectors stored as structure-of-arrays
+   ///
+   /// Same as the StateVector overload, but reads and writes the
+   /// position and velocity components directly from separate
+   /// component arrays. The component arrays may also be
+   /// propagated in place.
+   ///
+   /// \param positions Position vectors before propagation
+   /// \param velocities Velocity vectors before propagation
+   /// \param mu Gravitational parameter of the central body
+   /// \param timeDeltas Propagation times in seconds (may be negative)
+   /// \param finalPositions Output position vectors after propagation
+   /// \param finalVelocities Output velocity vectors after propagation
+   ///
+   ////////////////////////////////////////////////////////////
+   void PropagateStateVectors(const Vector3Span<const double>& positions,
+                              const Vector3Span<const double>& velocities,
+                              double mu,
+                              const Span<const double>& timeDeltas,
+                              const Vector3Span<double>& finalPositions,
+                              const Vector3Span<double>& finalVelocities);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Sample the trajectory of a state vector at many times
+   ///
+   /// Dense-output variant of PropagateStateVector() for drawing
+   /// or analysing a single orbit. Each sample is propagated from
+   /// the same initial state vector, but the Universal Variable
+   /// iteration starts from the previous sample's converged value
+   /// extrapolated to the new time, so closely spaced samples
+   /// converge in one or two Newton-Raphson steps instead of
+   /// restarting from the orbit-type initial guess.
+   ///
+   /// The time deltas should be monotonically ordered; unordered
+   /// times are still propagated correctly but converge slower.
+   /// A single warning is logged if any sample fails to converge.
+   ///
+   /// \param stateVector StateVector before propagation
+   /// \param mu Gravitational parameter of the central body
+   /// \param timeDeltas Propagation times in seconds from the initial state vector
+   /// \param sampledStateVectors Output StateVectors at each time delta
+   ///
+   ////////////////////////////////////////////////////////////
+   void SampleStateVectors(const StateVector& stateVector,
+                           double mu,
+                           const Span<const double>& timeDeltas,
+                           const Span<StateVector>& sampledStateVectors);
+
 private:
    ////////////////////////////////////////////////////////////
    /// \brief Calculate the universal variable
@@ -25,6 +25,7 @@
 #pragma once
 #include <OTL/Core/Base.h>
 #include <OTL/Core/Orbit.h>
+#include <OTL/Core/Span.h>
 #include <OTL/Core/Time.h>
 
 namespace otl
@@ -33,6 +34,22 @@ namespace otl
 namespace keplerian
 {
 
+using LambertJacobian = Eigen::Matrix<double, 6, 7>; ///< Partials of [v1; v2] with respect to [r1; r2; timeDelta (seconds)]
+
+////////////////////////////////////////////////////////////
+/// \brief Solver state carried between neighbouring Lambert solves
+////////////////////////////////////////////////////////////
+struct LambertSolverState
+{
+   LambertSolverState() : x(0.0), slope(0.0), numRevolutions(0), iterations(0), valid(false) {}
+
+   double x;            ///< Converged transfer parameter x (a = aMin / (1 - x^2)) of the previous solve
+   double slope;        ///< Algorithm specific derivative of the residual at convergence, zero if unknown
+   int numRevolutions;  ///< Number of full revolutions of the previous solve
+   int iterations;      ///< Number of iterations performed by the previous solve
+   bool valid;          ///< True if the state holds a converged solution
+};
+
 class OTL_CORE_API ILambertAlgorithm
 {
 public:
@@ -82,6 +99,13 @@ public:
    /// an initial position, final position, time delta, and
    /// maximum number of full revolutions allowed.
    ///
+   /// The zero revolution solution comes first, followed by two
+   /// solutions for each number of revolutions in increasing
+   /// order: the long period solution (larger semimajor axis)
+   /// and then the short period solution. The vectors stop at
+   /// the largest number of revolutions that is feasible within
+   /// the time delta.
+   ///
    /// This is a pure virtual function that must be re-implemented
    /// by the derived class.
    ///
@@ -103,6 +127,235 @@ public:
                             double mu,
                             std::vector<Vector3d>& initialVelocity,
                             std::vector<Vector3d>& finalVelocity) = 0;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Evaluate the solution to Lambert's Problem starting from a previous solution
+   ///
+   /// Identical to Evaluate() except that the iteration starts from
+   /// the solution stored in the solver state when it is valid and
+   /// was computed for the same number of revolutions. On return the
+   /// state holds the new solution, so a sweep over neighbouring
+   /// transfers (e.g. a porkchop grid) can pass the same state to
+   /// each solve. The converged transfer parameter may also be set
+   /// directly to seed the first solve.
+   ///
+   /// The default implementation calls Evaluate() and invalidates
+   /// the state.
+   ///
+   /// \param initialPosition Vector3d consisting of the initial cartesian position
+   /// \param finalPosition Vector3d consisting of the final cartesian position
+   /// \param timeDelta Total time of flight between initial and final positions
+   /// \param orbitDirection Either Orbit::Direction::Prograde or Orbit::Direciton::Retrograde
+   /// \param numRevolutions Number of full revolutions performed over the timeDelta
+   /// \param mu Gravitational parameter of the central body
+   /// \param [in,out] state Solver state of the previous solve, updated with the new solution
+   /// \param [out] initialVelocity Vector3d consisting of computed initial cartesian velocity
+   /// \param [out] finalVelocity Vector3d consisting of computed final cartesian velocity
+   ///
+   ////////////////////////////////////////////////////////////
+   virtual void EvaluateWarmStart(const Vector3d& initialPosition,
+                                  const Vector3d& finalPosition,
+                                  const Time& timeDelta,
+                                  const Orbit::Direction& orbitDirection,
+                                  int numRevolutions,
+                                  double mu,
+                                  LambertSolverState& state,
+                                  Vector3d& initialVelocity,
+                                  Vector3d& finalVelocity);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Evaluate the solution to Lambert's Problem to a reduced accuracy
+   ///
+   /// Screening mode for large sweeps where most candidates are
+   /// discarded. SolverAccuracy::Reduced stops the iteration at the
+   /// given tolerance and SolverAccuracy::Single additionally
+   /// iterates in single precision. Survivors can be re-solved
+   /// with Evaluate(). SolverAccuracy::Full is identical to Evaluate().
+   ///
+   /// The default implementation calls Evaluate() for every accuracy.
+   ///
+   /// \param initialPosition Vector3d consisting of the initial cartesian position
+   /// \param finalPosition Vector3d consisting of the final cartesian position
+   /// \param timeDelta Total time of flight between initial and final positions
+   /// \param orbitDirection Either Orbit::Direction::Prograde or Orbit::Direciton::Retrograde
+   /// \param numRevolutions Number of full revolutions performed over the timeDelta
+   /// \param mu Gravitational parameter of the central body
+   /// \param accuracy SolverAccuracy of the solve
+   /// \param tolerance Convergence tolerance of the transfer parameter, e.g. MATH_SCREENING_TOLERANCE
+   /// \param [out] initialVelocity Vector3d consisting of computed initial cartesian velocity
+   /// \param [out] finalVelocity Vector3d consisting of computed final cartesian velocity
+   ///
+   ////////////////////////////////////////////////////////////
+   virtual void EvaluateScreening(const Vector3d& initialPosition,
+                                  const Vector3d& finalPosition,
+                                  const Time& timeDelta,
+                                  const Orbit::Direction& orbitDirection,
+                                  int numRevolutions,
+                                  double mu,
+                                  SolverAccuracy accuracy,
+                                  double tolerance,
+                                  Vector3d& initialVelocity,
+                                  Vector3d& finalVelocity);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Evaluate the solution to Lambert's Problem and its partial derivatives
+   ///
+   /// Calculates the initial and final velocity vectors as in
+   /// Evaluate() together with the 6x7 Jacobian of the stacked
+   /// velocities [v1; v2] with respect to the stacked inputs
+   /// [r1; r2; timeDelta]. The time delta column is per second.
+   ///
+   /// The default implementation calls Evaluate() and then
+   /// CalculateJacobian(), which works for any algorithm and costs
+   /// a state transition matrix evaluation instead of another
+   /// solve of Lambert's Problem.
+   ///
+   /// \param initialPosition Vector3d consisting of the initial cartesian position
+   /// \param finalPosition Vector3d consisting of the final cartesian position
+   /// \param timeDelta Total time of flight between initial and final positions
+   /// \param orbitDirection Either Orbit::Direction::Prograde or Orbit::Direciton::Retrograde
+   /// \param numRevolutions Number of full revolutions performed over the timeDelta
+   /// \param mu Gravitational parameter of the central body
+   /// \param [out] initialVelocity Vector3d consisting of computed initial cartesian velocity
+   /// \param [out] finalVelocity Vector3d consisting of computed final cartesian velocity
+   /// \param [out] jacobian Partial derivatives of the velocities with respect to the inputs
+   ///
+   ////////////////////////////////////////////////////////////
+   virtual void EvaluateJacobian(const Vector3d& initialPosition,
+                                 const Vector3d& finalPosition,
+                                 const Time& timeDelta,
+                                 const Orbit::Direction& orbitDirection,
+                                 int numRevolutions,
+                                 double mu,
+                                 Vector3d& initialVelocity,
+                                 Vector3d& finalVelocity,
+                                 LambertJacobian& jacobian);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Evaluate a batch of independent Lambert's Problems
+   ///
+   /// Calculates the initial and final velocity vectors for each
+   /// element of the batch. The inputs and outputs are given in
+   /// structure-of-arrays form and all spans must be of equal size.
+   /// Element i of the outputs is identical to the result of calling
+   /// Evaluate() with element i of the inputs.
+   ///
+   /// The default implementation calls Evaluate() for each element.
+   /// Derived classes may override it with a kernel that solves
+   /// several elements in lockstep.
+   ///
+   /// \param initialPositions Initial cartesian positions
+   /// \param finalPositions Final cartesian positions
+   /// \param timeDeltas Total times of flight in seconds
+   /// \param numRevolutions Number of full revolutions performed over each time of flight
+   /// \param orbitDirection Either Orbit::Direction::Prograde or Orbit::Direciton::Retrograde
+   /// \param mu Gravitational parameter of the central body
+   /// \param [out] initialVelocities Computed initial cartesian velocities
+   /// \param [out] finalVelocities Computed final cartesian velocities
+   ///
+   ////////////////////////////////////////////////////////////
+   virtual void EvaluateBatch(const Vector3Span<const double>& initialPositions,
+                              const Vector3Span<const double>& finalPositions,
+                              const Span<const double>& timeDeltas,
+                              const Span<const int>& numRevolutions,
+                              const Orbit::Direction& orbitDirection,
+                              double mu,
+                              const Vector3Span<double>& initialVelocities,
+                              const Vector3Span<double>& finalVelocities);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Evaluate a batch of independent Lambert's Problems and their partial derivatives
+   ///
+   /// Identical to EvaluateBatch() but also computes the Jacobian
+   /// of each element as in EvaluateJacobian().
+   ///
+   /// The default implementation calls EvaluateJacobian() for each element.
+   ///
+   /// \param initialPositions Initial cartesian positions
+   /// \param finalPositions Final cartesian positions
+   /// \param timeDeltas Total times of flight in seconds
+   /// \param numRevolutions Number of full revolutions performed over each time of flight
+   /// \param orbitDirection Either Orbit::Direction::Prograde or Orbit::Direciton::Retrograde
+   /// \param mu Gravitational parameter of the central body
+   /// \param [out] initialVelocities Computed initial cartesian velocities
+   /// \param [out] finalVelocities Computed final cartesian velocities
+   /// \param [out] jacobians Partial derivatives of the velocities with respect to the inputs
+   ///
+   ////////////////////////////////////////////////////////////
+   virtual void EvaluateBatch(const Vector3Span<const double>& initialPositions,
+                              const Vector3Span<const double>& finalPositions,
+                              const Span<const double>& timeDeltas,
+                              const Span<const int>& numRevolutions,
+                              const Orbit::Direction& orbitDirection,
+                              double mu,
+                              const Vector3Span<double>& initialVelocities,
+                              const Vector3Span<double>& finalVelocities,
+                              const Span<LambertJacobian>& jacobians);
+
+protected:
+   ////////////////////////////////////////////////////////////
+   /// \brief Calculate the Jacobian of a converged solution
+   ///
+   /// Applies the implicit function theorem to the boundary
+   /// condition r(timeDelta; r1, v1) = r2. The state transition
+   /// matrix of the transfer gives the linearized final position
+   ///
+   /// \f$ \delta r_2 = \Phi_{rr} \delta r_1 + \Phi_{rv} \delta v_1 + v_2 \delta t \f$
+   ///
+   /// which is solved for the initial velocity, and the final
+   /// velocity follows from \f$ \Phi_{vr} \f$, \f$ \Phi_{vv} \f$ and the
+   /// acceleration at r2. Singular where Lambert's Problem is,
+   /// for a transfer angle of 180 degrees.
+   ///
+   /// \param initialPosition Vector3d consisting of the initial cartesian position
+   /// \param finalPosition Vector3d consisting of the final cartesian position
+   /// \param seconds Total time of flight in seconds
+   /// \param mu Gravitational parameter of the central body
+   /// \param initialVelocity Converged initial cartesian velocity
+   /// \param finalVelocity Converged final cartesian velocity
+   /// \param [out] jacobian Partial derivatives of the velocities with respect to the inputs
+   ///
+   ////////////////////////////////////////////////////////////
+   static void CalculateJacobian(const Vector3d& initialPosition,
+                                 const Vector3d& finalPosition,
+                                 double seconds,
+                                 double mu,
+                                 const Vector3d& initialVelocity,
+                                 const Vector3d& finalVelocity,
+                                 LambertJacobian& jacobian);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief First three derivatives of the time of flight with respect to x
+   ///
+   /// Shared by the algorithms that iterate on the transfer
+   /// parameter x of Izzo's formulation (a = aMin / (1 - x^2)).
+   /// The derivatives are those of the non-dimensional time of
+   /// flight T = sqrt(2 mu / s^3) t, which is given as the input.
+   ///
+   /// \param lambda Lambert parameter
+   /// \param x Transfer parameter
+   /// \param T Non-dimensional time of flight at x
+   /// \param [out] dT First derivative
+   /// \param [out] ddT Second derivative
+   /// \param [out] dddT Third derivative
+   ///
+   /// \reference D. Izzo. Revisiting Lambert's Problem. Celestial Mechanics and Dynamical Astronomy 121, 2015
+   ///
+   ////////////////////////////////////////////////////////////
+   static void CalculateTimeOfFlightDerivatives(double lambda, double x, double T, double& dT, double& ddT, double& dddT);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Check that all spans of a batch are of equal size
+   ///
+   /// \returns True if the sizes are consistent
+   ///
+   ////////////////////////////////////////////////////////////
+   static bool IsBatchConsistent(const Vector3Span<const double>& initialPositions,
+                                 const Vector3Span<const double>& finalPositions,
+                                 const Span<const double>& timeDeltas,
+                                 const Span<const int>& numRevolutions,
+                                 const Vector3Span<double>& initialVelocities,
+                                 const Vector3Span<double>& finalVelocities);
 };
 
 } // namespace keplerian
@@ -0,0 +1,225 @@
+////////////////////////////////////////////////////////////
+//
+// OTL - Orbital Trajectory Library
+// Copyright (C) 2013-2018 Jason Bryan (Jmbryan10@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#pragma once
+#include <OTL/Core/Lambert.h>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace otl
+{
+
+namespace keplerian
+{
+
+class OTL_CORE_API LambertCache : public ILambertAlgorithm
+{
+public:
+   ////////////////////////////////////////////////////////////
+   /// \brief Create a cache around a Lambert algorithm
+   ///
+   /// The inputs of each solve are quantised to the given relative
+   /// resolution by rounding the mantissa of every component, so
+   /// problems that differ by less than the resolution share one
+   /// entry. The least recently used entry is evicted once the
+   /// capacity is reached.
+   ///
+   /// \param lambert Lambert algorithm used to solve cache misses
+   /// \param capacity Maximum number of cached solutions
+   /// \param resolution Relative resolution of the quantised inputs
+   ///
+   ////////////////////////////////////////////////////////////
+   LambertCache(const std::shared_ptr<ILambertAlgorithm>& lambert,
+                std::size_t capacity = 4096,
+                double resolution = 1.0e-9);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Evaluate the solution to Lambert's Problem
+   ///
+   /// Returns the cached solution if the quantised inputs were
+   /// solved before, otherwise solves with the wrapped algorithm
+   /// and caches the result. Safe to call from multiple threads
+   /// provided the wrapped algorithm is. The wrapped algorithm is
+   /// called without holding the cache lock.
+   ///
+   /// \param initialPosition Vector3d consisting of the initial cartesian position
+   /// \param finalPosition Vector3d consisting of the final cartesian position
+   /// \param timeDelta Total time of flight between initial and final positions
+   /// \param orbitDirection Either Orbit::Direction::Prograde or Orbit::Direciton::Retrograde
+   /// \param numRevolutions Number of full revolutions performed over the timeDelta
+   /// \param mu Gravitational parameter of the central body
+   /// \param [out] initialVelocity Vector3d consisting of computed initial cartesian velocity
+   /// \param [out] finalVelocity Vector3d consisting of computed final cartesian velocity
+   ///
+   ////////////////////////////////////////////////////////////
+   virtual void Evaluate(const Vector3d& initialPosition,
+                         const Vector3d& finalPosition,
+                         const Time& timeDelta,
+                         const Orbit::Direction& orbitDirection,
+                         int numRevolutions,
+                         double mu,
+                         Vector3d& initialVelocity,
+                         Vector3d& finalVelocity) override;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Evaluate all solutions to Lambert's Problem
+   ///
+   /// Forwarded to the wrapped algorithm without caching.
+   ///
+   /// \param initialPosition Vector3d consisting of the initial cartesian position
+   /// \param finalPosition Vector3d consisting of the final cartesian position
+   /// \param timeDelta Total time of flight between initial and final positions
+   /// \param orbitDirection Either Orbit::Direction::Prograde or Orbit::Direciton::Retrograde
+   /// \param maxRevolutions Maximum number of full revolutions performed over the timeDelta
+   /// \param mu Gravitational parameter of the central body
+   /// \param [out] initialVelocities Vector of computed initial cartesian velocities
+   /// \param [out] finalVelocities Vector of computed final cartesian velocities
+   ///
+   ////////////////////////////////////////////////////////////
+   virtual void EvaluateAll(const Vector3d& initialPosition,
+                            const Vector3d& finalPosition,
+                            const Time& timeDelta,
+                            const Orbit::Direction& orbitDirection,
+                            int maxRevolutions,
+                            double mu,
+                            std::vector<Vector3d>& initialVelocities,
+                            std::vector<Vector3d>& finalVelocities) override;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the wrapped Lambert algorithm
+   ////////////////////////////////////////////////////////////
+   const std::shared_ptr<ILambertAlgorithm>& GetAlgorithm() const;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the maximum number of cached solutions
+   ////////////////////////////////////////////////////////////
+   std::size_t GetCapacity() const;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the number of cached solutions
+   ////////////////////////////////////////////////////////////
+   std::size_t GetSize() const;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the number of solves answered from the cache
+   ////////////////////////////////////////////////////////////
+   std::size_t GetHits() const;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the number of solves passed to the wrapped algorithm
+   ////////////////////////////////////////////////////////////
+   std::size_t GetMisses() const;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Remove all cached solutions and reset the statistics
+   ////////////////////////////////////////////////////////////
+   void Clear();
+
+private:
+   ////////////////////////////////////////////////////////////
+   /// \brief Quantised inputs of a solve
+   ////////////////////////////////////////////////////////////
+   struct Key
+   {
+      std::uint64_t values[8];   ///< Quantised r1, r2, time of flight and mu
+      int numRevolutions;        ///< Number of full revolutions
+      int orbitDirection;        ///< Orbit direction
+
+      bool operator==(const Key& other) const;
+   };
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Hash of the quantised inputs
+   ////////////////////////////////////////////////////////////
+   struct KeyHasher
+   {
+      std::size_t operator()(const Key& key) const;
+   };
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Cached solution
+   ////////////////////////////////////////////////////////////
+   struct Entry
+   {
+      Key key;                   ///< Quantised inputs
+      Vector3d initialVelocity;  ///< Initial velocity of the solution
+      Vector3d finalVelocity;    ///< Final velocity of the solution
+   };
+
+   typedef std::list<Entry> EntryList;
+   typedef std::unordered_map<Key, EntryList::iterator, KeyHasher> EntryMap;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Round the mantissa of a value to the cache resolution
+   ////////////////////////////////////////////////////////////
+   std::uint64_t Quantise(double value) const;
+
+private:
+   std::shared_ptr<ILambertAlgorithm> m_lambert;   ///< Wrapped Lambert algorithm
+   std::size_t m_capacity;                         ///< Maximum number of cached solutions
+   std::uint64_t m_roundingBit;                    ///< Half of the quantisation step in mantissa units
+   std::uint64_t m_mask;                           ///< Mask clearing the mantissa bits below the quantisation step
+
+   mutable std::mutex m_mutex;                     ///< Guards the entries and the statistics
+   EntryList m_entries;                            ///< Cached solutions, most recently used first
+   EntryMap m_map;                                 ///< Cached solutions by quantised inputs
+   std::size_t m_hits;                             ///< Number of solves answered from the cache
+   std::size_t m_misses;                           ///< Number of solves passed to the wrapped algorithm
+};
+
+} // namespace keplerian
+
+} // namespace otl
+
+////////////////////////////////////////////////////////////
+/// \class otl::keplerian::LambertCache
+/// \ingroup keplerian
+///
+/// Bounded least recently used cache of Lambert solutions.
+///
+/// Optimisers driving an MGADSMTrajectory revisit nearly identical
+/// decision vectors many times and therefore re-solve the same
+/// Lambert problems. This decorator wraps any ILambertAlgorithm
+/// and answers repeated problems from a bounded cache keyed on
+/// the quantised inputs. Hit and miss counts are available to
+/// tune the capacity and resolution.
+///
+/// Usage example:
+/// \code
+/// auto lambert = std::make_shared<otl::keplerian::LambertExponentialSinusoid>();
+/// otl::keplerian::LambertCache cache(lambert, 10000);
+///
+/// Vector3d initialVelocity, finalVelocity;
+/// cache.Evaluate(initialPosition, finalPosition, timeDelta,
+///                Orbit::Direction::Prograde, 0, ASTRO_MU_SUN,
+///                initialVelocity, finalVelocity);
+///
+/// double hitRate = double(cache.GetHits()) / (cache.GetHits() + cache.GetMisses());
+/// \endcode
+///
+////////////////////////////////////////////////////////////
@@ -31,6 +31,9 @@ namespace otl
 namespace keplerian
 {
 
+class PreparedLambertGeometry;
+class LambertExponentialSinusoidSingleRev;
+
 class OTL_CORE_API LambertExponentialSinusoid : public ILambertAlgorithm
 {
 public:
@@ -67,7 +70,16 @@ public:
     /// an initial position, final position, time delta, and
     /// maximum number of full revolutions.
     ///
-    /// \note There should be N+1 solutions where N=maxRevolutions. 
+    /// The transfer geometry is computed once and shared by all
+    /// revolution counts. For each revolution count the minimum
+    /// time of flight is found first; once it exceeds the time
+    /// delta the remaining revolution counts are rejected without
+    /// being solved.
+    ///
+    /// \note There are up to 2N+1 solutions where N=maxRevolutions.
+    /// The zero revolution solution comes first, followed by the
+    /// long period and short period solutions of each feasible
+    /// revolution count in increasing order.
     ///
     /// \param initialPosition Vector3d consisting of the initial cartesian position
     /// \param finalPosition Vector3d consisting of the final cartesian position
@@ -88,10 +100,345 @@ public:
                              std::vector<Vector3d>& initialVelocities,
                              std::vector<Vector3d>& finalVelocities) override;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Evaluate the solution to Lambert's Problem starting from a previous solution
+    ///
+    /// When the state is valid the secant iteration starts at the
+    /// previous transfer parameter and takes its second point from
+    /// the residual slope of the previous solve, instead of the fixed
+    /// bracket used by Evaluate().
+    ///
+    /// \param initialPosition Vector3d consisting of the initial cartesian position
+    /// \param finalPosition Vector3d consisting of the final cartesian position
+    /// \param timeDelta Total time of flight between initial and final positions
+    /// \param orbitDirection Either Orbit::Direction::Prograde or Orbit::Direciton::Retrograde
+    /// \param numRevolutions Number of full revolutions performed over the timeDelta
+    /// \param mu Gravitational parameter of the central body
+    /// \param [in,out] state Solver state of the previous solve, updated with the new solution
+    /// \param [out] initialVelocity Vector3d consisting of computed initial cartesian velocity
+    /// \param [out] finalVelocity Vector3d consisting of computed final cartesian velocity
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void EvaluateWarmStart(const Vector3d& initialPosition,
+                                   const Vector3d& finalPosition,
+                                   const Time& timeDelta,
+                                   const Orbit::Direction& orbitDirection,
+                                   int numRevolutions,
+                                   double mu,
+                                   LambertSolverState& state,
+                                   Vector3d& initialVelocity,
+                                   Vector3d& finalVelocity) override;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Evaluate the solution to Lambert's Problem to a reduced accuracy
+    ///
+    /// SolverAccuracy::Reduced stops the secant iteration once the
+    /// step in the transfer parameter is below the tolerance.
+    /// SolverAccuracy::Single also performs the iteration, which
+    /// dominates the cost, in single precision. Tolerances tighter
+    /// than single precision allows are clamped. The transfer
+    /// geometry and velocities are always computed in double
+    /// precision.
+    ///
+    /// \param initialPosition Vector3d consisting of the initial cartesian position
+    /// \param finalPosition Vector3d consisting of the final cartesian position
+    /// \param timeDelta Total time of flight between initial and final positions
+    /// \param orbitDirection Either Orbit::Direction::Prograde or Orbit::Direciton::Retrograde
+    /// \param numRevolutions Number of full revolutions performed over the timeDelta
+    /// \param mu Gravitational parameter of the central body
+    /// \param accuracy SolverAccuracy of the solve
+    /// \param tolerance Convergence tolerance of the transfer parameter, e.g. MATH_SCREENING_TOLERANCE
+    /// \param [out] initialVelocity Vector3d consisting of computed initial cartesian velocity
+    /// \param [out] finalVelocity Vector3d consisting of computed final cartesian velocity
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void EvaluateScreening(const Vector3d& initialPosition,
+                                   const Vector3d& finalPosition,
+                                   const Time& timeDelta,
+                                   const Orbit::Direction& orbitDirection,
+                                   int numRevolutions,
+                                   double mu,
+                                   SolverAccuracy accuracy,
+                                   double tolerance,
+                                   Vector3d& initialVelocity,
+                                   Vector3d& finalVelocity) override;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Evaluate a batch of independent Lambert's Problems
+    ///
+    /// The batch is processed in blocks of lanes. The transfer
+    /// geometry of each lane is computed once, then the secant
+    /// iterations of all lanes in the block are advanced in
+    /// lockstep. Lanes that have converged are masked out of the
+    /// remaining iterations, so each result is identical to the
+    /// one returned by Evaluate().
+    ///
+    /// \param initialPositions Initial cartesian positions
+    /// \param finalPositions Final cartesian positions
+    /// \param timeDeltas Total times of flight in seconds
+    /// \param numRevolutions Number of full revolutions performed over each time of flight
+    /// \param orbitDirection Either Orbit::Direction::Prograde or Orbit::Direciton::Retrograde
+    /// \param mu Gravitational parameter of the central body
+    /// \param [out] initialVelocities Computed initial cartesian velocities
+    /// \param [out] finalVelocities Computed final cartesian velocities
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void EvaluateBatch(const Vector3Span<const double>& initialPositions,
+                               const Vector3Span<const double>& finalPositions,
+                               const Span<const double>& timeDeltas,
+                               const Span<const int>& numRevolutions,
+                               const Orbit::Direction& orbitDirection,
+                               double mu,
+                               const Vector3Span<double>& initialVelocities,
+                               const Vector3Span<double>& finalVelocities) override;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Evaluate a batch of independent Lambert's Problems and their partial derivatives
+    ///
+    /// Solves the batch in lockstep as EvaluateBatch() and then
+    /// computes the Jacobian of each element from its converged
+    /// velocities with CalculateJacobian().
+    ///
+    /// \param initialPositions Initial cartesian positions
+    /// \param finalPositions Final cartesian positions
+    /// \param timeDeltas Total times of flight in seconds
+    /// \param numRevolutions Number of full revolutions performed over each time of flight
+    /// \param orbitDirection Either Orbit::Direction::Prograde or Orbit::Direciton::Retrograde
+    /// \param mu Gravitational parameter of the central body
+    /// \param [out] initialVelocities Computed initial cartesian velocities
+    /// \param [out] finalVelocities Computed final cartesian velocities
+    /// \param [out] jacobians Partial derivatives of the velocities with respect to the inputs
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void EvaluateBatch(const Vector3Span<const double>& initialPositions,
+                               const Vector3Span<const double>& finalPositions,
+                               const Span<const double>& timeDeltas,
+                               const Span<const int>& numRevolutions,
+                               const Orbit::Direction& orbitDirection,
+                               double mu,
+                               const Vector3Span<double>& initialVelocities,
+                               const Vector3Span<double>& finalVelocities,
+                               const Span<LambertJacobian>& jacobians) override;
+
 private:
+   ////////////////////////////////////////////////////////////
+   /// \brief Lockstep batch kernel shared by both EvaluateBatch() overloads
+   ///
+   /// \param jacobians Jacobian of each element, or an empty span to skip them
+   ///
+   ////////////////////////////////////////////////////////////
+    void EvaluateBatchKernel(const Vector3Span<const double>& initialPositions,
+                             const Vector3Span<const double>& finalPositions,
+                             const Span<const double>& timeDeltas,
+                             const Span<const int>& numRevolutions,
+                             const Orbit::Direction& orbitDirection,
+                             double mu,
+                             const Vector3Span<double>& initialVelocities,
+                             const Vector3Span<double>& finalVelocities,
+                             const Span<LambertJacobian>& jacobians);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Non-dimensional geometry of a transfer
+   ////////////////////////////////////////////////////////////
+   struct TransferGeometry
+   {
+      double VU;           ///< Velocity unit used to re-dimensionalize the velocities
+      double TU;           ///< Time unit used to non-dimensionalize the time of flight
+      double tof;          ///< Non-dimensional time of flight
+      double logt;         ///< Natural logarithm of the non-dimensional time of flight
+      double r2;           ///< Non-dimensional magnitude of the final position
+      double trueAnomaly;  ///< Transfer angle
+      double sinHalfTheta; ///< Sine of half the transfer angle
+      double tanHalfTheta; ///< Tangent of half the transfer angle
+      double c;            ///< Non-dimensional chord
+      double s;            ///< Non-dimensional semiperimeter
+      double aMin;         ///< Semimajor axis of the minimum energy ellipse
+      double sqrtAMin;     ///< Square root of aMin
+      double lambda;       ///< Lambert parameter
+      int longway;         ///< Equal to 1 for the shortway, -1 for the longway
+      Vector3d R1;         ///< Non-dimensional initial position unit vector
+      Vector3d R2u;        ///< Final position unit vector
+      Vector3d CrossIhR1;  ///< Initial tangential unit vector
+      Vector3d CrossIhR2u; ///< Final tangential unit vector
+   };
+
+   friend class PreparedLambertGeometry;
+   friend class LambertExponentialSinusoidSingleRev;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Compute the non-dimensional geometry of a transfer
+   ///
+   /// \param initialPosition Vector3d consisting of the initial cartesian position
+   /// \param finalPosition Vector3d consisting of the final cartesian position
+   /// \param seconds Total time of flight in seconds
+   /// \param orbitDirection Either Orbit::Direction::Prograde or Orbit::Direciton::Retrograde
+   /// \param mu Gravitational parameter of the central body
+   /// \param [out] geometry Computed transfer geometry
+   ///
+   ////////////////////////////////////////////////////////////
+    static void ComputeTransferGeometry(const Vector3d& initialPosition,
+                                        const Vector3d& finalPosition,
+                                        double seconds,
+                                        const Orbit::Direction& orbitDirection,
+                                        double mu,
+                                        TransferGeometry& geometry);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Compute the parts of the transfer geometry that do not depend on the time of flight
+   ////////////////////////////////////////////////////////////
+    static void PrepareTransferGeometry(const Vector3d& initialPosition,
+                                        const Vector3d& finalPosition,
+                                        const Orbit::Direction& orbitDirection,
+                                        double mu,
+                                        TransferGeometry& geometry);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Set the time of flight of a prepared transfer geometry
+   ////////////////////////////////////////////////////////////
+    static void SetTimeOfFlight(double seconds, TransferGeometry& geometry);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Initialize the two secant iterates for a transfer
+   ///
+   /// \tparam Real Floating point type of the secant iteration
+   ///
+   ////////////////////////////////////////////////////////////
+    template<typename Real>
+    static void InitializeSecant(const TransferGeometry& geometry, int numRevolutions,
+                                 Real& x1, Real& x2, Real& y1, Real& y2);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Map a secant iterate onto the transfer parameter x
+   ////////////////////////////////////////////////////////////
+    static double MapToTransferParameter(double xi, int numRevolutions);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Initialize the two secant iterates from the state of a previous solve
+   ////////////////////////////////////////////////////////////
+    static void InitializeSecant(const TransferGeometry& geometry, int numRevolutions, const LambertSolverState& state,
+                                 double& x1, double& x2, double& y1, double& y2);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Map the transfer parameter x onto a secant iterate
+   ///
+   /// Inverse of MapToTransferParameter().
+   ///
+   ////////////////////////////////////////////////////////////
+    static double MapFromTransferParameter(double x, int numRevolutions);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Time of flight residual driven to zero by the secant iteration
+   ////////////////////////////////////////////////////////////
+    static double CalculateResidual(double x, const TransferGeometry& geometry, int numRevolutions);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Solve for the transfer parameter x using the secant method
+   ///
+   /// \param geometry Transfer geometry
+   /// \param numRevolutions Number of full revolutions
+   /// \returns transfer parameter x
+   ///
+   ////////////////////////////////////////////////////////////
+    static double SolveTransferParameter(const TransferGeometry& geometry, int numRevolutions);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Iterate the secant method from two initial iterates
+   ///
+   /// \param geometry Transfer geometry
+   /// \param numRevolutions Number of full revolutions
+   /// \param x1, x2 Initial secant iterates
+   /// \param y1, y2 Residuals at the initial secant iterates
+   /// \param [out] state If not null, receives the converged solution
+   /// \param tolerance Convergence tolerance of the secant step
+   /// \returns transfer parameter x
+   ///
+   ////////////////////////////////////////////////////////////
+    static double IterateSecant(const TransferGeometry& geometry, int numRevolutions,
+                                double x1, double x2, double y1, double y2,
+                                LambertSolverState* state, double tolerance = MATH_TOLERANCE);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Solve for the transfer parameter x using the secant method in single precision
+   ///
+   /// Runs the same initialization and iteration as
+   /// SolveTransferParameter() instantiated for float.
+   ///
+   /// \param geometry Transfer geometry
+   /// \param numRevolutions Number of full revolutions
+   /// \param tolerance Convergence tolerance of the secant step
+   /// \returns transfer parameter x
+   ///
+   ////////////////////////////////////////////////////////////
+    static double SolveTransferParameterSingle(const TransferGeometry& geometry, int numRevolutions, double tolerance);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Solve for the transfer parameter x for a fixed revolution class
+   ///
+   /// \tparam ZeroRevolution True if numRevolutions is zero
+   ///
+   ////////////////////////////////////////////////////////////
+    template<bool ZeroRevolution>
+    static double SolveTransferParameterSpecialized(const TransferGeometry& geometry, int numRevolutions);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Iterate the secant method for a fixed revolution class
+   ///
+   /// The transfer parameter mapping (exp/log for zero revolutions,
+   /// atan/tan otherwise) and the residual are selected at compile
+   /// time, so the iteration loop does not branch on the number of
+   /// revolutions. IterateSecant() dispatches to this function.
+   ///
+   /// \tparam Real Floating point type of the iteration
+   /// \tparam ZeroRevolution True if numRevolutions is zero
+   ///
+   ////////////////////////////////////////////////////////////
+    template<typename Real, bool ZeroRevolution>
+    static double IterateSecantSpecialized(const TransferGeometry& geometry, int numRevolutions,
+                                           Real x1, Real x2, Real y1, Real y2,
+                                           LambertSolverState* state, double tolerance);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Calculate the minimum time of flight of a multiple revolution transfer
+   ///
+   /// \param geometry Transfer geometry
+   /// \param numRevolutions Number of full revolutions
+   /// \param [out] xMin Transfer parameter at the minimum time of flight
+   /// \returns non-dimensional minimum time of flight
+   ///
+   ////////////////////////////////////////////////////////////
+    static double CalculateMinimumTimeOfFlight(const TransferGeometry& geometry, int numRevolutions, double& xMin);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Solve for the transfer parameter x on one branch of a multiple revolution transfer
+   ///
+   /// Uses Householder iterations safeguarded by the bracket
+   /// between the minimum time of flight and the end of the branch.
+   ///
+   /// \param geometry Transfer geometry
+   /// \param numRevolutions Number of full revolutions
+   /// \param xMin Transfer parameter at the minimum time of flight
+   /// \param leftBranch True for the branch x < xMin, false for x > xMin
+   /// \returns transfer parameter x
+   ///
+   ////////////////////////////////////////////////////////////
+    static double SolveMultiRevBranch(const TransferGeometry& geometry, int numRevolutions, double xMin, bool leftBranch);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Compute the dimensional velocities from a converged transfer parameter
+   ///
+   /// \param geometry Transfer geometry
+   /// \param x Converged transfer parameter
+   /// \param [out] initialVelocity Vector3d consisting of computed initial cartesian velocity
+   /// \param [out] finalVelocity Vector3d consisting of computed final cartesian velocity
+   ///
+   ////////////////////////////////////////////////////////////
+    static void ComputeVelocities(const TransferGeometry& geometry, double x,
+                                  Vector3d& initialVelocity, Vector3d& finalVelocity);
+
    ////////////////////////////////////////////////////////////
    /// \brief Calculate the time of flight
    ///
+   /// \tparam Real Floating point type of the evaluation
    /// \param x
    /// \param s
    /// \param c
@@ -100,7 +447,8 @@ private:
    /// \returns time of flight
    ///
    ////////////////////////////////////////////////////////////
-    double CalculateTimeOfFlight(double x, double s, double c, int longway, int maxRevolutions);
+    template<typename Real>
+    static Real CalculateTimeOfFlight(Real x, Real s, Real c, int longway, int maxRevolutions);
 };
 
 } // namespace keplerian
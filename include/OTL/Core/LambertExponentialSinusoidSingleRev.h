@@ -0,0 +1,100 @@
+////////////////////////////////////////////////////////////
+//
+// OTL - Orbital Trajectory Library
+// Copyright (C) 2013-2018 Jason Bryan (Jmbryan10@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#pragma once
+#include <OTL/Core/LambertExponentialSinusoid.h>
+
+namespace otl
+{
+
+namespace keplerian
+{
+
+class OTL_CORE_API LambertExponentialSinusoidSingleRev : public LambertExponentialSinusoid
+{
+public:
+    ////////////////////////////////////////////////////////////
+    /// \brief Evaluate the solution to Lambert's Problem
+    ///
+    /// Zero revolution transfers are solved by the secant
+    /// iteration specialised at compile time for zero revolutions.
+    /// The result is identical to LambertExponentialSinusoid::Evaluate().
+    /// Multiple revolution transfers are forwarded to
+    /// LambertExponentialSinusoid::Evaluate().
+    ///
+    /// \param initialPosition Vector3d consisting of the initial cartesian position
+    /// \param finalPosition Vector3d consisting of the final cartesian position
+    /// \param timeDelta Total time of flight between initial and final positions
+    /// \param orbitDirection Either Orbit::Direction::Prograde or Orbit::Direciton::Retrograde
+    /// \param numRevolutions Number of full revolutions performed over the timeDelta, normally zero
+    /// \param mu Gravitational parameter of the central body
+    /// \param [out] initialVelocity Vector3d consisting of computed initial cartesian velocity
+    /// \param [out] finalVelocity Vector3d consisting of computed final cartesian velocity
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void Evaluate(const Vector3d& initialPosition,
+                          const Vector3d& finalPosition,
+                          const Time& timeDelta,
+                          const Orbit::Direction& orbitDirection,
+                          int numRevolutions,
+                          double mu,
+                          Vector3d& initialVelocity,
+                          Vector3d& finalVelocity) override;
+};
+
+} // namespace keplerian
+
+} // namespace otl
+
+////////////////////////////////////////////////////////////
+/// \class otl::keplerian::LambertExponentialSinusoidSingleRev
+/// \ingroup keplerian
+///
+/// Zero revolution variant of LambertExponentialSinusoid.
+///
+/// Selected by LambertType::SingleRev. Trajectory legs that never
+/// wrap around the central body, such as the legs of an
+/// MGADSMTrajectory, only ever solve zero revolution transfers.
+/// This variant calls the zero revolution instantiation of the
+/// secant iteration directly, which uses the exp/log mapping of
+/// the transfer parameter and the logarithmic time of flight
+/// residual without testing the number of revolutions.
+///
+/// Usage example:
+/// \code
+/// auto lambert = otl::keplerian::LambertExponentialSinusoidSingleRev();
+///
+/// Vector3d initialVelocity, finalVelocity;
+/// lambert.Evaluate(initialPosition,
+///                  finalPosition,
+///                  Time::Days(150.0),
+///                  Orbit::Direction::Prograde,
+///                  0,
+///                  ASTRO_MU_SUN,
+///                  initialVelocity,
+///                  finalVelocity);
+/// \endcode
+///
+////////////////////////////////////////////////////////////
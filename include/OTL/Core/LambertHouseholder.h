@@ -0,0 +1,291 @@
+////////////////////////////////////////////////////////////
+//
+// OTL - Orbital Trajectory Library
+// Copyright (C) 2013-2018 Jason Bryan (Jmbryan10@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#pragma once
+#include <OTL/Core/Lambert.h>
+
+namespace otl
+{
+
+namespace keplerian
+{
+
+class OTL_CORE_API LambertHouseholder : public ILambertAlgorithm
+{
+public:
+   ////////////////////////////////////////////////////////////
+   /// \brief Evaluate the solution to Lambert's Problem
+   ///
+   /// Calculates the initial and final velocity vectors given
+   /// an initial position, final position, time delta, and
+   /// number of full revolutions.
+   ///
+   /// \note For numRevolutions > 0 there are two solutions. The
+   /// left branch solution is returned. Use
+   /// EvaluateAll() to obtain both branches.
+   ///
+   /// If the time of flight is too short to perform numRevolutions
+   /// revolutions a warning is logged and both velocities are set
+   /// to NaN.
+   ///
+   /// \param initialPosition Vector3d consisting of the initial cartesian position
+   /// \param finalPosition Vector3d consisting of the final cartesian position
+   /// \param timeDelta Total time of flight between initial and final positions
+   /// \param orbitDirection Either Orbit::Direction::Prograde or Orbit::Direciton::Retrograde
+   /// \param numRevolutions Number of full revolutions performed over the timeDelta
+   /// \param mu Gravitational parameter of the central body
+   /// \param [out] initialVelocity Vector3d consisting of computed initial cartesian velocity
+   /// \param [out] finalVelocity Vector3d consisting of computed final cartesian velocity
+   ///
+   ////////////////////////////////////////////////////////////
+   virtual void Evaluate(const Vector3d& initialPosition,
+                         const Vector3d& finalPosition,
+                         const Time& timeDelta,
+                         const Orbit::Direction& orbitDirection,
+                         int numRevolutions,
+                         double mu,
+                         Vector3d& initialVelocity,
+                         Vector3d& finalVelocity) override;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Evaluate all solutions to Lambert's Problem up to a maximum number of revolutions
+   ///
+   /// Calculates all initial and final velocity vectors given
+   /// an initial position, final position, time delta, and
+   /// maximum number of full revolutions.
+   ///
+   /// \note There are up to 2N+1 solutions where N=maxRevolutions.
+   /// The zero revolution solution comes first, followed by the
+   /// long period and short period solutions of each revolution
+   /// count, as for every ILambertAlgorithm. Revolution counts
+   /// that cannot be completed within the time delta are omitted.
+   ///
+   /// \param initialPosition Vector3d consisting of the initial cartesian position
+   /// \param finalPosition Vector3d consisting of the final cartesian position
+   /// \param timeDelta Total time of flight between initial and final positions
+   /// \param orbitDirection Either Orbit::Direction::Prograde or Orbit::Direciton::Retrograde
+   /// \param maxRevolutions Maximum number of full revolutions allowed
+   /// \param mu Gravitational parameter of the central body
+   /// \param [out] initialVelocities Vector of Vector3d's consisting of computed initial cartesian velocity
+   /// \param [out] finalVelocities Vector of Vector3d's consisting of computed final cartesian velocity
+   ///
+   ////////////////////////////////////////////////////////////
+   virtual void EvaluateAll(const Vector3d& initialPosition,
+                            const Vector3d& finalPosition,
+                            const Time& timeDelta,
+                            const Orbit::Direction& orbitDirection,
+                            int maxRevolutions,
+                            double mu,
+                            std::vector<Vector3d>& initialVelocities,
+                            std::vector<Vector3d>& finalVelocities) override;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Evaluate the solution to Lambert's Problem starting from a previous solution
+   ///
+   /// When the state is valid the Householder iteration starts at
+   /// the previous transfer parameter instead of the initial guess.
+   ///
+   /// Unlike Evaluate(), no warning is logged if the time of flight
+   /// is too short to perform numRevolutions revolutions. Both
+   /// velocities are set to NaN and the state is invalidated.
+   ///
+   /// \param initialPosition Vector3d consisting of the initial cartesian position
+   /// \param finalPosition Vector3d consisting of the final cartesian position
+   /// \param timeDelta Total time of flight between initial and final positions
+   /// \param orbitDirection Either Orbit::Direction::Prograde or Orbit::Direciton::Retrograde
+   /// \param numRevolutions Number of full revolutions performed over the timeDelta
+   /// \param mu Gravitational parameter of the central body
+   /// \param [in,out] state Solver state of the previous solve, updated with the new solution
+   /// \param [out] initialVelocity Vector3d consisting of computed initial cartesian velocity
+   /// \param [out] finalVelocity Vector3d consisting of computed final cartesian velocity
+   ///
+   ////////////////////////////////////////////////////////////
+   virtual void EvaluateWarmStart(const Vector3d& initialPosition,
+                                  const Vector3d& finalPosition,
+                                  const Time& timeDelta,
+                                  const Orbit::Direction& orbitDirection,
+                                  int numRevolutions,
+                                  double mu,
+                                  LambertSolverState& state,
+                                  Vector3d& initialVelocity,
+                                  Vector3d& finalVelocity) override;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Evaluate the solution to Lambert's Problem to a reduced accuracy
+   ///
+   /// SolverAccuracy::Reduced and SolverAccuracy::Single both stop
+   /// the Householder iteration at the given tolerance. The
+   /// iteration already converges in a few steps, so there is no
+   /// separate single precision path.
+   ///
+   /// \param initialPosition Vector3d consisting of the initial cartesian position
+   /// \param finalPosition Vector3d consisting of the final cartesian position
+   /// \param timeDelta Total time of flight between initial and final positions
+   /// \param orbitDirection Either Orbit::Direction::Prograde or Orbit::Direciton::Retrograde
+   /// \param numRevolutions Number of full revolutions performed over the timeDelta
+   /// \param mu Gravitational parameter of the central body
+   /// \param accuracy SolverAccuracy of the solve
+   /// \param tolerance Convergence tolerance of the transfer parameter, e.g. MATH_SCREENING_TOLERANCE
+   /// \param [out] initialVelocity Vector3d consisting of computed initial cartesian velocity
+   /// \param [out] finalVelocity Vector3d consisting of computed final cartesian velocity
+   ///
+   ////////////////////////////////////////////////////////////
+   virtual void EvaluateScreening(const Vector3d& initialPosition,
+                                  const Vector3d& finalPosition,
+                                  const Time& timeDelta,
+                                  const Orbit::Direction& orbitDirection,
+                                  int numRevolutions,
+                                  double mu,
+                                  SolverAccuracy accuracy,
+                                  double tolerance,
+                                  Vector3d& initialVelocity,
+                                  Vector3d& finalVelocity) override;
+
+private:
+   ////////////////////////////////////////////////////////////
+   /// \brief Non-dimensional geometry of a transfer
+   ////////////////////////////////////////////////////////////
+   struct TransferGeometry
+   {
+      double lambda;    ///< Lambert parameter, negative for the long way
+      double T;         ///< Non-dimensional time of flight
+      double gamma;     ///< Velocity scale factor sqrt(mu * s / 2)
+      double rho;       ///< (r1 - r2) / c
+      double sigma;     ///< sqrt(1 - rho^2)
+      double r1;        ///< Magnitude of the initial position
+      double r2;        ///< Magnitude of the final position
+      Vector3d ir1;     ///< Initial radial unit vector
+      Vector3d ir2;     ///< Final radial unit vector
+      Vector3d it1;     ///< Initial tangential unit vector
+      Vector3d it2;     ///< Final tangential unit vector
+   };
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Compute the non-dimensional geometry of a transfer
+   ////////////////////////////////////////////////////////////
+   static void ComputeTransferGeometry(const Vector3d& initialPosition,
+                                       const Vector3d& finalPosition,
+                                       double seconds,
+                                       const Orbit::Direction& orbitDirection,
+                                       double mu,
+                                       TransferGeometry& geometry);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Maximum number of revolutions feasible for the transfer
+   ///
+   /// The minimum time of flight of the highest candidate
+   /// revolution count is found with Halley iterations and the
+   /// count is reduced by one if it exceeds the time of flight.
+   ///
+   ////////////////////////////////////////////////////////////
+   static int CalculateMaxRevolutions(double lambda, double T);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Solve for x using Householder iterations
+   ///
+   /// \param lambda Lambert parameter
+   /// \param T Non-dimensional time of flight
+   /// \param x0 Initial guess
+   /// \param numRevolutions Number of full revolutions
+   /// \param tolerance Convergence tolerance on x
+   /// \param [out] iterations Number of iterations performed
+   /// \param [out] converged Optional flag set to true if the last step was within the tolerance
+   /// \returns converged value of x
+   ///
+   ////////////////////////////////////////////////////////////
+   static double SolveHouseholder(double lambda, double T, double x0, int numRevolutions, double tolerance, int& iterations, bool* converged = nullptr);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Initial guess for the zero revolution solution
+   ////////////////////////////////////////////////////////////
+   static double CalculateInitialGuess(double lambda, double T);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Initial guess for a multiple revolution solution
+   ///
+   /// \param T Non-dimensional time of flight
+   /// \param numRevolutions Number of full revolutions
+   /// \param leftBranch True for the left branch, false for the right branch
+   ///
+   ////////////////////////////////////////////////////////////
+   static double CalculateInitialGuess(double T, int numRevolutions, bool leftBranch);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Non-dimensional time of flight as a function of x
+   ////////////////////////////////////////////////////////////
+   static double CalculateTimeOfFlight(double lambda, double x, int numRevolutions);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Time of flight using Lagrange's formulation
+   ////////////////////////////////////////////////////////////
+   static double CalculateTimeOfFlightLagrange(double lambda, double x, int numRevolutions);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Compute the dimensional velocities from a converged x
+   ////////////////////////////////////////////////////////////
+   static void ComputeVelocities(const TransferGeometry& geometry, double x,
+                                 Vector3d& initialVelocity, Vector3d& finalVelocity);
+};
+
+} // namespace keplerian
+
+} // namespace otl
+
+////////////////////////////////////////////////////////////
+/// \class otl::keplerian::LambertHouseholder
+/// \ingroup keplerian
+///
+/// Implements Lambert's problem using Izzo's formulation with
+/// Householder iterations.
+///
+/// The problem is reduced to finding the root x of the non-
+/// dimensional time of flight equation T(x) = T* for a single
+/// geometric parameter lambda. Starting from an accurate initial
+/// guess, a third order Householder update converges in two to
+/// three iterations for zero revolution transfers as well as
+/// both branches of multiple revolution transfers. The time of
+/// flight is evaluated with Lancaster's expression, Lagrange's
+/// expression or Battin's hypergeometric series depending on
+/// the distance of x from the parabolic case.
+///
+/// Usage example:
+/// \code
+/// auto lambert = otl::keplerian::LambertHouseholder();
+///
+/// std::vector<Vector3d> initialVelocities, finalVelocities;
+/// lambert.EvaluateAll(initialPosition,
+///                     finalPosition,
+///                     timeDelta,
+///                     otl::keplerian::Orbit::Direction::Prograde,
+///                     2,
+///                     ASTRO_MU_SUN,
+///                     initialVelocities,
+///                     finalVelocities);
+/// \endcode
+///
+/// \reference D. Izzo. Revisiting Lambert's problem.
+/// Celestial Mechanics and Dynamical Astronomy, 121(1):1-15, 2015.
+///
+////////////////////////////////////////////////////////////
@@ -1,5 +1,6 @@
 #pragma once
 #include <OTL/Core/Export.h>
+#include <atomic>
 #include <sstream>
 #include <memory>
 #include <tuple>
@@ -52,6 +53,7 @@ class OTL_CORE_API Logger
 {
 public:
     Logger();
+    Logger(const Logger& other);
     virtual ~Logger();
     void Initialize();
 
@@ -79,7 +81,7 @@ protected:
     virtual void VLog(const std::string& message, const LogLevel& logLevel);
     
 private:
-    bool m_initialized;
+    std::atomic<bool> m_initialized;
     LogLevel m_logLevel;
     std::string m_logDirectory;
     std::string m_logFilename;
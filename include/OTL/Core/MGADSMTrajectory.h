@@ -42,6 +42,9 @@ namespace otl
 namespace keplerian
 {
 
+// Forward declarations
+class LambertCache;
+
 ////////////////////////////////////////////////////////////
 /// \defgroup trajectory Trajectory
 /// \ingroup keplerian
@@ -535,7 +538,12 @@ public:
    ////////////////////////////////////////////////////////////
    /// \brief Set the type of Lambert algorithm to be used
    ///
-   /// The default type is LambertType::ExponentialSinusoid.
+   /// The default type is LambertType::SingleRev, which selects
+   /// LambertExponentialSinusoidSingleRev since every leg is solved
+   /// with zero revolutions. LambertType::MultiRev selects the
+   /// general LambertExponentialSinusoid.
+   /// LambertType::Householder selects the LambertHouseholder
+   /// algorithm, which converges in fewer iterations.
    /// 
    /// \param type Type of Lambert algorithm
    ///
@@ -552,6 +560,20 @@ public:
    ////////////////////////////////////////////////////////////
    void SetFlybyType(FlybyType type);
 
+   ////////////////////////////////////////////////////////////
+   /// \brief Enable or disable caching of Lambert solutions
+   ///
+   /// Optimizers revisit nearly identical state vectors many
+   /// times. When enabled, the Lambert algorithm is wrapped in a
+   /// LambertCache so repeated legs are not solved again. The
+   /// cache is disabled by default and survives SetLambertType().
+   ///
+   /// \param capacity Maximum number of cached solutions, zero disables the cache
+   /// \param resolution Relative resolution of the quantised Lambert inputs
+   ///
+   ////////////////////////////////////////////////////////////
+   void SetLambertCache(std::size_t capacity, double resolution = 1.0e-9);
+
    // Getters
 
    ////////////////////////////////////////////////////////////
@@ -586,6 +608,14 @@ public:
    ////////////////////////////////////////////////////////////
    int GetNumStates() const;
 
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the Lambert cache
+   ///
+   /// \returns Smart pointer to the LambertCache, or null if caching is disabled
+   ///
+   ////////////////////////////////////////////////////////////
+   std::shared_ptr<const LambertCache> GetLambertCache() const;
+
 private:
    ////////////////////////////////////////////////////////////
    /// \brief Initialize the trajectory
@@ -697,6 +727,8 @@ private:
 
    std::shared_ptr<otl::IPropagator> m_propagator;    ///< Propagation algorithm smart pointer
    std::shared_ptr<ILambertAlgorithm> m_lambert;      ///< Lambert algorithm smart pointer
+   std::size_t m_lambertCacheCapacity;                ///< Capacity of the Lambert cache, zero if disabled
+   double m_lambertCacheResolution;                   ///< Relative resolution of the Lambert cache
    std::shared_ptr<IFlybyAlgorithm> m_flyby;          ///< Flyby algorithm smart pointer
 
    // Temporary variables used in CalculateTrajectory()
@@ -114,18 +114,38 @@ public:
    ////////////////////////////////////////////////////////////
    /// \brief Set the gravitational parameter of the central body
    ///
+   /// The orbital elements are preserved and the state vector
+   /// is recomputed from them when it is next requested.
+   ///
    /// \param mu Gravitational parameter of the central body of the orbit
    ///
    ////////////////////////////////////////////////////////////
    void SetGravitationalParameterCentralBody(double mu);
 
+   ////////////////////////////////////////////////////////////
+   /// \brief Set the orbital elements of the orbit
+   ///
+   /// Only the quantities that depend on the modified elements
+   /// are invalidated. Changing just the mean anomaly keeps
+   /// the mean motion, period and other properties of the
+   /// orbit shape, and setting the same elements again keeps
+   /// everything that has already been computed.
+   ///
+   /// \param orbitalElements OrbitalElements of the orbit
+   /// \param orbitDirection Direction of motion of the orbit
+   ///
+   ////////////////////////////////////////////////////////////
+   void SetOrbitalElements(const OrbitalElements& orbitalElements, Direction orbitDirection = Direction::Prograde);
+
    ////////////////////////////////////////////////////////////
    /// \brief Set the state vector of the orbit
    ///
+   /// The orbital elements and orbit properties are recomputed
+   /// from the state vector when they are next requested.
+   ///
    /// \param stateVector StateVector of the orbit
    ///
    ////////////////////////////////////////////////////////////
-   void SetOrbitalElements(const OrbitalElements& orbitalElements, Direction orbitDirection = Direction::Prograde);
    void SetStateVector(const StateVector& stateVector);
 
    ////////////////////////////////////////////////////////////
@@ -225,8 +245,42 @@ public:
    ////////////////////////////////////////////////////////////
    Type GetOrbitType() const;
 
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the properties of the orbit
+   ///
+   /// The properties are cached. Those that depend only on the
+   /// size and shape of the orbit (type, mean motion, period,
+   /// semiparameter and specific angular momentum) are kept
+   /// across Propagate() calls, while the anomalies, radius and
+   /// time since periapsis are recomputed once per new mean anomaly.
+   ///
+   /// \return OrbitProperties of the orbit
+   ///
+   ////////////////////////////////////////////////////////////
    const OrbitProperties& GetOrbitProperties() const;
 
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the mean motion of the orbit
+   ///
+   /// Unlike GetOrbitProperties(), this does not solve
+   /// Kepler's equation for the current anomaly.
+   ///
+   /// \return Mean motion (radians / sec)
+   ///
+   ////////////////////////////////////////////////////////////
+   double GetMeanMotion() const;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the period of the orbit
+   ///
+   /// Unlike GetOrbitProperties(), this does not solve
+   /// Kepler's equation for the current anomaly.
+   ///
+   /// \return Orbit period (seconds), infinite for open orbits
+   ///
+   ////////////////////////////////////////////////////////////
+   double GetPeriod() const;
+
    ////////////////////////////////////////////////////////////
    /// \brief Get the elapsed propagation time of the orbit
    ///
@@ -254,9 +308,10 @@ public:
    /// \brief Propagate the orbit in time
    ///
    /// This function propagates the state vector of the orbit
-   /// in time using the internal propagation algorithm.
-   /// The propagation algorithm defaults to KeplerianPropagator
-   /// but can be specified by calling the SetPropagator() method.
+   /// in time using a Keplerian propagator shared by all orbits.
+   /// Only the mean anomaly is advanced using the cached mean
+   /// motion, the state vector and anomaly dependent properties
+   /// are recomputed lazily when they are next requested.
    ///
    /// \note The time can be positive or negative for forewards and backwards propagation respectively
    ///
@@ -346,6 +401,8 @@ private:
    ///
    ////////////////////////////////////////////////////////////
    void UpdateOrbitProperties() const;
+   void UpdateShapeProperties() const;
+   void UpdateAnomalyProperties() const;
    void UpdateOrbitalElements() const;
    void UpdateStateVector() const;
 
@@ -355,7 +412,10 @@ private:
    mutable OrbitalElements m_orbitalElements;            ///< Orbital elements
    mutable StateVector m_StateVector;                    ///< Cartesian state vector
    mutable Direction m_direction;                        ///< Orbit direction (e.g. Prograde or Retrograde)
-   mutable bool m_propertiesDirty;                       ///< True if the orbit properties are not up-to-date
+   mutable double m_anomalyMeanAnomaly;                  ///< Mean anomaly at which the anomaly properties were computed
+   mutable double m_StateVectorMeanAnomaly;              ///< Mean anomaly at which the cartesian state vector was computed
+   mutable bool m_shapePropertiesDirty;                  ///< True if the properties of the orbit shape are not up-to-date
+   mutable bool m_anomalyPropertiesDirty;                ///< True if the anomaly properties are not up-to-date
    mutable bool m_orbitalElementsDirty;                  ///< True if the orbital elements are not up-to-date
    mutable bool m_StateVectorDirty;                      ///< True if the cartesian state vector is not up-to-date
 };
@@ -0,0 +1,197 @@
+////////////////////////////////////////////////////////////
+//
+// OTL - Orbital Trajectory Library
+// Copyright (C) 2013-2018 Jason Bryan (Jmbryan10@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#pragma once
+#include <OTL/Core/Base.h>
+#include <OTL/Core/Epoch.h>
+#include <OTL/Core/Orbit.h>
+#include <string>
+#include <vector>
+
+namespace otl
+{
+
+// Forward declarations
+class OrbitalBody;
+
+namespace keplerian
+{
+
+////////////////////////////////////////////////////////////
+/// \brief Options controlling how a PorkchopEngine evaluates a grid
+/// \ingroup keplerian
+////////////////////////////////////////////////////////////
+struct OTL_CORE_API PorkchopOptions
+{
+   Orbit::Direction orbitDirection; ///< Direction of every transfer
+   int numRevolutions;              ///< Number of full revolutions of every transfer
+   LambertType lambertType;         ///< Lambert algorithm used to solve each cell
+   int numThreads;                  ///< Number of worker threads, zero selects one per hardware core
+   int tileSize;                    ///< Number of departure and arrival epochs per tile
+   std::string outputFilename;      ///< If not empty, tiles are streamed to this file instead of kept in memory
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Default constructor
+   ///
+   /// Prograde zero revolution transfers solved with
+   /// LambertType::MultiRev on every core in 32x32 tiles.
+   ///
+   ////////////////////////////////////////////////////////////
+   PorkchopOptions();
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Departure and arrival grid computed by a PorkchopEngine
+/// \ingroup keplerian
+///
+/// Cell arrays are stored row-major with one row per departure
+/// epoch. Cells whose arrival epoch does not follow the departure
+/// epoch hold NaN, as do cells whose time of flight is too short
+/// for the requested number of revolutions. The cell arrays are
+/// empty if the grid was streamed to disk.
+///
+////////////////////////////////////////////////////////////
+struct OTL_CORE_API PorkchopGrid
+{
+   std::vector<Epoch> departureEpochs; ///< Departure epoch of each row
+   std::vector<Epoch> arrivalEpochs;   ///< Arrival epoch of each column
+   std::vector<double> departureC3;    ///< Departure characteristic energy (squared hyperbolic excess velocity)
+   std::vector<double> arrivalVinf;    ///< Arrival hyperbolic excess velocity
+   std::vector<double> totalDeltaV;    ///< Sum of the departure and arrival hyperbolic excess velocities
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the index of a cell in the cell arrays
+   ///
+   /// \param departureIndex Index of the departure epoch (row)
+   /// \param arrivalIndex Index of the arrival epoch (column)
+   /// \returns Index into departureC3, arrivalVinf and totalDeltaV
+   ///
+   ////////////////////////////////////////////////////////////
+   std::size_t GetIndex(std::size_t departureIndex, std::size_t arrivalIndex) const;
+};
+
+class OTL_CORE_API PorkchopEngine
+{
+public:
+   ////////////////////////////////////////////////////////////
+   /// \brief Create a porkchop engine
+   ///
+   /// \param options PorkchopOptions controlling the evaluation
+   ///
+   ////////////////////////////////////////////////////////////
+   explicit PorkchopEngine(const PorkchopOptions& options = PorkchopOptions());
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Set the options used by subsequent evaluations
+   ///
+   /// \param options PorkchopOptions controlling the evaluation
+   ///
+   ////////////////////////////////////////////////////////////
+   void SetOptions(const PorkchopOptions& options);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the options used by evaluations
+   ///
+   /// \returns PorkchopOptions controlling the evaluation
+   ///
+   ////////////////////////////////////////////////////////////
+   const PorkchopOptions& GetOptions() const;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Evaluate the porkchop grid between two bodies
+   ///
+   /// Both bodies must orbit the same central body. The state of
+   /// each body is computed once per departure epoch (row) and
+   /// once per arrival epoch (column) on the calling thread. The
+   /// grid is then split into tiles which are solved in parallel,
+   /// each row of a tile warm starting Lambert's problem from the
+   /// neighbouring cell.
+   ///
+   /// If PorkchopOptions::outputFilename is set, every tile is
+   /// appended to that binary file as soon as it is finished and
+   /// only the epochs are returned. Each tile record consists of
+   /// four int32 values (first departure index, first arrival
+   /// index, number of rows, number of columns) followed by the
+   /// row-major departure C3, arrival v-infinity and total delta-V
+   /// of the tile as doubles. Tiles are written in completion order.
+   /// An error is logged if the file could not be written.
+   ///
+   /// Cells without a Lambert solution are counted by the workers
+   /// and reported in a single warning once all tiles are finished.
+   ///
+   /// \param departureBody OrbitalBody at the start of the transfer
+   /// \param arrivalBody OrbitalBody at the end of the transfer
+   /// \param departureBegin First departure epoch
+   /// \param departureEnd Last departure epoch
+   /// \param arrivalBegin First arrival epoch
+   /// \param arrivalEnd Last arrival epoch
+   /// \param resolution Spacing between consecutive departure and arrival epochs
+   /// \returns PorkchopGrid containing the epochs and, if not streamed, the cell arrays
+   ///
+   ////////////////////////////////////////////////////////////
+   PorkchopGrid Evaluate(OrbitalBody& departureBody,
+                         OrbitalBody& arrivalBody,
+                         const Epoch& departureBegin,
+                         const Epoch& departureEnd,
+                         const Epoch& arrivalBegin,
+                         const Epoch& arrivalEnd,
+                         const Time& resolution) const;
+
+private:
+   PorkchopOptions m_options; ///< Options controlling the evaluation
+};
+
+} // namespace keplerian
+
+} // namespace otl
+
+////////////////////////////////////////////////////////////
+/// \class otl::keplerian::PorkchopEngine
+/// \ingroup keplerian
+///
+/// Parallel evaluation of departure and arrival epoch grids.
+///
+/// A porkchop plot maps the cost of a ballistic transfer between
+/// two bodies over a range of departure and arrival epochs. The
+/// engine evaluates the body states once per row and column,
+/// solves Lambert's problem for every cell on all cores and
+/// returns the departure C3, arrival v-infinity and total delta-V.
+/// Very large grids can be streamed to disk tile by tile.
+///
+/// Usage example:
+/// \code
+/// otl::Planet earth("Earth");
+/// otl::Planet mars("Mars");
+///
+/// otl::keplerian::PorkchopEngine engine;
+/// auto grid = engine.Evaluate(earth, mars,
+///                             otl::Epoch::MJD2000(3000.0), otl::Epoch::MJD2000(3400.0),
+///                             otl::Epoch::MJD2000(3150.0), otl::Epoch::MJD2000(3750.0),
+///                             otl::Time::Days(1.0));
+///
+/// double c3 = grid.departureC3[grid.GetIndex(10, 200)];
+/// \endcode
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,160 @@
+////////////////////////////////////////////////////////////
+//
+// OTL - Orbital Trajectory Library
+// Copyright (C) 2013-2018 Jason Bryan (Jmbryan10@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#pragma once
+#include <OTL/Core/LambertExponentialSinusoid.h>
+
+namespace otl
+{
+
+namespace keplerian
+{
+
+class OTL_CORE_API PreparedLambertGeometry
+{
+public:
+   ////////////////////////////////////////////////////////////
+   /// \brief Prepare the geometry of a transfer between two fixed positions
+   ///
+   /// Computes and caches everything that does not depend on
+   /// the time of flight: the non-dimensional units, the
+   /// transfer angle, chord, semiperimeter, lambda and the
+   /// radial and tangential unit vectors.
+   ///
+   /// \param initialPosition Vector3d consisting of the initial cartesian position
+   /// \param finalPosition Vector3d consisting of the final cartesian position
+   /// \param orbitDirection Either Orbit::Direction::Prograde or Orbit::Direciton::Retrograde
+   /// \param mu Gravitational parameter of the central body
+   ///
+   ////////////////////////////////////////////////////////////
+   PreparedLambertGeometry(const Vector3d& initialPosition,
+                           const Vector3d& finalPosition,
+                           const Orbit::Direction& orbitDirection,
+                           double mu);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Solve Lambert's Problem for a single time of flight
+   ///
+   /// The result is identical to LambertExponentialSinusoid::Evaluate()
+   /// for the prepared positions.
+   ///
+   /// \param timeDelta Total time of flight between initial and final positions
+   /// \param numRevolutions Number of full revolutions performed over the timeDelta
+   /// \param [out] initialVelocity Vector3d consisting of computed initial cartesian velocity
+   /// \param [out] finalVelocity Vector3d consisting of computed final cartesian velocity
+   ///
+   ////////////////////////////////////////////////////////////
+   void Solve(const Time& timeDelta,
+              int numRevolutions,
+              Vector3d& initialVelocity,
+              Vector3d& finalVelocity) const;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Solve Lambert's Problem for a sequence of times of flight
+   ///
+   /// Each solve is warm started from the previous one, so
+   /// sweeps over smoothly varying times of flight converge
+   /// in fewer iterations. All spans must be of equal size.
+   ///
+   /// \param timeDeltas Total times of flight in seconds
+   /// \param numRevolutions Number of full revolutions performed over each time of flight
+   /// \param [out] initialVelocities Computed initial cartesian velocities
+   /// \param [out] finalVelocities Computed final cartesian velocities
+   ///
+   ////////////////////////////////////////////////////////////
+   void Solve(const Span<const double>& timeDeltas,
+              int numRevolutions,
+              const Vector3Span<double>& initialVelocities,
+              const Vector3Span<double>& finalVelocities) const;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the transfer angle
+   ///
+   /// \returns Transfer angle (radians)
+   ///
+   ////////////////////////////////////////////////////////////
+   double GetTransferAngle() const;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the Lambert parameter lambda
+   ///
+   /// \returns Lambda, negative for transfers longer than half a revolution
+   ///
+   ////////////////////////////////////////////////////////////
+   double GetLambda() const;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the chord between the initial and final positions
+   ///
+   /// \returns Chord (same units as the positions)
+   ///
+   ////////////////////////////////////////////////////////////
+   double GetChord() const;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the semiperimeter of the transfer triangle
+   ///
+   /// \returns Semiperimeter (same units as the positions)
+   ///
+   ////////////////////////////////////////////////////////////
+   double GetSemiperimeter() const;
+
+private:
+   LambertExponentialSinusoid::TransferGeometry m_geometry; ///< Geometry with the time of flight unset
+   double m_distanceUnit;                                   ///< Distance unit of the non-dimensional geometry
+};
+
+} // namespace keplerian
+
+} // namespace otl
+
+////////////////////////////////////////////////////////////
+/// \class otl::keplerian::PreparedLambertGeometry
+/// \ingroup keplerian
+///
+/// Transfer geometry between two fixed positions, prepared once
+/// and reused for many times of flight.
+///
+/// Phasing studies and resonance searches solve Lambert's problem
+/// between the same two positions for many times of flight. This
+/// class performs the vector work of LambertExponentialSinusoid
+/// once at construction so that each solve only iterates on the
+/// time of flight equation and assembles the velocities.
+///
+/// Usage example:
+/// \code
+/// otl::keplerian::PreparedLambertGeometry geometry(initialPosition,
+///                                                  finalPosition,
+///                                                  otl::keplerian::Orbit::Direction::Prograde,
+///                                                  ASTRO_MU_SUN);
+///
+/// Vector3d initialVelocity, finalVelocity;
+/// for (int days = 100; days < 400; ++days)
+/// {
+///    geometry.Solve(Time::Days(days), 0, initialVelocity, finalVelocity);
+/// }
+/// \endcode
+///
+////////////////////////////////////////////////////////////
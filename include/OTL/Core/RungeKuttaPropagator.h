@@ -0,0 +1,363 @@
+////////////////////////////////////////////////////////////
+//
+// OTL - Orbital Trajectory Library
+// Copyright (C) 2013-2018 Jason Bryan (Jmbryan10@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#pragma once
+#include <OTL/Core/Propagator.h>
+#include <OTL/Core/ForceModel.h>
+#include <OTL/Core/Span.h>
+#include <vector>
+
+namespace otl
+{
+
+class OTL_CORE_API RungeKuttaPropagator : public IPropagator
+{
+public:
+   ////////////////////////////////////////////////////////////
+   /// \brief Default Constructor
+   ///
+   /// Creates a propagator with no force models, so only the
+   /// point mass gravity of the central body is integrated.
+   ///
+   ////////////////////////////////////////////////////////////
+   RungeKuttaPropagator();
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Destructor
+   ////////////////////////////////////////////////////////////
+   virtual ~RungeKuttaPropagator();
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Add a perturbing force model
+   ///
+   /// The accelerations of all force models are added to the
+   /// point mass gravity of the central body.
+   ///
+   /// \param forceModel Smart pointer to the force model
+   ///
+   ////////////////////////////////////////////////////////////
+   void AddForceModel(const ForceModelPointer& forceModel);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Remove all perturbing force models
+   ////////////////////////////////////////////////////////////
+   void ClearForceModels();
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Set the epoch of the initial state vector
+   ///
+   /// Passed to every force model at the start of each
+   /// propagation, so that perturbing bodies and radiation
+   /// sources follow their ephemerides. Defaults to Epoch().
+   ///
+   /// \param epoch Epoch of the initial state vector
+   ///
+   ////////////////////////////////////////////////////////////
+   void SetEpoch(const Epoch& epoch);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the epoch of the initial state vector
+   ////////////////////////////////////////////////////////////
+   const Epoch& GetEpoch() const;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Set the integration tolerances
+   ///
+   /// Each step is accepted when the estimated local error of
+   /// every state component is within
+   /// absoluteTolerance + relativeTolerance * |component|
+   /// in the root mean square sense. Both default to 1e-12.
+   ///
+   /// \param relativeTolerance Relative error tolerance
+   /// \param absoluteTolerance Absolute error tolerance (km and km/s)
+   ///
+   ////////////////////////////////////////////////////////////
+   void SetTolerance(double relativeTolerance, double absoluteTolerance);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the number of steps taken by the last propagation
+   ///
+   /// \returns Number of accepted and rejected steps
+   ///
+   ////////////////////////////////////////////////////////////
+   int GetNumSteps() const;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Propagate the state vector in time by numerical integration
+   ///
+   /// Calculates the final state vector after propagating
+   /// forwards or backwards in time. Backwards propgation is
+   /// achieved by setting a negative timeDelta.
+   ///
+   /// \param stateVector StateVector before propagation
+   /// \param mu Gravitational parameter of the central body
+   /// \param timeDelta Propgation time (may be negative)
+   /// \returns StateVector after propagation
+   ///
+   /// \reference E. Hairer, S. Norsett, G. Wanner. Solving Ordinary Differential Equations I 2nd Edition 1993. Section II.10
+   ///
+   ////////////////////////////////////////////////////////////
+   virtual StateVector PropagateStateVector(const StateVector& stateVector, double mu, const Time& timeDelta) override;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Propagate the Orbital Elements in time by numerical integration
+   ///
+   /// The orbital elements are converted to a state vector,
+   /// propagated, and converted back.
+   ///
+   /// \param orbitalElements OrbitalElements before propagation
+   /// \param mu Gravitational parameter of the central body
+   /// \param timeDelta Propgation time (may be negative)
+   /// \return OrbitalElements after propagation
+   ///
+   ////////////////////////////////////////////////////////////
+   virtual OrbitalElements PropagateOrbitalElements(const OrbitalElements& orbitalElements, double mu, const Time& timeDelta) override;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Sample the trajectory of a state vector at many times
+   ///
+   /// Integrates once to the last time delta and evaluates each
+   /// sample from the seventh order continuous extension of the
+   /// step containing it. Three extra derivative evaluations are
+   /// made for each step that contains samples, so the cost is
+   /// nearly independent of the number of samples, and the
+   /// samples are as accurate as the step end points.
+   ///
+   /// The time deltas must be monotonically ordered in the
+   /// direction of propagation.
+   ///
+   /// \param stateVector StateVector before propagation
+   /// \param mu Gravitational parameter of the central body
+   /// \param timeDeltas Propagation times in seconds from the initial state vector
+   /// \param sampledStateVectors Output StateVectors at each time delta
+   ///
+   ////////////////////////////////////////////////////////////
+   void SampleStateVectors(const StateVector& stateVector,
+                           double mu,
+                           const Span<const double>& timeDeltas,
+                           const Span<StateVector>& sampledStateVectors);
+
+protected:
+   static const int STATE_SIZE = 6;    ///< Number of components of the integrated state
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Set the integrated state from the initial state vector
+   ///
+   /// The default integrates the position and velocity directly.
+   ///
+   /// \param stateVector StateVector before propagation
+   /// \param mu Gravitational parameter of the central body
+   /// \param [out] state Integrated state
+   ///
+   ////////////////////////////////////////////////////////////
+   virtual void InitializeState(const StateVector& stateVector, double mu, double* state);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the state vector corresponding to an integrated state
+   ///
+   /// \param seconds Time since the start of the propagation in seconds
+   /// \param mu Gravitational parameter of the central body
+   /// \param state Integrated state
+   /// \returns StateVector at the given time
+   ///
+   ////////////////////////////////////////////////////////////
+   virtual StateVector GetStateVector(double seconds, double mu, const double* state);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Evaluate the derivative of the integrated state
+   ///
+   /// The default is the point mass gravity of the central body
+   /// plus the perturbing accelerations.
+   ///
+   /// \param seconds Time since the start of the propagation in seconds
+   /// \param mu Gravitational parameter of the central body
+   /// \param state Integrated state
+   /// \param [out] derivative Derivative of the integrated state
+   ///
+   ////////////////////////////////////////////////////////////
+   virtual void EvaluateDerivative(double seconds, double mu, const double* state, double* derivative);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the magnitudes against which the relative tolerance is applied
+   ///
+   /// The default uses the larger magnitude of each component at
+   /// the start and end of the step.
+   ///
+   /// \param state Integrated state at the start of the step
+   /// \param nextState Integrated state at the end of the step
+   /// \param [out] scale Magnitude of each component
+   ///
+   ////////////////////////////////////////////////////////////
+   virtual void GetErrorScale(const double* state, const double* nextState, double* scale);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Optionally replace the integrated state after an accepted step
+   ///
+   /// Called after every accepted step. The default does nothing.
+   ///
+   /// \param seconds Time since the start of the propagation in seconds
+   /// \param mu Gravitational parameter of the central body
+   /// \param [in,out] state Integrated state
+   /// \returns True if the state was replaced and its derivative must be reevaluated
+   ///
+   ////////////////////////////////////////////////////////////
+   virtual bool Rectify(double seconds, double mu, double* state);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Prepare for the stages of a step
+   ///
+   /// Called before the stages of every step attempt, including
+   /// rejected ones, with the time of each stage. The default
+   /// does nothing.
+   ///
+   /// \param mu Gravitational parameter of the central body
+   /// \param stageTimes Times of the stages since the start of the propagation in seconds
+   ///
+   ////////////////////////////////////////////////////////////
+   virtual void PrepareStep(double mu, const Span<const double>& stageTimes);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Prepare for the extra stages of the dense output
+   ///
+   /// Called after a step is accepted and before the extra
+   /// stages of its dense output, with the time of each extra
+   /// stage. Anything prepared by PrepareStep() for the step
+   /// is still needed afterwards. The default does nothing.
+   ///
+   /// \param mu Gravitational parameter of the central body
+   /// \param stageTimes Times of the extra stages since the start of the propagation in seconds
+   ///
+   ////////////////////////////////////////////////////////////
+   virtual void PrepareDenseStages(double mu, const Span<const double>& stageTimes);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the sum of the perturbing accelerations of all force models
+   ///
+   /// \param seconds Time since the start of the propagation in seconds
+   /// \param position Cartesian position of the body (km)
+   /// \param velocity Cartesian velocity of the body (km/s)
+   /// \returns Perturbing acceleration (km/s^2)
+   ///
+   ////////////////////////////////////////////////////////////
+   Vector3d GetPerturbingAcceleration(double seconds, const Vector3d& position, const Vector3d& velocity);
+
+private:
+   ////////////////////////////////////////////////////////////
+   /// \brief Integrate the equations of motion
+   ///
+   /// \param stateVector StateVector before propagation
+   /// \param mu Gravitational parameter of the central body
+   /// \param seconds Propagation time in seconds
+   /// \param timeDeltas Optional sample times for dense output
+   /// \param sampledStateVectors Optional output StateVectors at each sample time
+   /// \returns StateVector after propagation
+   ///
+   ////////////////////////////////////////////////////////////
+   StateVector Integrate(const StateVector& stateVector,
+                         double mu,
+                         double seconds,
+                         const Span<const double>& timeDeltas,
+                         const Span<StateVector>& sampledStateVectors);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Evaluate a stage of the current step from the previous stages
+   ///
+   /// \param mu Gravitational parameter of the central body
+   /// \param stage Index of the stage
+   /// \param h Step size in seconds
+   /// \param seconds Time of the stage since the start of the propagation in seconds
+   ///
+   ////////////////////////////////////////////////////////////
+   void EvaluateStage(double mu, int stage, double h, double seconds);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Evaluate the extra stages and interpolation terms of the dense output
+   ///
+   /// \param mu Gravitational parameter of the central body
+   /// \param t Time at the start of the step in seconds
+   /// \param h Step size in seconds
+   ///
+   ////////////////////////////////////////////////////////////
+   void PrepareDenseOutput(double mu, double t, double h);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Estimate the size of the first step
+   ///
+   /// \reference E. Hairer, S. Norsett, G. Wanner. Solving Ordinary Differential Equations I 2nd Edition 1993. Section II.4, page 169
+   ///
+   ////////////////////////////////////////////////////////////
+   double EstimateInitialStep(double mu, double seconds);
+
+   static const int NUM_STAGES = 13;         ///< Number of stages of the Dormand-Prince 8(5,3) pair, including the derivative at the end of the step
+   static const int NUM_DENSE_STAGES = 16;   ///< Number of stages including the extra stages of the dense output
+   static const int NUM_DENSE_TERMS = 7;     ///< Number of interpolation terms of the dense output
+
+   std::vector<ForceModelPointer> m_forceModels;   ///< Perturbing force models
+   Epoch m_epoch;                                  ///< Epoch of the initial state vector
+   double m_relativeTolerance;                     ///< Relative error tolerance
+   double m_absoluteTolerance;                     ///< Absolute error tolerance
+   int m_numSteps;                                 ///< Number of steps taken by the last propagation
+
+   // Scratch buffers reused by every step
+   double m_state[STATE_SIZE];                     ///< State at the start of the current step
+   double m_derivative[STATE_SIZE];                ///< Derivative at the start of the current step
+   double m_nextState[STATE_SIZE];                 ///< State at the end of the current step
+   double m_stageState[STATE_SIZE];                ///< State at which the current stage is evaluated
+   double m_stages[NUM_DENSE_STAGES][STATE_SIZE];  ///< Stage derivatives of the current step
+   double m_denseTerms[NUM_DENSE_TERMS][STATE_SIZE]; ///< Interpolation terms of the dense output of the current step
+   double m_sample[STATE_SIZE];                    ///< Dense output state at the current sample
+};
+
+} // namespace otl
+
+////////////////////////////////////////////////////////////
+/// \class otl::RungeKuttaPropagator
+/// \ingroup otl
+///
+/// Propagates a state vector forward or backwards in time by
+/// numerically integrating the equations of motion with the
+/// embedded Dormand-Prince 8(5,3) pair (DOP853) and adaptive
+/// step size control. The point mass gravity of the central body
+/// is always included; further perturbations are added with
+/// AddForceModel(). Derived classes may integrate a different
+/// state, such as the deviation from a reference orbit, by
+/// overriding the protected hooks. All scratch storage is owned by the
+/// propagator, so no memory is allocated per step, but a
+/// single instance must not be used from several threads at
+/// once.
+///
+/// Usage example:
+/// \code
+/// auto propagator = otl::RungeKuttaPropagator();
+///
+/// auto gravity = std::make_shared<otl::GravityModel>();
+/// gravity->AddExternalBody(4902.8, moonPosition);  // Moon, position function of the epoch
+/// propagator.AddForceModel(gravity);
+/// propagator.SetEpoch(initialEpoch);
+///
+/// auto finalStateVector = propagator.PropagateStateVector(initialStateVector, otl::ASTRO_MU_EARTH, otl::Time::Days(1.0));
+/// \endcode
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,313 @@
+////////////////////////////////////////////////////////////
+//
+// OTL - Orbital Trajectory Library
+// Copyright (C) 2013-2018 Jason Bryan (Jmbryan10@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#pragma once
+#include <OTL/Core/Matrix.h>
+#include <OTL/Core/OrbitalElements.h>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace otl
+{
+
+template<typename T>
+class Span
+{
+public:
+   typedef T ValueType;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Default constructor
+   ///
+   /// Creates an empty span.
+   ///
+   ////////////////////////////////////////////////////////////
+   Span() :
+   m_data(nullptr),
+   m_size(0)
+   {
+   }
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Create a span from a pointer and a number of elements
+   ///
+   /// \param data Pointer to the first element
+   /// \param size Number of contiguous elements
+   ///
+   ////////////////////////////////////////////////////////////
+   Span(T* data, std::size_t size) :
+   m_data(data),
+   m_size(size)
+   {
+   }
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Create a span viewing the contents of a std::vector
+   ///
+   /// \param v Vector owning the elements
+   ///
+   ////////////////////////////////////////////////////////////
+   template<typename Allocator>
+   Span(std::vector<typename std::remove_const<T>::type, Allocator>& v) :
+   m_data(v.data()),
+   m_size(v.size())
+   {
+   }
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Create a read-only span viewing the contents of a const std::vector
+   ///
+   /// \param v Vector owning the elements
+   ///
+   ////////////////////////////////////////////////////////////
+   template<typename Allocator>
+   Span(const std::vector<typename std::remove_const<T>::type, Allocator>& v) :
+   m_data(v.data()),
+   m_size(v.size())
+   {
+   }
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Convert a mutable span into a read-only span
+   ////////////////////////////////////////////////////////////
+   template<typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+   Span(const Span<U>& other) :
+   m_data(other.Data()),
+   m_size(other.Size())
+   {
+   }
+
+   T* Data() const { return m_data; }
+   std::size_t Size() const { return m_size; }
+   bool IsEmpty() const { return m_size == 0; }
+
+   T& operator[](std::size_t index) const { return m_data[index]; }
+
+   T* begin() const { return m_data; }
+   T* end() const { return m_data + m_size; }
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Get a view of a contiguous subrange of the span
+   ///
+   /// \param offset Index of the first element of the subrange
+   /// \param count Number of elements in the subrange
+   /// \returns Span viewing elements [offset, offset + count)
+   ///
+   ////////////////////////////////////////////////////////////
+   Span SubSpan(std::size_t offset, std::size_t count) const
+   {
+      return Span(m_data + offset, count);
+   }
+
+private:
+   T* m_data;           ///< Pointer to the first element
+   std::size_t m_size;  ///< Number of elements
+};
+
+template<typename T>
+struct Vector3Span
+{
+   Span<T> x;  ///< X components
+   Span<T> y;  ///< Y components
+   Span<T> z;  ///< Z components
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Default constructor
+   ////////////////////////////////////////////////////////////
+   Vector3Span() {}
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Create from three component spans of equal size
+   ////////////////////////////////////////////////////////////
+   Vector3Span(const Span<T>& _x, const Span<T>& _y, const Span<T>& _z) :
+   x(_x), y(_y), z(_z)
+   {
+   }
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Convert a mutable Vector3Span into a read-only Vector3Span
+   ////////////////////////////////////////////////////////////
+   template<typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+   Vector3Span(const Vector3Span<U>& other) :
+   x(other.x), y(other.y), z(other.z)
+   {
+   }
+
+   std::size_t Size() const { return x.Size(); }
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Gather the i'th element into a Vector3d
+   ////////////////////////////////////////////////////////////
+   Vector3d Get(std::size_t index) const
+   {
+      return Vector3d(x[index], y[index], z[index]);
+   }
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Scatter a Vector3d into the i'th element
+   ////////////////////////////////////////////////////////////
+   void Set(std::size_t index, const Vector3d& v) const
+   {
+      x[index] = v.x();
+      y[index] = v.y();
+      z[index] = v.z();
+   }
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Get a view of a contiguous subrange of the vectors
+   ////////////////////////////////////////////////////////////
+   Vector3Span SubSpan(std::size_t offset, std::size_t count) const
+   {
+      return Vector3Span(x.SubSpan(offset, count), y.SubSpan(offset, count), z.SubSpan(offset, count));
+   }
+};
+
+template<typename T>
+struct OrbitalElementsSpan
+{
+   Span<T> semiMajorAxis;       ///< SemiMajor axes (a)
+   Span<T> eccentricity;        ///< Eccentricities (e)
+   Span<T> meanAnomaly;         ///< Mean anomalies (m)
+   Span<T> inclination;         ///< Inclinations (i)
+   Span<T> argOfPericenter;     ///< Arguments of pericenter (w)
+   Span<T> lonOfAscendingNode;  ///< Longitudes of the ascending node (l)
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Default constructor
+   ////////////////////////////////////////////////////////////
+   OrbitalElementsSpan() {}
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Create from six element spans of equal size
+   ////////////////////////////////////////////////////////////
+   OrbitalElementsSpan(const Span<T>& _semiMajorAxis, const Span<T>& _eccentricity, const Span<T>& _meanAnomaly,
+                       const Span<T>& _inclination, const Span<T>& _argOfPericenter, const Span<T>& _lonOfAscendingNode) :
+   semiMajorAxis(_semiMajorAxis), eccentricity(_eccentricity), meanAnomaly(_meanAnomaly),
+   inclination(_inclination), argOfPericenter(_argOfPericenter), lonOfAscendingNode(_lonOfAscendingNode)
+   {
+   }
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Convert a mutable OrbitalElementsSpan into a read-only OrbitalElementsSpan
+   ////////////////////////////////////////////////////////////
+   template<typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+   OrbitalElementsSpan(const OrbitalElementsSpan<U>& other) :
+   semiMajorAxis(other.semiMajorAxis), eccentricity(other.eccentricity), meanAnomaly(other.meanAnomaly),
+   inclination(other.inclination), argOfPericenter(other.argOfPericenter), lonOfAscendingNode(other.lonOfAscendingNode)
+   {
+   }
+
+   std::size_t Size() const { return semiMajorAxis.Size(); }
+
+   ////////////////////////////////////////////////////////////
+   /// \brief True if all six element spans have the same size
+   ////////////////////////////////////////////////////////////
+   bool IsConsistent() const
+   {
+      const std::size_t size = Size();
+      return (eccentricity.Size() == size && meanAnomaly.Size() == size && inclination.Size() == size &&
+              argOfPericenter.Size() == size && lonOfAscendingNode.Size() == size);
+   }
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Gather the i'th element into an OrbitalElements
+   ////////////////////////////////////////////////////////////
+   OrbitalElements Get(std::size_t index) const
+   {
+      return OrbitalElements(semiMajorAxis[index], eccentricity[index], meanAnomaly[index],
+                             inclination[index], argOfPericenter[index], lonOfAscendingNode[index]);
+   }
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Scatter an OrbitalElements into the i'th element
+   ////////////////////////////////////////////////////////////
+   void Set(std::size_t index, const OrbitalElements& orbitalElements) const
+   {
+      semiMajorAxis[index] = orbitalElements.semiMajorAxis;
+      eccentricity[index] = orbitalElements.eccentricity;
+      meanAnomaly[index] = orbitalElements.meanAnomaly;
+      inclination[index] = orbitalElements.inclination;
+      argOfPericenter[index] = orbitalElements.argOfPericenter;
+      lonOfAscendingNode[index] = orbitalElements.lonOfAscendingNode;
+   }
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Get a view of a contiguous subrange of the orbital elements
+   ////////////////////////////////////////////////////////////
+   OrbitalElementsSpan SubSpan(std::size_t offset, std::size_t count) const
+   {
+      return OrbitalElementsSpan(semiMajorAxis.SubSpan(offset, count), eccentricity.SubSpan(offset, count),
+                                 meanAnomaly.SubSpan(offset, count), inclination.SubSpan(offset, count),
+                                 argOfPericenter.SubSpan(offset, count), lonOfAscendingNode.SubSpan(offset, count));
+   }
+};
+
+} // namespace otl
+
+////////////////////////////////////////////////////////////
+/// \class otl::Span
+/// \ingroup otl
+///
+/// Non-owning view of a contiguous array of elements.
+///
+/// Span is a lightweight pointer and size pair used by the
+/// batched interfaces to accept data stored in std::vector's
+/// or raw arrays without copying. A Span<const T> may be
+/// implicitly created from a Span<T>.
+///
+/// Usage example:
+/// \code
+/// std::vector<double> timeDeltas(1000, 86400.0);
+/// otl::Span<const double> view(timeDeltas);
+/// double firstTimeDelta = view[0];
+/// \endcode
+///
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+/// \class otl::Vector3Span
+/// \ingroup otl
+///
+/// Structure-of-arrays view of a set of three-dimensional
+/// vectors.
+///
+/// The x, y and z components are stored in three separate
+/// contiguous arrays of equal size, which allows batched
+/// algorithms to process several vectors in lockstep.
+///
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+/// \class otl::OrbitalElementsSpan
+/// \ingroup otl
+///
+/// Structure-of-arrays view of a set of orbital elements.
+///
+/// Each of the six classical orbital elements is stored in
+/// its own contiguous array, which allows catalogs of orbits
+/// to be converted in lockstep by the batched conversions.
+///
+////////////////////////////////////////////////////////////
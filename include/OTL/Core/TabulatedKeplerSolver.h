@@ -0,0 +1,142 @@
+////////////////////////////////////////////////////////////
+//
+// OTL - Orbital Trajectory Library
+// Copyright (C) 2013-2018 Jason Bryan (Jmbryan10@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#pragma once
+#include <OTL/Core/Base.h>
+#include <vector>
+
+namespace otl
+{
+
+namespace keplerian
+{
+
+class OTL_CORE_API TabulatedKeplerSolver
+{
+public:
+   ////////////////////////////////////////////////////////////
+   /// \brief Default constructor
+   ///
+   /// Creates a solver for circular orbits.
+   ///
+   ////////////////////////////////////////////////////////////
+   TabulatedKeplerSolver();
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Create a solver for a fixed eccentricity
+   ///
+   /// Tabulates the eccentric anomaly and its derivative with
+   /// respect to the mean anomaly at numIntervals + 1 equally
+   /// spaced mean anomalies in [0, pi]. No table is built if the
+   /// eccentricity is greater than MAX_ECCENTRICITY, in which
+   /// case every solve falls back to SolveKeplersEquation().
+   ///
+   /// \param eccentricity The eccentricity of the orbit
+   /// \param numIntervals Number of interpolation intervals
+   ///
+   ////////////////////////////////////////////////////////////
+   explicit TabulatedKeplerSolver(double eccentricity, int numIntervals = DEFAULT_INTERVALS);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the eccentricity the table was built for
+   ////////////////////////////////////////////////////////////
+   double GetEccentricity() const;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Returns true if the table can solve for the given eccentricity
+   ///
+   /// The eccentricity must be within ECCENTRICITY_TOLERANCE of
+   /// the tabulated eccentricity.
+   ///
+   ////////////////////////////////////////////////////////////
+   bool IsValidFor(double eccentricity) const;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Solve Kepler's Equation at the tabulated eccentricity
+   ///
+   /// \param meanAnomaly The mean anomaly of the orbit
+   /// \returns The eccentric anomaly of the orbit
+   ///
+   ////////////////////////////////////////////////////////////
+   double Solve(double meanAnomaly) const;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Solve Kepler's Equation near the tabulated eccentricity
+   ///
+   /// The interpolated anomaly is refined with a single Danby
+   /// quartic correction at the given eccentricity, which
+   /// absorbs the slow drift of a body's eccentricity across a
+   /// query window. There is no iteration. Falls back to
+   /// SolveKeplersEquation() if IsValidFor() returns false.
+   ///
+   /// \param eccentricity The eccentricity of the orbit
+   /// \param meanAnomaly The mean anomaly of the orbit
+   /// \returns The eccentric anomaly of the orbit
+   ///
+   ////////////////////////////////////////////////////////////
+   double Solve(double eccentricity, double meanAnomaly) const;
+
+   static const int DEFAULT_INTERVALS = 256;          ///< Default number of interpolation intervals
+   static const double MAX_ECCENTRICITY;              ///< Largest eccentricity that is tabulated
+   static const double ECCENTRICITY_TOLERANCE;        ///< Largest eccentricity drift absorbed by the correction
+
+private:
+   double m_eccentricity;           ///< Tabulated eccentricity
+   double m_step;                   ///< Mean anomaly spacing of the table
+   double m_inverseStep;            ///< Reciprocal of the spacing
+   int m_numIntervals;              ///< Number of interpolation intervals
+   std::vector<double> m_anomalies; ///< Eccentric anomaly at each node
+   std::vector<double> m_slopes;    ///< Derivative of the eccentric anomaly times the spacing at each node
+};
+
+} // namespace keplerian
+
+} // namespace otl
+
+////////////////////////////////////////////////////////////
+/// \class otl::keplerian::TabulatedKeplerSolver
+/// \ingroup keplerian
+///
+/// Table-driven Kepler's Equation solver for one eccentricity.
+///
+/// Planets and most catalogued bodies have an eccentricity
+/// that barely changes across a query window, so the inverse
+/// of Kepler's Equation can be tabulated once and reused for
+/// every epoch. The mean anomaly is reduced to [-pi, pi), the
+/// eccentric anomaly is interpolated with a cubic Hermite
+/// polynomial and one Danby quartic correction takes it to
+/// full double precision for eccentricities up to
+/// MAX_ECCENTRICITY with the default table.
+///
+/// Usage example:
+/// \code
+/// using namespace otl::keplerian;
+/// TabulatedKeplerSolver kepler(0.0934);
+/// for (double meanAnomaly : meanAnomalies)
+/// {
+///    double eccentricAnomaly = kepler.Solve(meanAnomaly);
+/// }
+/// \endcode
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,244 @@
+////////////////////////////////////////////////////////////
+//
+// OTL - Orbital Trajectory Library
+// Copyright (C) 2013-2018 Jason Bryan (Jmbryan10@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#pragma once
+#include <OTL/Core/Base.h>
+#include <OTL/Core/ForceModel.h>
+#include <OTL/Core/Span.h>
+#include <vector>
+
+namespace otl
+{
+
+class OTL_CORE_API WisdomHolmanIntegrator
+{
+public:
+   ////////////////////////////////////////////////////////////
+   /// \brief Create an integrator for bodies orbiting a central body
+   ///
+   /// \param mu Gravitational parameter of the central body
+   ///
+   ////////////////////////////////////////////////////////////
+   explicit WisdomHolmanIntegrator(double mu = ASTRO_MU_SUN);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Set the number of worker threads for the test particles
+   ///
+   /// Also used by the tree evaluation of the interaction kicks.
+   ///
+   /// \param numThreads Number of worker threads, zero selects one per hardware core
+   ///
+   ////////////////////////////////////////////////////////////
+   void SetNumThreads(int numThreads);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Set the opening angle of the interaction kicks between massive bodies
+   ///
+   /// By default every pair of massive bodies is summed
+   /// directly, which costs O(N^2) per step. A positive opening
+   /// angle evaluates the kicks with a BarnesHutGravityModel
+   /// rebuilt from the body positions at every kick, so a full
+   /// system of many massive small bodies costs O(N log N) per
+   /// step. The tree kicks are not exactly antisymmetric, so the
+   /// momentum and energy are conserved only to the accuracy of
+   /// the tree. Test particles still sum the massive bodies
+   /// directly.
+   ///
+   /// \param openingAngle Opening angle of the BarnesHutGravityModel, zero for the direct sum
+   ///
+   ////////////////////////////////////////////////////////////
+   void SetOpeningAngle(double openingAngle);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Add a massive body
+   ///
+   /// Massive bodies attract each other and every test particle.
+   ///
+   /// \param mu Gravitational parameter of the body
+   /// \param stateVector Cartesian state vector relative to the central body
+   /// \returns Index of the body
+   ///
+   ////////////////////////////////////////////////////////////
+   std::size_t AddBody(double mu, const StateVector& stateVector);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Add massless test particles
+   ///
+   /// Test particles are attracted by the central body and the
+   /// massive bodies but not by each other.
+   ///
+   /// \param stateVectors Cartesian state vectors relative to the central body
+   ///
+   ////////////////////////////////////////////////////////////
+   void AddTestParticles(const Span<const StateVector>& stateVectors);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the number of massive bodies
+   ////////////////////////////////////////////////////////////
+   std::size_t GetNumBodies() const;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the number of test particles
+   ////////////////////////////////////////////////////////////
+   std::size_t GetNumTestParticles() const;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the time integrated since the bodies were added
+   ///
+   /// \returns Elapsed time
+   ///
+   ////////////////////////////////////////////////////////////
+   Time GetTime() const;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the state vector of a massive body
+   ///
+   /// \param index Index of the body
+   /// \returns Cartesian state vector relative to the central body
+   ///
+   ////////////////////////////////////////////////////////////
+   StateVector GetBodyStateVector(std::size_t index) const;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the state vector of a test particle
+   ///
+   /// \param index Index of the test particle
+   /// \returns Cartesian state vector relative to the central body
+   ///
+   ////////////////////////////////////////////////////////////
+   StateVector GetTestParticleStateVector(std::size_t index) const;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the total energy of the central and massive bodies
+   ///
+   /// The energy is multiplied by the gravitational constant so
+   /// that it can be expressed with gravitational parameters.
+   /// It is conserved to within a bounded oscillation by the
+   /// symplectic integration.
+   ///
+   /// \returns Total energy times the gravitational constant (km^5/s^4)
+   ///
+   ////////////////////////////////////////////////////////////
+   double GetEnergy() const;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Integrate all bodies and test particles in time
+   ///
+   /// Takes the fewest equal steps no longer than stepSize that
+   /// span the timeDelta. Each step is a second order
+   /// kick-drift-kick composition in democratic heliocentric
+   /// coordinates: a half step of the interaction kicks between
+   /// bodies, a half step of the central body momentum jump, a
+   /// Kepler drift of every body about the central body using
+   /// the Universal Variable, and the half jump and half kick
+   /// again.
+   ///
+   /// The test particles do not affect the massive bodies, so the
+   /// massive bodies are integrated first over a block of steps
+   /// while their positions and momentum are recorded. Worker
+   /// threads then integrate contiguous ranges of test particles
+   /// through the block, with the Kepler drifts of each range
+   /// solved in lockstep lanes by a single batch propagation per
+   /// step.
+   ///
+   /// \param timeDelta Integration time (may be negative)
+   /// \param stepSize Maximum step size
+   ///
+   /// \reference J. Wisdom, M. Holman. Symplectic Maps for the N-Body Problem. The Astronomical Journal 102, 1991
+   /// \reference M. Duncan, H. Levison, M. Lee. A Multiple Time Step Symplectic Algorithm for Integrating Close Encounters. The Astronomical Journal 116, 1998
+   ///
+   ////////////////////////////////////////////////////////////
+   void Integrate(const Time& timeDelta, const Time& stepSize);
+
+private:
+   ////////////////////////////////////////////////////////////
+   /// \brief Add a velocity to every massive body and test particle
+   ////////////////////////////////////////////////////////////
+   void ShiftVelocities(const Vector3d& velocity);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Get the sum of the momenta of the massive bodies divided by the central body mass
+   ////////////////////////////////////////////////////////////
+   Vector3d GetJumpVelocity() const;
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Apply the interaction kicks between massive bodies
+   ////////////////////////////////////////////////////////////
+   void KickBodies(double seconds);
+
+   ////////////////////////////////////////////////////////////
+   /// \brief Integrate the test particles in [begin, end) through the recorded block of steps
+   ///
+   /// \param timeDeltas Scratch storage of the calling worker for the drift times
+   ///
+   ////////////////////////////////////////////////////////////
+   void IntegrateTestParticles(std::size_t begin, std::size_t end, std::size_t numSteps, double seconds, std::vector<double>& timeDeltas);
+
+   double m_mu;                                    ///< Gravitational parameter of the central body
+   int m_numThreads;                               ///< Number of worker threads, zero selects one per hardware core
+   double m_time;                                  ///< Elapsed time in seconds
+   std::vector<double> m_bodyMu;                   ///< Gravitational parameters of the massive bodies
+   std::vector<StateVector> m_bodies;              ///< State vectors of the massive bodies relative to the central body
+   std::vector<StateVector> m_testParticles;       ///< State vectors of the test particles relative to the central body
+
+   // Tree evaluation of the interaction kicks
+   double m_openingAngle;                          ///< Opening angle of the tree, zero for the direct sum
+   BarnesHutGravityModel m_gravityModel;           ///< Octree of the massive bodies, rebuilt at every kick
+   std::vector<Vector3d> m_bodyPositions;          ///< Positions of the massive bodies at the kick
+   std::vector<Vector3d> m_bodyAccelerations;      ///< Tree accelerations of the massive bodies at the kick
+
+   // Massive body history recorded for one block of steps
+   std::vector<Vector3d> m_positionHistory;        ///< Positions of the massive bodies at each step boundary
+   std::vector<Vector3d> m_jumpHistory;            ///< Jump velocities before and after each drift
+   std::vector<std::vector<double>> m_workerTimeDeltas; ///< Drift times of the test particle chunk of each worker thread
+};
+
+} // namespace otl
+
+////////////////////////////////////////////////////////////
+/// \class otl::WisdomHolmanIntegrator
+/// \ingroup otl
+///
+/// Mixed variable symplectic integrator for long duration
+/// N-body integrations such as asteroids perturbed by the
+/// planets. The dominant Keplerian motion about the central
+/// body is solved exactly by the LagrangianPropagator, so the
+/// step size only needs to resolve the perturbations. The
+/// energy error remains bounded instead of growing secularly.
+/// Close encounters between bodies are not treated specially.
+///
+/// Usage example:
+/// \code
+/// otl::WisdomHolmanIntegrator integrator(otl::ASTRO_MU_SUN);
+/// integrator.AddBody(otl::ASTRO_MU_JUPITER, jupiterStateVector);
+/// integrator.AddBody(otl::ASTRO_MU_SATURN, saturnStateVector);
+/// integrator.AddTestParticles(asteroidStateVectors);
+///
+/// // Integrate for 1000 years with 10 day steps on every core
+/// integrator.Integrate(otl::Time::Days(365250.0), otl::Time::Days(10.0));
+/// auto asteroid = integrator.GetTestParticleStateVector(0);
+/// \endcode
+///
+////////////////////////////////////////////////////////////
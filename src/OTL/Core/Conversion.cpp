@@ -25,11 +25,30 @@
 #include <OTL/Core/Conversion.h>
 #include <OTL/Core/Transformation.h>
 
+#include <OTL/Core/KeplerSolver.h>
 #include <OTL/Core/KeplersEquations.h>
+#include <OTL/Core/TabulatedKeplerSolver.h>
+#include <algorithm>
 
 namespace otl
 {
 
+namespace
+{
+
+// Number of orbits converted per pass of the batched conversions. Small
+// enough for the intermediate arrays of a pass to stay in L1 cache.
+const std::size_t CONVERSION_BATCH_SIZE = 256;
+
+// True if all three component spans hold the given number of vectors
+template<typename T>
+bool HasSize(const Vector3Span<T>& vectors, std::size_t size)
+{
+   return (vectors.x.Size() == size && vectors.y.Size() == size && vectors.z.Size() == size);
+}
+
+} // namespace
+
 ////////////////////////////////////////////////////////////
 void CalculateCanonicalUnits(double radius, double mu,
                              double& DU, double& TU, double& VU)
@@ -100,7 +119,7 @@ OrbitalElements ConvertStateVector2OrbitalElements(const StateVector& stateVecto
 
    // Argument of Perigee
    double aop = 0.0;
-   if (ecc != ASTRO_ECC_CIRCULAR && incl != ASTRO_INCL_EQUATORIAL) // non-circular non-equatorial orbit
+   if (ecc != ASTRO_ECC_CIRCULAR && n > 0.0) // non-circular non-equatorial orbit
    {
       double nDotecc = N.dot(Ecc);
       aop = acos(nDotecc / n / ecc);
@@ -112,6 +131,10 @@ OrbitalElements ConvertStateVector2OrbitalElements(const StateVector& stateVecto
    else if (ecc != ASTRO_ECC_CIRCULAR) // non-circular equatorial orbit (line of nodes is undefined)
    {
       aop = acos(Ecc.x() / ecc);
+      if ((Ecc.y() < 0.0) != (H.z() < 0.0)) // retrograde orbits measure the angle clockwise
+      {
+         aop = MATH_2_PI - aop;
+      }
    }
 
    // True Anomaly
@@ -125,7 +148,7 @@ OrbitalElements ConvertStateVector2OrbitalElements(const StateVector& stateVecto
          ta = MATH_2_PI - ta;
       }
    }
-   else if (incl != ASTRO_INCL_EQUATORIAL) // circular non-equatorial orbit
+   else if (n > 0.0) // circular non-equatorial orbit
    {
       double nDotr = N.dot(R);
       double nDotv = N.dot(V);
@@ -183,6 +206,209 @@ StateVector ConvertOrbitalElements2StateVector(const OrbitalElements& orbitalEle
    return TransformPerifocal2Inertial(perifocalStateVector, incl, aop, lan);
 }
 
+////////////////////////////////////////////////////////////
+StateVector ConvertOrbitalElements2StateVector(const OrbitalElements& orbitalElements, double mu,
+                                               const keplerian::TabulatedKeplerSolver& kepler)
+{
+   double a    = orbitalElements.semiMajorAxis;
+   double ecc  = orbitalElements.eccentricity;
+   double M    = orbitalElements.meanAnomaly;
+   double incl = orbitalElements.inclination;
+   double aop  = orbitalElements.argOfPericenter;
+   double lan  = orbitalElements.lonOfAscendingNode;
+
+   if (!kepler.IsValidFor(ecc))
+   {
+      return ConvertOrbitalElements2StateVector(orbitalElements, mu);
+   }
+
+   // Compute eccentric anomaly
+   double E = kepler.Solve(ecc, M);
+
+   // Precompute common terms.
+   double cosE = cos(E);
+   double sinE = sin(E);
+   double beta = sqrt(1.0 - SQR(ecc));
+   double r = a * (1.0 - ecc * cosE);
+   double n = sqrt(mu * a) / r;
+
+   // Build the state vectors in perifical coordinates.
+   StateVector perifocalStateVector;
+   perifocalStateVector.position.x() = a * (cosE - ecc);
+   perifocalStateVector.position.y() = a * beta * sinE;
+   perifocalStateVector.position.z() = 0.0;
+   perifocalStateVector.velocity.x() = -n * sinE;
+   perifocalStateVector.velocity.y() = n * beta * cosE;
+   perifocalStateVector.velocity.z() = 0.0;
+
+   // Return the rotated state vector in inertial coordinates.
+   return TransformPerifocal2Inertial(perifocalStateVector, incl, aop, lan);
+}
+
+////////////////////////////////////////////////////////////
+void ConvertStateVector2OrbitalElementsBatch(const Vector3Span<const double>& positions,
+                                             const Vector3Span<const double>& velocities,
+                                             double mu,
+                                             const OrbitalElementsSpan<double>& orbitalElements)
+{
+   const std::size_t size = orbitalElements.Size();
+   if (!orbitalElements.IsConsistent() || !HasSize(positions, size) || !HasSize(velocities, size))
+   {
+      OTL_ERROR() << "Conversion batch spans must all be of equal size " << Bracket(size);
+      return;
+   }
+
+   bool fallback[CONVERSION_BATCH_SIZE];
+   for (std::size_t offset = 0; offset < size; offset += CONVERSION_BATCH_SIZE)
+   {
+      const std::size_t count = std::min(CONVERSION_BATCH_SIZE, size - offset);
+      const double* rx = positions.x.Data() + offset;
+      const double* ry = positions.y.Data() + offset;
+      const double* rz = positions.z.Data() + offset;
+      const double* vx = velocities.x.Data() + offset;
+      const double* vy = velocities.y.Data() + offset;
+      const double* vz = velocities.z.Data() + offset;
+      double* a = orbitalElements.semiMajorAxis.Data() + offset;
+      double* ecc = orbitalElements.eccentricity.Data() + offset;
+      double* M = orbitalElements.meanAnomaly.Data() + offset;
+      double* incl = orbitalElements.inclination.Data() + offset;
+      double* aop = orbitalElements.argOfPericenter.Data() + offset;
+      double* lan = orbitalElements.lonOfAscendingNode.Data() + offset;
+
+      bool anyFallback = false;
+      for (std::size_t i = 0; i < count; ++i)
+      {
+         const double r = sqrt(SQR(rx[i]) + SQR(ry[i]) + SQR(rz[i]));
+         const double vSquared = SQR(vx[i]) + SQR(vy[i]) + SQR(vz[i]);
+         const double rDotv = rx[i] * vx[i] + ry[i] * vy[i] + rz[i] * vz[i];
+
+         // Specific angular momentum H, the node vector is K x H = (-Hy, Hx, 0)
+         const double hx = ry[i] * vz[i] - rz[i] * vy[i];
+         const double hy = rz[i] * vx[i] - rx[i] * vz[i];
+         const double hz = rx[i] * vy[i] - ry[i] * vx[i];
+         const double n = sqrt(SQR(hx) + SQR(hy));
+         const double h = sqrt(SQR(n) + SQR(hz));
+
+         // Eccentricity vector
+         const double cr = vSquared / mu - 1.0 / r;
+         const double cv = rDotv / mu;
+         const double ex = cr * rx[i] - cv * vx[i];
+         const double ey = cr * ry[i] - cv * vy[i];
+         const double ez = cr * rz[i] - cv * vz[i];
+         ecc[i] = sqrt(SQR(ex) + SQR(ey) + SQR(ez));
+         a[i] = 1.0 / (2.0 / r - vSquared / mu);
+
+         // Eccentric anomaly from e * cos(E) = 1 - r / a and e * sin(E) = r.v / sqrt(mu * a)
+         const double eSinE = rDotv / sqrt(mu * a[i]);
+         M[i] = atan2(eSinE, 1.0 - r / a[i]) - eSinE;
+
+         // The sine terms of the angles are scaled by the same positive factor as the cosine terms
+         incl[i] = atan2(n, hz);
+         lan[i] = atan2(hx, -hy);
+         lan[i] += (lan[i] < 0.0 ? MATH_2_PI : 0.0);
+         aop[i] = atan2(ez * h, hx * ey - hy * ex);
+         aop[i] += (aop[i] < 0.0 ? MATH_2_PI : 0.0);
+
+         fallback[i] = !(IsElliptical(ecc[i]) && n > 0.0);
+         anyFallback |= fallback[i];
+      }
+
+      // Circular, equatorial and open orbits need the special cases of the scalar conversion
+      for (std::size_t i = 0; anyFallback && i < count; ++i)
+      {
+         if (fallback[i])
+         {
+            orbitalElements.Set(offset + i, ConvertStateVector2OrbitalElements(
+               StateVector(positions.Get(offset + i), velocities.Get(offset + i)), mu));
+         }
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////
+void ConvertOrbitalElements2StateVectorBatch(const OrbitalElementsSpan<const double>& orbitalElements,
+                                             double mu,
+                                             const Vector3Span<double>& positions,
+                                             const Vector3Span<double>& velocities)
+{
+   const std::size_t size = orbitalElements.Size();
+   if (!orbitalElements.IsConsistent() || !HasSize(positions, size) || !HasSize(velocities, size))
+   {
+      OTL_ERROR() << "Conversion batch spans must all be of equal size " << Bracket(size);
+      return;
+   }
+
+   double E[CONVERSION_BATCH_SIZE];
+   bool fallback[CONVERSION_BATCH_SIZE];
+   for (std::size_t offset = 0; offset < size; offset += CONVERSION_BATCH_SIZE)
+   {
+      const std::size_t count = std::min(CONVERSION_BATCH_SIZE, size - offset);
+      const OrbitalElementsSpan<const double> batch = orbitalElements.SubSpan(offset, count);
+      keplerian::SolveKeplersEquationBatch(batch.eccentricity, batch.meanAnomaly, Span<double>(E, count));
+
+      const double* a = batch.semiMajorAxis.Data();
+      const double* ecc = batch.eccentricity.Data();
+      const double* incl = batch.inclination.Data();
+      const double* aop = batch.argOfPericenter.Data();
+      const double* lan = batch.lonOfAscendingNode.Data();
+      double* rx = positions.x.Data() + offset;
+      double* ry = positions.y.Data() + offset;
+      double* rz = positions.z.Data() + offset;
+      double* vx = velocities.x.Data() + offset;
+      double* vy = velocities.y.Data() + offset;
+      double* vz = velocities.z.Data() + offset;
+
+      bool anyFallback = false;
+      for (std::size_t i = 0; i < count; ++i)
+      {
+         // Perifocal state vectors from the eccentric anomaly
+         const double cosE = cos(E[i]);
+         const double sinE = sin(E[i]);
+         const double beta = sqrt(1.0 - SQR(ecc[i]));
+         const double xp = a[i] * (cosE - ecc[i]);
+         const double yp = a[i] * beta * sinE;
+         const double vScale = sqrt(mu * a[i]) / (a[i] * (1.0 - ecc[i] * cosE));
+         const double vxp = -vScale * sinE;
+         const double vyp = vScale * beta * cosE;
+
+         // First two columns (P and Q) of the perifocal to inertial matrix
+         const double cosIncl = cos(incl[i]);
+         const double sinIncl = sin(incl[i]);
+         const double cosAop = cos(aop[i]);
+         const double sinAop = sin(aop[i]);
+         const double cosLan = cos(lan[i]);
+         const double sinLan = sin(lan[i]);
+         const double px = (cosLan * cosAop) - (sinLan * sinAop * cosIncl);
+         const double py = (sinLan * cosAop) + (cosLan * cosIncl * sinAop);
+         const double pz = (sinIncl * sinAop);
+         const double qx = -(cosLan * sinAop) - (sinLan * cosIncl * cosAop);
+         const double qy = -(sinLan * sinAop) + (cosLan * cosIncl * cosAop);
+         const double qz = (sinIncl * cosAop);
+
+         rx[i] = xp * px + yp * qx;
+         ry[i] = xp * py + yp * qy;
+         rz[i] = xp * pz + yp * qz;
+         vx[i] = vxp * px + vyp * qx;
+         vy[i] = vxp * py + vyp * qy;
+         vz[i] = vxp * pz + vyp * qz;
+
+         fallback[i] = !IsCircularOrElliptical(ecc[i]);
+         anyFallback |= fallback[i];
+      }
+
+      // Parabolic and hyperbolic orbits are not described by an eccentric anomaly
+      for (std::size_t i = 0; anyFallback && i < count; ++i)
+      {
+         if (fallback[i])
+         {
+            const StateVector stateVector = ConvertOrbitalElements2StateVector(batch.Get(i), mu);
+            positions.Set(offset + i, stateVector.position);
+            velocities.Set(offset + i, stateVector.velocity);
+         }
+      }
+   }
+}
+
 ////////////////////////////////////////////////////////////
 Vector3d ConvertNormalizedSpherical2Cartesian(double magnitude, double normTheta, double normPhi)
 {
@@ -358,14 +584,16 @@ double ConvertMeanAnomaly2TrueAnomaly(double eccentricity, double meanAnomaly)
 {
    if (IsCircularOrElliptical(eccentricity))
    {
-      keplerian::KeplersEquationElliptical kepler;
-      double eccentricAnomaly = kepler.Evaluate(eccentricity, meanAnomaly);
+      const keplerian::KeplerSolution solution = keplerian::KeplerSolverElliptical::Solve(eccentricity, meanAnomaly);
+      OTL_WARN_IF(!solution.IsConverged(), "Kepler's Equation did not converge for eccentricity " << Bracket(eccentricity));
+      double eccentricAnomaly = solution.anomaly;
       return ConvertEccentricAnomaly2TrueAnomaly(eccentricity, eccentricAnomaly);
    }
    else if (IsHyperbolic(eccentricity))
    {
-      keplerian::KeplersEquationHyperbolic kepler;
-      double hyperbolicAnomaly = kepler.Evaluate(eccentricity, meanAnomaly);
+      const keplerian::KeplerSolution solution = keplerian::KeplerSolverHyperbolic::Solve(eccentricity, meanAnomaly);
+      OTL_WARN_IF(!solution.IsConverged(), "Kepler's Equation did not converge for eccentricity " << Bracket(eccentricity));
+      double hyperbolicAnomaly = solution.anomaly;
       return ConvertHyperbolicAnomaly2TrueAnomaly(eccentricity, hyperbolicAnomaly);
    }
    else if (IsParabolic(eccentricity))
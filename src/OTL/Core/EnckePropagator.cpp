@@ -0,0 +1,207 @@
+////////////////////////////////////////////////////////////
+//
+// OTL - Orbital Trajectory Library
+// Copyright (C) 2013-2018 Jason Bryan (Jmbryan10@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#include <OTL/Core/EnckePropagator.h>
+#include <algorithm>
+
+namespace otl
+{
+
+////////////////////////////////////////////////////////////
+EnckePropagator::EnckePropagator() :
+m_referenceTime(0.0),
+m_referenceRadius(0.0),
+m_referenceSpeed(0.0),
+m_rectificationThreshold(0.01),
+m_numRectifications(0)
+{
+
+}
+
+////////////////////////////////////////////////////////////
+EnckePropagator::~EnckePropagator()
+{
+
+}
+
+////////////////////////////////////////////////////////////
+void EnckePropagator::SetRectificationThreshold(double threshold)
+{
+   m_rectificationThreshold = threshold;
+}
+
+////////////////////////////////////////////////////////////
+int EnckePropagator::GetNumRectifications() const
+{
+   return m_numRectifications;
+}
+
+////////////////////////////////////////////////////////////
+void EnckePropagator::InitializeState(const StateVector& stateVector, double mu, double* state)
+{
+   m_referenceStateVector = stateVector;
+   m_referenceTime = 0.0;
+   m_referenceRadius = stateVector.position.norm();
+   m_referenceSpeed = stateVector.velocity.norm();
+   m_numRectifications = 0;
+   ClearReferenceCache();
+   std::fill(state, state + STATE_SIZE, 0.0);
+}
+
+////////////////////////////////////////////////////////////
+StateVector EnckePropagator::GetStateVector(double seconds, double mu, const double* state)
+{
+   StateVector stateVector = GetReferenceStateVector(seconds, mu);
+   for (int i = 0; i < 3; ++i)
+   {
+      stateVector.position[i] += state[i];
+      stateVector.velocity[i] += state[i + 3];
+   }
+   return stateVector;
+}
+
+////////////////////////////////////////////////////////////
+void EnckePropagator::EvaluateDerivative(double seconds, double mu, const double* state, double* derivative)
+{
+   const StateVector reference = GetReferenceStateVector(seconds, mu);
+   const Vector3d deviation(state[0], state[1], state[2]);
+   const Vector3d position = reference.position + deviation;
+
+   // 1 - (rho / r)^3 = f(q) with r^2 = rho^2 * (1 + q)
+   const double rhoSquared = reference.position.squaredNorm();
+   const double q = deviation.dot(deviation + 2.0 * reference.position) / rhoSquared;
+   const double onePlusQ = 1.0 + q;
+   const double onePlusQ15 = onePlusQ * sqrt(onePlusQ);
+   const double fq = q * (3.0 + 3.0 * q + q * q) / ((1.0 + onePlusQ15) * onePlusQ15);
+
+   const Vector3d velocity = reference.velocity + Vector3d(state[3], state[4], state[5]);
+   const Vector3d acceleration = mu / (rhoSquared * sqrt(rhoSquared)) * (fq * position - deviation) +
+      GetPerturbingAcceleration(seconds, position, velocity);
+
+   for (int i = 0; i < 3; ++i)
+   {
+      derivative[i] = state[i + 3];
+      derivative[i + 3] = acceleration[i];
+   }
+}
+
+////////////////////////////////////////////////////////////
+void EnckePropagator::GetErrorScale(const double* state, const double* nextState, double* scale)
+{
+   for (int i = 0; i < 3; ++i)
+   {
+      scale[i] = m_referenceRadius;
+      scale[i + 3] = m_referenceSpeed;
+   }
+}
+
+////////////////////////////////////////////////////////////
+bool EnckePropagator::Rectify(double seconds, double mu, double* state)
+{
+   const double deviationSquared = SQR(state[0]) + SQR(state[1]) + SQR(state[2]);
+   if (deviationSquared <= SQR(m_rectificationThreshold * m_referenceRadius))
+   {
+      return false;
+   }
+
+   // Restart the reference conic from the osculating orbit
+   m_referenceStateVector = GetStateVector(seconds, mu, state);
+   m_referenceTime = seconds;
+   m_referenceRadius = m_referenceStateVector.position.norm();
+   m_referenceSpeed = m_referenceStateVector.velocity.norm();
+   ClearReferenceCache();
+   std::fill(state, state + STATE_SIZE, 0.0);
+   ++m_numRectifications;
+   return true;
+}
+
+////////////////////////////////////////////////////////////
+void EnckePropagator::PrepareStep(double mu, const Span<const double>& stageTimes)
+{
+   ClearReferenceCache();
+   SampleReferenceStates(mu, stageTimes);
+}
+
+////////////////////////////////////////////////////////////
+void EnckePropagator::PrepareDenseStages(double mu, const Span<const double>& stageTimes)
+{
+   SampleReferenceStates(mu, stageTimes);
+}
+
+////////////////////////////////////////////////////////////
+StateVector EnckePropagator::GetReferenceStateVector(double seconds, double mu)
+{
+   const double timeDelta = seconds - m_referenceTime;
+   if (timeDelta == 0.0)
+   {
+      return m_referenceStateVector;
+   }
+
+   for (std::size_t i = 0; i < m_stageTimes.size(); ++i)
+   {
+      if (m_stageTimes[i] == seconds)
+      {
+         return m_stageStateVectors[i];
+      }
+   }
+
+   return m_lagrangian.PropagateStateVector(m_referenceStateVector, mu, Time::Seconds(timeDelta));
+}
+
+////////////////////////////////////////////////////////////
+void EnckePropagator::SampleReferenceStates(double mu, const Span<const double>& stageTimes)
+{
+   // Several stages share the same time, and the reference time itself needs no propagation
+   m_sampleTimes.clear();
+   for (std::size_t i = 0; i < stageTimes.Size(); ++i)
+   {
+      if (stageTimes[i] != m_referenceTime &&
+          std::find(m_stageTimes.begin(), m_stageTimes.end(), stageTimes[i]) == m_stageTimes.end())
+      {
+         m_sampleTimes.push_back(stageTimes[i]);
+      }
+   }
+   std::sort(m_sampleTimes.begin(), m_sampleTimes.end());
+   m_sampleTimes.erase(std::unique(m_sampleTimes.begin(), m_sampleTimes.end()), m_sampleTimes.end());
+
+   const std::size_t numCached = m_stageTimes.size();
+   m_stageTimeDeltas.resize(m_sampleTimes.size());
+   m_stageStateVectors.resize(numCached + m_sampleTimes.size());
+   for (std::size_t i = 0; i < m_sampleTimes.size(); ++i)
+   {
+      m_stageTimeDeltas[i] = m_sampleTimes[i] - m_referenceTime;
+   }
+   m_stageTimes.insert(m_stageTimes.end(), m_sampleTimes.begin(), m_sampleTimes.end());
+   m_lagrangian.SampleStateVectors(m_referenceStateVector, mu, m_stageTimeDeltas,
+                                   Span<StateVector>(m_stageStateVectors.data() + numCached, m_sampleTimes.size()));
+}
+
+////////////////////////////////////////////////////////////
+void EnckePropagator::ClearReferenceCache()
+{
+   m_stageTimes.clear();
+}
+
+} // namespace otl
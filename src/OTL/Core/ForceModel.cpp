@@ -1,73 +1,757 @@
+////////////////////////////////////////////////////////////
+//
+// OTL - Orbital Trajectory Library
+// Copyright (C) 2013-2018 Jason Bryan (Jmbryan10@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
 #include <OTL/Core/ForceModel.h>
+#include <OTL/Core/Logger.h>
 #include <OTL/Core/OrbitalBody.h>
+#include <OTL/Core/Threading/WorkerPool.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <thread>
 
 namespace otl
 {
 
-IForceModel::IForceModel()
+namespace
+{
+
+// Bits of each coordinate in a Morton key
+const int MORTON_BITS = 21;
+
+// Maximum number of bodies summed directly in a leaf cell
+const std::size_t LEAF_SIZE = 8;
+
+// Number of positions evaluated together by one thread
+const std::size_t ACCELERATION_CHUNK = 256;
+
+// Spread the lower 21 bits so that there are two zero bits between each
+std::uint64_t SpreadBits(std::uint64_t x)
+{
+   x &= 0x1fffff;
+   x = (x | x << 32) & 0x1f00000000ffff;
+   x = (x | x << 16) & 0x1f0000ff0000ff;
+   x = (x | x << 8) & 0x100f00f00f00f00f;
+   x = (x | x << 4) & 0x10c30c30c30c30c3;
+   x = (x | x << 2) & 0x1249249249249249;
+   return x;
+}
+
+// Index of degree n and order m in triangular storage
+std::size_t TriangularIndex(int n, int m)
+{
+   return static_cast<std::size_t>(n) * (n + 1) / 2 + m;
+}
+
+// Add the quadrupole moment of a point mass offset from the center of mass
+void AddQuadrupole(double mu, const Vector3d& offset, Matrix3d& quadrupole)
 {
+   quadrupole += mu * (3.0 * offset * offset.transpose() - offset.squaredNorm() * Matrix3d::Identity());
+}
 
+} // namespace
+
+////////////////////////////////////////////////////////////
+void IForceModel::SetEpoch(const Epoch& epoch)
+{
+   m_epoch = epoch;
 }
 
-Vector3d IForceModel::GetForces() const
+////////////////////////////////////////////////////////////
+const Epoch& IForceModel::GetEpoch() const
 {
-   return m_Forces;
+   return m_epoch;
 }
 
-GravityModel::GravityModel(const OrbitalBodyPointer& orbitalBody)
+////////////////////////////////////////////////////////////
+Epoch IForceModel::GetEpochAt(double seconds) const
 {
-   m_OrbitalBody = orbitalBody;
+   return m_epoch + Time::Seconds(seconds);
 }
 
+////////////////////////////////////////////////////////////
+GravityModel::GravityModel()
+{
+
+}
+
+////////////////////////////////////////////////////////////
 void GravityModel::AddExternalBody(const OrbitalBodyPointer& orbitalBody)
 {
-   m_ExternalBodies.push_back(orbitalBody);
+   if (!orbitalBody)
+   {
+      OTL_ERROR() << "Invalid external body";
+      return;
+   }
+   AddExternalBody(orbitalBody->GetPhysicalProperties().GetGravitationalParameter(),
+                   [orbitalBody](const Epoch& epoch) { return orbitalBody->GetStateVectorAt(epoch).position; });
+}
+
+////////////////////////////////////////////////////////////
+void GravityModel::AddExternalBody(double mu, const PositionFunction& position)
+{
+   ExternalBody externalBody;
+   externalBody.mu = mu;
+   externalBody.position = position;
+   m_externalBodies.push_back(externalBody);
+}
+
+////////////////////////////////////////////////////////////
+Vector3d GravityModel::GetAcceleration(double seconds, const Vector3d& position, const Vector3d& velocity)
+{
+   Vector3d acceleration = Vector3d::Zero();
+   if (m_externalBodies.empty())
+   {
+      return acceleration;
+   }
+
+   const Epoch epoch = GetEpochAt(seconds);
+   for (const auto& externalBody : m_externalBodies)
+   {
+      // Direct attraction of the body less the acceleration of the central body towards it
+      const Vector3d bodyPosition = externalBody.position(epoch);
+      const Vector3d relativePosition = bodyPosition - position;
+      const double distance = relativePosition.norm();
+      const double bodyDistance = bodyPosition.norm();
+      acceleration += externalBody.mu * (relativePosition / (distance * distance * distance) -
+                                         bodyPosition / (bodyDistance * bodyDistance * bodyDistance));
+   }
+   return acceleration;
+}
+
+////////////////////////////////////////////////////////////
+BarnesHutGravityModel::BarnesHutGravityModel(double openingAngle) :
+m_openingAngle(openingAngle),
+m_numThreads(0),
+m_indirect(Vector3d::Zero()),
+m_workers(new WorkerPool())
+{
+
+}
+
+////////////////////////////////////////////////////////////
+BarnesHutGravityModel::BarnesHutGravityModel(const BarnesHutGravityModel& other) :
+m_openingAngle(other.m_openingAngle),
+m_numThreads(other.m_numThreads),
+m_indirect(other.m_indirect),
+m_keys(other.m_keys),
+m_mu(other.m_mu),
+m_positions(other.m_positions),
+m_cells(other.m_cells),
+m_workers(new WorkerPool())
+{
+
+}
+
+////////////////////////////////////////////////////////////
+BarnesHutGravityModel& BarnesHutGravityModel::operator=(const BarnesHutGravityModel& other)
+{
+   m_openingAngle = other.m_openingAngle;
+   m_numThreads = other.m_numThreads;
+   m_indirect = other.m_indirect;
+   m_keys = other.m_keys;
+   m_mu = other.m_mu;
+   m_positions = other.m_positions;
+   m_cells = other.m_cells;
+   return *this;
+}
+
+////////////////////////////////////////////////////////////
+BarnesHutGravityModel::~BarnesHutGravityModel()
+{
+
 }
 
-void GravityModel::Update(const Time& deltaTime)
+////////////////////////////////////////////////////////////
+void BarnesHutGravityModel::SetOpeningAngle(double openingAngle)
 {
-   m_Forces.Zero();
+   m_openingAngle = openingAngle;
+}
 
-   double myMass = m_OrbitalBody->GetPhysicalProperties().GetMass();
-   const auto& myPosition = m_OrbitalBody->GetCartesianStateVector().position;
+////////////////////////////////////////////////////////////
+void BarnesHutGravityModel::SetNumThreads(int numThreads)
+{
+   m_numThreads = numThreads;
+}
+
+////////////////////////////////////////////////////////////
+void BarnesHutGravityModel::SetBodies(const Span<const double>& mu, const Span<const Vector3d>& positions)
+{
+   m_cells.clear();
+   m_indirect = Vector3d::Zero();
+   if (mu.Size() != positions.Size())
+   {
+      OTL_ERROR() << "Body size mismatch: " << Bracket(mu.Size()) << " gravitational parameters and "
+                  << Bracket(positions.Size()) << " positions";
+      return;
+   }
 
-   for (const auto& externalBody : m_ExternalBodies)
+   // Massless bodies have no effect
+   m_keys.clear();
+   Vector3d lower = Vector3d::Constant(std::numeric_limits<double>::infinity());
+   Vector3d upper = -lower;
+   for (std::size_t i = 0; i < mu.Size(); ++i)
+   {
+      if (mu[i] != 0.0)
+      {
+         m_keys.push_back(std::make_pair(0, i));
+         lower = lower.cwiseMin(positions[i]);
+         upper = upper.cwiseMax(positions[i]);
+         m_indirect += mu[i] / (positions[i].squaredNorm() * positions[i].norm()) * positions[i];
+      }
+   }
+   const std::size_t size = m_keys.size();
+   if (size == 0)
    {
-      double otherMass = externalBody->GetPhysicalProperties().GetMass();
-      const auto& otherPosition = externalBody->GetCartesianStateVector().position;
+      return;
+   }
 
-      Vector3d distanceVector = (otherPosition - myPosition);
-      double distanceSquared = distanceVector.squaredNorm();
-      distanceVector.normalize();
+   // Sort the bodies along a Morton curve through the bounding cube
+   const double halfSize = 0.5 * (upper - lower).maxCoeff() * (1.0 + 1.0e-12) + 1.0e-12;
+   const Vector3d center = 0.5 * (lower + upper);
+   const Vector3d origin = center - Vector3d::Constant(halfSize);
+   const double scale = static_cast<double>(1 << MORTON_BITS) / (2.0 * halfSize);
+   for (auto& key : m_keys)
+   {
+      const Vector3d cell = (positions[key.second] - origin) * scale;
+      for (int k = 0; k < 3; ++k)
+      {
+         const std::uint64_t coordinate = std::min<std::uint64_t>(static_cast<std::uint64_t>(cell[k]), (1 << MORTON_BITS) - 1);
+         key.first |= SpreadBits(coordinate) << k;
+      }
+   }
+   std::sort(m_keys.begin(), m_keys.end());
 
-      m_Forces += otherMass / distanceSquared * distanceVector;
+   m_mu.resize(size);
+   m_positions.resize(size);
+   for (std::size_t i = 0; i < size; ++i)
+   {
+      m_mu[i] = mu[m_keys[i].second];
+      m_positions[i] = positions[m_keys[i].second];
    }
 
-   m_Forces *= m_GravitationalParameter * myMass;
+   BuildCell(0, size, 0, center, halfSize);
 }
 
-SolarPressureModel::SolarPressureModel(const RadiationSourcePointer& radiationSource, const SpacecraftPointer& spacecraft)
+////////////////////////////////////////////////////////////
+Vector3d BarnesHutGravityModel::GetAcceleration(double seconds, const Vector3d& position, const Vector3d& velocity)
 {
-    m_RadiationSource = radiationSource;
-	m_Spacecraft = spacecraft;
+   return Traverse(position) - m_indirect;
 }
 
-void SolarPressureModel::Update(const Time& deltaTime)
+////////////////////////////////////////////////////////////
+void BarnesHutGravityModel::GetAccelerations(const Span<const Vector3d>& positions, const Span<Vector3d>& accelerations)
 {
-   const auto& sourcePosition = m_RadiationSource->GetCartesianStateVector().position;
-    const auto& radiationPressure = m_RadiationSource->GetRadiationPressure();
+   const std::size_t size = positions.Size();
+   if (accelerations.Size() != size)
+   {
+      OTL_ERROR() << "Batch size mismatch: " << Bracket(size) << " positions and "
+                  << Bracket(accelerations.Size()) << " accelerations";
+      return;
+   }
+
+   const std::size_t numChunks = (size + ACCELERATION_CHUNK - 1) / ACCELERATION_CHUNK;
+   std::atomic<std::size_t> nextChunk(0);
+   auto worker = [&]()
+   {
+      for (std::size_t c = nextChunk++; c < numChunks; c = nextChunk++)
+      {
+         const std::size_t end = std::min(size, (c + 1) * ACCELERATION_CHUNK);
+         for (std::size_t i = c * ACCELERATION_CHUNK; i < end; ++i)
+         {
+            accelerations[i] = Traverse(positions[i]) - m_indirect;
+         }
+      }
+   };
 
-    const auto& myPosition = m_Spacecraft->GetPosition();
-    const auto& radiationPressureArea = m_Spacecraft->GetRadiationPressureArea();
-    const auto& radiationPressureCoefficient = m_Spacecraft->GetRadiationPressureCoefficient();
+   std::size_t numThreads = (m_numThreads > 0 ? m_numThreads : std::thread::hardware_concurrency());
+   numThreads = std::max<std::size_t>(1, std::min(numThreads, numChunks));
 
-    Vector3d incidentVector = sourcePosition - myPosition;
-    incidentVector.normalize();
+   // The calling thread works alongside the pooled threads
+   m_workers->Run(numThreads, worker);
+}
+
+////////////////////////////////////////////////////////////
+const Vector3d& BarnesHutGravityModel::GetIndirectAcceleration() const
+{
+   return m_indirect;
+}
+
+////////////////////////////////////////////////////////////
+void BarnesHutGravityModel::BuildCell(std::size_t begin, std::size_t end, int level, const Vector3d& center, double halfSize)
+{
+   const std::size_t index = m_cells.size();
+   m_cells.push_back(Cell());
+   Cell cell;
+   cell.center = center;
+   cell.halfSize = halfSize;
+   cell.begin = begin;
+   cell.end = end;
+   cell.leaf = (end - begin <= LEAF_SIZE || level == MORTON_BITS);
+   cell.mu = 0.0;
+   cell.centerOfMass = Vector3d::Zero();
+   cell.quadrupole = Matrix3d::Zero();
+
+   if (cell.leaf)
+   {
+      for (std::size_t i = begin; i < end; ++i)
+      {
+         cell.mu += m_mu[i];
+         cell.centerOfMass += m_mu[i] * m_positions[i];
+      }
+      cell.centerOfMass /= cell.mu;
+      for (std::size_t i = begin; i < end; ++i)
+      {
+         AddQuadrupole(m_mu[i], m_positions[i] - cell.centerOfMass, cell.quadrupole);
+      }
+   }
+   else
+   {
+      // Bodies are in Morton order, so each octant is a contiguous range
+      const int shift = 3 * (MORTON_BITS - 1 - level);
+      std::size_t children[8];
+      int numChildren = 0;
+      for (std::size_t first = begin; first < end; )
+      {
+         const std::uint64_t octant = (m_keys[first].first >> shift) & 7;
+         std::size_t last = first + 1;
+         while (last < end && ((m_keys[last].first >> shift) & 7) == octant)
+         {
+            ++last;
+         }
+
+         const double childHalfSize = 0.5 * halfSize;
+         const Vector3d childCenter(center.x() + ((octant & 1) ? childHalfSize : -childHalfSize),
+                                    center.y() + ((octant & 2) ? childHalfSize : -childHalfSize),
+                                    center.z() + ((octant & 4) ? childHalfSize : -childHalfSize));
+         children[numChildren++] = m_cells.size();
+         BuildCell(first, last, level + 1, childCenter, childHalfSize);
+         first = last;
+      }
+
+      // Combine the moments of the children about the new center of mass
+      for (int c = 0; c < numChildren; ++c)
+      {
+         const Cell& child = m_cells[children[c]];
+         cell.mu += child.mu;
+         cell.centerOfMass += child.mu * child.centerOfMass;
+      }
+      cell.centerOfMass /= cell.mu;
+      for (int c = 0; c < numChildren; ++c)
+      {
+         const Cell& child = m_cells[children[c]];
+         cell.quadrupole += child.quadrupole;
+         AddQuadrupole(child.mu, child.centerOfMass - cell.centerOfMass, cell.quadrupole);
+      }
+   }
+
+   cell.centerOffset = (cell.centerOfMass - cell.center).norm();
+   cell.next = m_cells.size();
+   m_cells[index] = cell;
+}
+
+////////////////////////////////////////////////////////////
+Vector3d BarnesHutGravityModel::Traverse(const Vector3d& position) const
+{
+   const double inverseOpeningAngle = 1.0 / m_openingAngle;
+   Vector3d acceleration = Vector3d::Zero();
+   std::size_t index = 0;
+   while (index < m_cells.size())
+   {
+      const Cell& cell = m_cells[index];
+      if (cell.leaf)
+      {
+         for (std::size_t i = cell.begin; i < cell.end; ++i)
+         {
+            const Vector3d separation = m_positions[i] - position;
+            const double distanceSquared = separation.squaredNorm();
+            if (distanceSquared > 0.0)
+            {
+               acceleration += m_mu[i] / (distanceSquared * std::sqrt(distanceSquared)) * separation;
+            }
+         }
+         index = cell.next;
+         continue;
+      }
+
+      // The opening distance grows with the offset of the center of mass so that lopsided cells are not accepted too close.
+      // Cells containing the position are always opened.
+      const Vector3d offset = position - cell.centerOfMass;
+      const double distanceSquared = offset.squaredNorm();
+      const double openingDistance = 2.0 * cell.halfSize * inverseOpeningAngle + cell.centerOffset;
+      const bool inside = ((position - cell.center).cwiseAbs().maxCoeff() <= cell.halfSize);
+      if (!inside && distanceSquared > openingDistance * openingDistance)
+      {
+         const double inverseDistanceSquared = 1.0 / distanceSquared;
+         const double inverseDistance = std::sqrt(inverseDistanceSquared);
+         const double inverseDistance3 = inverseDistance * inverseDistanceSquared;
+         const double inverseDistance5 = inverseDistance3 * inverseDistanceSquared;
+         const Vector3d quadrupoleOffset = cell.quadrupole * offset;
+         acceleration += (-cell.mu * inverseDistance3 - 2.5 * offset.dot(quadrupoleOffset) * inverseDistance5 * inverseDistanceSquared) * offset
+                       + inverseDistance5 * quadrupoleOffset;
+         index = cell.next;
+      }
+      else
+      {
+         index = index + 1;
+      }
+   }
+   return acceleration;
+}
 
-    m_Forces = radiationPressure *
-               radiationPressureCoefficient *
-               radiationPressureArea *
-               incidentVector;
+////////////////////////////////////////////////////////////
+SphericalHarmonicGravityModel::SphericalHarmonicGravityModel(double mu, double referenceRadius) :
+m_mu(mu),
+m_referenceRadius(referenceRadius),
+m_maxDegree(-1),
+m_degree(-1),
+m_requestedDegree(-1),
+m_rotationRate(0.0),
+m_rotationAngle(0.0)
+{
+   SetMaxDegree(0);
+}
+
+////////////////////////////////////////////////////////////
+void SphericalHarmonicGravityModel::LoadDataFile(const std::string& dataFilename)
+{
+   std::ifstream ifs(dataFilename);
+   if (!ifs)
+   {
+      OTL_FATAL() << "Failed to open gravity field data file " << Bracket(dataFilename);
+      return;
+   }
+
+   struct Coefficient
+   {
+      int n, m;
+      double c, s;
+   };
+   std::vector<Coefficient> coefficients;
+   int maxDegree = 0;
+   bool normalized = true;
+   double mu = m_mu;
+   double referenceRadius = m_referenceRadius;
+
+   std::string line;
+   while (std::getline(ifs, line))
+   {
+      // ICGEM files use the D exponent in some older fields
+      std::replace(line.begin(), line.end(), 'D', 'E');
+      std::istringstream iss(line);
+      std::string key;
+      iss >> key;
+
+      double value;
+      std::string norm;
+      if (key == "norm" && iss >> norm)
+      {
+         if (norm != "fully_normalized" && norm != "unnormalized")
+         {
+            OTL_ERROR() << "Unsupported normalization " << Bracket(norm) << " in gravity field data file " << Bracket(dataFilename);
+            return;
+         }
+         normalized = (norm == "fully_normalized");
+      }
+      else if (key == "earth_gravity_constant" && iss >> value)
+      {
+         mu = value * 1.0e-9;     // [m^3/s^2] to [km^3/s^2]
+      }
+      else if (key == "radius" && iss >> value)
+      {
+         referenceRadius = value * 1.0e-3; // [m] to [km]
+      }
+      else
+      {
+         // Entries are either "gfc n m C S ..." or "n m C S ..."
+         if (key != "gfc")
+         {
+            iss.clear();
+            iss.str(line);
+         }
+         Coefficient coefficient;
+         if (iss >> coefficient.n >> coefficient.m >> coefficient.c >> coefficient.s &&
+             coefficient.m >= 0 && coefficient.m <= coefficient.n)
+         {
+            coefficients.push_back(coefficient);
+            maxDegree = std::max(maxDegree, coefficient.n);
+         }
+      }
+   }
+
+   // The field is only replaced once the whole file has been read
+   m_mu = mu;
+   m_referenceRadius = referenceRadius;
+   std::fill(m_c.begin(), m_c.end(), 0.0);
+   std::fill(m_s.begin(), m_s.end(), 0.0);
+   SetMaxDegree(maxDegree);
+   for (const auto& coefficient : coefficients)
+   {
+      // Unnormalized coefficients are divided by N(n,m) = sqrt((2 - delta(m)) (2n + 1) (n - m)! / (n + m)!)
+      double scale = 1.0;
+      if (!normalized)
+      {
+         const int n = coefficient.n, m = coefficient.m;
+         scale = std::exp(0.5 * (std::lgamma(n + m + 1.0) - std::lgamma(n - m + 1.0) - std::log((m == 0 ? 1.0 : 2.0) * (2.0 * n + 1.0))));
+      }
+      const std::size_t index = TriangularIndex(coefficient.n, coefficient.m);
+      m_c[index] = scale * coefficient.c;
+      m_s[index] = scale * coefficient.s;
+   }
+}
+
+////////////////////////////////////////////////////////////
+void SphericalHarmonicGravityModel::SetMaxDegree(int maxDegree)
+{
+   if (maxDegree == m_maxDegree)
+   {
+      return;
+   }
+   // The full field is evaluated unless a degree was set explicitly
+   m_maxDegree = std::max(0, maxDegree);
+   m_degree = (m_requestedDegree < 0 ? m_maxDegree : std::min(m_requestedDegree, m_maxDegree));
+
+   const std::size_t size = TriangularIndex(m_maxDegree + 1, 0);
+   m_c.resize(size, 0.0);
+   m_s.resize(size, 0.0);
+   m_factorLower.assign(size, 0.0);
+   m_factorEqual.assign(size, 0.0);
+   m_factorHigher.assign(size, 0.0);
+
+   // The accelerations of degree n need the harmonics of degree n + 1
+   const std::size_t harmonicSize = TriangularIndex(m_maxDegree + 2, 0);
+   m_v.assign(harmonicSize, 0.0);
+   m_w.assign(harmonicSize, 0.0);
+   m_recursionA.assign(harmonicSize, 0.0);
+   m_recursionB.assign(harmonicSize, 0.0);
+   m_sectoral.assign(m_maxDegree + 2, 0.0);
+
+   // Ratios of the normalization N(n,m) = sqrt((2 - delta(m)) (2n + 1) (n - m)! / (n + m)!) between harmonics
+   for (int m = 1; m <= m_maxDegree + 1; ++m)
+   {
+      m_sectoral[m] = (m == 1 ? std::sqrt(3.0) : std::sqrt((2.0 * m + 1.0) / (2.0 * m)));
+   }
+   for (int n = 1; n <= m_maxDegree + 1; ++n)
+   {
+      for (int m = 0; m < n; ++m)
+      {
+         const std::size_t index = TriangularIndex(n, m);
+         m_recursionA[index] = std::sqrt((2.0 * n + 1.0) * (2.0 * n - 1.0) / ((n - m) * (n + m)));
+         if (n - m >= 2)
+         {
+            m_recursionB[index] = std::sqrt((2.0 * n + 1.0) * (n + m - 1.0) * (n - m - 1.0) / ((2.0 * n - 3.0) * (n + m) * (n - m)));
+         }
+      }
+   }
+   for (int n = 0; n <= m_maxDegree; ++n)
+   {
+      const double degreeRatio = (2.0 * n + 1.0) / (2.0 * n + 3.0);
+      for (int m = 0; m <= n; ++m)
+      {
+         const std::size_t index = TriangularIndex(n, m);
+         m_factorHigher[index] = std::sqrt((m == 0 ? 0.5 : 1.0) * degreeRatio * (n + m + 1.0) * (n + m + 2.0));
+         m_factorEqual[index] = std::sqrt(degreeRatio * (n + m + 1.0) * (n - m + 1.0));
+         if (m > 0)
+         {
+            m_factorLower[index] = std::sqrt((m == 1 ? 2.0 : 1.0) * degreeRatio * (n - m + 1.0) * (n - m + 2.0));
+         }
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////
+int SphericalHarmonicGravityModel::GetMaxDegree() const
+{
+   return m_maxDegree;
+}
+
+////////////////////////////////////////////////////////////
+void SphericalHarmonicGravityModel::SetCoefficient(int degree, int order, double c, double s)
+{
+   if (order < 0 || order > degree)
+   {
+      OTL_ERROR() << "Invalid order " << Bracket(order) << " for degree " << Bracket(degree);
+      return;
+   }
+   if (degree > m_maxDegree)
+   {
+      SetMaxDegree(degree);
+   }
+   const std::size_t index = TriangularIndex(degree, order);
+   m_c[index] = c;
+   m_s[index] = s;
+}
+
+////////////////////////////////////////////////////////////
+void SphericalHarmonicGravityModel::SetDegree(int degree)
+{
+   m_requestedDegree = std::max(0, degree);
+   m_degree = std::min(m_requestedDegree, m_maxDegree);
+}
+
+////////////////////////////////////////////////////////////
+void SphericalHarmonicGravityModel::SetRotation(double rate, double angle)
+{
+   m_rotationRate = rate;
+   m_rotationAngle = angle;
+}
+
+////////////////////////////////////////////////////////////
+Vector3d SphericalHarmonicGravityModel::GetAcceleration(double seconds, const Vector3d& position, const Vector3d& velocity)
+{
+   if (m_rotationRate == 0.0 && m_rotationAngle == 0.0)
+   {
+      return GetAcceleration(position, m_degree);
+   }
+
+   const double angle = m_rotationAngle + m_rotationRate * seconds;
+   const double cosAngle = std::cos(angle);
+   const double sinAngle = std::sin(angle);
+   const Vector3d bodyFixedPosition(cosAngle * position.x() + sinAngle * position.y(),
+                                    -sinAngle * position.x() + cosAngle * position.y(),
+                                    position.z());
+   const Vector3d bodyFixedAcceleration = GetAcceleration(bodyFixedPosition, m_degree);
+   return Vector3d(cosAngle * bodyFixedAcceleration.x() - sinAngle * bodyFixedAcceleration.y(),
+                   sinAngle * bodyFixedAcceleration.x() + cosAngle * bodyFixedAcceleration.y(),
+                   bodyFixedAcceleration.z());
+}
+
+////////////////////////////////////////////////////////////
+Vector3d SphericalHarmonicGravityModel::GetAcceleration(const Vector3d& position, int degree)
+{
+   degree = std::min(degree, m_maxDegree);
+   if (degree < 2)
+   {
+      return Vector3d::Zero();
+   }
+   EvaluateHarmonics(position, degree + 1);
+
+   double ax = 0.0, ay = 0.0, az = 0.0;
+   for (int n = 2; n <= degree; ++n)
+   {
+      const std::size_t next = TriangularIndex(n + 1, 0);
+
+      // Zonal terms
+      const std::size_t zonal = TriangularIndex(n, 0);
+      const double c = m_c[zonal];
+      ax -= c * m_factorHigher[zonal] * m_v[next + 1];
+      ay -= c * m_factorHigher[zonal] * m_w[next + 1];
+      az -= c * m_factorEqual[zonal] * m_v[next];
+
+      // Tesseral and sectoral terms
+      for (int m = 1; m <= n; ++m)
+      {
+         const std::size_t index = zonal + m;
+         const double cnm = m_c[index];
+         const double snm = m_s[index];
+         const double higher = m_factorHigher[index];
+         const double lower = m_factorLower[index];
+         ax += 0.5 * (higher * (-cnm * m_v[next + m + 1] - snm * m_w[next + m + 1]) +
+                      lower * (cnm * m_v[next + m - 1] + snm * m_w[next + m - 1]));
+         ay += 0.5 * (higher * (-cnm * m_w[next + m + 1] + snm * m_v[next + m + 1]) +
+                      lower * (-cnm * m_w[next + m - 1] + snm * m_v[next + m - 1]));
+         az += m_factorEqual[index] * (-cnm * m_v[next + m] - snm * m_w[next + m]);
+      }
+   }
+
+   const double scale = m_mu / (m_referenceRadius * m_referenceRadius);
+   return Vector3d(scale * ax, scale * ay, scale * az);
+}
+
+////////////////////////////////////////////////////////////
+double SphericalHarmonicGravityModel::GetPotential(const Vector3d& position, int degree)
+{
+   degree = std::min(degree, m_maxDegree);
+   if (degree < 2)
+   {
+      return 0.0;
+   }
+   EvaluateHarmonics(position, degree);
+
+   double potential = 0.0;
+   for (std::size_t index = TriangularIndex(2, 0); index < TriangularIndex(degree + 1, 0); ++index)
+   {
+      potential += m_c[index] * m_v[index] + m_s[index] * m_w[index];
+   }
+   return m_mu / m_referenceRadius * potential;
+}
+
+////////////////////////////////////////////////////////////
+void SphericalHarmonicGravityModel::EvaluateHarmonics(const Vector3d& position, int degree)
+{
+   const double inverseRadiusSquared = 1.0 / position.squaredNorm();
+   const double rho = SQR(m_referenceRadius) * inverseRadiusSquared;
+   const double x0 = m_referenceRadius * position.x() * inverseRadiusSquared;
+   const double y0 = m_referenceRadius * position.y() * inverseRadiusSquared;
+   const double z0 = m_referenceRadius * position.z() * inverseRadiusSquared;
+
+   // Each degree is recursed from the two previous degrees, so every row is read and written contiguously
+   m_v[0] = m_referenceRadius * std::sqrt(inverseRadiusSquared);
+   m_w[0] = 0.0;
+   for (int n = 1; n <= degree; ++n)
+   {
+      const std::size_t row = TriangularIndex(n, 0);
+      const std::size_t previous = TriangularIndex(n - 1, 0);
+      const std::size_t beforePrevious = (n >= 2 ? TriangularIndex(n - 2, 0) : 0);
+      for (int m = 0; m < n - 1; ++m)
+      {
+         const double a = m_recursionA[row + m] * z0;
+         const double b = m_recursionB[row + m] * rho;
+         m_v[row + m] = a * m_v[previous + m] - b * m_v[beforePrevious + m];
+         m_w[row + m] = a * m_w[previous + m] - b * m_w[beforePrevious + m];
+      }
+
+      // The harmonic next to the sectoral one has no second previous degree
+      const double a = m_recursionA[row + n - 1] * z0;
+      m_v[row + n - 1] = a * m_v[previous + n - 1];
+      m_w[row + n - 1] = a * m_w[previous + n - 1];
+
+      const double vPrevious = m_v[previous + n - 1];
+      const double wPrevious = m_w[previous + n - 1];
+      m_v[row + n] = m_sectoral[n] * (x0 * vPrevious - y0 * wPrevious);
+      m_w[row + n] = m_sectoral[n] * (x0 * wPrevious + y0 * vPrevious);
+   }
+}
+
+////////////////////////////////////////////////////////////
+SolarPressureModel::SolarPressureModel(const PositionFunction& sourcePosition, double radiationPressure, double area, double coefficient, double mass) :
+m_sourcePosition(sourcePosition),
+m_scale(radiationPressure * coefficient * area / mass * 1.0e-3 * SQR(ASTRO_AU_TO_KM))
+{
+
+}
+
+////////////////////////////////////////////////////////////
+Vector3d SolarPressureModel::GetAcceleration(double seconds, const Vector3d& position, const Vector3d& velocity)
+{
+   const Vector3d incidentVector = position - m_sourcePosition(GetEpochAt(seconds));
+   const double distance = incidentVector.norm();
+   return m_scale / (distance * distance * distance) * incidentVector;
 }
 
-}
\ No newline at end of file
+} // namespace otl
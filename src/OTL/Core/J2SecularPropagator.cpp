@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////
+//
+// OTL - Orbital Trajectory Library
+// Copyright (C) 2013-2018 Jason Bryan (Jmbryan10@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#include <OTL/Core/J2SecularPropagator.h>
+#include <OTL/Core/Conversion.h>
+
+namespace otl
+{
+
+namespace keplerian
+{
+
+namespace
+{
+
+// Add the Keplerian and secular J2 motion to mean elements
+void AddSecularMotion(const OrbitalElements& orbitalElements, double mu, double j2RadiusSquared, double seconds, OrbitalElements& propagatedOrbitalElements)
+{
+   const double a = orbitalElements.semiMajorAxis;
+   const double e = orbitalElements.eccentricity;
+   const double meanMotion = sqrt(mu / std::abs(a * a * a));
+   propagatedOrbitalElements = orbitalElements;
+   if (e >= 1.0 || a <= 0.0)
+   {
+      propagatedOrbitalElements.meanAnomaly += meanMotion * seconds;
+      return;
+   }
+
+   const double oneMinusESquared = 1.0 - e * e;
+   const double p = a * oneMinusESquared;
+   const double cosI = cos(orbitalElements.inclination);
+   const double sinISquared = 1.0 - cosI * cosI;
+   const double k = 1.5 * meanMotion * j2RadiusSquared / (p * p);
+
+   propagatedOrbitalElements.lonOfAscendingNode += -k * cosI * seconds;
+   propagatedOrbitalElements.argOfPericenter += k * (2.0 - 2.5 * sinISquared) * seconds;
+   propagatedOrbitalElements.meanAnomaly += (meanMotion + k * sqrt(oneMinusESquared) * (1.0 - 1.5 * sinISquared)) * seconds;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////
+J2SecularPropagator::J2SecularPropagator(double j2, double referenceRadius) :
+m_j2(j2),
+m_referenceRadius(referenceRadius)
+{
+
+}
+
+////////////////////////////////////////////////////////////
+void J2SecularPropagator::SetJ2(double j2, double referenceRadius)
+{
+   m_j2 = j2;
+   m_referenceRadius = referenceRadius;
+}
+
+////////////////////////////////////////////////////////////
+StateVector J2SecularPropagator::PropagateStateVector(const StateVector& stateVector, double mu, const Time& timeDelta)
+{
+   return ConvertOrbitalElements2StateVector(PropagateOrbitalElements(ConvertStateVector2OrbitalElements(stateVector, mu), mu, timeDelta), mu);
+}
+
+////////////////////////////////////////////////////////////
+OrbitalElements J2SecularPropagator::PropagateOrbitalElements(const OrbitalElements& orbitalElements, double mu, const Time& timeDelta)
+{
+   OrbitalElements propagatedOrbitalElements;
+   AddSecularMotion(orbitalElements, mu, m_j2 * m_referenceRadius * m_referenceRadius, timeDelta.Seconds(), propagatedOrbitalElements);
+   return propagatedOrbitalElements;
+}
+
+////////////////////////////////////////////////////////////
+void J2SecularPropagator::PropagateOrbitalElements(const Span<const OrbitalElements>& orbitalElements,
+                                                   double mu,
+                                                   const Span<const double>& timeDeltas,
+                                                   const Span<OrbitalElements>& propagatedOrbitalElements)
+{
+   const std::size_t size = orbitalElements.Size();
+   if (timeDeltas.Size() != size || propagatedOrbitalElements.Size() != size)
+   {
+      OTL_ERROR() << "Batch size mismatch: " << Bracket(size) << " orbital elements, "
+                  << Bracket(timeDeltas.Size()) << " time deltas, and "
+                  << Bracket(propagatedOrbitalElements.Size()) << " outputs";
+      return;
+   }
+
+   const double j2RadiusSquared = m_j2 * m_referenceRadius * m_referenceRadius;
+   for (std::size_t i = 0; i < size; ++i)
+   {
+      AddSecularMotion(orbitalElements[i], mu, j2RadiusSquared, timeDeltas[i], propagatedOrbitalElements[i]);
+   }
+}
+
+} // namespace keplerian
+
+} // namespace otl
@@ -107,6 +107,22 @@ OrbitalElements JplApproximateEphemerisIO::GetOrbitalElements(const std::string&
       w         * MATH_DEG_TO_RAD);
 }
 
+////////////////////////////////////////////////////////////
+StateVector JplApproximateEphemerisIO::GetStateVector(const std::string& name, const Epoch& epoch)
+{
+   const OrbitalElements orbitalElements = GetOrbitalElements(name, epoch);
+
+   // The eccentricity drifts slowly, so the Kepler's Equation table of each
+   // body is reused until the drift exceeds what its correction step absorbs
+   auto& kepler = m_keplerSolvers[name];
+   if (!kepler.IsValidFor(orbitalElements.eccentricity))
+   {
+      kepler = keplerian::TabulatedKeplerSolver(orbitalElements.eccentricity);
+   }
+
+   return ConvertOrbitalElements2StateVector(orbitalElements, ASTRO_MU_SUN, kepler);
+}
+
 ////////////////////////////////////////////////////////////
 bool JplApproximateEphemerisIO::IsValidName(const std::string& name) const
 {
@@ -239,6 +255,7 @@ void JplApproximateEphemerisIO::Load()
 
    // Save the ephemeris data for each planet to the database
    g_database.clear();
+   m_keplerSolvers.clear();
    for (unsigned int p = 0; p < numPlanets; ++p)
    {
       g_database[planetNames[p]] = ephemeris[p];
@@ -24,6 +24,8 @@
 
 #pragma once
 #include <OTL/Core/Epoch.h>
+#include <OTL/Core/TabulatedKeplerSolver.h>
+#include <map>
 #include <string>
 #include <vector>
 #include <memory>
@@ -34,6 +36,7 @@ namespace otl
 // Forward declarations
 class PhysicalProperties;
 struct OrbitalElements;
+struct StateVector;
 
 class JplApproximateEphemerisIO
 {
@@ -44,6 +47,7 @@ public:
    JplApproximateEphemerisIO& operator=(const JplApproximateEphemerisIO&) = delete;
 
    OrbitalElements GetOrbitalElements(const std::string& name, const Epoch& epoch);
+   StateVector GetStateVector(const std::string& name, const Epoch& epoch);
 
    bool IsValidName(const std::string& name) const;
    bool IsValidEpoch(const Epoch& epoch) const;
@@ -58,6 +62,7 @@ private:
    Epoch m_startEpoch;
    Epoch m_endEpoch;
    std::pair<std::string, std::vector<double>> m_cache;
+   std::map<std::string, keplerian::TabulatedKeplerSolver> m_keplerSolvers;
 };
 
 } // namespace otl
\ No newline at end of file
@@ -59,7 +59,7 @@ void JplApproximateEphemeris::VLoad()
    {
       g_ephemerisDatabase->Initialize();
    }
-   catch (std::exception ex)
+   catch (const std::exception& ex)
    {
       OTL_FATAL() << "Exception caught while trying to load ephemeris datafile " <<
          Bracket(GetDataFilename()) << ": " << Bracket(ex.what());
@@ -91,7 +91,7 @@ PhysicalProperties JplApproximateEphemeris::VGetPhysicalProperties(const std::st
    {
       return GetPlanetPhysicalProperties(name);
    }
-   catch (std::exception ex)
+   catch (const std::exception& ex)
    {
       OTL_ERROR() << "Exception caught while trying to retrieve physical properties for "
          << Bracket(name) << ": " << Bracket(ex.what());
@@ -129,7 +129,7 @@ OrbitalElements JplApproximateEphemeris::VGetOrbitalElements(const std::string&
    {
       return g_ephemerisDatabase->GetOrbitalElements(name, epoch);
    }
-   catch (std::exception ex)
+   catch (const std::exception& ex)
    {
       OTL_ERROR() << "Exception caught while trying to retrieve state vector for " << Bracket(name) <<
          " at epoch " << Bracket(epoch) << ": " << Bracket(ex.what());
@@ -141,8 +141,17 @@ OrbitalElements JplApproximateEphemeris::VGetOrbitalElements(const std::string&
 ////////////////////////////////////////////////////////////
 StateVector JplApproximateEphemeris::VGetStateVector(const std::string& name, const Epoch& epoch)
 {
-   return ConvertOrbitalElements2StateVector(
-      VGetOrbitalElements(name, epoch), ASTRO_MU_SUN);
+   try
+   {
+      return g_ephemerisDatabase->GetStateVector(name, epoch);
+   }
+   catch (const std::exception& ex)
+   {
+      OTL_ERROR() << "Exception caught while trying to retrieve state vector for " << Bracket(name) <<
+         " at epoch " << Bracket(epoch) << ": " << Bracket(ex.what());
+   }
+
+   return StateVector();
 }
 
 } // namespace otl
\ No newline at end of file
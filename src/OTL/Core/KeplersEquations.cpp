@@ -23,7 +23,10 @@
 ////////////////////////////////////////////////////////////
 
 #include <OTL/Core/KeplersEquations.h>
+#include <OTL/Core/KeplerSolver.h>
 #include <OTL/Core/Logger.h>
+#include <algorithm>
+#include <limits>
 
 namespace otl
 {
@@ -31,6 +34,176 @@ namespace otl
 namespace keplerian
 {
 
+namespace
+{
+
+////////////////////////////////////////////////////////////
+double CheckKeplerSolution(const KeplerSolution& solution, int maxIterations)
+{
+   if (solution.status == KeplerSolverStatus::ZeroDerivative)
+   {
+      OTL_WARN() << "IKeplersEquation::Evaluate: SolveInverseDerivative() must return greater than or equal to zero, but returned " << Bracket(solution.derivative);
+   }
+   else if (solution.status == KeplerSolverStatus::MaxIterations)
+   {
+      OTL_WARN() << "IKeplersEquation::Evaluate: Max iterations " << Bracket(maxIterations) << " exceeded!";
+   }
+   return solution.anomaly;
+}
+
+// Iteration limit of SolverAccuracy::Reduced, the same as the default of the double precision solvers
+const int KEPLER_REDUCED_MAX_ITERATIONS = 1000;
+
+// Iteration limit of SolverAccuracy::Single. Newton-Raphson from the starting guesses
+// below converges in a handful of steps, so an unconverged solve stops early.
+const int KEPLER_SINGLE_MAX_ITERATIONS = 50;
+
+// Number of lanes advanced in lockstep by the batch solver
+const int KEPLER_BATCH_LANES = 8;
+
+// Largest Newton step after which the batch solver updates sin/cos (or sinh/cosh)
+// of the anomaly with the angle addition formulas instead of calling them again.
+// The series below are accurate to better than 1e-16 for steps up to this size.
+const double KEPLER_BATCH_MAX_SERIES_STEP = 0.1;
+
+////////////////////////////////////////////////////////////
+// Solves a batch lane by lane with Newton-Raphson iterations that advance in
+// lockstep, and returns the number of elements that did not converge.
+//
+// Each lane carries sigma = -1 for Kepler's Equation of elliptical orbits and
+// sigma = +1 for hyperbolic orbits, so that both are written as
+//    f(E)  = sigma * (e * s - E) - M
+//    f'(E) = sigma * (e * c - 1)
+// where s and c are sin(E) and cos(E), or sinh(E) and cosh(E). After the first
+// few steps the iterates move by less than KEPLER_BATCH_MAX_SERIES_STEP and s
+// and c are advanced with the addition formulas, so the inner loop is plain
+// arithmetic over all lanes. Converged lanes are masked out with a zero step.
+template<bool AllElliptical>
+std::size_t SolveBatch(const Span<const double>& eccentricities,
+                       const Span<const double>& meanAnomalies,
+                       const Span<double>& anomalies,
+                       int maxIterations,
+                       double tolerance)
+{
+   double e[KEPLER_BATCH_LANES], M[KEPLER_BATCH_LANES], E[KEPLER_BATCH_LANES];
+   double s[KEPLER_BATCH_LANES], c[KEPLER_BATCH_LANES], sigma[KEPLER_BATCH_LANES];
+   double denominator[KEPLER_BATCH_LANES], ratio[KEPLER_BATCH_LANES];
+   int iterations[KEPLER_BATCH_LANES];
+   bool active[KEPLER_BATCH_LANES], converged[KEPLER_BATCH_LANES];
+
+   std::size_t failures = 0;
+   const std::size_t size = anomalies.Size();
+   for (std::size_t offset = 0; offset < size; offset += KEPLER_BATCH_LANES)
+   {
+      const int lanes = static_cast<int>(std::min<std::size_t>(KEPLER_BATCH_LANES, size - offset));
+      for (int lane = 0; lane < KEPLER_BATCH_LANES; ++lane)
+      {
+         e[lane] = 0.0;
+         M[lane] = 0.0;
+         E[lane] = 0.0;
+         s[lane] = 0.0;
+         c[lane] = 1.0;
+         sigma[lane] = -1.0;
+         iterations[lane] = 0;
+         active[lane] = false;
+         converged[lane] = true;
+         if (lane >= lanes)
+         {
+            continue;
+         }
+
+         e[lane] = eccentricities[offset + lane];
+         M[lane] = meanAnomalies[offset + lane];
+         if (AllElliptical || IsCircularOrElliptical(e[lane]))
+         {
+            E[lane] = EllipticalAnomalyPolicy::InitialGuess(e[lane], M[lane]);
+            s[lane] = sin(E[lane]);
+            c[lane] = cos(E[lane]);
+            active[lane] = (maxIterations > 0);
+            converged[lane] = false;
+         }
+         else if (IsHyperbolic(e[lane]))
+         {
+            // The bracketing starter avoids the long descent from H = M at high eccentricity
+            E[lane] = HyperbolicAnomalyPolicy::HighOrderGuess(e[lane], M[lane]);
+            s[lane] = sinh(E[lane]);
+            c[lane] = cosh(E[lane]);
+            sigma[lane] = 1.0;
+            active[lane] = (maxIterations > 0);
+            converged[lane] = false;
+         }
+         else
+         {
+            // Parabolic and invalid orbits are handled exactly as the scalar solver does
+            E[lane] = SolveKeplersEquation(e[lane], M[lane], maxIterations, tolerance);
+         }
+      }
+
+      bool anyActive = true;
+      while (anyActive)
+      {
+         for (int lane = 0; lane < KEPLER_BATCH_LANES; ++lane)
+         {
+            const double sg = (AllElliptical ? -1.0 : sigma[lane]);
+            const double numerator = sg * (e[lane] * s[lane] - E[lane]) - M[lane];
+            denominator[lane] = sg * (e[lane] * c[lane] - 1.0);
+            const bool step = active[lane] && fabs(denominator[lane]) > MATH_NEAR_ZERO;
+            ratio[lane] = (step ? numerator / denominator[lane] : 0.0);
+            E[lane] -= ratio[lane];
+         }
+
+         anyActive = false;
+         for (int lane = 0; lane < lanes; ++lane)
+         {
+            if (!active[lane])
+            {
+               continue;
+            }
+            if (fabs(denominator[lane]) <= MATH_NEAR_ZERO)
+            {
+               active[lane] = false;
+               continue;
+            }
+            ++iterations[lane];
+            converged[lane] = (fabs(ratio[lane]) <= tolerance);
+            active[lane] = (!converged[lane] && iterations[lane] < maxIterations);
+            if (!active[lane])
+            {
+               continue;
+            }
+            anyActive = true;
+
+            const double sg = (AllElliptical ? -1.0 : sigma[lane]);
+            const double d = -ratio[lane];
+            if (fabs(d) > KEPLER_BATCH_MAX_SERIES_STEP)
+            {
+               s[lane] = (sg < 0.0 ? sin(E[lane]) : sinh(E[lane]));
+               c[lane] = (sg < 0.0 ? cos(E[lane]) : cosh(E[lane]));
+            }
+            else
+            {
+               // cos(d) or cosh(d), and sin(d) or sinh(d), to tenth order
+               const double d2 = sg * d * d;
+               const double cd = 1.0 + d2 / 2.0 * (1.0 + d2 / 12.0 * (1.0 + d2 / 30.0 * (1.0 + d2 / 56.0)));
+               const double sd = d * (1.0 + d2 / 6.0 * (1.0 + d2 / 20.0 * (1.0 + d2 / 42.0 * (1.0 + d2 / 72.0))));
+               const double sNew = s[lane] * cd + c[lane] * sd;
+               c[lane] = c[lane] * cd + sg * s[lane] * sd;
+               s[lane] = sNew;
+            }
+         }
+      }
+
+      for (int lane = 0; lane < lanes; ++lane)
+      {
+         anomalies[offset + lane] = E[lane];
+         failures += (converged[lane] ? 0 : 1);
+      }
+   }
+   return failures;
+}
+
+} // namespace
+
 ////////////////////////////////////////////////////////////
 IKeplersEquation::IKeplersEquation(int maxIterations, double tolerance)
 {
@@ -113,24 +286,19 @@ double KeplersEquationElliptical::Evaluate(double eccentricity, double meanAnoma
 ////////////////////////////////////////////////////////////
 double KeplersEquationElliptical::CalculateInitialGuess(double eccentricity, double meanAnomaly)
 {
-   double eccentricAnomaly;
-   if (meanAnomaly < MATH_PI)
-      eccentricAnomaly = meanAnomaly + eccentricity / 2.0;
-   else
-      eccentricAnomaly = meanAnomaly - eccentricity / 2.0;
-   return eccentricAnomaly;
+   return EllipticalAnomalyPolicy::InitialGuess(eccentricity, meanAnomaly);
 }
 
 ////////////////////////////////////////////////////////////
 double KeplersEquationElliptical::SolveInverseEquation(double eccentricity, double eccentricAnomaly)
 {
-   return (eccentricAnomaly - eccentricity * sin(eccentricAnomaly));
+   return EllipticalAnomalyPolicy::InverseEquation(eccentricity, eccentricAnomaly);
 }
 
 ////////////////////////////////////////////////////////////
 double KeplersEquationElliptical::SolveInverseDerivative(double eccentricity, double eccentricAnomaly)
 {
-   return (1.0 - eccentricity * cos(eccentricAnomaly));
+   return EllipticalAnomalyPolicy::InverseDerivative(eccentricity, eccentricAnomaly);
 }
 
 ////////////////////////////////////////////////////////////
@@ -148,20 +316,19 @@ double KeplersEquationHyperbolic::Evaluate(double eccentricity, double meanAnoma
 ////////////////////////////////////////////////////////////
 double KeplersEquationHyperbolic::CalculateInitialGuess(double eccentricity, double meanAnomaly)
 {
-   double hyperbolicAnomaly = meanAnomaly;
-   return hyperbolicAnomaly;
+   return HyperbolicAnomalyPolicy::InitialGuess(eccentricity, meanAnomaly);
 }
 
 ////////////////////////////////////////////////////////////
 double KeplersEquationHyperbolic::SolveInverseEquation(double eccentricity, double hyperbolicAnomaly)
 {
-   return (eccentricity * sinh(hyperbolicAnomaly) - hyperbolicAnomaly);
+   return HyperbolicAnomalyPolicy::InverseEquation(eccentricity, hyperbolicAnomaly);
 }
 
 ////////////////////////////////////////////////////////////
 double KeplersEquationHyperbolic::SolveInverseDerivative(double eccentricity, double hyperbolicAnomaly)
 {
-   return (eccentricity * cosh(hyperbolicAnomaly) - 1.0);
+   return HyperbolicAnomalyPolicy::InverseDerivative(eccentricity, hyperbolicAnomaly);
 }
 
 ////////////////////////////////////////////////////////////
@@ -169,13 +336,11 @@ double SolveKeplersEquation(double eccentricity, double meanAnomaly, int maxIter
 {
    if (IsCircularOrElliptical(eccentricity))
    {
-      KeplersEquationElliptical kepler(maxIterations, tolerance);
-      return kepler.Evaluate(eccentricity, meanAnomaly);
+      return CheckKeplerSolution(KeplerSolverElliptical::Solve(eccentricity, meanAnomaly, maxIterations, tolerance), maxIterations);
    }
    else if (IsHyperbolic(eccentricity))
    {
-      KeplersEquationHyperbolic kepler(maxIterations, tolerance);
-      return kepler.Evaluate(eccentricity, meanAnomaly);
+      return CheckKeplerSolution(KeplerSolverHyperbolic::Solve(eccentricity, meanAnomaly, maxIterations, tolerance), maxIterations);
    }
    else if (IsParabolic(eccentricity))
    {
@@ -186,6 +351,83 @@ double SolveKeplersEquation(double eccentricity, double meanAnomaly, int maxIter
    return 0.0;
 }
 
+////////////////////////////////////////////////////////////
+double SolveKeplersEquation(double eccentricity, double meanAnomaly, SolverAccuracy accuracy, double tolerance)
+{
+   switch (accuracy)
+   {
+      case SolverAccuracy::Reduced:
+         return SolveKeplersEquation(eccentricity, meanAnomaly, KEPLER_REDUCED_MAX_ITERATIONS, tolerance);
+
+      case SolverAccuracy::Single:
+         break;
+
+      case SolverAccuracy::Full:
+      default:
+         return SolveKeplersEquation(eccentricity, meanAnomaly);
+   }
+
+   const float e = static_cast<float>(eccentricity);
+   const float M = static_cast<float>(meanAnomaly);
+   const float minimumTolerance = 4.0f * std::numeric_limits<float>::epsilon();
+
+   if (IsCircularOrElliptical(eccentricity))
+   {
+      float E = (M < static_cast<float>(MATH_PI) ? M + 0.5f * e : M - 0.5f * e);
+      const float singleTolerance = std::max(static_cast<float>(tolerance), minimumTolerance * std::max(1.0f, std::abs(M)));
+      float ratio = std::numeric_limits<float>::infinity();
+      for (int iteration = 0; iteration < KEPLER_SINGLE_MAX_ITERATIONS && std::abs(ratio) > singleTolerance; ++iteration)
+      {
+         ratio = (E - e * std::sin(E) - M) / (1.0f - e * std::cos(E));
+         E -= ratio;
+      }
+      return E;
+   }
+   else if (IsHyperbolic(eccentricity))
+   {
+      // Start from asinh(M / e) rather than M so that sinh() cannot overflow in single precision
+      float H = std::asinh(M / e);
+      const float singleTolerance = std::max(static_cast<float>(tolerance), minimumTolerance * std::max(1.0f, std::abs(H)));
+      float ratio = std::numeric_limits<float>::infinity();
+      for (int iteration = 0; iteration < KEPLER_SINGLE_MAX_ITERATIONS && std::abs(ratio) > singleTolerance; ++iteration)
+      {
+         ratio = (e * std::sinh(H) - H - M) / (e * std::cosh(H) - 1.0f);
+         H -= ratio;
+      }
+      return H;
+   }
+
+   return SolveKeplersEquation(eccentricity, meanAnomaly);
+}
+
+////////////////////////////////////////////////////////////
+void SolveKeplersEquationBatch(const Span<const double>& eccentricities,
+                               const Span<const double>& meanAnomalies,
+                               const Span<double>& anomalies,
+                               int maxIterations,
+                               double tolerance)
+{
+   if (eccentricities.Size() != anomalies.Size() || meanAnomalies.Size() != anomalies.Size())
+   {
+      OTL_ERROR() << "Kepler's Equation batch spans must all be of equal size " << Bracket(anomalies.Size());
+      return;
+   }
+
+   bool allElliptical = true;
+   for (std::size_t i = 0; i < eccentricities.Size() && allElliptical; ++i)
+   {
+      allElliptical = IsCircularOrElliptical(eccentricities[i]);
+   }
+
+   const std::size_t failures = (allElliptical ?
+      SolveBatch<true>(eccentricities, meanAnomalies, anomalies, maxIterations, tolerance) :
+      SolveBatch<false>(eccentricities, meanAnomalies, anomalies, maxIterations, tolerance));
+   if (failures > 0)
+   {
+      OTL_WARN() << "SolveKeplersEquationBatch: " << Bracket(failures) << " of " << Bracket(anomalies.Size()) << " solves did not converge";
+   }
+}
+
 } // namespace keplerian
 
-} // namespace otl
\ No newline at end of file
+} // namespace otl
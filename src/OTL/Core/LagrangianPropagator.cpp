@@ -24,6 +24,7 @@
 
 #include <OTL/Core/LagrangianPropagator.h>
 #include <OTL/Core/Time.h>
+#include <algorithm>
 
 namespace otl
 {
@@ -31,6 +32,359 @@ namespace otl
 namespace keplerian
 {
 
+namespace
+{
+
+// Maximum number of Newton-Raphson iterations for the universal variable
+const int MAX_ITERATIONS = 100;
+
+// Number of lanes advanced in lockstep by the batch kernel
+const int BATCH_LANES = 8;
+
+// The batch Stumpff functions quarter psi until its magnitude is at most one.
+// The cap only matters for groups with a lane whose psi has diverged.
+const int MAX_STUMPFF_QUARTERINGS = 40;
+
+////////////////////////////////////////////////////////////
+// Initial guess for the universal variable depending on orbit type
+inline double UniversalVariableInitialGuess(double r0, double v0, double rdotv, double alpha, double seconds, double mu)
+{
+   double x = 1.0;
+   double alphaThreshold = 0.000001 * (ASTRO_MU_EARTH / mu); // Reference?
+   if (alpha > alphaThreshold) // Circle or Ellipse
+   {
+      x = sqrt(mu) * alpha * seconds;
+   }
+   else if (alpha < -alphaThreshold) // Hyperbola
+   {
+      double a = 1.0 / alpha;
+      x = Sign(seconds) * sqrt(-a) * log((-2.0 * mu * alpha * seconds) /
+         (rdotv + Sign(seconds) * sqrt(-mu * a) * (1.0 - r0 * alpha)));
+   }
+   else // Parabola
+   {
+      double h = 0.5 * SQR(v0) - mu / r0;
+      double p = SQR(h) / mu;
+      double s = 0.5 * acot(3.0 * sqrt(mu / (p * p * p)) * seconds);
+      double w = pow(tan(s), 1.0 / 3.0);
+      x = 2.0 * sqrt(p) * cot(2.0 * w);
+   }
+
+   return x;
+}
+
+////////////////////////////////////////////////////////////
+// Stumpff functions c2(psi) and c3(psi) of the scalar paths
+inline void EvaluateStumpff(double psi, double& c2, double& c3)
+{
+   if (psi > 1.0e-6)
+   {
+      const double sqrtPsi = sqrt(psi);
+      c2 = (1.0 - cos(sqrtPsi)) / psi;
+      c3 = (sqrtPsi - sin(sqrtPsi)) / (psi * sqrtPsi);
+   }
+   else if (psi < -1.0e-6)
+   {
+      const double sqrtPsi = sqrt(-psi);
+      c2 = (1.0 - cosh(sqrtPsi)) / psi;
+      c3 = (sinh(sqrtPsi) - sqrtPsi) / (-psi * sqrtPsi);
+   }
+   else
+   {
+      c2 = 0.5;
+      c3 = 1.0 / 6.0;
+   }
+}
+
+////////////////////////////////////////////////////////////
+// One Newton-Raphson step of the universal Kepler's Equation. Returns the
+// absolute change of the universal variable.
+inline double UniversalVariableStep(double r0, double alpha, double rdotvOverSqrtMu, double sqrtMuSeconds,
+                                    double& x, double& r, double& psi, double& c2, double& c3)
+{
+   const double xPrev = x;
+   const double xSquared = x * x;
+   psi = xSquared * alpha;
+   EvaluateStumpff(psi, c2, c3);
+   r = xSquared * c2 + rdotvOverSqrtMu * x * (1.0 - psi * c3) + r0 * (1.0 - psi * c2);
+   x += (sqrtMuSeconds - xSquared * x * c3 - rdotvOverSqrtMu * xSquared * c2 - r0 * x * (1.0 - psi * c3)) / r;
+   return fabs(x - xPrev);
+}
+
+////////////////////////////////////////////////////////////
+// Lagrange coefficients from the converged universal variable. Returns the
+// deviation of the coefficients from the identity f * gDot - fDot * g = 1.
+inline double EvaluateLagrangeCoefficients(double r0, double seconds, double sqrtMu,
+                                           double x, double r, double psi, double c2, double c3,
+                                           double& f, double& g, double& fDot, double& gDot)
+{
+   const double xSquared = x * x;
+   f = 1.0 - xSquared / r0 * c2;
+   fDot = sqrtMu / r / r0 * x * (psi * c3 - 1.0);
+   g = seconds - xSquared * x / sqrtMu * c3;
+   gDot = 1.0 - xSquared / r * c2;
+   return std::abs((f * gDot - fDot * g) - 1.0);
+}
+
+////////////////////////////////////////////////////////////
+// Stumpff functions c4(psi) and c5(psi) used by the state transition matrix.
+// The closed forms lose precision as psi approaches zero, so the power
+// series is used for small arguments.
+inline void EvaluateHigherStumpff(double psi, double c2, double c3, double& c4, double& c5)
+{
+   if (std::abs(psi) >= 1.0)
+   {
+      c4 = (0.5 - c2) / psi;
+      c5 = (1.0 / 6.0 - c3) / psi;
+   }
+   else
+   {
+      // c_n(psi) = sum_k (-psi)^k / (2k + n)!
+      double term4 = 1.0 / 24.0, term5 = 1.0 / 120.0;
+      c4 = term4;
+      c5 = term5;
+      for (int k = 1; k <= 10; ++k)
+      {
+         term4 *= -psi / ((2 * k + 3) * (2 * k + 4));
+         term5 *= -psi / ((2 * k + 4) * (2 * k + 5));
+         c4 += term4;
+         c5 += term5;
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////
+// State transition matrix d[R2; V2] / d[R1; V1] of the arc from [R1; V1]
+// with the given reciprocal semimajor axis and universal variable.
+void EvaluateStateTransitionMatrix(const Vector3d& R1, const Vector3d& V1, double mu, double seconds,
+                                   double alpha, double x, StateTransitionMatrix& stateTransitionMatrix)
+{
+   typedef Eigen::Matrix<double, 1, 6> Gradient;
+
+   // Universal functions U0..U5 of the universal variable
+   const double sqrtMu = sqrt(mu);
+   const double r0 = R1.norm();
+   const double sigma0 = R1.dot(V1) / sqrtMu;
+   const double psi = SQR(x) * alpha;
+   double c2, c3, c4, c5;
+   EvaluateStumpff(psi, c2, c3);
+   EvaluateHigherStumpff(psi, c2, c3, c4, c5);
+   const double xSquared = x * x;
+   const double U0 = 1.0 - psi * c2;
+   const double U1 = x * (1.0 - psi * c3);
+   const double U2 = xSquared * c2;
+   const double U3 = xSquared * x * c3;
+   const double U4 = xSquared * xSquared * c4;
+   const double U5 = xSquared * xSquared * x * c5;
+   const double r = r0 * U0 + sigma0 * U1 + U2;
+
+   // Lagrange coefficients
+   const double f = 1.0 - U2 / r0;
+   const double g = seconds - U3 / sqrtMu;
+   const double fDot = -sqrtMu * U1 / (r * r0);
+   const double gDot = 1.0 - U2 / r;
+
+   // Partials of the universal functions with respect to alpha,
+   // dUn/dalpha = -(x * U(n+1) - n * U(n+2)) / 2
+   const double U0Alpha = -0.5 * x * U1;
+   const double U1Alpha = -0.5 * (x * U2 - U3);
+   const double U2Alpha = -0.5 * (x * U3 - 2.0 * U4);
+   const double U3Alpha = -0.5 * (x * U4 - 3.0 * U5);
+
+   // Gradients of r0, sigma0, and alpha with respect to [R1; V1]
+   Gradient r0Grad, sigma0Grad, alphaGrad;
+   r0Grad << R1.transpose() / r0, 0.0, 0.0, 0.0;
+   sigma0Grad << V1.transpose() / sqrtMu, R1.transpose() / sqrtMu;
+   alphaGrad << -2.0 / (r0 * r0 * r0) * R1.transpose(), -2.0 / mu * V1.transpose();
+
+   // Implicit gradient of the universal variable from Kepler's Equation,
+   // sqrt(mu) * t = r0 * U1 + sigma0 * U2 + U3, with dF/dx = r
+   const Gradient xGrad = -(U1 * r0Grad + U2 * sigma0Grad + (r0 * U1Alpha + sigma0 * U2Alpha + U3Alpha) * alphaGrad) / r;
+
+   // Total gradients of the universal functions (dU0/dx = -alpha * U1, dUn/dx = U(n-1))
+   const Gradient U0Grad = -alpha * U1 * xGrad + U0Alpha * alphaGrad;
+   const Gradient U1Grad = U0 * xGrad + U1Alpha * alphaGrad;
+   const Gradient U2Grad = U1 * xGrad + U2Alpha * alphaGrad;
+   const Gradient U3Grad = U2 * xGrad + U3Alpha * alphaGrad;
+   const Gradient rGrad = U0 * r0Grad + r0 * U0Grad + U1 * sigma0Grad + sigma0 * U1Grad + U2Grad;
+
+   // Gradients of the Lagrange coefficients
+   // f = 1 - U2 / r0, g = t - U3 / sqrt(mu), fDot = -sqrt(mu) * U1 / (r * r0), gDot = 1 - U2 / r
+   const Gradient fGrad = -U2Grad / r0 + U2 / (r0 * r0) * r0Grad;
+   const Gradient gGrad = -U3Grad / sqrtMu;
+   const Gradient fDotGrad = -sqrtMu / (r * r0) * (U1Grad - U1 / r * rGrad - U1 / r0 * r0Grad);
+   const Gradient gDotGrad = -U2Grad / r + U2 / (r * r) * rGrad;
+
+   // Assemble the state transition matrix d[R2; V2] / d[R1; V1]
+   const Matrix3d identity = Matrix3d::Identity();
+   stateTransitionMatrix.block<3, 3>(0, 0) = f * identity;
+   stateTransitionMatrix.block<3, 3>(0, 3) = g * identity;
+   stateTransitionMatrix.block<3, 3>(3, 0) = fDot * identity;
+   stateTransitionMatrix.block<3, 3>(3, 3) = gDot * identity;
+   stateTransitionMatrix.topRows<3>() += R1 * fGrad + V1 * gGrad;
+   stateTransitionMatrix.bottomRows<3>() += R1 * fDotGrad + V1 * gDotGrad;
+}
+
+////////////////////////////////////////////////////////////
+// Stumpff functions c2(psi) and c3(psi) of a group of lanes without any
+// trigonometric or hyperbolic calls. With c0 = cos(sqrt(psi)) and
+// c1 = sin(sqrt(psi)) / sqrt(psi), quadrupling psi doubles the angle:
+//    c0(4 psi) = 2 * c0(psi)^2 - 1,    c1(4 psi) = c0(psi) * c1(psi)
+// Substituting c0 = 1 - psi * c2 and c1 = 1 - psi * c3 gives
+//    c2(4 psi) = c2 * (2 - psi * c2) / 2
+//    c3(4 psi) = (c2 + c3 - psi * c2 * c3) / 4
+// which also hold for negative psi and do not cancel as psi approaches zero.
+// Every lane is quartered as often as the lane of largest magnitude needs to
+// reach one, the power series is summed there, and the recurrences are
+// applied once per quartering, so all lanes run the same operations.
+inline void EvaluateStumpffLanes(const double* psi, double* c2, double* c3)
+{
+   double largest = 0.0;
+   for (int lane = 0; lane < BATCH_LANES; ++lane)
+   {
+      largest = std::max(largest, fabs(psi[lane]));
+   }
+   int quarterings = 0;
+   double scale = 1.0;
+   while (largest > 1.0 && quarterings < MAX_STUMPFF_QUARTERINGS)
+   {
+      largest *= 0.25;
+      scale *= 0.25;
+      ++quarterings;
+   }
+
+   // c_n(psi) = sum_k (-psi)^k / (2k + n)!, to the k = 8 term
+   double reduced[BATCH_LANES];
+   for (int lane = 0; lane < BATCH_LANES; ++lane)
+   {
+      reduced[lane] = scale * psi[lane];
+      const double p = -reduced[lane];
+      c2[lane] = 0.5 * (1.0 + p * (1.0 / 12.0) * (1.0 + p * (1.0 / 30.0) * (1.0 + p * (1.0 / 56.0) * (1.0 + p * (1.0 / 90.0) *
+                 (1.0 + p * (1.0 / 132.0) * (1.0 + p * (1.0 / 182.0) * (1.0 + p * (1.0 / 240.0) * (1.0 + p * (1.0 / 306.0)))))))));
+      c3[lane] = (1.0 / 6.0) * (1.0 + p * (1.0 / 20.0) * (1.0 + p * (1.0 / 42.0) * (1.0 + p * (1.0 / 72.0) * (1.0 + p * (1.0 / 110.0) *
+                 (1.0 + p * (1.0 / 156.0) * (1.0 + p * (1.0 / 210.0) * (1.0 + p * (1.0 / 272.0) * (1.0 + p * (1.0 / 342.0)))))))));
+   }
+
+   for (int pass = 0; pass < quarterings; ++pass)
+   {
+      for (int lane = 0; lane < BATCH_LANES; ++lane)
+      {
+         const double p = reduced[lane];
+         const double c2Next = 0.5 * c2[lane] * (2.0 - p * c2[lane]);
+         c3[lane] = 0.25 * (c2[lane] + c3[lane] - p * c2[lane] * c3[lane]);
+         c2[lane] = c2Next;
+         reduced[lane] = 4.0 * p;
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////
+// Propagate a group of state vectors in place, one per lane. The lanes at or
+// beyond the given count are padding and are neither read nor written.
+//
+// The Newton-Raphson iterations of every lane advance in lockstep, and a
+// lane is masked out once its last step is below the tolerance. The Stumpff
+// functions are rebuilt from a reduced psi instead of trigonometric calls, so
+// a lane agrees with PropagateStateVector only to within rounding, and the
+// two can fail to converge on different near-parabolic elements. Only the
+// initial guess is computed lane by lane. Failures are counted instead of
+// logged so that a batch reports a single summary.
+void PropagateLanes(double mu, int lanes, const double* seconds,
+                    double (&position)[3][BATCH_LANES], double (&velocity)[3][BATCH_LANES],
+                    std::size_t& numNonConverged, std::size_t& numSanityFailures)
+{
+   const double sqrtMu = sqrt(mu);
+   double r0[BATCH_LANES], alpha[BATCH_LANES], rdotvOverSqrtMu[BATCH_LANES], sqrtMuSeconds[BATCH_LANES];
+   double x[BATCH_LANES], r[BATCH_LANES], psi[BATCH_LANES], c2[BATCH_LANES], c3[BATCH_LANES], error[BATCH_LANES];
+   double psiNext[BATCH_LANES], c2Next[BATCH_LANES], c3Next[BATCH_LANES];
+   double rNext[BATCH_LANES], xNext[BATCH_LANES], errorNext[BATCH_LANES];
+   for (int lane = 0; lane < BATCH_LANES; ++lane)
+   {
+      // Padding lanes hold a trivial orbit that starts converged
+      r0[lane] = 1.0;
+      alpha[lane] = 1.0;
+      rdotvOverSqrtMu[lane] = 0.0;
+      sqrtMuSeconds[lane] = 0.0;
+      x[lane] = r[lane] = psi[lane] = c2[lane] = c3[lane] = error[lane] = 0.0;
+      if (lane >= lanes)
+      {
+         continue;
+      }
+
+      const Vector3d R1(position[0][lane], position[1][lane], position[2][lane]);
+      const Vector3d V1(velocity[0][lane], velocity[1][lane], velocity[2][lane]);
+      const double v0 = V1.norm();
+      const double rdotv = R1.dot(V1);
+      r0[lane] = R1.norm();
+      alpha[lane] = 2.0 / r0[lane] - SQR(v0) / mu;
+      rdotvOverSqrtMu[lane] = rdotv / sqrtMu;
+      sqrtMuSeconds[lane] = sqrtMu * seconds[lane];
+      x[lane] = UniversalVariableInitialGuess(r0[lane], v0, rdotv, alpha[lane], seconds[lane], mu);
+      error[lane] = MATH_INFINITY;
+   }
+
+   int activeLanes = BATCH_LANES;
+   for (int iter = 0; activeLanes > 0 && iter < MAX_ITERATIONS; ++iter)
+   {
+      for (int lane = 0; lane < BATCH_LANES; ++lane)
+      {
+         psiNext[lane] = x[lane] * x[lane] * alpha[lane];
+      }
+      EvaluateStumpffLanes(psiNext, c2Next, c3Next);
+
+      // Same step as UniversalVariableStep for every lane
+      for (int lane = 0; lane < BATCH_LANES; ++lane)
+      {
+         const double xSquared = x[lane] * x[lane];
+         rNext[lane] = xSquared * c2Next[lane] + rdotvOverSqrtMu[lane] * x[lane] * (1.0 - psiNext[lane] * c3Next[lane]) +
+                       r0[lane] * (1.0 - psiNext[lane] * c2Next[lane]);
+         xNext[lane] = x[lane] + (sqrtMuSeconds[lane] - xSquared * x[lane] * c3Next[lane] -
+                       rdotvOverSqrtMu[lane] * xSquared * c2Next[lane] -
+                       r0[lane] * x[lane] * (1.0 - psiNext[lane] * c3Next[lane])) / rNext[lane];
+         errorNext[lane] = fabs(xNext[lane] - x[lane]);
+      }
+
+      // Keep the step only for the lanes that have not converged
+      activeLanes = 0;
+      for (int lane = 0; lane < BATCH_LANES; ++lane)
+      {
+         const bool active = (error[lane] >= MATH_TOLERANCE);
+         error[lane] = (active ? errorNext[lane] : error[lane]);
+         x[lane] = (active ? xNext[lane] : x[lane]);
+         r[lane] = (active ? rNext[lane] : r[lane]);
+         psi[lane] = (active ? psiNext[lane] : psi[lane]);
+         c2[lane] = (active ? c2Next[lane] : c2[lane]);
+         c3[lane] = (active ? c3Next[lane] : c3[lane]);
+         activeLanes += (error[lane] >= MATH_TOLERANCE ? 1 : 0);
+      }
+   }
+
+   for (int lane = 0; lane < lanes; ++lane)
+   {
+      numNonConverged += (error[lane] >= MATH_TOLERANCE ? 1 : 0);
+
+      double f, g, fDot, gDot;
+      const double sanityCheck = EvaluateLagrangeCoefficients(r0[lane], seconds[lane], sqrtMu, x[lane], r[lane], psi[lane], c2[lane], c3[lane], f, g, fDot, gDot);
+      numSanityFailures += (sanityCheck > MATH_TOLERANCE ? 1 : 0);
+      for (int k = 0; k < 3; ++k)
+      {
+         const double R1 = position[k][lane];
+         position[k][lane] = f * R1 + g * velocity[k][lane];
+         velocity[k][lane] = fDot * R1 + gDot * velocity[k][lane];
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////
+// Log a single summary of any elements that failed during a batch
+void CheckBatchResults(std::size_t numNonConverged, std::size_t numSanityFailures, std::size_t size)
+{
+   OTL_WARN_IF(numNonConverged > 0, "Max iterations " << Bracket(MAX_ITERATIONS) << " reached for " << Bracket(numNonConverged) << " of " << Bracket(size) << " state vectors");
+   OTL_WARN_IF(numSanityFailures > 0, "Sanity check failed for " << Bracket(numSanityFailures) << " of " << Bracket(size) << " state vectors");
+}
+
+} // namespace
+
 ////////////////////////////////////////////////////////////
 LagrangianPropagator::LagrangianPropagator()
 {
@@ -68,6 +422,225 @@ StateVector LagrangianPropagator::PropagateStateVector(const StateVector& stateV
    return StateVector(R2, V2);
 }
 
+////////////////////////////////////////////////////////////
+StateVector LagrangianPropagator::PropagateStateVector(const StateVector& stateVector,
+                                                       double mu,
+                                                       const Time& timeDelta,
+                                                       StateTransitionMatrix& stateTransitionMatrix)
+{
+   // Compute frequently used variables
+   const auto& R1 = stateVector.position;
+   const auto& V1 = stateVector.velocity;
+   const double seconds = timeDelta.Seconds();
+   const double sqrtMu = sqrt(mu);
+   const double r0 = R1.norm();
+   const double v0 = V1.norm();
+   const double rdotv = R1.dot(V1);
+
+   // Compute the universal variable results and Lagrange coefficients
+   auto results = CalculateUniversalVariable(r0, v0, rdotv, seconds, mu);
+   auto coeff = CalculateLagrangeCoefficients(r0, seconds, sqrtMu, results);
+
+   // The Stumpff functions in the results belong to the last iterate
+   // before the converged universal variable, so they are re-evaluated
+   const double alpha = 2.0 / r0 - SQR(v0) / mu;
+   EvaluateStateTransitionMatrix(R1, V1, mu, seconds, alpha, results.x, stateTransitionMatrix);
+
+   // Compute the final cartesian vectors
+   Vector3d R2 = coeff.f    * R1 + coeff.g    * V1;
+   Vector3d V2 = coeff.fDot * R1 + coeff.gDot * V1;
+
+   return StateVector(R2, V2);
+}
+
+////////////////////////////////////////////////////////////
+void LagrangianPropagator::CalculateStateTransitionMatrix(const StateVector& initialStateVector,
+                                                          const StateVector& finalStateVector,
+                                                          double mu,
+                                                          const Time& timeDelta,
+                                                          StateTransitionMatrix& stateTransitionMatrix)
+{
+   const auto& R1 = initialStateVector.position;
+   const auto& V1 = initialStateVector.velocity;
+   const double seconds = timeDelta.Seconds();
+   const double sqrtMu = sqrt(mu);
+   const double alpha = 2.0 / R1.norm() - V1.squaredNorm() / mu;
+
+   // Kepler's Equation in the universal variable is equivalent to
+   // x = alpha * sqrt(mu) * t + sigma - sigma0, so no iteration is needed
+   const double sigma0 = R1.dot(V1) / sqrtMu;
+   const double sigma = finalStateVector.position.dot(finalStateVector.velocity) / sqrtMu;
+   const double x = alpha * sqrtMu * seconds + sigma - sigma0;
+
+   EvaluateStateTransitionMatrix(R1, V1, mu, seconds, alpha, x, stateTransitionMatrix);
+}
+
+////////////////////////////////////////////////////////////
+void LagrangianPropagator::PropagateStateVectors(const Span<const StateVector>& stateVectors,
+                                                 double mu,
+                                                 const Span<const double>& timeDeltas,
+                                                 const Span<StateVector>& propagatedStateVectors)
+{
+   const std::size_t size = stateVectors.Size();
+   if (timeDeltas.Size() != size || propagatedStateVectors.Size() != size)
+   {
+      OTL_ERROR() << "Batch size mismatch: " << Bracket(size) << " state vectors, "
+                  << Bracket(timeDeltas.Size()) << " time deltas, and "
+                  << Bracket(propagatedStateVectors.Size()) << " outputs";
+      return;
+   }
+
+   std::size_t numNonConverged = 0, numSanityFailures = 0;
+   double seconds[BATCH_LANES], position[3][BATCH_LANES], velocity[3][BATCH_LANES];
+   for (std::size_t offset = 0; offset < size; offset += BATCH_LANES)
+   {
+      // Each group is read before any of it is written, so the spans may alias
+      const int lanes = static_cast<int>(std::min<std::size_t>(BATCH_LANES, size - offset));
+      for (int lane = 0; lane < lanes; ++lane)
+      {
+         const StateVector& stateVector = stateVectors[offset + lane];
+         seconds[lane] = timeDeltas[offset + lane];
+         for (int k = 0; k < 3; ++k)
+         {
+            position[k][lane] = stateVector.position[k];
+            velocity[k][lane] = stateVector.velocity[k];
+         }
+      }
+
+      PropagateLanes(mu, lanes, seconds, position, velocity, numNonConverged, numSanityFailures);
+
+      for (int lane = 0; lane < lanes; ++lane)
+      {
+         StateVector& propagatedStateVector = propagatedStateVectors[offset + lane];
+         for (int k = 0; k < 3; ++k)
+         {
+            propagatedStateVector.position[k] = position[k][lane];
+            propagatedStateVector.velocity[k] = velocity[k][lane];
+         }
+      }
+   }
+
+   CheckBatchResults(numNonConverged, numSanityFailures, size);
+}
+
+////////////////////////////////////////////////////////////
+void LagrangianPropagator::PropagateStateVectors(const Vector3Span<const double>& positions,
+                                                 const Vector3Span<const double>& velocities,
+                                                 double mu,
+                                                 const Span<const double>& timeDeltas,
+                                                 const Vector3Span<double>& finalPositions,
+                                                 const Vector3Span<double>& finalVelocities)
+{
+   const std::size_t size = timeDeltas.Size();
+   const Span<const double> inputs[] = {positions.x, positions.y, positions.z, velocities.x, velocities.y, velocities.z};
+   const Span<double> outputs[] = {finalPositions.x, finalPositions.y, finalPositions.z, finalVelocities.x, finalVelocities.y, finalVelocities.z};
+   for (int k = 0; k < 6; ++k)
+   {
+      if (inputs[k].Size() != size || outputs[k].Size() != size)
+      {
+         OTL_ERROR() << "Batch size mismatch: expected " << Bracket(size) << " components but found "
+                     << Bracket(inputs[k].Size()) << " inputs and " << Bracket(outputs[k].Size()) << " outputs";
+         return;
+      }
+   }
+
+   std::size_t numNonConverged = 0, numSanityFailures = 0;
+   double seconds[BATCH_LANES], position[3][BATCH_LANES], velocity[3][BATCH_LANES];
+   for (std::size_t offset = 0; offset < size; offset += BATCH_LANES)
+   {
+      const int lanes = static_cast<int>(std::min<std::size_t>(BATCH_LANES, size - offset));
+      for (int lane = 0; lane < lanes; ++lane)
+      {
+         seconds[lane] = timeDeltas[offset + lane];
+         for (int k = 0; k < 3; ++k)
+         {
+            position[k][lane] = inputs[k][offset + lane];
+            velocity[k][lane] = inputs[k + 3][offset + lane];
+         }
+      }
+
+      PropagateLanes(mu, lanes, seconds, position, velocity, numNonConverged, numSanityFailures);
+
+      for (int lane = 0; lane < lanes; ++lane)
+      {
+         for (int k = 0; k < 3; ++k)
+         {
+            outputs[k][offset + lane] = position[k][lane];
+            outputs[k + 3][offset + lane] = velocity[k][lane];
+         }
+      }
+   }
+
+   CheckBatchResults(numNonConverged, numSanityFailures, size);
+}
+
+////////////////////////////////////////////////////////////
+void LagrangianPropagator::SampleStateVectors(const StateVector& stateVector,
+                                              double mu,
+                                              const Span<const double>& timeDeltas,
+                                              const Span<StateVector>& sampledStateVectors)
+{
+   const std::size_t size = timeDeltas.Size();
+   if (sampledStateVectors.Size() != size)
+   {
+      OTL_ERROR() << "Sample size mismatch: " << Bracket(size) << " time deltas and "
+                  << Bracket(sampledStateVectors.Size()) << " outputs";
+      return;
+   }
+
+   // Compute the variables shared by every sample
+   const auto& R1 = stateVector.position;
+   const auto& V1 = stateVector.velocity;
+   const double sqrtMu = sqrt(mu);
+   const double r0 = R1.norm();
+   const double v0 = V1.norm();
+   const double rdotv = R1.dot(V1);
+   const double rdotvOverSqrtMu = rdotv / sqrtMu;
+   const double alpha = 2.0 / r0 - SQR(v0) / mu;
+
+   std::size_t numNonConverged = 0, numSanityFailures = 0;
+   double x = 0.0, r = 0.0, psi = 0.0, c2 = 0.0, c3 = 0.0;
+   for (std::size_t i = 0; i < size; ++i)
+   {
+      const double seconds = timeDeltas[i];
+      if (i == 0)
+      {
+         x = UniversalVariableInitialGuess(r0, v0, rdotv, alpha, seconds, mu);
+      }
+      else
+      {
+         // Extrapolate the previous universal variable to second order using
+         // dx/dt = sqrt(mu) / r and d2x/dt2 = -sqrt(mu) * (r . v) / r^3
+         const StateVector& previous = sampledStateVectors[i - 1];
+         const double rPrev = previous.position.norm();
+         const double dt = seconds - timeDeltas[i - 1];
+         x += sqrtMu / rPrev * dt * (1.0 - 0.5 * previous.position.dot(previous.velocity) / SQR(rPrev) * dt);
+      }
+
+      int iter = 0;
+      double error = MATH_INFINITY;
+      const double sqrtMuSeconds = sqrtMu * seconds;
+      while (error >= MATH_TOLERANCE && iter++ < MAX_ITERATIONS)
+      {
+         error = UniversalVariableStep(r0, alpha, rdotvOverSqrtMu, sqrtMuSeconds, x, r, psi, c2, c3);
+      }
+      if (error >= MATH_TOLERANCE)
+      {
+         ++numNonConverged;
+      }
+
+      double f, g, fDot, gDot;
+      if (EvaluateLagrangeCoefficients(r0, seconds, sqrtMu, x, r, psi, c2, c3, f, g, fDot, gDot) > MATH_TOLERANCE)
+      {
+         ++numSanityFailures;
+      }
+      sampledStateVectors[i].position = f * R1 + g * V1;
+      sampledStateVectors[i].velocity = fDot * R1 + gDot * V1;
+   }
+
+   CheckBatchResults(numNonConverged, numSanityFailures, size);
+}
+
 ////////////////////////////////////////////////////////////
 // Vallado, preferred method but nearly identical performance-wise as Curtis
 LagrangianPropagator::UniversalVariableResult
@@ -80,7 +653,6 @@ LagrangianPropagator::CalculateUniversalVariable(double r0, double v0, double rd
    double& psi = results.psi;
    double& c2 = results.stumpff.c2;
    double& c3 = results.stumpff.c3;
-   auto& stumpff = results.stumpff;
 
    // Compute frequently used variables
    double sqrtMu = sqrt(mu);
@@ -90,18 +662,13 @@ LagrangianPropagator::CalculateUniversalVariable(double r0, double v0, double rd
    x = CalculateUniversableVariableInitialGuess(r0, v0, rdotv, alpha, seconds, mu);
 
    // Solve using Newton-Raphson iteration
+   const double rdotvOverSqrtMu = rdotv / sqrtMu;
+   const double sqrtMuSeconds = sqrtMu * seconds;
    int iter = 0;
-   const int MAX_ITERATIONS = 100;
-   double xPrev, error = MATH_INFINITY;
+   double error = MATH_INFINITY;
    while (error >= MATH_TOLERANCE && iter++ < MAX_ITERATIONS)
    {
-      xPrev = x;
-      double xSquared = SQR(x);
-      psi = xSquared * alpha;
-      stumpff = CalculateStumpffParameters(psi);
-      r = xSquared * c2 + (rdotv / sqrtMu) * x * (1.0 - psi * c3) + r0 * (1.0 - psi * c2);
-      x += (sqrtMu * seconds - pow(x, 3.0) * c3 - rdotv / sqrtMu * xSquared * c2 - r0 * x * (1.0 - psi * c3)) / r;
-      error = fabs(x - xPrev);
+      error = UniversalVariableStep(r0, alpha, rdotvOverSqrtMu, sqrtMuSeconds, x, r, psi, c2, c3);
    }
    OTL_WARN_IF(iter == MAX_ITERATIONS, "Max iterations << " << Bracket(MAX_ITERATIONS) << " reached before error " << Bracket(error) << " within tolerance " << Bracket(MATH_TOLERANCE));
 
@@ -111,53 +678,14 @@ LagrangianPropagator::CalculateUniversalVariable(double r0, double v0, double rd
 ////////////////////////////////////////////////////////////
 double LagrangianPropagator::CalculateUniversableVariableInitialGuess(double r0, double v0, double rdotv, double alpha, double seconds, double mu)
 {
-   double x = 1.0;
-   double alphaThreshold = 0.000001 * (ASTRO_MU_EARTH / mu); // Reference?
-   if (alpha > alphaThreshold) // Circle or Ellipse
-   {
-      x = sqrt(mu) * alpha * seconds;
-   }
-   else if (alpha < -alphaThreshold) // Hyperbola
-   {
-      double a = 1.0 / alpha;
-      x = Sign(seconds) * sqrt(-a) * log((-2.0 * mu * alpha * seconds) /
-         (rdotv + Sign(seconds) * sqrt(-mu * a) * (1.0 - r0 * alpha)));
-   }
-   else // Parabola
-   {
-      double h = 0.5 * SQR(v0) - mu / r0;
-      double p = SQR(h) / mu;
-      double s = 0.5 * acot(3.0 * sqrt(mu / pow(p, 3.0)) * seconds);
-      double w = pow(tan(s), 1.0 / 3.0);
-      x = 2.0 * sqrt(p) * cot(2.0 * w);
-   }
-
-   return x;
+   return UniversalVariableInitialGuess(r0, v0, rdotv, alpha, seconds, mu);
 }
 
 ////////////////////////////////////////////////////////////
 LagrangianPropagator::StumpffParameters LagrangianPropagator::CalculateStumpffParameters(double psi)
 {
    StumpffParameters stumpff;
-
-   if (psi > 1.0e-6)
-   {
-      double sqrtPsi = sqrt(psi);
-      stumpff.c2 = (1.0 - cos(sqrtPsi)) / psi;
-      stumpff.c3 = (sqrtPsi - sin(sqrtPsi)) / pow(psi, 1.5);
-   }
-   else if (psi < -1.0e-6)
-   {
-      double sqrtPsi = sqrt(-psi);
-      stumpff.c2 = (1.0 - cosh(sqrtPsi)) / psi;
-      stumpff.c3 = (sinh(sqrtPsi) - sqrtPsi) / pow(-psi, 1.5);
-   }
-   else
-   {
-      stumpff.c2 = 0.5;
-      stumpff.c3 = 1.0 / 6.0;
-   }
-
+   EvaluateStumpff(psi, stumpff.c2, stumpff.c3);
    return stumpff;
 }
 
@@ -178,12 +706,7 @@ LagrangianPropagator::LagrangeCoefficients LagrangianPropagator::CalculateLagran
    double& fDot = coeff.fDot;
    double& gDot = coeff.gDot;
 
-   f = 1.0 - SQR(x) / r0 * c2;
-   fDot = sqrtMu / r / r0 * x * (psi * c3 - 1.0);
-   g = seconds - pow(x, 3.0) / sqrtMu * c3;
-   gDot = 1.0 - SQR(x) / r * c2;
-
-   double sanityCheck = std::abs((f * gDot - fDot * g) - 1.0);
+   double sanityCheck = EvaluateLagrangeCoefficients(r0, seconds, sqrtMu, x, r, psi, c2, c3, f, g, fDot, gDot);
    OTL_WARN_IF(sanityCheck > MATH_TOLERANCE, "Sanity check failed for " << Bracket(sanityCheck) << " == " << Bracket(MATH_TOLERANCE));
 
    return coeff;
@@ -0,0 +1,232 @@
+////////////////////////////////////////////////////////////
+//
+// OTL - Orbital Trajectory Library
+// Copyright (C) 2013-2018 Jason Bryan (Jmbryan10@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#include <OTL/Core/Lambert.h>
+#include <OTL/Core/LagrangianPropagator.h>
+#include <OTL/Core/Logger.h>
+#include <algorithm>
+#include <cmath>
+
+namespace otl
+{
+
+namespace keplerian
+{
+
+////////////////////////////////////////////////////////////
+void ILambertAlgorithm::EvaluateWarmStart(const Vector3d& initialPosition,
+                                          const Vector3d& finalPosition,
+                                          const Time& timeDelta,
+                                          const Orbit::Direction& orbitDirection,
+                                          int numRevolutions,
+                                          double mu,
+                                          LambertSolverState& state,
+                                          Vector3d& initialVelocity,
+                                          Vector3d& finalVelocity)
+{
+   Evaluate(initialPosition, finalPosition, timeDelta, orbitDirection, numRevolutions, mu, initialVelocity, finalVelocity);
+   state.valid = false;
+}
+
+////////////////////////////////////////////////////////////
+void ILambertAlgorithm::EvaluateScreening(const Vector3d& initialPosition,
+                                          const Vector3d& finalPosition,
+                                          const Time& timeDelta,
+                                          const Orbit::Direction& orbitDirection,
+                                          int numRevolutions,
+                                          double mu,
+                                          SolverAccuracy accuracy,
+                                          double tolerance,
+                                          Vector3d& initialVelocity,
+                                          Vector3d& finalVelocity)
+{
+   Evaluate(initialPosition, finalPosition, timeDelta, orbitDirection, numRevolutions, mu, initialVelocity, finalVelocity);
+}
+
+////////////////////////////////////////////////////////////
+void ILambertAlgorithm::EvaluateJacobian(const Vector3d& initialPosition,
+                                         const Vector3d& finalPosition,
+                                         const Time& timeDelta,
+                                         const Orbit::Direction& orbitDirection,
+                                         int numRevolutions,
+                                         double mu,
+                                         Vector3d& initialVelocity,
+                                         Vector3d& finalVelocity,
+                                         LambertJacobian& jacobian)
+{
+   Evaluate(initialPosition, finalPosition, timeDelta, orbitDirection, numRevolutions, mu, initialVelocity, finalVelocity);
+   CalculateJacobian(initialPosition, finalPosition, timeDelta.Seconds(), mu, initialVelocity, finalVelocity, jacobian);
+}
+
+////////////////////////////////////////////////////////////
+void ILambertAlgorithm::EvaluateBatch(const Vector3Span<const double>& initialPositions,
+                                      const Vector3Span<const double>& finalPositions,
+                                      const Span<const double>& timeDeltas,
+                                      const Span<const int>& numRevolutions,
+                                      const Orbit::Direction& orbitDirection,
+                                      double mu,
+                                      const Vector3Span<double>& initialVelocities,
+                                      const Vector3Span<double>& finalVelocities)
+{
+   if (!IsBatchConsistent(initialPositions, finalPositions, timeDeltas, numRevolutions, initialVelocities, finalVelocities))
+   {
+      return;
+   }
+
+   Vector3d initialVelocity, finalVelocity;
+   for (std::size_t i = 0; i < timeDeltas.Size(); ++i)
+   {
+      Evaluate(initialPositions.Get(i),
+               finalPositions.Get(i),
+               Time::Seconds(timeDeltas[i]),
+               orbitDirection,
+               numRevolutions[i],
+               mu,
+               initialVelocity,
+               finalVelocity);
+      initialVelocities.Set(i, initialVelocity);
+      finalVelocities.Set(i, finalVelocity);
+   }
+}
+
+////////////////////////////////////////////////////////////
+void ILambertAlgorithm::EvaluateBatch(const Vector3Span<const double>& initialPositions,
+                                      const Vector3Span<const double>& finalPositions,
+                                      const Span<const double>& timeDeltas,
+                                      const Span<const int>& numRevolutions,
+                                      const Orbit::Direction& orbitDirection,
+                                      double mu,
+                                      const Vector3Span<double>& initialVelocities,
+                                      const Vector3Span<double>& finalVelocities,
+                                      const Span<LambertJacobian>& jacobians)
+{
+   if (!IsBatchConsistent(initialPositions, finalPositions, timeDeltas, numRevolutions, initialVelocities, finalVelocities))
+   {
+      return;
+   }
+   if (jacobians.Size() != timeDeltas.Size())
+   {
+      OTL_ERROR() << "Lambert batch spans must all be of equal size " << Bracket(timeDeltas.Size());
+      return;
+   }
+
+   Vector3d initialVelocity, finalVelocity;
+   for (std::size_t i = 0; i < timeDeltas.Size(); ++i)
+   {
+      EvaluateJacobian(initialPositions.Get(i),
+                       finalPositions.Get(i),
+                       Time::Seconds(timeDeltas[i]),
+                       orbitDirection,
+                       numRevolutions[i],
+                       mu,
+                       initialVelocity,
+                       finalVelocity,
+                       jacobians[i]);
+      initialVelocities.Set(i, initialVelocity);
+      finalVelocities.Set(i, finalVelocity);
+   }
+}
+
+////////////////////////////////////////////////////////////
+void ILambertAlgorithm::CalculateJacobian(const Vector3d& initialPosition,
+                                          const Vector3d& finalPosition,
+                                          double seconds,
+                                          double mu,
+                                          const Vector3d& initialVelocity,
+                                          const Vector3d& finalVelocity,
+                                          LambertJacobian& jacobian)
+{
+   LagrangianPropagator propagator;
+   StateTransitionMatrix stm;
+   propagator.CalculateStateTransitionMatrix(StateVector(initialPosition, initialVelocity),
+                                             StateVector(finalPosition, finalVelocity),
+                                             mu,
+                                             Time::Seconds(seconds),
+                                             stm);
+
+   // Initial velocity holding the final position fixed
+   const Matrix3d inverseRV = stm.block<3, 3>(0, 3).inverse();
+   jacobian.block<3, 3>(0, 0) = -inverseRV * stm.block<3, 3>(0, 0);
+   jacobian.block<3, 3>(0, 3) = inverseRV;
+   jacobian.block<3, 1>(0, 6) = -inverseRV * finalVelocity;
+
+   // Final velocity through the perturbed initial state, plus the acceleration over the extra time
+   const Matrix3d stmVV = stm.block<3, 3>(3, 3);
+   const double r2 = finalPosition.norm();
+   jacobian.block<3, 3>(3, 0) = stm.block<3, 3>(3, 0) + stmVV * jacobian.block<3, 3>(0, 0);
+   jacobian.block<3, 3>(3, 3) = stmVV * inverseRV;
+   jacobian.block<3, 1>(3, 6) = stmVV * jacobian.block<3, 1>(0, 6) - (mu / (r2 * r2 * r2)) * finalPosition;
+}
+
+////////////////////////////////////////////////////////////
+void ILambertAlgorithm::CalculateTimeOfFlightDerivatives(double lambda, double x, double T, double& dT, double& ddT, double& dddT)
+{
+   const double lambda2 = lambda * lambda;
+   const double lambda3 = lambda * lambda2;
+   const double umx2 = 1.0 - x * x;
+   const double y = std::sqrt(1.0 - lambda2 * umx2);
+   const double y2 = y * y;
+   const double y3 = y2 * y;
+
+   dT   = (3.0 * T * x - 2.0 + 2.0 * lambda3 * x / y) / umx2;
+   ddT  = (3.0 * T + 5.0 * x * dT + 2.0 * (1.0 - lambda2) * lambda3 / y3) / umx2;
+   dddT = (7.0 * x * ddT + 8.0 * dT - 6.0 * (1.0 - lambda2) * lambda2 * lambda3 * x / y3 / y2) / umx2;
+}
+
+////////////////////////////////////////////////////////////
+bool ILambertAlgorithm::IsBatchConsistent(const Vector3Span<const double>& initialPositions,
+                                          const Vector3Span<const double>& finalPositions,
+                                          const Span<const double>& timeDeltas,
+                                          const Span<const int>& numRevolutions,
+                                          const Vector3Span<double>& initialVelocities,
+                                          const Vector3Span<double>& finalVelocities)
+{
+   const std::size_t size = timeDeltas.Size();
+   const Span<const double> spans[] =
+   {
+      initialPositions.x, initialPositions.y, initialPositions.z,
+      finalPositions.x, finalPositions.y, finalPositions.z,
+      initialVelocities.x, initialVelocities.y, initialVelocities.z,
+      finalVelocities.x, finalVelocities.y, finalVelocities.z
+   };
+   for (const auto& span : spans)
+   {
+      if (span.Size() != size)
+      {
+         OTL_ERROR() << "Lambert batch spans must all be of equal size " << Bracket(size);
+         return false;
+      }
+   }
+   if (numRevolutions.Size() != size)
+   {
+      OTL_ERROR() << "Lambert batch spans must all be of equal size " << Bracket(size);
+      return false;
+   }
+   return true;
+}
+
+} // namespace keplerian
+
+} // namespace otl
@@ -0,0 +1,210 @@
+////////////////////////////////////////////////////////////
+//
+// OTL - Orbital Trajectory Library
+// Copyright (C) 2013-2018 Jason Bryan (Jmbryan10@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#include <OTL/Core/LambertCache.h>
+#include <OTL/Core/Logger.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace otl
+{
+
+namespace keplerian
+{
+
+// Number of explicitly stored mantissa bits of a double
+static const int MANTISSA_BITS = 52;
+
+////////////////////////////////////////////////////////////
+LambertCache::LambertCache(const std::shared_ptr<ILambertAlgorithm>& lambert,
+                           std::size_t capacity,
+                           double resolution) :
+m_lambert(lambert),
+m_capacity(std::max<std::size_t>(capacity, 1)),
+m_hits(0),
+m_misses(0)
+{
+   OTL_ASSERT(m_lambert, "Lambert cache requires a Lambert algorithm");
+
+   // Number of mantissa bits below the quantisation step
+   int keptBits = static_cast<int>(std::ceil(-std::log2(std::max(resolution, MATH_EPSILON))));
+   keptBits = std::max(1, std::min(MANTISSA_BITS, keptBits));
+   const int droppedBits = MANTISSA_BITS - keptBits;
+
+   m_roundingBit = (droppedBits > 0 ? (std::uint64_t(1) << (droppedBits - 1)) : 0);
+   m_mask = ~((std::uint64_t(1) << droppedBits) - 1);
+}
+
+////////////////////////////////////////////////////////////
+void LambertCache::Evaluate(const Vector3d& initialPosition,
+                            const Vector3d& finalPosition,
+                            const Time& timeDelta,
+                            const Orbit::Direction& orbitDirection,
+                            int numRevolutions,
+                            double mu,
+                            Vector3d& initialVelocity,
+                            Vector3d& finalVelocity)
+{
+   Entry entry;
+   for (int i = 0; i < 3; ++i)
+   {
+      entry.key.values[i] = Quantise(initialPosition(i));
+      entry.key.values[3 + i] = Quantise(finalPosition(i));
+   }
+   entry.key.values[6] = Quantise(timeDelta.Seconds());
+   entry.key.values[7] = Quantise(mu);
+   entry.key.numRevolutions = numRevolutions;
+   entry.key.orbitDirection = static_cast<int>(orbitDirection);
+
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      auto it = m_map.find(entry.key);
+      if (it != m_map.end())
+      {
+         m_entries.splice(m_entries.begin(), m_entries, it->second);
+         initialVelocity = it->second->initialVelocity;
+         finalVelocity = it->second->finalVelocity;
+         ++m_hits;
+         return;
+      }
+      ++m_misses;
+   }
+
+   m_lambert->Evaluate(initialPosition, finalPosition, timeDelta, orbitDirection, numRevolutions, mu, initialVelocity, finalVelocity);
+   entry.initialVelocity = initialVelocity;
+   entry.finalVelocity = finalVelocity;
+
+   std::lock_guard<std::mutex> lock(m_mutex);
+   if (m_map.find(entry.key) != m_map.end())
+   {
+      // Another thread solved the same problem in the meantime
+      return;
+   }
+   m_entries.push_front(entry);
+   m_map[entry.key] = m_entries.begin();
+   if (m_entries.size() > m_capacity)
+   {
+      m_map.erase(m_entries.back().key);
+      m_entries.pop_back();
+   }
+}
+
+////////////////////////////////////////////////////////////
+void LambertCache::EvaluateAll(const Vector3d& initialPosition,
+                               const Vector3d& finalPosition,
+                               const Time& timeDelta,
+                               const Orbit::Direction& orbitDirection,
+                               int maxRevolutions,
+                               double mu,
+                               std::vector<Vector3d>& initialVelocities,
+                               std::vector<Vector3d>& finalVelocities)
+{
+   m_lambert->EvaluateAll(initialPosition, finalPosition, timeDelta, orbitDirection, maxRevolutions, mu, initialVelocities, finalVelocities);
+}
+
+////////////////////////////////////////////////////////////
+const std::shared_ptr<ILambertAlgorithm>& LambertCache::GetAlgorithm() const
+{
+   return m_lambert;
+}
+
+////////////////////////////////////////////////////////////
+std::size_t LambertCache::GetCapacity() const
+{
+   return m_capacity;
+}
+
+////////////////////////////////////////////////////////////
+std::size_t LambertCache::GetSize() const
+{
+   std::lock_guard<std::mutex> lock(m_mutex);
+   return m_entries.size();
+}
+
+////////////////////////////////////////////////////////////
+std::size_t LambertCache::GetHits() const
+{
+   std::lock_guard<std::mutex> lock(m_mutex);
+   return m_hits;
+}
+
+////////////////////////////////////////////////////////////
+std::size_t LambertCache::GetMisses() const
+{
+   std::lock_guard<std::mutex> lock(m_mutex);
+   return m_misses;
+}
+
+////////////////////////////////////////////////////////////
+void LambertCache::Clear()
+{
+   std::lock_guard<std::mutex> lock(m_mutex);
+   m_entries.clear();
+   m_map.clear();
+   m_hits = 0;
+   m_misses = 0;
+}
+
+////////////////////////////////////////////////////////////
+std::uint64_t LambertCache::Quantise(double value) const
+{
+   // Adding half a step before masking rounds the magnitude to the
+   // nearest step, carrying into the exponent when needed
+   std::uint64_t bits;
+   std::memcpy(&bits, &value, sizeof(bits));
+   return (bits + m_roundingBit) & m_mask;
+}
+
+////////////////////////////////////////////////////////////
+bool LambertCache::Key::operator==(const Key& other) const
+{
+   return std::equal(values, values + 8, other.values) &&
+          numRevolutions == other.numRevolutions &&
+          orbitDirection == other.orbitDirection;
+}
+
+////////////////////////////////////////////////////////////
+std::size_t LambertCache::KeyHasher::operator()(const Key& key) const
+{
+   // FNV-1a over the quantised words
+   std::uint64_t hash = 14695981039346656037ULL;
+   auto combine = [&hash](std::uint64_t word)
+   {
+      hash ^= word;
+      hash *= 1099511628211ULL;
+   };
+   for (int i = 0; i < 8; ++i)
+   {
+      combine(key.values[i]);
+   }
+   combine(static_cast<std::uint64_t>(key.numRevolutions));
+   combine(static_cast<std::uint64_t>(key.orbitDirection));
+   return static_cast<std::size_t>(hash);
+}
+
+} // namespace keplerian
+
+} // namespace otl
@@ -24,6 +24,8 @@
 
 #include <OTL/Core/LambertExponentialSinusoid.h>
 #include <OTL/Core/Logger.h>
+#include <algorithm>
+#include <limits>
 
 namespace otl
 {
@@ -31,6 +33,39 @@ namespace otl
 namespace keplerian
 {
 
+namespace
+{
+
+// Transfer parameter mapping and time of flight residual of the secant
+// iteration, selected at compile time by the revolution class
+template<typename Real, bool ZeroRevolution>
+struct RevolutionMapping;
+
+template<typename Real>
+struct RevolutionMapping<Real, true>
+{
+    static Real ToTransferParameter(Real xi) { return std::exp(xi) - Real(1); }
+    static Real Residual(Real timeOfFlight, Real logt, Real tof) { return std::log(timeOfFlight) - logt; }
+};
+
+template<typename Real>
+struct RevolutionMapping<Real, false>
+{
+    static Real ToTransferParameter(Real xi) { return Real(2) * static_cast<Real>(MATH_1_OVER_PI) * std::atan(xi); }
+    static Real Residual(Real timeOfFlight, Real logt, Real tof) { return timeOfFlight - tof; }
+};
+
+// Maximum number of secant iterations
+const int MAX_ITERATIONS = 60;
+
+// Maximum number of Halley iterations when searching for the minimum time of flight
+const int MAX_MINIMUM_ITERATIONS = 12;
+
+// Number of lanes advanced in lockstep by the batch kernel
+const int BATCH_LANES = 8;
+
+} // namespace
+
 ////////////////////////////////////////////////////////////
 void LambertExponentialSinusoid::Evaluate(const Vector3d& initialPosition,
                                           const Vector3d& finalPosition,
@@ -43,7 +78,301 @@ void LambertExponentialSinusoid::Evaluate(const Vector3d& initialPosition,
 {
     double seconds = timeDelta.Seconds();
     OTL_ASSERT(seconds >= 0.0);
-    
+
+    TransferGeometry geometry;
+    ComputeTransferGeometry(initialPosition, finalPosition, seconds, orbitDirection, mu, geometry);
+
+    double x = SolveTransferParameter(geometry, numRevolutions);
+
+    ComputeVelocities(geometry, x, initialVelocity, finalVelocity);
+}
+
+////////////////////////////////////////////////////////////
+void LambertExponentialSinusoid::EvaluateWarmStart(const Vector3d& initialPosition,
+                                                   const Vector3d& finalPosition,
+                                                   const Time& timeDelta,
+                                                   const Orbit::Direction& orbitDirection,
+                                                   int numRevolutions,
+                                                   double mu,
+                                                   LambertSolverState& state,
+                                                   Vector3d& initialVelocity,
+                                                   Vector3d& finalVelocity)
+{
+    double seconds = timeDelta.Seconds();
+    OTL_ASSERT(seconds >= 0.0);
+
+    TransferGeometry geometry;
+    ComputeTransferGeometry(initialPosition, finalPosition, seconds, orbitDirection, mu, geometry);
+
+    double x1, x2, y1, y2;
+    if (state.valid && state.numRevolutions == numRevolutions)
+    {
+        InitializeSecant(geometry, numRevolutions, state, x1, x2, y1, y2);
+    }
+    else
+    {
+        InitializeSecant(geometry, numRevolutions, x1, x2, y1, y2);
+    }
+
+    double x = IterateSecant(geometry, numRevolutions, x1, x2, y1, y2, &state);
+    state.numRevolutions = numRevolutions;
+
+    ComputeVelocities(geometry, x, initialVelocity, finalVelocity);
+}
+
+////////////////////////////////////////////////////////////
+void LambertExponentialSinusoid::EvaluateScreening(const Vector3d& initialPosition,
+                                                   const Vector3d& finalPosition,
+                                                   const Time& timeDelta,
+                                                   const Orbit::Direction& orbitDirection,
+                                                   int numRevolutions,
+                                                   double mu,
+                                                   SolverAccuracy accuracy,
+                                                   double tolerance,
+                                                   Vector3d& initialVelocity,
+                                                   Vector3d& finalVelocity)
+{
+    double seconds = timeDelta.Seconds();
+    OTL_ASSERT(seconds >= 0.0);
+
+    TransferGeometry geometry;
+    ComputeTransferGeometry(initialPosition, finalPosition, seconds, orbitDirection, mu, geometry);
+
+    double x;
+    switch (accuracy)
+    {
+        case SolverAccuracy::Reduced:
+        {
+            double x1, x2, y1, y2;
+            InitializeSecant(geometry, numRevolutions, x1, x2, y1, y2);
+            x = IterateSecant(geometry, numRevolutions, x1, x2, y1, y2, nullptr, tolerance);
+            break;
+        }
+
+        case SolverAccuracy::Single:
+            x = SolveTransferParameterSingle(geometry, numRevolutions, tolerance);
+            break;
+
+        case SolverAccuracy::Full:
+        default:
+            x = SolveTransferParameter(geometry, numRevolutions);
+            break;
+    }
+
+    ComputeVelocities(geometry, x, initialVelocity, finalVelocity);
+}
+
+////////////////////////////////////////////////////////////
+void LambertExponentialSinusoid::EvaluateAll(const Vector3d& initialPosition,
+                                             const Vector3d& finalPosition,
+                                             const Time& timeDelta,
+                                             const Orbit::Direction& orbitDirection,
+                                             int maxRevolutions,
+                                             double mu,
+                                             std::vector<Vector3d>& initialVelocities,
+                                             std::vector<Vector3d>& finalVelocities)
+{
+   if (maxRevolutions < 0)
+   {
+      OTL_ERROR() << "Max number of revolutions must be greater or equal than zero";
+      return;
+   }
+
+   double seconds = timeDelta.Seconds();
+   OTL_ASSERT(seconds >= 0.0);
+
+   // The geometry is shared by all revolution counts
+   TransferGeometry geometry;
+   ComputeTransferGeometry(initialPosition, finalPosition, seconds, orbitDirection, mu, geometry);
+
+   initialVelocities.resize(2 * maxRevolutions + 1);
+   finalVelocities.resize(2 * maxRevolutions + 1);
+
+   double x = SolveTransferParameter(geometry, 0);
+   ComputeVelocities(geometry, x, initialVelocities[0], finalVelocities[0]);
+
+   int numSolutions = 1;
+   for (int i = 1; i <= maxRevolutions; ++i)
+   {
+      // The minimum time of flight increases with the number of revolutions
+      double xMin;
+      if (CalculateMinimumTimeOfFlight(geometry, i, xMin) > geometry.tof)
+      {
+         break;
+      }
+
+      double xLeft = SolveMultiRevBranch(geometry, i, xMin, true);
+      double xRight = SolveMultiRevBranch(geometry, i, xMin, false);
+
+      // Semimajor axis grows with |x|, so the long period solution has the larger |x|
+      if (std::abs(xLeft) < std::abs(xRight))
+      {
+         std::swap(xLeft, xRight);
+      }
+      ComputeVelocities(geometry, xLeft, initialVelocities[numSolutions], finalVelocities[numSolutions]);
+      ComputeVelocities(geometry, xRight, initialVelocities[numSolutions + 1], finalVelocities[numSolutions + 1]);
+      numSolutions += 2;
+   }
+
+   initialVelocities.resize(numSolutions);
+   finalVelocities.resize(numSolutions);
+}
+
+////////////////////////////////////////////////////////////
+void LambertExponentialSinusoid::EvaluateBatch(const Vector3Span<const double>& initialPositions,
+                                               const Vector3Span<const double>& finalPositions,
+                                               const Span<const double>& timeDeltas,
+                                               const Span<const int>& numRevolutions,
+                                               const Orbit::Direction& orbitDirection,
+                                               double mu,
+                                               const Vector3Span<double>& initialVelocities,
+                                               const Vector3Span<double>& finalVelocities)
+{
+    if (!IsBatchConsistent(initialPositions, finalPositions, timeDeltas, numRevolutions, initialVelocities, finalVelocities))
+    {
+        return;
+    }
+
+    EvaluateBatchKernel(initialPositions, finalPositions, timeDeltas, numRevolutions, orbitDirection, mu,
+                        initialVelocities, finalVelocities, Span<LambertJacobian>());
+}
+
+////////////////////////////////////////////////////////////
+void LambertExponentialSinusoid::EvaluateBatch(const Vector3Span<const double>& initialPositions,
+                                               const Vector3Span<const double>& finalPositions,
+                                               const Span<const double>& timeDeltas,
+                                               const Span<const int>& numRevolutions,
+                                               const Orbit::Direction& orbitDirection,
+                                               double mu,
+                                               const Vector3Span<double>& initialVelocities,
+                                               const Vector3Span<double>& finalVelocities,
+                                               const Span<LambertJacobian>& jacobians)
+{
+    if (!IsBatchConsistent(initialPositions, finalPositions, timeDeltas, numRevolutions, initialVelocities, finalVelocities))
+    {
+        return;
+    }
+    if (jacobians.Size() != timeDeltas.Size())
+    {
+        OTL_ERROR() << "Lambert batch spans must all be of equal size " << Bracket(timeDeltas.Size());
+        return;
+    }
+
+    EvaluateBatchKernel(initialPositions, finalPositions, timeDeltas, numRevolutions, orbitDirection, mu,
+                        initialVelocities, finalVelocities, jacobians);
+}
+
+////////////////////////////////////////////////////////////
+void LambertExponentialSinusoid::EvaluateBatchKernel(const Vector3Span<const double>& initialPositions,
+                                                     const Vector3Span<const double>& finalPositions,
+                                                     const Span<const double>& timeDeltas,
+                                                     const Span<const int>& numRevolutions,
+                                                     const Orbit::Direction& orbitDirection,
+                                                     double mu,
+                                                     const Vector3Span<double>& initialVelocities,
+                                                     const Vector3Span<double>& finalVelocities,
+                                                     const Span<LambertJacobian>& jacobians)
+{
+
+    TransferGeometry geometry[BATCH_LANES];
+    int revs[BATCH_LANES];
+    double x1[BATCH_LANES], x2[BATCH_LANES];
+    double y1[BATCH_LANES], y2[BATCH_LANES];
+    double xnew[BATCH_LANES], x[BATCH_LANES];
+    bool active[BATCH_LANES];
+
+    const std::size_t size = timeDeltas.Size();
+    for (std::size_t offset = 0; offset < size; offset += BATCH_LANES)
+    {
+        const int lanes = static_cast<int>(std::min<std::size_t>(BATCH_LANES, size - offset));
+
+        // Geometry is computed once per lane
+        for (int lane = 0; lane < lanes; ++lane)
+        {
+            const std::size_t i = offset + lane;
+            OTL_ASSERT(timeDeltas[i] >= 0.0);
+            ComputeTransferGeometry(initialPositions.Get(i),
+                                    finalPositions.Get(i),
+                                    timeDeltas[i],
+                                    orbitDirection,
+                                    mu,
+                                    geometry[lane]);
+            revs[lane] = numRevolutions[i];
+            InitializeSecant(geometry[lane], revs[lane], x1[lane], x2[lane], y1[lane], y2[lane]);
+
+            // Same starting iterate and stopping test as IterateSecantSpecialized(),
+            // which takes no step when the initial residuals are equal
+            x[lane] = MapToTransferParameter(x2[lane], revs[lane]);
+            active[lane] = (y2[lane] != y1[lane]);
+        }
+
+        // Advance the secant iterations of all lanes in lockstep. Converged
+        // lanes are masked out so they retain exactly the same iterate as
+        // the scalar solver.
+        bool anyActive = std::any_of(active, active + lanes, [](bool a) { return a; });
+        for (int iteration = 0; anyActive && iteration < MAX_ITERATIONS; ++iteration)
+        {
+            for (int lane = 0; lane < lanes; ++lane)
+            {
+                if (active[lane])
+                {
+                    xnew[lane] = (x1[lane] * y2[lane] - y1[lane] * x2[lane]) / (y2[lane] - y1[lane]);
+                }
+            }
+
+            anyActive = false;
+            for (int lane = 0; lane < lanes; ++lane)
+            {
+                if (active[lane])
+                {
+                    x[lane] = MapToTransferParameter(xnew[lane], revs[lane]);
+                    double ynew = CalculateResidual(x[lane], geometry[lane], revs[lane]);
+
+                    x1[lane] = x2[lane];    x2[lane] = xnew[lane];
+                    y1[lane] = y2[lane];    y2[lane] = ynew;
+
+                    active[lane] = (std::abs(x1[lane] - xnew[lane]) > MATH_TOLERANCE && y2[lane] != y1[lane]);
+                    anyActive = anyActive || active[lane];
+                }
+            }
+        }
+
+        Vector3d initialVelocity, finalVelocity;
+        for (int lane = 0; lane < lanes; ++lane)
+        {
+            const std::size_t i = offset + lane;
+            ComputeVelocities(geometry[lane], x[lane], initialVelocity, finalVelocity);
+            initialVelocities.Set(i, initialVelocity);
+            finalVelocities.Set(i, finalVelocity);
+
+            if (!jacobians.IsEmpty())
+            {
+                CalculateJacobian(initialPositions.Get(i), finalPositions.Get(i), timeDeltas[i], mu,
+                                  initialVelocity, finalVelocity, jacobians[i]);
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////
+void LambertExponentialSinusoid::ComputeTransferGeometry(const Vector3d& initialPosition,
+                                                         const Vector3d& finalPosition,
+                                                         double seconds,
+                                                         const Orbit::Direction& orbitDirection,
+                                                         double mu,
+                                                         TransferGeometry& geometry)
+{
+    PrepareTransferGeometry(initialPosition, finalPosition, orbitDirection, mu, geometry);
+    SetTimeOfFlight(seconds, geometry);
+}
+
+////////////////////////////////////////////////////////////
+void LambertExponentialSinusoid::PrepareTransferGeometry(const Vector3d& initialPosition,
+                                                         const Vector3d& finalPosition,
+                                                         const Orbit::Direction& orbitDirection,
+                                                         double mu,
+                                                         TransferGeometry& geometry)
+{
     // Non-dimensional units
     double DU, VU, TU;
     DU = initialPosition.norm();
@@ -58,9 +387,6 @@ void LambertExponentialSinusoid::Evaluate(const Vector3d& initialPosition,
 
     double r2 = R2.norm();
 
-    // Non-dimensionalize the time of flight
-    double tof = seconds / TU;
-
     // Cross product and dot product of initial and final position.
     Vector3d CrossR1R2 = R1.cross(R2);
     double crossR1R2 = CrossR1R2.norm();
@@ -84,57 +410,304 @@ void LambertExponentialSinusoid::Evaluate(const Vector3d& initialPosition,
         longway = -1;
     }
 
-    double c      = sqrt(1.0 + r2*r2 - 2.0*r2*cos(trueAnomaly));
-    double s      = 0.5*(1.0 + r2 + c);
-    double aMin   = 0.5*s;
-    double lambda = sqrt(r2)*cos(0.5*trueAnomaly)/s;
+    Vector3d Ih = (longway / crossR1R2) * CrossR1R2;
+    Vector3d R2u = R2.normalized();
+
+    geometry.VU           = VU;
+    geometry.TU           = TU;
+    geometry.r2           = r2;
+    geometry.trueAnomaly  = trueAnomaly;
+    geometry.sinHalfTheta = sin(0.5*trueAnomaly);
+    geometry.tanHalfTheta = tan(0.5*trueAnomaly);
+    geometry.c            = sqrt(1.0 + r2*r2 - 2.0*r2*cos(trueAnomaly));
+    geometry.s            = 0.5*(1.0 + r2 + geometry.c);
+    geometry.aMin         = 0.5*geometry.s;
+    geometry.sqrtAMin     = sqrt(geometry.aMin);
+    geometry.lambda       = sqrt(r2)*cos(0.5*trueAnomaly)/geometry.s;
+    geometry.longway      = longway;
+    geometry.R1           = R1;
+    geometry.R2u          = R2u;
+    geometry.CrossIhR1    = Ih.cross(R1);
+    geometry.CrossIhR2u   = Ih.cross(R2u);
+}
+
+////////////////////////////////////////////////////////////
+void LambertExponentialSinusoid::SetTimeOfFlight(double seconds, TransferGeometry& geometry)
+{
+    // Non-dimensionalize the time of flight
+    geometry.tof  = seconds / geometry.TU;
+    geometry.logt = log(geometry.tof);
+}
+
+////////////////////////////////////////////////////////////
+template<typename Real>
+void LambertExponentialSinusoid::InitializeSecant(const TransferGeometry& geometry, int numRevolutions,
+                                                  Real& x1, Real& x2, Real& y1, Real& y2)
+{
+    const Real s = static_cast<Real>(geometry.s);
+    const Real c = static_cast<Real>(geometry.c);
+    const Real logt = static_cast<Real>(geometry.logt);
+
+    Real input1 = Real(-0.5233);
+    Real input2 = Real( 0.5233);
+    x1 = std::log(Real(1) + input1);
+    x2 = std::log(Real(1) + input2);
+
+    y1 = CalculateTimeOfFlight(input1, s, c, geometry.longway, numRevolutions);
+    y2 = CalculateTimeOfFlight(input2, s, c, geometry.longway, numRevolutions);
+    y1 = std::log(y1) - logt;
+    y2 = std::log(y2) - logt;
+}
+
+// Explicit instantiation for PreparedLambertGeometry
+template void LambertExponentialSinusoid::InitializeSecant<double>(const TransferGeometry&, int, double&, double&, double&, double&);
+
+////////////////////////////////////////////////////////////
+void LambertExponentialSinusoid::InitializeSecant(const TransferGeometry& geometry, int numRevolutions, const LambertSolverState& state,
+                                                  double& x1, double& x2, double& y1, double& y2)
+{
+    // Start from the previous solution
+    x1 = MapFromTransferParameter(state.x, numRevolutions);
+    y1 = CalculateResidual(state.x, geometry, numRevolutions);
+
+    // Take the second point from a Newton step using the previous slope
+    const double maxStep = 0.1;
+    double step = (state.slope != 0.0) ? -y1 / state.slope : maxStep;
+    step = std::max(-maxStep, std::min(maxStep, step));
+    if (step == 0.0)
+    {
+        // Already converged, IterateSecant() returns immediately
+        x2 = x1;
+        y2 = y1;
+        return;
+    }
+    x2 = x1 + step;
+    y2 = CalculateResidual(MapToTransferParameter(x2, numRevolutions), geometry, numRevolutions);
+}
+
+////////////////////////////////////////////////////////////
+double LambertExponentialSinusoid::MapFromTransferParameter(double x, int numRevolutions)
+{
+    if (numRevolutions == 0)
+    {
+        return log(1.0 + x);
+    }
+    return tan(0.5 * MATH_PI * x);
+}
+
+////////////////////////////////////////////////////////////
+double LambertExponentialSinusoid::MapToTransferParameter(double xi, int numRevolutions)
+{
+    if (numRevolutions == 0)
+    {
+        return exp(xi) - 1.0;
+    }
+    return 2.0 * MATH_1_OVER_PI * atan(xi);
+}
 
-    double input1 = -0.5233;
-    double input2 =  0.5233;
-    double x1     = log(1.0 + input1);
-    double x2     = log(1.0 + input2);
+////////////////////////////////////////////////////////////
+double LambertExponentialSinusoid::CalculateResidual(double x, const TransferGeometry& geometry, int numRevolutions)
+{
+    double timeOfFlight = CalculateTimeOfFlight(x, geometry.s, geometry.c, geometry.longway, numRevolutions);
+    if (numRevolutions == 0)
+    {
+        return log(timeOfFlight) - geometry.logt;
+    }
+    return timeOfFlight - geometry.tof;
+}
+
+////////////////////////////////////////////////////////////
+double LambertExponentialSinusoid::SolveTransferParameter(const TransferGeometry& geometry, int numRevolutions)
+{
+    if (numRevolutions == 0)
+    {
+        return SolveTransferParameterSpecialized<true>(geometry, numRevolutions);
+    }
+    return SolveTransferParameterSpecialized<false>(geometry, numRevolutions);
+}
 
-    double logt   = log(tof);
+////////////////////////////////////////////////////////////
+template<bool ZeroRevolution>
+double LambertExponentialSinusoid::SolveTransferParameterSpecialized(const TransferGeometry& geometry, int numRevolutions)
+{
+    double x1, x2, y1, y2;
+    InitializeSecant(geometry, ZeroRevolution ? 0 : numRevolutions, x1, x2, y1, y2);
+    return IterateSecantSpecialized<double, ZeroRevolution>(geometry, numRevolutions, x1, x2, y1, y2, nullptr, MATH_TOLERANCE);
+}
 
-    double y1 = CalculateTimeOfFlight(input1, s, c, longway, numRevolutions);
-    double y2 = CalculateTimeOfFlight(input2, s, c, longway, numRevolutions);
-    y1 = log(y1) - logt;
-    y2 = log(y2) - logt;
+////////////////////////////////////////////////////////////
+double LambertExponentialSinusoid::IterateSecant(const TransferGeometry& geometry, int numRevolutions,
+                                                 double x1, double x2, double y1, double y2,
+                                                 LambertSolverState* state, double tolerance)
+{
+    if (numRevolutions == 0)
+    {
+        return IterateSecantSpecialized<double, true>(geometry, numRevolutions, x1, x2, y1, y2, state, tolerance);
+    }
+    return IterateSecantSpecialized<double, false>(geometry, numRevolutions, x1, x2, y1, y2, state, tolerance);
+}
 
-    // Newton-Raphson iteration
-    double error = 1.0;
+////////////////////////////////////////////////////////////
+template<typename Real, bool ZeroRevolution>
+double LambertExponentialSinusoid::IterateSecantSpecialized(const TransferGeometry& geometry, int numRevolutions,
+                                                            Real x1, Real x2, Real y1, Real y2,
+                                                            LambertSolverState* state, double tolerance)
+{
+    typedef RevolutionMapping<Real, ZeroRevolution> Mapping;
+    const int revolutions = (ZeroRevolution ? 0 : numRevolutions);
+    const Real s = static_cast<Real>(geometry.s);
+    const Real c = static_cast<Real>(geometry.c);
+    const Real logt = static_cast<Real>(geometry.logt);
+    const Real tof = static_cast<Real>(geometry.tof);
+
+    // Secant iteration
+    Real error = Real(1);
     int iteration = 0;
-    double xnew, ynew, x = 0.0;
-    while (error > MATH_TOLERANCE && iteration < 60)
+    Real xnew, ynew, x = Mapping::ToTransferParameter(x2);
+    while (error > tolerance && iteration < MAX_ITERATIONS && y2 != y1)
     {
         xnew = (x1*y2 - y1*x2) / (y2 - y1);
-        if (numRevolutions == 0)
-        {
-            x = exp(xnew) - 1.0;
-        }
-        else
+        x = Mapping::ToTransferParameter(xnew);
+        ynew = Mapping::Residual(CalculateTimeOfFlight(x, s, c, geometry.longway, revolutions), logt, tof);
+
+        x1 = x2;    x2 = xnew;
+        y1 = y2;    y2 = ynew;
+
+        error = std::abs(x1 - xnew);
+        iteration++;
+    }
+
+    if (state)
+    {
+        state->x = x;
+        state->slope = (x2 != x1) ? (y2 - y1) / (x2 - x1) : 0.0;
+        state->iterations = iteration;
+        state->valid = (error <= tolerance || y2 == y1);
+    }
+
+    return x;
+}
+
+// Explicit instantiations for LambertExponentialSinusoidSingleRev
+template double LambertExponentialSinusoid::SolveTransferParameterSpecialized<true>(const TransferGeometry&, int);
+template double LambertExponentialSinusoid::SolveTransferParameterSpecialized<false>(const TransferGeometry&, int);
+
+////////////////////////////////////////////////////////////
+double LambertExponentialSinusoid::SolveTransferParameterSingle(const TransferGeometry& geometry, int numRevolutions, double tolerance)
+{
+    const double minimumTolerance = 4.0 * std::numeric_limits<float>::epsilon();
+    const double singleTolerance = std::max(tolerance, minimumTolerance);
+
+    float x1, x2, y1, y2;
+    InitializeSecant(geometry, numRevolutions, x1, x2, y1, y2);
+    if (numRevolutions == 0)
+    {
+        return IterateSecantSpecialized<float, true>(geometry, numRevolutions, x1, x2, y1, y2, nullptr, singleTolerance);
+    }
+    return IterateSecantSpecialized<float, false>(geometry, numRevolutions, x1, x2, y1, y2, nullptr, singleTolerance);
+}
+
+////////////////////////////////////////////////////////////
+double LambertExponentialSinusoid::CalculateMinimumTimeOfFlight(const TransferGeometry& geometry, int numRevolutions, double& xMin)
+{
+    // The derivatives are expressed in terms of the time of flight scaled by sqrt(2 / s^3)
+    const double scale = sqrt(2.0 / (geometry.s * geometry.s * geometry.s));
+
+    // Halley iterations on dT/dx = 0 starting from the minimum energy transfer
+    double x = 0.0;
+    double T = scale * CalculateTimeOfFlight(x, geometry.s, geometry.c, geometry.longway, numRevolutions);
+    double dT, ddT, dddT;
+    for (int iteration = 0; iteration < MAX_MINIMUM_ITERATIONS; ++iteration)
+    {
+        CalculateTimeOfFlightDerivatives(geometry.lambda, x, T, dT, ddT, dddT);
+        double xNew = x - dT * ddT / (ddT * ddT - 0.5 * dT * dddT);
+        double error = std::abs(xNew - x);
+        x = xNew;
+        T = scale * CalculateTimeOfFlight(x, geometry.s, geometry.c, geometry.longway, numRevolutions);
+        if (error < 1.0e-13)
         {
-            x = 2.0 * MATH_1_OVER_PI * atan(xnew);
+            break;
         }
+    }
+
+    xMin = x;
+    return T / scale;
+}
+
+////////////////////////////////////////////////////////////
+double LambertExponentialSinusoid::SolveMultiRevBranch(const TransferGeometry& geometry, int numRevolutions, double xMin, bool leftBranch)
+{
+    const double scale = sqrt(2.0 / (geometry.s * geometry.s * geometry.s));
+    const double targetT = scale * geometry.tof;
 
-        ynew = CalculateTimeOfFlight(x, s, c, longway, numRevolutions);
+    // Bracket of the branch and Izzo's initial guess
+    double lower, upper, tmp;
+    if (leftBranch)
+    {
+        lower = -1.0;
+        upper = xMin;
+        tmp = pow((numRevolutions * MATH_PI + MATH_PI) / (8.0 * targetT), 2.0 / 3.0);
+    }
+    else
+    {
+        lower = xMin;
+        upper = 1.0;
+        tmp = pow((8.0 * targetT) / (numRevolutions * MATH_PI), 2.0 / 3.0);
+    }
+    double x = (tmp - 1.0) / (tmp + 1.0);
+    if (x <= lower || x >= upper)
+    {
+        x = 0.5 * (lower + upper);
+    }
 
-        if (numRevolutions == 0)
+    double dT, ddT, dddT;
+    for (int iteration = 0; iteration < MAX_ITERATIONS; ++iteration)
+    {
+        double T = scale * CalculateTimeOfFlight(x, geometry.s, geometry.c, geometry.longway, numRevolutions);
+        double delta = T - targetT;
+
+        // The time of flight decreases along the left branch and increases along the right branch
+        if ((delta > 0.0) == leftBranch)
         {
-            ynew = log(ynew) - logt;
+            lower = x;
         }
         else
         {
-            ynew = ynew - tof;
+            upper = x;
         }
 
-        x1 = x2;    x2 = xnew;
-        y1 = y2;    y2 = ynew;
+        // Householder update, falling back to bisection if it leaves the bracket
+        CalculateTimeOfFlightDerivatives(geometry.lambda, x, T, dT, ddT, dddT);
+        double dT2 = dT * dT;
+        double xNew = x - delta * (dT2 - 0.5 * delta * ddT) /
+                      (dT * (dT2 - delta * ddT) + dddT * delta * delta / 6.0);
+        if (!(xNew > lower && xNew < upper))
+        {
+            xNew = 0.5 * (lower + upper);
+        }
 
-        error = std::abs(x1 - xnew);
-        iteration++;
+        double error = std::abs(xNew - x);
+        x = xNew;
+        if (error < MATH_TOLERANCE)
+        {
+            break;
+        }
     }
 
+    return x;
+}
+
+////////////////////////////////////////////////////////////
+void LambertExponentialSinusoid::ComputeVelocities(const TransferGeometry& geometry, double x,
+                                                   Vector3d& initialVelocity, Vector3d& finalVelocity)
+{
+    const double s = geometry.s;
+    const double c = geometry.c;
+    const double aMin = geometry.aMin;
+    const double lambda = geometry.lambda;
+    const double r2 = geometry.r2;
+    const int longway = geometry.longway;
+
     double a = aMin / (1.0 - x*x);
 
     double alpha, beta, sinpsi, sinhpsi, eta, eta2;
@@ -155,74 +728,45 @@ void LambertExponentialSinusoid::Evaluate(const Vector3d& initialPosition,
         eta     = sqrt(eta2);
     }
 
-    Vector3d Ih = (longway / crossR1R2) * CrossR1R2; 
-    Vector3d R2u = R2.normalized();
-
-    Vector3d CrossIhR1 = Ih.cross(R1);
-    Vector3d CrossIhR2u = Ih.cross(R2u);
-
-    double sinHalfTheta = sin(0.5 * trueAnomaly);
+    const double sinHalfTheta = geometry.sinHalfTheta;
 
     // Radial and tangential departure velocity
-    double vr1 = (1.0 / eta / sqrt(aMin)) * ((2.0 * lambda * aMin) - lambda - (x * eta));
+    double vr1 = (1.0 / eta / geometry.sqrtAMin) * ((2.0 * lambda * aMin) - lambda - (x * eta));
     double vt1 = sqrt((r2 / aMin / eta2) * (sinHalfTheta * sinHalfTheta));
 
     // Radial and tangential arrival velocity
     double vt2 = vt1 / r2;
-    double vr2 = (vt1 - vt2) / tan(0.5 * trueAnomaly) - vr1;
+    double vr2 = (vt1 - vt2) / geometry.tanHalfTheta - vr1;
 
     // Velocity vectors
-    initialVelocity = (vr1 * R1)  + (vt1 * CrossIhR1);
-    finalVelocity =   (vr2 * R2u) + (vt2 * CrossIhR2u);
+    initialVelocity = (vr1 * geometry.R1)  + (vt1 * geometry.CrossIhR1);
+    finalVelocity =   (vr2 * geometry.R2u) + (vt2 * geometry.CrossIhR2u);
 
     // Convert back to dimensional units
-    initialVelocity *= VU;
-    finalVelocity *= VU;
+    initialVelocity *= geometry.VU;
+    finalVelocity *= geometry.VU;
 }
 
 ////////////////////////////////////////////////////////////
-void LambertExponentialSinusoid::EvaluateAll(const Vector3d& initialPosition,
-                                             const Vector3d& finalPosition,
-                                             const Time& timeDelta,
-                                             const Orbit::Direction& orbitDirection,
-                                             int maxRevolutions,
-                                             double mu,
-                                             std::vector<Vector3d>& initialVelocities,
-                                             std::vector<Vector3d>& finalVelocities)
+template<typename Real>
+Real LambertExponentialSinusoid::CalculateTimeOfFlight(Real x, Real s, Real c, int longway, int maxRevolutions)
 {
-   if (maxRevolutions < 0)
-   {
-      OTL_ERROR() << "Max number of revolutions must be greater or equal than zero";
-      return;
-   }
+    Real timeOfFlight = Real(0);
 
-   initialVelocities.resize(maxRevolutions + 1);
-   finalVelocities.resize(maxRevolutions + 1);
-   for (int i = 0; i <= maxRevolutions; ++i)
-   {
-      Evaluate(initialPosition, finalPosition, timeDelta, orbitDirection, i, mu, initialVelocities[i], finalVelocities[i]);
-   }
-}
+    Real a = Real(0.5)*s / (Real(1) - x*x);
 
-////////////////////////////////////////////////////////////
-double LambertExponentialSinusoid::CalculateTimeOfFlight(double x, double s, double c, int longway, int maxRevolutions)
-{
-    double timeOfFlight = 0.0;
-
-    double a = 0.5*s / (1.0 - x*x);
-    
-    double alpha, beta;   
-    if (x < 1.0) // ellipse
+    Real alpha, beta;
+    if (x < Real(1)) // ellipse
     {
-        alpha = 2.0*acos(x);
-        beta  = 2.0*longway*asin(sqrt(0.5*(s - c) / a));
-        timeOfFlight  = a*sqrt(a)*((alpha - sin(alpha)) - (beta - sin(beta)) + MATH_2_PI * maxRevolutions); 
+        alpha = Real(2)*std::acos(x);
+        beta  = Real(2)*longway*std::asin(std::sqrt(Real(0.5)*(s - c) / a));
+        timeOfFlight  = a*std::sqrt(a)*((alpha - std::sin(alpha)) - (beta - std::sin(beta)) + static_cast<Real>(MATH_2_PI) * maxRevolutions);
     }
     else // hyperbola
     {
-        alpha = 2.0*acosh(x);
-        beta  = 2.0*longway*asinh(sqrt(-0.5*(s - c) / a));
-        timeOfFlight  = -a*sqrt(-a)*((sinh(alpha) - alpha) - (sinh(beta) - beta));
+        alpha = Real(2)*std::acosh(x);
+        beta  = Real(2)*longway*std::asinh(std::sqrt(Real(-0.5)*(s - c) / a));
+        timeOfFlight  = -a*std::sqrt(-a)*((std::sinh(alpha) - alpha) - (std::sinh(beta) - beta));
     }
 
     return timeOfFlight;
@@ -0,0 +1,64 @@
+////////////////////////////////////////////////////////////
+//
+// OTL - Orbital Trajectory Library
+// Copyright (C) 2013-2018 Jason Bryan (Jmbryan10@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#include <OTL/Core/LambertExponentialSinusoidSingleRev.h>
+#include <OTL/Core/Logger.h>
+
+namespace otl
+{
+
+namespace keplerian
+{
+
+////////////////////////////////////////////////////////////
+void LambertExponentialSinusoidSingleRev::Evaluate(const Vector3d& initialPosition,
+                                                   const Vector3d& finalPosition,
+                                                   const Time& timeDelta,
+                                                   const Orbit::Direction& orbitDirection,
+                                                   int numRevolutions,
+                                                   double mu,
+                                                   Vector3d& initialVelocity,
+                                                   Vector3d& finalVelocity)
+{
+    if (numRevolutions != 0)
+    {
+        LambertExponentialSinusoid::Evaluate(initialPosition, finalPosition, timeDelta, orbitDirection, numRevolutions, mu, initialVelocity, finalVelocity);
+        return;
+    }
+
+    double seconds = timeDelta.Seconds();
+    OTL_ASSERT(seconds >= 0.0);
+
+    TransferGeometry geometry;
+    ComputeTransferGeometry(initialPosition, finalPosition, seconds, orbitDirection, mu, geometry);
+
+    double x = SolveTransferParameterSpecialized<true>(geometry, 0);
+
+    ComputeVelocities(geometry, x, initialVelocity, finalVelocity);
+}
+
+} // namespace keplerian
+
+} // namespace otl
@@ -0,0 +1,485 @@
+////////////////////////////////////////////////////////////
+//
+// OTL - Orbital Trajectory Library
+// Copyright (C) 2013-2018 Jason Bryan (Jmbryan10@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#include <OTL/Core/LambertHouseholder.h>
+#include <OTL/Core/Logger.h>
+#include <limits>
+
+namespace otl
+{
+
+namespace keplerian
+{
+
+// Maximum number of Householder iterations
+static const int MAX_ITERATIONS = 15;
+
+// Convergence tolerance on x for zero and multiple revolution solutions
+static const double ZERO_REV_TOLERANCE = 1.0e-5;
+static const double MULTI_REV_TOLERANCE = 1.0e-8;
+
+// Distances of x from one at which the time of flight expressions are switched
+static const double BATTIN_DISTANCE = 0.01;
+static const double LAGRANGE_DISTANCE = 0.2;
+
+// Natural logarithm of two
+static const double LN2 = 0.69314718055994529;
+
+////////////////////////////////////////////////////////////
+void LambertHouseholder::Evaluate(const Vector3d& initialPosition,
+                                  const Vector3d& finalPosition,
+                                  const Time& timeDelta,
+                                  const Orbit::Direction& orbitDirection,
+                                  int numRevolutions,
+                                  double mu,
+                                  Vector3d& initialVelocity,
+                                  Vector3d& finalVelocity)
+{
+   double seconds = timeDelta.Seconds();
+   OTL_ASSERT(seconds >= 0.0);
+
+   TransferGeometry geometry;
+   ComputeTransferGeometry(initialPosition, finalPosition, seconds, orbitDirection, mu, geometry);
+
+   double x;
+   int iterations;
+   if (numRevolutions == 0)
+   {
+      x = SolveHouseholder(geometry.lambda, geometry.T, CalculateInitialGuess(geometry.lambda, geometry.T), 0, ZERO_REV_TOLERANCE, iterations);
+   }
+   else
+   {
+      if (numRevolutions > CalculateMaxRevolutions(geometry.lambda, geometry.T))
+      {
+         OTL_WARN() << "Time of flight is too short to perform " << Bracket(numRevolutions) << " revolutions";
+         initialVelocity.setConstant(std::numeric_limits<double>::quiet_NaN());
+         finalVelocity.setConstant(std::numeric_limits<double>::quiet_NaN());
+         return;
+      }
+      x = SolveHouseholder(geometry.lambda, geometry.T, CalculateInitialGuess(geometry.T, numRevolutions, true), numRevolutions, MULTI_REV_TOLERANCE, iterations);
+   }
+
+   ComputeVelocities(geometry, x, initialVelocity, finalVelocity);
+}
+
+////////////////////////////////////////////////////////////
+void LambertHouseholder::EvaluateAll(const Vector3d& initialPosition,
+                                     const Vector3d& finalPosition,
+                                     const Time& timeDelta,
+                                     const Orbit::Direction& orbitDirection,
+                                     int maxRevolutions,
+                                     double mu,
+                                     std::vector<Vector3d>& initialVelocities,
+                                     std::vector<Vector3d>& finalVelocities)
+{
+   if (maxRevolutions < 0)
+   {
+      OTL_ERROR() << "Max number of revolutions must be greater or equal than zero";
+      return;
+   }
+
+   double seconds = timeDelta.Seconds();
+   OTL_ASSERT(seconds >= 0.0);
+
+   TransferGeometry geometry;
+   ComputeTransferGeometry(initialPosition, finalPosition, seconds, orbitDirection, mu, geometry);
+
+   const int numRevolutions = std::min(maxRevolutions, CalculateMaxRevolutions(geometry.lambda, geometry.T));
+   int iterations;
+   initialVelocities.resize(2 * numRevolutions + 1);
+   finalVelocities.resize(2 * numRevolutions + 1);
+
+   double x = SolveHouseholder(geometry.lambda, geometry.T, CalculateInitialGuess(geometry.lambda, geometry.T), 0, ZERO_REV_TOLERANCE, iterations);
+   ComputeVelocities(geometry, x, initialVelocities[0], finalVelocities[0]);
+
+   for (int i = 1; i <= numRevolutions; ++i)
+   {
+      double xLeft = SolveHouseholder(geometry.lambda, geometry.T, CalculateInitialGuess(geometry.T, i, true), i, MULTI_REV_TOLERANCE, iterations);
+      double xRight = SolveHouseholder(geometry.lambda, geometry.T, CalculateInitialGuess(geometry.T, i, false), i, MULTI_REV_TOLERANCE, iterations);
+
+      // Semimajor axis grows with |x|, so the long period solution has the larger |x|
+      if (std::abs(xLeft) < std::abs(xRight))
+      {
+         std::swap(xLeft, xRight);
+      }
+      ComputeVelocities(geometry, xLeft, initialVelocities[2 * i - 1], finalVelocities[2 * i - 1]);
+      ComputeVelocities(geometry, xRight, initialVelocities[2 * i], finalVelocities[2 * i]);
+   }
+}
+
+////////////////////////////////////////////////////////////
+void LambertHouseholder::EvaluateWarmStart(const Vector3d& initialPosition,
+                                           const Vector3d& finalPosition,
+                                           const Time& timeDelta,
+                                           const Orbit::Direction& orbitDirection,
+                                           int numRevolutions,
+                                           double mu,
+                                           LambertSolverState& state,
+                                           Vector3d& initialVelocity,
+                                           Vector3d& finalVelocity)
+{
+   double seconds = timeDelta.Seconds();
+   OTL_ASSERT(seconds >= 0.0);
+
+   TransferGeometry geometry;
+   ComputeTransferGeometry(initialPosition, finalPosition, seconds, orbitDirection, mu, geometry);
+
+   // Sweeps meet many infeasible transfers, which are left to the caller to report
+   if (numRevolutions > 0 && numRevolutions > CalculateMaxRevolutions(geometry.lambda, geometry.T))
+   {
+      initialVelocity.setConstant(std::numeric_limits<double>::quiet_NaN());
+      finalVelocity.setConstant(std::numeric_limits<double>::quiet_NaN());
+      state.valid = false;
+      return;
+   }
+
+   double x0;
+   if (state.valid && state.numRevolutions == numRevolutions)
+   {
+      x0 = state.x;
+   }
+   else if (numRevolutions == 0)
+   {
+      x0 = CalculateInitialGuess(geometry.lambda, geometry.T);
+   }
+   else
+   {
+      x0 = CalculateInitialGuess(geometry.T, numRevolutions, true);
+   }
+
+   const double tolerance = (numRevolutions == 0 ? ZERO_REV_TOLERANCE : MULTI_REV_TOLERANCE);
+   state.x = SolveHouseholder(geometry.lambda, geometry.T, x0, numRevolutions, tolerance, state.iterations, &state.valid);
+   state.slope = 0.0;
+   state.numRevolutions = numRevolutions;
+
+   ComputeVelocities(geometry, state.x, initialVelocity, finalVelocity);
+}
+
+////////////////////////////////////////////////////////////
+void LambertHouseholder::EvaluateScreening(const Vector3d& initialPosition,
+                                           const Vector3d& finalPosition,
+                                           const Time& timeDelta,
+                                           const Orbit::Direction& orbitDirection,
+                                           int numRevolutions,
+                                           double mu,
+                                           SolverAccuracy accuracy,
+                                           double tolerance,
+                                           Vector3d& initialVelocity,
+                                           Vector3d& finalVelocity)
+{
+   if (accuracy == SolverAccuracy::Full)
+   {
+      Evaluate(initialPosition, finalPosition, timeDelta, orbitDirection, numRevolutions, mu, initialVelocity, finalVelocity);
+      return;
+   }
+
+   double seconds = timeDelta.Seconds();
+   OTL_ASSERT(seconds >= 0.0);
+
+   TransferGeometry geometry;
+   ComputeTransferGeometry(initialPosition, finalPosition, seconds, orbitDirection, mu, geometry);
+
+   double x0;
+   if (numRevolutions == 0)
+   {
+      x0 = CalculateInitialGuess(geometry.lambda, geometry.T);
+   }
+   else
+   {
+      if (numRevolutions > CalculateMaxRevolutions(geometry.lambda, geometry.T))
+      {
+         OTL_WARN() << "Time of flight is too short to perform " << Bracket(numRevolutions) << " revolutions";
+         initialVelocity.setConstant(std::numeric_limits<double>::quiet_NaN());
+         finalVelocity.setConstant(std::numeric_limits<double>::quiet_NaN());
+         return;
+      }
+      x0 = CalculateInitialGuess(geometry.T, numRevolutions, true);
+   }
+
+   int iterations;
+   double x = SolveHouseholder(geometry.lambda, geometry.T, x0, numRevolutions, tolerance, iterations);
+
+   ComputeVelocities(geometry, x, initialVelocity, finalVelocity);
+}
+
+////////////////////////////////////////////////////////////
+void LambertHouseholder::ComputeTransferGeometry(const Vector3d& initialPosition,
+                                                 const Vector3d& finalPosition,
+                                                 double seconds,
+                                                 const Orbit::Direction& orbitDirection,
+                                                 double mu,
+                                                 TransferGeometry& geometry)
+{
+   const double r1 = initialPosition.norm();
+   const double r2 = finalPosition.norm();
+   const double c = (finalPosition - initialPosition).norm();
+   const double s = 0.5 * (r1 + r2 + c);
+
+   const Vector3d ir1 = initialPosition / r1;
+   const Vector3d ir2 = finalPosition / r2;
+   const Vector3d ih = ir1.cross(ir2).normalized();
+
+   double lambda = sqrt(1.0 - c / s);
+   Vector3d it1, it2;
+
+   // Direction of travel
+   bool longway = (orbitDirection == Orbit::Direction::Prograde && ih.z() <= 0.0) ||
+                  (orbitDirection == Orbit::Direction::Retrograde && ih.z() >= 0.0);
+   if (ih.z() <= 0.0)
+   {
+      it1 = ir1.cross(ih);
+      it2 = ir2.cross(ih);
+   }
+   else
+   {
+      it1 = ih.cross(ir1);
+      it2 = ih.cross(ir2);
+   }
+   if (orbitDirection == Orbit::Direction::Retrograde)
+   {
+      it1 = -it1;
+      it2 = -it2;
+   }
+   if (longway)
+   {
+      lambda = -lambda;
+   }
+
+   geometry.lambda = lambda;
+   geometry.T      = sqrt(2.0 * mu / (s * s * s)) * seconds;
+   geometry.gamma  = sqrt(0.5 * mu * s);
+   geometry.rho    = (r1 - r2) / c;
+   geometry.sigma  = sqrt(1.0 - geometry.rho * geometry.rho);
+   geometry.r1     = r1;
+   geometry.r2     = r2;
+   geometry.ir1    = ir1;
+   geometry.ir2    = ir2;
+   geometry.it1    = it1.normalized();
+   geometry.it2    = it2.normalized();
+}
+
+////////////////////////////////////////////////////////////
+int LambertHouseholder::CalculateMaxRevolutions(double lambda, double T)
+{
+   int maxRevolutions = static_cast<int>(T / MATH_PI);
+   if (maxRevolutions == 0)
+   {
+      return 0;
+   }
+
+   const double lambda2 = lambda * lambda;
+   const double T00 = acos(lambda) + lambda * sqrt(1.0 - lambda2);
+   const double T0 = T00 + maxRevolutions * MATH_PI;
+
+   // The minimum time of flight of the last revolution count is only
+   // larger than T if T falls below T0 = T(x=0)
+   if (T < T0)
+   {
+      double xOld = 0.0, xNew = 0.0;
+      double Tmin = T0;
+      double dT, ddT, dddT;
+      for (int iteration = 0; iteration <= 12; ++iteration)
+      {
+         // Halley iteration on dT/dx = 0
+         CalculateTimeOfFlightDerivatives(lambda, xOld, Tmin, dT, ddT, dddT);
+         if (dT != 0.0)
+         {
+            xNew = xOld - dT * ddT / (ddT * ddT - 0.5 * dT * dddT);
+         }
+         if (std::abs(xOld - xNew) < 1.0e-13)
+         {
+            break;
+         }
+         Tmin = CalculateTimeOfFlight(lambda, xNew, maxRevolutions);
+         xOld = xNew;
+      }
+      if (Tmin > T)
+      {
+         maxRevolutions -= 1;
+      }
+   }
+
+   return maxRevolutions;
+}
+
+////////////////////////////////////////////////////////////
+double LambertHouseholder::SolveHouseholder(double lambda, double T, double x0, int numRevolutions, double tolerance, int& iterations, bool* converged)
+{
+   double error = 1.0;
+   double x = x0;
+   double dT, ddT, dddT;
+   for (iterations = 0; error > tolerance && iterations < MAX_ITERATIONS; ++iterations)
+   {
+      double tof = CalculateTimeOfFlight(lambda, x, numRevolutions);
+      CalculateTimeOfFlightDerivatives(lambda, x, tof, dT, ddT, dddT);
+
+      double delta = tof - T;
+      double dT2 = dT * dT;
+      double xNew = x - delta * (dT2 - 0.5 * delta * ddT) /
+                    (dT * (dT2 - delta * ddT) + dddT * delta * delta / 6.0);
+
+      error = std::abs(x - xNew);
+      x = xNew;
+   }
+
+   // A NaN step also ends the loop, but never compares within the tolerance
+   if (converged)
+   {
+      *converged = (error <= tolerance);
+   }
+   return x;
+}
+
+////////////////////////////////////////////////////////////
+double LambertHouseholder::CalculateInitialGuess(double lambda, double T)
+{
+   const double lambda2 = lambda * lambda;
+   const double lambda3 = lambda * lambda2;
+   const double T0 = acos(lambda) + lambda * sqrt(1.0 - lambda2);
+   const double T1 = 2.0 / 3.0 * (1.0 - lambda3);
+
+   if (T >= T0)
+   {
+      return -(T - T0) / (T - T0 + 4.0);
+   }
+   else if (T <= T1)
+   {
+      return T1 * (T1 - T) / (0.4 * (1.0 - lambda2 * lambda3) * T) + 1.0;
+   }
+   return pow(T / T0, LN2 / log(T1 / T0)) - 1.0;
+}
+
+////////////////////////////////////////////////////////////
+double LambertHouseholder::CalculateInitialGuess(double T, int numRevolutions, bool leftBranch)
+{
+   double tmp;
+   if (leftBranch)
+   {
+      tmp = pow((numRevolutions * MATH_PI + MATH_PI) / (8.0 * T), 2.0 / 3.0);
+   }
+   else
+   {
+      tmp = pow((8.0 * T) / (numRevolutions * MATH_PI), 2.0 / 3.0);
+   }
+   return (tmp - 1.0) / (tmp + 1.0);
+}
+
+////////////////////////////////////////////////////////////
+double LambertHouseholder::CalculateTimeOfFlight(double lambda, double x, int numRevolutions)
+{
+   const double distance = std::abs(x - 1.0);
+   if (distance < LAGRANGE_DISTANCE && distance > BATTIN_DISTANCE)
+   {
+      return CalculateTimeOfFlightLagrange(lambda, x, numRevolutions);
+   }
+
+   const double K = lambda * lambda;
+   const double E = x * x - 1.0;
+   const double rho = std::abs(E);
+   const double z = sqrt(1.0 + K * E);
+
+   if (distance < BATTIN_DISTANCE)
+   {
+      // Battin's series expansion of the hypergeometric function
+      const double eta = z - lambda * x;
+      const double S1 = 0.5 * (1.0 - lambda - x * eta);
+
+      double Sj = 1.0, Cj = 1.0, error = 1.0;
+      for (int j = 0; error > 1.0e-11; ++j)
+      {
+         Cj = Cj * (3.0 + j) * (1.0 + j) / (2.5 + j) * S1 / (j + 1);
+         Sj += Cj;
+         error = std::abs(Cj);
+      }
+      const double Q = 4.0 / 3.0 * Sj;
+
+      return 0.5 * (eta * eta * eta * Q + 4.0 * lambda * eta) + numRevolutions * MATH_PI / pow(rho, 1.5);
+   }
+
+   // Lancaster's expression
+   const double y = sqrt(rho);
+   const double g = x * z - lambda * E;
+   double d;
+   if (E < 0.0)
+   {
+      d = numRevolutions * MATH_PI + acos(g);
+   }
+   else
+   {
+      const double f = y * (z - lambda * x);
+      d = log(f + g);
+   }
+   return (x - lambda * z - d / y) / E;
+}
+
+////////////////////////////////////////////////////////////
+double LambertHouseholder::CalculateTimeOfFlightLagrange(double lambda, double x, int numRevolutions)
+{
+   const double a = 1.0 / (1.0 - x * x);
+   double alpha, beta;
+   if (a > 0.0) // ellipse
+   {
+      alpha = 2.0 * acos(x);
+      beta = 2.0 * asin(sqrt(lambda * lambda / a));
+      if (lambda < 0.0)
+      {
+         beta = -beta;
+      }
+      return 0.5 * a * sqrt(a) * ((alpha - sin(alpha)) - (beta - sin(beta)) + MATH_2_PI * numRevolutions);
+   }
+   else // hyperbola
+   {
+      alpha = 2.0 * acosh(x);
+      beta = 2.0 * asinh(sqrt(-lambda * lambda / a));
+      if (lambda < 0.0)
+      {
+         beta = -beta;
+      }
+      return -0.5 * a * sqrt(-a) * ((beta - sinh(beta)) - (alpha - sinh(alpha)));
+   }
+}
+
+////////////////////////////////////////////////////////////
+void LambertHouseholder::ComputeVelocities(const TransferGeometry& geometry, double x,
+                                           Vector3d& initialVelocity, Vector3d& finalVelocity)
+{
+   const double lambda = geometry.lambda;
+   const double y = sqrt(1.0 - lambda * lambda + lambda * lambda * x * x);
+
+   // Radial and tangential departure and arrival velocity
+   const double vr1 =  geometry.gamma * ((lambda * y - x) - geometry.rho * (lambda * y + x)) / geometry.r1;
+   const double vr2 = -geometry.gamma * ((lambda * y - x) + geometry.rho * (lambda * y + x)) / geometry.r2;
+   const double vt  =  geometry.gamma * geometry.sigma * (y + lambda * x);
+   const double vt1 = vt / geometry.r1;
+   const double vt2 = vt / geometry.r2;
+
+   // Velocity vectors
+   initialVelocity = (vr1 * geometry.ir1) + (vt1 * geometry.it1);
+   finalVelocity   = (vr2 * geometry.ir2) + (vt2 * geometry.it2);
+}
+
+} // namespace keplerian
+
+} // namespace otl
@@ -6,6 +6,7 @@
    #include <OTL/Core/Spdlog/LoggerImpl.h>
 #endif
 #include <OTL/Core/System.h>
+#include <mutex>
 
 namespace otl
 {
@@ -44,13 +45,25 @@ m_initialized(false),
 m_logLevel(LogLevel::Info)
 {
     std::string currentDirectory = gSystem.GetCurrentDirectory();
-    m_logDirectory = currentDirectory + "\\logs";
+    m_logDirectory = currentDirectory + "/logs";
 
     m_logFilename = "otl_log";
     m_maxFileSize = 10 * 1024 * 1024;
     m_numRotatingFiles = 5; 
 }
 
+////////////////////////////////////////////////////////////
+Logger::Logger(const Logger& other) :
+m_initialized(other.m_initialized.load()),
+m_logLevel(other.m_logLevel),
+m_logDirectory(other.m_logDirectory),
+m_logFilename(other.m_logFilename),
+m_maxFileSize(other.m_maxFileSize),
+m_numRotatingFiles(other.m_numRotatingFiles)
+{
+
+}
+
 ////////////////////////////////////////////////////////////
 Logger::~Logger()
 {
@@ -60,56 +73,63 @@ Logger::~Logger()
 ////////////////////////////////////////////////////////////
 void Logger::Initialize()
 {
+   // Every log call comes through here, so skip the lock once initialized
+   if (m_initialized.load(std::memory_order_acquire))
+   {
+      return;
+   }
+
+   // Worker threads may emit the first log line concurrently
+   static std::mutex initializeMutex;
+   std::lock_guard<std::mutex> lock(initializeMutex);
+   if (m_initialized.load(std::memory_order_relaxed))
+   {
+      return;
+   }
    gSystem.CreateDirectory(m_logDirectory);
    VInitialize();
-   m_initialized = true;
+   m_initialized.store(true, std::memory_order_release);
 }
 
 ////////////////////////////////////////////////////////////
 void Logger::Log(const std::string& message, const LogLevel& logLevel)
 {
-    if (!m_initialized)
-        Initialize();
+    Initialize();
     VLog(message, logLevel);
 }
 
 ////////////////////////////////////////////////////////////
 LineLogger Logger::Debug()
 {
-   if (!m_initialized)
-      Initialize();
+   Initialize();
    return LineLogger(std::make_shared<Logger>(*this), LogLevel::Debug);
 }
 
 ////////////////////////////////////////////////////////////
 LineLogger Logger::Info()
 {
-    if (!m_initialized)
-        Initialize();
+    Initialize();
     return LineLogger(std::make_shared<Logger>(*this), LogLevel::Info);
 }
 
 ////////////////////////////////////////////////////////////
 LineLogger Logger::Warn()
 {
-    if (!m_initialized)
-        Initialize();
+    Initialize();
     return LineLogger(std::make_shared<Logger>(*this), LogLevel::Warning);
 }
 
 ////////////////////////////////////////////////////////////
 LineLogger Logger::Error()
 {
-    if (!m_initialized)
-        Initialize();
+    Initialize();
     return LineLogger(std::make_shared<Logger>(*this), LogLevel::Error);
 }
 
 ////////////////////////////////////////////////////////////
 LineLogger Logger::Fatal()
 {
-    if (!m_initialized)
-        Initialize();
+    Initialize();
     return LineLogger(std::make_shared<Logger>(*this), LogLevel::Fatal);
 }
 
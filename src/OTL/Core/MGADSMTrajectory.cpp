@@ -25,6 +25,10 @@
 #include <OTL/Core/MGADSMTrajectory.h>
 #include <OTL/Core/KeplerianPropagator.h>
 #include <OTL/Core/LambertExponentialSinusoid.h>
+#include <OTL/Core/LambertExponentialSinusoidSingleRev.h>
+#include <OTL/Core/LambertCache.h>
+#include <OTL/Core/LambertHouseholder.h>
+#include <OTL/Core/RungeKuttaPropagator.h>
 #include <OTL/Core/UnpoweredFlyby.h>
 #include <OTL/Core/Conversion.h>
 //#include <OTL/Core/KeplersEquations.hpp>
@@ -55,6 +59,8 @@ MGADSMTrajectory::MGADSMTrajectory() :
 m_numNodes(0),
 m_numStates(0),
 m_legsInitialized(false),
+m_lambertCacheCapacity(0),
+m_lambertCacheResolution(1.0e-9),
 m_initialEpoch(Epoch()),
 m_finalEpoch(Epoch()),
 m_initialStateVector(),
@@ -69,6 +75,8 @@ MGADSMTrajectory::MGADSMTrajectory(const std::vector<TrajectoryNodePtr>& nodes)
 m_numNodes(0),
 m_numStates(0),
 m_legsInitialized(false),
+m_lambertCacheCapacity(0),
+m_lambertCacheResolution(1.0e-9),
 m_initialEpoch(Epoch()),
 m_finalEpoch(Epoch()),
 m_initialStateVector(),
@@ -398,6 +406,10 @@ void MGADSMTrajectory::SetPropagateType(PropagatorType type)
       //m_propagator = std::unique_ptr<otl::IPropagator>(new KeplerianPropagator());
       break;
 
+   case PropagatorType::RungeKutta:
+      m_propagator = std::make_shared<RungeKuttaPropagator>();
+      break;
+
    case PropagatorType::Invalid:
    default:
       OTL_ASSERT(false, "Can't set Propagate algorithm. Uknown or invalid type.");
@@ -414,11 +426,41 @@ void MGADSMTrajectory::SetLambertType(LambertType type)
          m_lambert = std::unique_ptr<ILambertAlgorithm>(new LambertExponentialSinusoid());
          break;
 
+      case LambertType::SingleRev:
+         m_lambert = std::unique_ptr<ILambertAlgorithm>(new LambertExponentialSinusoidSingleRev());
+         break;
+
+      case LambertType::Householder:
+         m_lambert = std::unique_ptr<ILambertAlgorithm>(new LambertHouseholder());
+         break;
+
       case LambertType::Invalid:
       default:
          OTL_ASSERT(false, "Can't set Lambert algorithm. Uknown or invalid type.");
          break;
    }
+
+   if (m_lambertCacheCapacity > 0)
+   {
+      m_lambert = std::make_shared<LambertCache>(m_lambert, m_lambertCacheCapacity, m_lambertCacheResolution);
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+void MGADSMTrajectory::SetLambertCache(std::size_t capacity, double resolution)
+{
+   // Unwrap any existing cache before applying the new settings
+   if (auto cache = std::dynamic_pointer_cast<LambertCache>(m_lambert))
+   {
+      m_lambert = cache->GetAlgorithm();
+   }
+
+   m_lambertCacheCapacity = capacity;
+   m_lambertCacheResolution = resolution;
+   if (m_lambertCacheCapacity > 0)
+   {
+      m_lambert = std::make_shared<LambertCache>(m_lambert, m_lambertCacheCapacity, m_lambertCacheResolution);
+   }
 }
 
 ///////////////////////////////////////////////////////////////////////////////////
@@ -461,6 +503,12 @@ int MGADSMTrajectory::GetNumStates() const
    return m_numStates;
 }
 
+///////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<const LambertCache> MGADSMTrajectory::GetLambertCache() const
+{
+   return std::dynamic_pointer_cast<const LambertCache>(m_lambert);
+}
+
 ///////////////////////////////////////////////////////////////////////////////////
 void MGADSMTrajectory::Init()
 {
@@ -471,7 +519,7 @@ void MGADSMTrajectory::Init()
 
    // Default algorithms
    //m_propagator = std::make_shared<KeplerianPropagator>();
-   m_lambert = std::make_shared<LambertExponentialSinusoid>();
+   m_lambert = std::make_shared<LambertExponentialSinusoidSingleRev>();
    m_flyby = std::make_shared<UnpoweredFlyby>();
 }
 
@@ -25,7 +25,10 @@
 #include <OTL/Core/Orbit.h>
 #include <OTL/Core/LagrangianPropagator.h>
 #include <OTL/Core/Conversion.h>
+#include <OTL/Core/KeplerSolver.h>
 #include <OTL/Core/Logger.h>
+#include <OTL/Core/Transformation.h>
+#include <limits>
 
 namespace otl
 {
@@ -33,6 +36,90 @@ namespace otl
 namespace keplerian
 {
 
+namespace
+{
+
+// Advancing the mean anomaly does not depend on any propagator state,
+// so every orbit shares a single instance instead of creating its own
+LagrangianPropagator& GetSharedPropagator()
+{
+   static LagrangianPropagator propagator;
+   return propagator;
+}
+
+// Computes the properties that depend only on the size and shape of the orbit
+void ComputeShapeProperties(double mu, const OrbitalElements& orbitalElements, Orbit::OrbitProperties& properties)
+{
+   const double a = orbitalElements.semiMajorAxis;
+   const double e = orbitalElements.eccentricity;
+
+   properties.type = ComputeOrbitType(e);
+   properties.meanMotion = sqrt(mu / std::abs(pow(a, 3.0)));
+   properties.period = (IsCircularOrElliptical(e) ? MATH_2_PI / properties.meanMotion : std::numeric_limits<double>::infinity());
+   properties.semiparameter = a * (1.0 - SQR(e));
+   properties.specificAngularMomentum = sqrt(mu * properties.semiparameter);
+}
+
+// Computes the properties that vary with the mean anomaly. Kepler's equation is
+// solved the same way as ConvertMeanAnomaly2TrueAnomaly() but the anomaly is kept.
+// Requires the shape properties to be up-to-date.
+void ComputeAnomalyProperties(const OrbitalElements& orbitalElements, Orbit::OrbitProperties& properties)
+{
+   const double e = orbitalElements.eccentricity;
+   const double M = orbitalElements.meanAnomaly;
+
+   if (IsCircularOrElliptical(e))
+   {
+      const KeplerSolution solution = KeplerSolverElliptical::Solve(e, M);
+      OTL_WARN_IF(!solution.IsConverged(), "Kepler's Equation did not converge for eccentricity " << Bracket(e));
+      properties.anomaly = solution.anomaly;
+      properties.trueAnomaly = ConvertEccentricAnomaly2TrueAnomaly(e, properties.anomaly);
+      properties.timeSincePerapsis = (M - MATH_2_PI * floor(M / MATH_2_PI)) / properties.meanMotion;
+   }
+   else
+   {
+      if (IsHyperbolic(e))
+      {
+         const KeplerSolution solution = KeplerSolverHyperbolic::Solve(e, M);
+         OTL_WARN_IF(!solution.IsConverged(), "Kepler's Equation did not converge for eccentricity " << Bracket(e));
+         properties.anomaly = solution.anomaly;
+         properties.trueAnomaly = ConvertHyperbolicAnomaly2TrueAnomaly(e, properties.anomaly);
+      }
+      else
+      {
+         properties.anomaly = M;
+         properties.trueAnomaly = ConvertParabolicAnomaly2TrueAnomaly(properties.anomaly);
+      }
+      properties.timeSincePerapsis = M / properties.meanMotion;
+   }
+
+   properties.radius = properties.semiparameter / (1.0 + e * cos(properties.trueAnomaly));
+}
+
+// Builds the cartesian state vector from the cached true anomaly and radius. Matches
+// ConvertOrbitalElements2StateVector() without solving Kepler's equation again.
+StateVector ComputeStateVector(double mu, const OrbitalElements& orbitalElements, const Orbit::OrbitProperties& properties)
+{
+   const double e = orbitalElements.eccentricity;
+   const double p = properties.semiparameter;
+   const double r = properties.radius;
+   const double cosTa = cos(properties.trueAnomaly);
+   const double sinTa = sin(properties.trueAnomaly);
+
+   StateVector perifocalStateVector;
+   perifocalStateVector.position.x() = r * cosTa;
+   perifocalStateVector.position.y() = r * sinTa;
+   perifocalStateVector.position.z() = 0.0;
+   perifocalStateVector.velocity.x() = -sqrt(mu / p) * sinTa;
+   perifocalStateVector.velocity.y() = sqrt(mu / p) * (e + cosTa);
+   perifocalStateVector.velocity.z() = 0.0;
+
+   return TransformPerifocal2Inertial(perifocalStateVector, orbitalElements.inclination,
+      orbitalElements.argOfPericenter, orbitalElements.lonOfAscendingNode);
+}
+
+} // namespace
+
 std::string Orbit::OrbitProperties::ToString(std::string prefix) const
 {
    std::ostringstream os;
@@ -87,7 +174,10 @@ std::string Orbit::OrbitProperties::ToString(std::string prefix) const
 Orbit::Orbit() :
 m_gravitationalParameterCentralBody(1.0),
 m_direction(Direction::Invalid),
-m_propertiesDirty(false),
+m_anomalyMeanAnomaly(0.0),
+m_StateVectorMeanAnomaly(0.0),
+m_shapePropertiesDirty(true),
+m_anomalyPropertiesDirty(true),
 m_orbitalElementsDirty(false),
 m_StateVectorDirty(false)
 //m_orbitType(Type::Invalid),
@@ -119,7 +209,10 @@ Orbit::Orbit(double mu, const OrbitalElements& orbitalElements, Direction orbitD
 m_gravitationalParameterCentralBody(mu),
 m_orbitalElements(orbitalElements),
 m_direction(orbitDirection),
-m_propertiesDirty(true),
+m_anomalyMeanAnomaly(0.0),
+m_StateVectorMeanAnomaly(0.0),
+m_shapePropertiesDirty(true),
+m_anomalyPropertiesDirty(true),
 m_orbitalElementsDirty(false),
 m_StateVectorDirty(true)
 {
@@ -130,7 +223,10 @@ Orbit::Orbit(double mu, const StateVector& StateVector) :
 m_gravitationalParameterCentralBody(mu),
 m_StateVector(StateVector),
 m_direction(Direction::Invalid),
-m_propertiesDirty(true),
+m_anomalyMeanAnomaly(0.0),
+m_StateVectorMeanAnomaly(0.0),
+m_shapePropertiesDirty(true),
+m_anomalyPropertiesDirty(true),
 m_orbitalElementsDirty(true),
 m_StateVectorDirty(false)
 {
@@ -145,25 +241,54 @@ Orbit::~Orbit()
 ////////////////////////////////////////////////////////////
 void Orbit::SetGravitationalParameterCentralBody(double mu)
 {
-   m_gravitationalParameterCentralBody = mu;
+   if (mu != m_gravitationalParameterCentralBody)
+   {
+      UpdateOrbitalElements();
+      m_gravitationalParameterCentralBody = mu;
+
+      m_shapePropertiesDirty = true;
+      m_anomalyPropertiesDirty = true;
+      m_StateVectorDirty = true;
+   }
 }
 
+////////////////////////////////////////////////////////////
 void Orbit::SetOrbitalElements(const OrbitalElements& orbitalElements, Direction orbitDirection)
 {
+   // The mean anomaly is checked when the cached anomaly properties
+   // and state vector are requested, so only the other elements are
+   // compared here.
+   const bool shapeChanged = m_orbitalElementsDirty ||
+      orbitalElements.semiMajorAxis != m_orbitalElements.semiMajorAxis ||
+      orbitalElements.eccentricity != m_orbitalElements.eccentricity;
+   const bool orientationChanged = shapeChanged ||
+      orbitalElements.inclination != m_orbitalElements.inclination ||
+      orbitalElements.argOfPericenter != m_orbitalElements.argOfPericenter ||
+      orbitalElements.lonOfAscendingNode != m_orbitalElements.lonOfAscendingNode;
+
    m_orbitalElements = orbitalElements;
    m_direction = orbitDirection;
    m_orbitalElementsDirty = false;
 
-   m_propertiesDirty = true;  
-   m_StateVectorDirty = true;
+   if (shapeChanged)
+   {
+      m_shapePropertiesDirty = true;
+      m_anomalyPropertiesDirty = true;
+   }
+   if (orientationChanged)
+   {
+      m_StateVectorDirty = true;
+   }
 }
 
+////////////////////////////////////////////////////////////
 void Orbit::SetStateVector(const StateVector& StateVector)
 {
    m_StateVector = StateVector;
    m_StateVectorDirty = false;
 
-   m_propertiesDirty = true;
+   m_shapePropertiesDirty = true;
+   m_anomalyPropertiesDirty = true;
    m_orbitalElementsDirty = true;
 }
 
@@ -254,21 +379,37 @@ const OrbitalElements& Orbit::GetOrbitalElements() const
 ////////////////////////////////////////////////////////////
 Orbit::Type Orbit::GetOrbitType() const
 {
-   return GetOrbitProperties().type;
+   UpdateShapeProperties();
+   return m_properties.type;
 }
 
+////////////////////////////////////////////////////////////
 Orbit::Direction Orbit::GetOrbitDirection() const
 {
-   UpdateOrbitProperties();
    return m_direction;
 }
 
+////////////////////////////////////////////////////////////
 const Orbit::OrbitProperties& Orbit::GetOrbitProperties() const
 {
    UpdateOrbitProperties();
    return m_properties;
 }
 
+////////////////////////////////////////////////////////////
+double Orbit::GetMeanMotion() const
+{
+   UpdateShapeProperties();
+   return m_properties.meanMotion;
+}
+
+////////////////////////////////////////////////////////////
+double Orbit::GetPeriod() const
+{
+   UpdateShapeProperties();
+   return m_properties.period;
+}
+
 ////////////////////////////////////////////////////////////
 //const Time& Orbit::GetElapsedPropagationTime() const
 //{
@@ -289,22 +430,9 @@ bool Orbit::IsDirection(Direction orbitDirection) const
 ////////////////////////////////////////////////////////////
 void Orbit::Propagate(const Time& timeDelta)
 {
-   keplerian::LagrangianPropagator propagator;
-   if (m_propertiesDirty || m_orbitalElementsDirty)
-   {
-      m_orbitalElements.meanAnomaly = propagator.PropagateMeanAnomaly(
-         GetOrbitalElements(), m_gravitationalParameterCentralBody, timeDelta);
-   }
-   else
-   {
-      m_orbitalElements.meanAnomaly = propagator.PropagateMeanAnomaly(
-         m_orbitalElements.meanAnomaly, m_properties.meanMotion, timeDelta);
-   }
-   
-
-   m_orbitalElementsDirty = false;
-   m_propertiesDirty = true;
-   m_StateVectorDirty = true;
+   UpdateShapeProperties();
+   m_orbitalElements.meanAnomaly = GetSharedPropagator().PropagateMeanAnomaly(
+      m_orbitalElements.meanAnomaly, m_properties.meanMotion, timeDelta);
 }
 //void Orbit::Propagate(const Time& timeDelta)
 //{
@@ -333,19 +461,13 @@ void Orbit::PropagateToMeanAnomaly(double meanAnomaly)
 {
    UpdateOrbitalElements();
    m_orbitalElements.meanAnomaly = meanAnomaly;
-
-   m_orbitalElementsDirty = false;
-   m_propertiesDirty = true;
-   m_StateVectorDirty = true;
 }
+
+////////////////////////////////////////////////////////////
 void Orbit::PropagateToTrueAnomaly(double trueAnomaly)
 {
    UpdateOrbitalElements();
    m_orbitalElements.meanAnomaly = ConvertTrueAnomaly2MeanAnomaly(m_orbitalElements.eccentricity, trueAnomaly);
-
-   m_orbitalElementsDirty = false;
-   m_propertiesDirty = true;
-   m_StateVectorDirty = true;
 }
 
 //void Orbit::PropagateToTrueAnomaly(double trueAnomaly)
@@ -411,9 +533,8 @@ void Orbit::PropagateToTrueAnomaly(double trueAnomaly)
 ////////////////////////////////////////////////////////////
 std::string Orbit::ToString(std::string prefix) const
 {
-   UpdateStateVector();
-   UpdateOrbitalElements();
    UpdateOrbitProperties();
+   UpdateStateVector();
 
    std::ostringstream os;
    os << prefix << "Direction:                              ";
@@ -443,26 +564,62 @@ std::string Orbit::ToString(std::string prefix) const
 ////////////////////////////////////////////////////////////
 void Orbit::UpdateOrbitProperties() const
 {
-   UpdateOrbitalElements();
-   m_properties = ComputeOrbitProperties(m_gravitationalParameterCentralBody, m_orbitalElements);
+   UpdateAnomalyProperties();
+}
 
-   m_propertiesDirty = false;
+////////////////////////////////////////////////////////////
+void Orbit::UpdateShapeProperties() const
+{
+   if (m_shapePropertiesDirty)
+   {
+      UpdateOrbitalElements();
+      ComputeShapeProperties(m_gravitationalParameterCentralBody, m_orbitalElements, m_properties);
+      m_shapePropertiesDirty = false;
+   }
 }
 
+////////////////////////////////////////////////////////////
+void Orbit::UpdateAnomalyProperties() const
+{
+   UpdateShapeProperties();
+   if (m_anomalyPropertiesDirty || m_anomalyMeanAnomaly != m_orbitalElements.meanAnomaly)
+   {
+      ComputeAnomalyProperties(m_orbitalElements, m_properties);
+      m_anomalyMeanAnomaly = m_orbitalElements.meanAnomaly;
+      m_anomalyPropertiesDirty = false;
+   }
+}
+
+////////////////////////////////////////////////////////////
 void Orbit::UpdateOrbitalElements() const
 {
    if (m_orbitalElementsDirty)
    {
       m_orbitalElements = ConvertStateVector2OrbitalElements(m_StateVector, m_gravitationalParameterCentralBody);
+      m_StateVectorMeanAnomaly = m_orbitalElements.meanAnomaly;
       m_orbitalElementsDirty = false;
    }
 }
 
+////////////////////////////////////////////////////////////
 void Orbit::UpdateStateVector() const
 {
-   if (m_StateVectorDirty)
+   // A state vector that was set directly is up-to-date until the
+   // orbital elements are propagated away from its mean anomaly
+   if (m_StateVectorDirty || (!m_orbitalElementsDirty && m_StateVectorMeanAnomaly != m_orbitalElements.meanAnomaly))
    {
-      m_StateVector = ConvertOrbitalElements2StateVector(m_orbitalElements, m_gravitationalParameterCentralBody);
+      // Reuse the cached true anomaly when the properties are current. Otherwise
+      // convert the elements directly so the properties stay lazy; an ephemeris
+      // that changes the shape every epoch never asks for them.
+      if (!m_anomalyPropertiesDirty && m_anomalyMeanAnomaly == m_orbitalElements.meanAnomaly)
+      {
+         m_StateVector = ComputeStateVector(m_gravitationalParameterCentralBody, m_orbitalElements, m_properties);
+      }
+      else
+      {
+         m_StateVector = ConvertOrbitalElements2StateVector(m_orbitalElements, m_gravitationalParameterCentralBody);
+      }
+      m_StateVectorMeanAnomaly = m_orbitalElements.meanAnomaly;
       m_StateVectorDirty = false;
    }
 }
@@ -471,82 +628,19 @@ void Orbit::UpdateStateVector() const
 Orbit::OrbitProperties ComputeOrbitProperties(double mu, const OrbitalElements& orbitalElements)
 {
    Orbit::OrbitProperties properties;
-
-   // Unpack the orbital elements
-   const double a = orbitalElements.semiMajorAxis;
-   const double e = orbitalElements.eccentricity;
-   const double M = orbitalElements.meanAnomaly;
-
-   // Compute orbit type
-   properties.type = ComputeOrbitType(mu, orbitalElements);
-
-   // Compute anomaly (eccentric, hyperbolic, parabolic)
-   properties.anomaly = ConvertMeanAnomalyToAnomaly(e, M);
-
-   // Compute true anomaly
-   properties.trueAnomaly = ConvertAnomaly2TrueAnomaly(e, properties.anomaly);
-
-   // Compute radius
-   properties.radius = ComputeOrbitRadius(orbitalElements, properties.trueAnomaly);
-
-   // Compute mean motion
-   properties.meanMotion = sqrt(mu / pow(a, 3.0));
-
-   // Compute period
-   properties.period = 1.0 / properties.meanMotion;
-
-   // Compute specific angular momentum (h)
-   properties.specificAngularMomentum = 1.0;
-
-   // Compute semiparameter
-   properties.semiparameter = 1.0;
-
-   // Compute time since periapsis
-   properties.timeSincePerapsis = 1.0;
-
+   ComputeShapeProperties(mu, orbitalElements, properties);
+   ComputeAnomalyProperties(orbitalElements, properties);
    return properties;
 }
 
 ////////////////////////////////////////////////////////////
 Orbit::OrbitProperties ComputeOrbitProperties(double mu, const StateVector& StateVector)
 {
-   //OrbitalElements orbitalElements = ConvertStateVector2OrbitalElements(StateVector, mu);
-   //return ComputeOrbitProperties(mu, orbitalElements);
-
-   Orbit::OrbitProperties properties;
-
-   // Unpack the cartesian state vector
-   const Vector3d& R = StateVector.position;
-   const Vector3d& V = StateVector.velocity;
-   const double e = ((SQR(V.norm()) / mu - 1.0 / R.norm()) * R - (R.dot(V) / mu) * V).norm();
-
-   // Compute orbit type
-   properties.type = ComputeOrbitType(mu, StateVector);
-
-   // Compute anomaly (eccentric, hyperbolic, parabolic)
-   properties.anomaly = 1.0;// ConvertMeanAnomalyToAnomaly(e, M);
+   Orbit::OrbitProperties properties = ComputeOrbitProperties(mu, ConvertStateVector2OrbitalElements(StateVector, mu));
 
-   // Compute true anomaly
-   properties.trueAnomaly = ConvertAnomaly2TrueAnomaly(e, properties.anomaly);
-
-   // Compute radius
+   // Use the exact radius rather than the one reconstructed from the orbital elements
    properties.radius = ComputeOrbitRadius(StateVector);
 
-   // Compute mean motion
-   properties.meanMotion = 1.0;
-
-   // Compute period
-   properties.period = 1.0 / properties.meanMotion;
-
-   // Compute specific angular momentum (h)
-   properties.specificAngularMomentum = R.cross(V).norm();
-
-   // Compute semiperimeter
-   properties.semiparameter = 1.0;
-
-   // Compute time since periapsis
-   properties.timeSincePerapsis = 1.0;
-
    return properties;
 }
 
@@ -0,0 +1,353 @@
+////////////////////////////////////////////////////////////
+//
+// OTL - Orbital Trajectory Library
+// Copyright (C) 2013-2018 Jason Bryan (Jmbryan10@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#include <OTL/Core/Porkchop.h>
+#include <OTL/Core/LambertExponentialSinusoidSingleRev.h>
+#include <OTL/Core/LambertHouseholder.h>
+#include <OTL/Core/OrbitalBody.h>
+#include <OTL/Core/Logger.h>
+#include <OTL/Core/Threading/ThreadGroup.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace otl
+{
+
+namespace keplerian
+{
+
+namespace
+{
+
+// Region of the grid solved by a single worker at a time
+struct Tile
+{
+   std::size_t departureIndex;   ///< First departure epoch (row) of the tile
+   std::size_t arrivalIndex;     ///< First arrival epoch (column) of the tile
+   std::size_t rows;             ///< Number of departure epochs in the tile
+   std::size_t columns;          ///< Number of arrival epochs in the tile
+};
+
+////////////////////////////////////////////////////////////
+std::unique_ptr<ILambertAlgorithm> CreateLambertAlgorithm(LambertType type)
+{
+   switch (type)
+   {
+      case LambertType::MultiRev:
+         return std::unique_ptr<ILambertAlgorithm>(new LambertExponentialSinusoid());
+
+      case LambertType::SingleRev:
+         return std::unique_ptr<ILambertAlgorithm>(new LambertExponentialSinusoidSingleRev());
+
+      case LambertType::Householder:
+         return std::unique_ptr<ILambertAlgorithm>(new LambertHouseholder());
+
+      case LambertType::Invalid:
+      default:
+         return std::unique_ptr<ILambertAlgorithm>();
+   }
+}
+
+////////////////////////////////////////////////////////////
+std::vector<Epoch> SampleEpochs(const Epoch& begin, const Epoch& end, const Time& resolution)
+{
+   const std::size_t count = static_cast<std::size_t>(std::floor((end - begin).Seconds() / resolution.Seconds() + 1.0e-9)) + 1;
+
+   std::vector<Epoch> epochs;
+   epochs.reserve(count);
+   for (std::size_t i = 0; i < count; ++i)
+   {
+      epochs.push_back(begin + Time::Seconds(i * resolution.Seconds()));
+   }
+   return epochs;
+}
+
+////////////////////////////////////////////////////////////
+std::vector<StateVector> SampleStateVectors(OrbitalBody& body, const std::vector<Epoch>& epochs)
+{
+   std::vector<StateVector> stateVectors;
+   stateVectors.reserve(epochs.size());
+   for (const auto& epoch : epochs)
+   {
+      stateVectors.push_back(body.GetStateVectorAt(epoch));
+   }
+   return stateVectors;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////
+PorkchopOptions::PorkchopOptions() :
+orbitDirection(Orbit::Direction::Prograde),
+numRevolutions(0),
+lambertType(LambertType::MultiRev),
+numThreads(0),
+tileSize(32)
+{
+}
+
+////////////////////////////////////////////////////////////
+std::size_t PorkchopGrid::GetIndex(std::size_t departureIndex, std::size_t arrivalIndex) const
+{
+   return departureIndex * arrivalEpochs.size() + arrivalIndex;
+}
+
+////////////////////////////////////////////////////////////
+PorkchopEngine::PorkchopEngine(const PorkchopOptions& options) :
+m_options(options)
+{
+}
+
+////////////////////////////////////////////////////////////
+void PorkchopEngine::SetOptions(const PorkchopOptions& options)
+{
+   m_options = options;
+}
+
+////////////////////////////////////////////////////////////
+const PorkchopOptions& PorkchopEngine::GetOptions() const
+{
+   return m_options;
+}
+
+////////////////////////////////////////////////////////////
+PorkchopGrid PorkchopEngine::Evaluate(OrbitalBody& departureBody,
+                                      OrbitalBody& arrivalBody,
+                                      const Epoch& departureBegin,
+                                      const Epoch& departureEnd,
+                                      const Epoch& arrivalBegin,
+                                      const Epoch& arrivalEnd,
+                                      const Time& resolution) const
+{
+   PorkchopGrid grid;
+   if (resolution.Seconds() <= 0.0 || departureEnd < departureBegin || arrivalEnd < arrivalBegin)
+   {
+      OTL_ERROR() << "Invalid porkchop epoch ranges or resolution " << Bracket(resolution.Seconds());
+      return grid;
+   }
+   if (!CreateLambertAlgorithm(m_options.lambertType))
+   {
+      OTL_ERROR() << "Invalid porkchop Lambert type " << Bracket(static_cast<int>(m_options.lambertType));
+      return grid;
+   }
+
+   // Body states once per row and once per column. Orbital bodies
+   // are not thread safe so this is done on the calling thread.
+   grid.departureEpochs = SampleEpochs(departureBegin, departureEnd, resolution);
+   grid.arrivalEpochs = SampleEpochs(arrivalBegin, arrivalEnd, resolution);
+   const std::vector<StateVector> departureStates = SampleStateVectors(departureBody, grid.departureEpochs);
+   const std::vector<StateVector> arrivalStates = SampleStateVectors(arrivalBody, grid.arrivalEpochs);
+   const double mu = departureBody.GetGravitationalParameterCentralBody();
+
+   std::vector<double> departureSeconds(grid.departureEpochs.size());
+   for (std::size_t i = 0; i < departureSeconds.size(); ++i)
+   {
+      departureSeconds[i] = (grid.departureEpochs[i] - departureBegin).Seconds();
+   }
+   std::vector<double> arrivalSeconds(grid.arrivalEpochs.size());
+   for (std::size_t j = 0; j < arrivalSeconds.size(); ++j)
+   {
+      arrivalSeconds[j] = (grid.arrivalEpochs[j] - departureBegin).Seconds();
+   }
+
+   const std::size_t rows = departureStates.size();
+   const std::size_t columns = arrivalStates.size();
+   const std::size_t tileSize = static_cast<std::size_t>(std::max(m_options.tileSize, 1));
+
+   std::vector<Tile> tiles;
+   for (std::size_t i = 0; i < rows; i += tileSize)
+   {
+      for (std::size_t j = 0; j < columns; j += tileSize)
+      {
+         Tile tile = { i, j, std::min(tileSize, rows - i), std::min(tileSize, columns - j) };
+         tiles.push_back(tile);
+      }
+   }
+
+   const bool streaming = !m_options.outputFilename.empty();
+   std::ofstream stream;
+   std::mutex streamMutex;
+   if (streaming)
+   {
+      stream.open(m_options.outputFilename, std::ios::out | std::ios::binary | std::ios::trunc);
+      if (!stream.is_open())
+      {
+         OTL_ERROR() << "Failed to open porkchop output file " << Bracket(m_options.outputFilename);
+         return grid;
+      }
+   }
+   else
+   {
+      grid.departureC3.resize(rows * columns);
+      grid.arrivalVinf.resize(rows * columns);
+      grid.totalDeltaV.resize(rows * columns);
+   }
+
+   std::atomic<std::size_t> nextTile(0);
+   std::atomic<std::size_t> failedCells(0);
+   auto worker = [&]()
+   {
+      auto lambert = CreateLambertAlgorithm(m_options.lambertType);
+      std::size_t failed = 0;
+      std::vector<double> c3, vinf, deltaV;
+      if (streaming)
+      {
+         c3.resize(tileSize * tileSize);
+         vinf.resize(tileSize * tileSize);
+         deltaV.resize(tileSize * tileSize);
+      }
+
+      Vector3d initialVelocity, finalVelocity;
+      for (std::size_t t = nextTile++; t < tiles.size(); t = nextTile++)
+      {
+         const Tile& tile = tiles[t];
+         for (std::size_t row = 0; row < tile.rows; ++row)
+         {
+            const std::size_t i = tile.departureIndex + row;
+            const StateVector& departureState = departureStates[i];
+
+            // Neighbouring cells along a row differ only slightly in arrival position and time of flight
+            LambertSolverState state;
+            for (std::size_t column = 0; column < tile.columns; ++column)
+            {
+               const std::size_t j = tile.arrivalIndex + column;
+               const StateVector& arrivalState = arrivalStates[j];
+
+               double cellC3, cellVinf, cellDeltaV;
+               const double seconds = arrivalSeconds[j] - departureSeconds[i];
+               bool solved = false;
+               if (seconds > 0.0)
+               {
+                  // Never let a cell inherit the previous solution if the solve returns early
+                  initialVelocity.setConstant(std::numeric_limits<double>::quiet_NaN());
+                  finalVelocity.setConstant(std::numeric_limits<double>::quiet_NaN());
+                  lambert->EvaluateWarmStart(departureState.position,
+                                             arrivalState.position,
+                                             Time::Seconds(seconds),
+                                             m_options.orbitDirection,
+                                             m_options.numRevolutions,
+                                             mu,
+                                             state,
+                                             initialVelocity,
+                                             finalVelocity);
+                  solved = initialVelocity.allFinite() && finalVelocity.allFinite();
+                  if (!solved)
+                  {
+                     ++failed;
+                  }
+               }
+
+               if (solved)
+               {
+                  const double departureVinf = (initialVelocity - departureState.velocity).norm();
+                  cellVinf = (arrivalState.velocity - finalVelocity).norm();
+                  cellC3 = departureVinf * departureVinf;
+                  cellDeltaV = departureVinf + cellVinf;
+               }
+               else
+               {
+                  cellC3 = cellVinf = cellDeltaV = std::numeric_limits<double>::quiet_NaN();
+                  state.valid = false;
+               }
+
+               if (streaming)
+               {
+                  const std::size_t index = row * tile.columns + column;
+                  c3[index] = cellC3;
+                  vinf[index] = cellVinf;
+                  deltaV[index] = cellDeltaV;
+               }
+               else
+               {
+                  const std::size_t index = grid.GetIndex(i, j);
+                  grid.departureC3[index] = cellC3;
+                  grid.arrivalVinf[index] = cellVinf;
+                  grid.totalDeltaV[index] = cellDeltaV;
+               }
+            }
+         }
+
+         if (streaming)
+         {
+            const std::int32_t header[4] = { static_cast<std::int32_t>(tile.departureIndex),
+                                             static_cast<std::int32_t>(tile.arrivalIndex),
+                                             static_cast<std::int32_t>(tile.rows),
+                                             static_cast<std::int32_t>(tile.columns) };
+            const std::streamsize bytes = static_cast<std::streamsize>(tile.rows * tile.columns * sizeof(double));
+
+            // A failed stream ignores further writes and is reported once all tiles are finished
+            std::lock_guard<std::mutex> lock(streamMutex);
+            stream.write(reinterpret_cast<const char*>(header), sizeof(header));
+            stream.write(reinterpret_cast<const char*>(c3.data()), bytes);
+            stream.write(reinterpret_cast<const char*>(vinf.data()), bytes);
+            stream.write(reinterpret_cast<const char*>(deltaV.data()), bytes);
+         }
+      }
+
+      failedCells += failed;
+   };
+
+   std::size_t numThreads = (m_options.numThreads > 0 ? m_options.numThreads : std::thread::hardware_concurrency());
+   numThreads = std::max<std::size_t>(1, std::min(numThreads, tiles.size()));
+
+   // The calling thread works alongside the additional threads
+   ThreadGroup threads;
+   for (std::size_t i = 1; i < numThreads; ++i)
+   {
+      threads.Start(worker);
+   }
+   worker();
+   threads.Join();
+
+   // Logged once here rather than per cell from the workers
+   if (failedCells > 0)
+   {
+      OTL_WARN() << "No Lambert solution with " << Bracket(m_options.numRevolutions) << " revolutions for "
+                 << Bracket(failedCells.load()) << " of " << Bracket(rows * columns) << " porkchop cells";
+   }
+
+   if (streaming)
+   {
+      // Closing flushes the last tiles, which may fail as well
+      stream.close();
+      if (stream.fail())
+      {
+         OTL_ERROR() << "Failed to write porkchop output file " << Bracket(m_options.outputFilename);
+      }
+   }
+
+   return grid;
+}
+
+} // namespace keplerian
+
+} // namespace otl
@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////
+//
+// OTL - Orbital Trajectory Library
+// Copyright (C) 2013-2018 Jason Bryan (Jmbryan10@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#include <OTL/Core/PreparedLambertGeometry.h>
+#include <OTL/Core/Logger.h>
+
+namespace otl
+{
+
+namespace keplerian
+{
+
+////////////////////////////////////////////////////////////
+PreparedLambertGeometry::PreparedLambertGeometry(const Vector3d& initialPosition,
+                                                 const Vector3d& finalPosition,
+                                                 const Orbit::Direction& orbitDirection,
+                                                 double mu) :
+m_distanceUnit(initialPosition.norm())
+{
+   LambertExponentialSinusoid::PrepareTransferGeometry(initialPosition, finalPosition, orbitDirection, mu, m_geometry);
+}
+
+////////////////////////////////////////////////////////////
+void PreparedLambertGeometry::Solve(const Time& timeDelta,
+                                    int numRevolutions,
+                                    Vector3d& initialVelocity,
+                                    Vector3d& finalVelocity) const
+{
+   double seconds = timeDelta.Seconds();
+   OTL_ASSERT(seconds >= 0.0);
+
+   auto geometry = m_geometry;
+   LambertExponentialSinusoid::SetTimeOfFlight(seconds, geometry);
+
+   double x = LambertExponentialSinusoid::SolveTransferParameter(geometry, numRevolutions);
+
+   LambertExponentialSinusoid::ComputeVelocities(geometry, x, initialVelocity, finalVelocity);
+}
+
+////////////////////////////////////////////////////////////
+void PreparedLambertGeometry::Solve(const Span<const double>& timeDeltas,
+                                    int numRevolutions,
+                                    const Vector3Span<double>& initialVelocities,
+                                    const Vector3Span<double>& finalVelocities) const
+{
+   const std::size_t size = timeDeltas.Size();
+   if (initialVelocities.Size() != size || finalVelocities.Size() != size)
+   {
+      OTL_ERROR() << "Time of flight and velocity spans must all be of equal size " << Bracket(size);
+      return;
+   }
+
+   auto geometry = m_geometry;
+   LambertSolverState state;
+   Vector3d initialVelocity, finalVelocity;
+   double x1, x2, y1, y2;
+   for (std::size_t i = 0; i < size; ++i)
+   {
+      OTL_ASSERT(timeDeltas[i] >= 0.0);
+      LambertExponentialSinusoid::SetTimeOfFlight(timeDeltas[i], geometry);
+
+      if (state.valid)
+      {
+         LambertExponentialSinusoid::InitializeSecant(geometry, numRevolutions, state, x1, x2, y1, y2);
+      }
+      else
+      {
+         LambertExponentialSinusoid::InitializeSecant(geometry, numRevolutions, x1, x2, y1, y2);
+      }
+      double x = LambertExponentialSinusoid::IterateSecant(geometry, numRevolutions, x1, x2, y1, y2, &state);
+
+      LambertExponentialSinusoid::ComputeVelocities(geometry, x, initialVelocity, finalVelocity);
+      initialVelocities.Set(i, initialVelocity);
+      finalVelocities.Set(i, finalVelocity);
+   }
+}
+
+////////////////////////////////////////////////////////////
+double PreparedLambertGeometry::GetTransferAngle() const
+{
+   return m_geometry.trueAnomaly;
+}
+
+////////////////////////////////////////////////////////////
+double PreparedLambertGeometry::GetLambda() const
+{
+   return m_geometry.lambda;
+}
+
+////////////////////////////////////////////////////////////
+double PreparedLambertGeometry::GetChord() const
+{
+   return m_geometry.c * m_distanceUnit;
+}
+
+////////////////////////////////////////////////////////////
+double PreparedLambertGeometry::GetSemiperimeter() const
+{
+   return m_geometry.s * m_distanceUnit;
+}
+
+} // namespace keplerian
+
+} // namespace otl
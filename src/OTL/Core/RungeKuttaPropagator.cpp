@@ -0,0 +1,510 @@
+////////////////////////////////////////////////////////////
+//
+// OTL - Orbital Trajectory Library
+// Copyright (C) 2013-2018 Jason Bryan (Jmbryan10@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#include <OTL/Core/RungeKuttaPropagator.h>
+#include <OTL/Core/Conversion.h>
+#include <algorithm>
+
+namespace otl
+{
+
+namespace
+{
+
+// Maximum number of steps per propagation
+const int MAX_STEPS = 1000000;
+
+// Bounds on the factor by which the step size may change between steps
+const double MIN_STEP_FACTOR = 0.2;
+const double MAX_STEP_FACTOR = 5.0;
+const double STEP_SAFETY_FACTOR = 0.9;
+
+// Dormand-Prince 8(5,3) nodes, including the three extra stages of the dense output
+const double DOP853_C[16] =
+{
+   0.0, 0.526001519587677318785587544488e-01, 0.789002279381515978178381316732e-01, 0.118350341907227396726757197510,
+   0.281649658092772603273242802490, 0.333333333333333333333333333333, 0.25, 0.307692307692307692307692307692,
+   0.651282051282051282051282051282, 0.6, 0.857142857142857142857142857142, 1.0,
+   1.0, 0.1, 0.2, 0.777777777777777777777777777778
+};
+
+// Dormand-Prince 8(5,3) coupling coefficients. Row 12 holds the weights of the
+// eighth order solution, so that stage is the derivative at the end of the step.
+const double DOP853_A[16][15] =
+{
+   { 0.0 },
+   { 5.26001519587677318785587544488e-2 },
+   { 1.97250569845378994544595329183e-2, 5.91751709536136983633785987549e-2 },
+   { 2.95875854768068491816892993775e-2, 0.0, 8.87627564304205475450678981324e-2 },
+   { 2.41365134159266685502369798665e-1, 0.0, -8.84549479328286085344864962717e-1, 9.24834003261792003115737966543e-1 },
+   { 3.7037037037037037037037037037e-2, 0.0, 0.0, 1.70828608729473871279604482173e-1, 1.25467687566822425016691814123e-1 },
+   { 3.7109375e-2, 0.0, 0.0, 1.70252211019544039314978060272e-1, 6.02165389804559606850219397283e-2, -1.7578125e-2 },
+   { 3.70920001185047927108779319836e-2, 0.0, 0.0, 1.70383925712239993810214054705e-1, 1.07262030446373284651809199168e-1, -1.53194377486244017527936158236e-2, 8.27378916381402288758473766002e-3 },
+   { 6.24110958716075717114429577812e-1, 0.0, 0.0, -3.36089262944694129406857109825, -8.68219346841726006818189891453e-1, 2.75920996994467083049415600797e1, 2.01540675504778934086186788979e1, -4.34898841810699588477366255144e1 },
+   { 4.77662536438264365890433908527e-1, 0.0, 0.0, -2.48811461997166764192642586468, -5.90290826836842996371446475743e-1, 2.12300514481811942347288949897e1, 1.52792336328824235832596922938e1, -3.32882109689848629194453265587e1, -2.03312017085086261358222928593e-2 },
+   { -9.3714243008598732571704021658e-1, 0.0, 0.0, 5.18637242884406370830023853209, 1.09143734899672957818500254654, -8.14978701074692612513997267357, -1.85200656599969598641566180701e1, 2.27394870993505042818970056734e1, 2.49360555267965238987089396762, -3.0467644718982195003823669022 },
+   { 2.27331014751653820792359768449, 0.0, 0.0, -1.05344954667372501984066689879e1, -2.00087205822486249909675718444, -1.79589318631187989172765950534e1, 2.79488845294199600508499808837e1, -2.85899827713502369474065508674, -8.87285693353062954433549289258, 1.23605671757943030647266201528e1, 6.43392746015763530355970484046e-1 },
+   { 5.42937341165687622380535766363e-2, 0.0, 0.0, 0.0, 0.0, 4.45031289275240888144113950566, 1.89151789931450038304281599044, -5.8012039600105847814672114227, 3.1116436695781989440891606237e-1, -1.52160949662516078556178806805e-1, 2.01365400804030348374776537501e-1, 4.47106157277725905176885569043e-2 },
+   { 5.61675022830479523392909219681e-2, 0.0, 0.0, 0.0, 0.0, 0.0, 2.53500210216624811088794765333e-1, -2.46239037470802489917441475441e-1, -1.24191423263816360469010140626e-1, 1.5329179827876569731206322685e-1, 8.20105229563468988491666602057e-3, 7.56789766054569976138603589584e-3, -8.298e-3 },
+   { 3.18346481635021405060768473261e-2, 0.0, 0.0, 0.0, 0.0, 2.83009096723667755288322961402e-2, 5.35419883074385676223797384372e-2, -5.49237485713909884646569340306e-2, 0.0, 0.0, -1.08347328697249322858509316994e-4, 3.82571090835658412954920192323e-4, -3.40465008687404560802977114492e-4, 1.41312443674632500278074618366e-1 },
+   { -4.28896301583791923408573538692e-1, 0.0, 0.0, 0.0, 0.0, -4.69762141536116384314449447206, 7.68342119606259904184240953878, 4.06898981839711007970213554331, 3.56727187455281109270669543021e-1, 0.0, 0.0, 0.0, -1.39902416515901462129418009734e-3, 2.9475147891527723389556272149, -9.15095847217987001081870187138 }
+};
+
+// Fifth order error estimator
+const double DOP853_E5[12] =
+{
+   0.1312004499419488073250102996e-1, 0.0, 0.0, 0.0, 0.0, -0.1225156446376204440720569753e+1,
+   -0.4957589496572501915214079952, 0.1664377182454986536961530415e+1, -0.3503288487499736816886487290, 0.3341791187130174790297318841, 0.8192320648511571246570742613e-1, -0.2235530786388629525884427845e-1
+};
+
+// Weights of the embedded third order solution
+const double DOP853_BHH[12] =
+{
+   0.244094488188976377952755905512, 0.0, 0.0, 0.0, 0.0, 0.0,
+   0.0, 0.0, 0.733846688281611857341361741547, 0.0, 0.0, 0.220588235294117647058823529412e-1
+};
+
+// Coefficients of the four highest terms of the seventh order dense output
+const double DOP853_D[4][16] =
+{
+   { -0.84289382761090128651353491142e+1, 0.0, 0.0, 0.0, 0.0, 0.56671495351937776962531783590,
+     -0.30689499459498916912797304727e+1, 0.23846676565120698287728149680e+1, 0.21170345824450282767155149946e+1, -0.87139158377797299206789907490, 0.22404374302607882758541771650e+1,
+     0.63157877876946881815570249290, -0.88990336451333310820698117400e-1, 0.18148505520854727256656404962e+2, -0.91946323924783554000451984436e+1, -0.44360363875948939664310572000e+1 },
+   { 0.10427508642579134603413151009e+2, 0.0, 0.0, 0.0, 0.0, 0.24228349177525818288430175319e+3,
+     0.16520045171727028198505394887e+3, -0.37454675472269020279518312152e+3, -0.22113666853125306036270938578e+2, 0.77334326684722638389603898808e+1, -0.30674084731089398182061213626e+2,
+     -0.93321305264302278729567221706e+1, 0.15697238121770843886131091075e+2, -0.31139403219565177677282850411e+2, -0.93529243588444783865713862664e+1, 0.35816841486394083752465898540e+2 },
+   { 0.19985053242002433820987653617e+2, 0.0, 0.0, 0.0, 0.0, -0.38703730874935176555105901742e+3,
+     -0.18917813819516756882830838328e+3, 0.52780815920542364900561016686e+3, -0.11573902539959630126141871134e+2, 0.68812326946963000169666922661e+1, -0.10006050966910838403183860980e+1,
+     0.77771377980534432092869265740, -0.27782057523535084065932004339e+1, -0.60196695231264120758267380846e+2, 0.84320405506677161018159903784e+2, 0.11992291136182789328035130030e+2 },
+   { -0.25693933462703749003312586129e+2, 0.0, 0.0, 0.0, 0.0, -0.15418974869023643374053993627e+3,
+     -0.23152937917604549567536039109e+3, 0.35763911791061412378285349910e+3, 0.93405324183624310003907691704e+2, -0.37458323136451633156875139351e+2, 0.10409964950896230045147246184e+3,
+     0.29840293426660503123344363579e+2, -0.43533456590011143754432175058e+2, 0.96324553959188282948394950600e+2, -0.39177261675615439165231486172e+2, -0.14972683625798562581422125276e+3 }
+};
+
+
+////////////////////////////////////////////////////////////
+// Root mean square of the components of value scaled by the tolerances
+double ScaledNorm(const double* value, const double* scale, double relativeTolerance, double absoluteTolerance)
+{
+   double sum = 0.0;
+   for (int i = 0; i < 6; ++i)
+   {
+      sum += SQR(value[i] / (absoluteTolerance + relativeTolerance * scale[i]));
+   }
+   return sqrt(sum / 6.0);
+}
+
+////////////////////////////////////////////////////////////
+// Evaluate the seventh order dense output at fraction theta of a step
+// from the state at the start of the step and the interpolation terms
+void InterpolateStep(const double* state, const double (*terms)[6], double theta, double* sample)
+{
+   const double eta = 1.0 - theta;
+   for (int i = 0; i < 6; ++i)
+   {
+      sample[i] = state[i] + theta * (terms[0][i] + eta * (terms[1][i] + theta * (terms[2][i] + eta * (terms[3][i] +
+                  theta * (terms[4][i] + eta * (terms[5][i] + theta * terms[6][i]))))));
+   }
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////
+RungeKuttaPropagator::RungeKuttaPropagator() :
+m_relativeTolerance(1.0e-12),
+m_absoluteTolerance(1.0e-12),
+m_numSteps(0)
+{
+
+}
+
+////////////////////////////////////////////////////////////
+RungeKuttaPropagator::~RungeKuttaPropagator()
+{
+
+}
+
+////////////////////////////////////////////////////////////
+void RungeKuttaPropagator::AddForceModel(const ForceModelPointer& forceModel)
+{
+   m_forceModels.push_back(forceModel);
+}
+
+////////////////////////////////////////////////////////////
+void RungeKuttaPropagator::ClearForceModels()
+{
+   m_forceModels.clear();
+}
+
+////////////////////////////////////////////////////////////
+void RungeKuttaPropagator::SetEpoch(const Epoch& epoch)
+{
+   m_epoch = epoch;
+}
+
+////////////////////////////////////////////////////////////
+const Epoch& RungeKuttaPropagator::GetEpoch() const
+{
+   return m_epoch;
+}
+
+////////////////////////////////////////////////////////////
+void RungeKuttaPropagator::SetTolerance(double relativeTolerance, double absoluteTolerance)
+{
+   m_relativeTolerance = relativeTolerance;
+   m_absoluteTolerance = absoluteTolerance;
+}
+
+////////////////////////////////////////////////////////////
+int RungeKuttaPropagator::GetNumSteps() const
+{
+   return m_numSteps;
+}
+
+////////////////////////////////////////////////////////////
+StateVector RungeKuttaPropagator::PropagateStateVector(const StateVector& stateVector, double mu, const Time& timeDelta)
+{
+   return Integrate(stateVector, mu, timeDelta.Seconds(), Span<const double>(), Span<StateVector>());
+}
+
+////////////////////////////////////////////////////////////
+OrbitalElements RungeKuttaPropagator::PropagateOrbitalElements(const OrbitalElements& orbitalElements, double mu, const Time& timeDelta)
+{
+   const StateVector stateVector = ConvertOrbitalElements2StateVector(orbitalElements, mu);
+   return ConvertStateVector2OrbitalElements(PropagateStateVector(stateVector, mu, timeDelta), mu);
+}
+
+////////////////////////////////////////////////////////////
+void RungeKuttaPropagator::SampleStateVectors(const StateVector& stateVector,
+                                              double mu,
+                                              const Span<const double>& timeDeltas,
+                                              const Span<StateVector>& sampledStateVectors)
+{
+   const std::size_t size = timeDeltas.Size();
+   if (sampledStateVectors.Size() != size)
+   {
+      OTL_ERROR() << "Sample size mismatch: " << Bracket(size) << " time deltas and "
+                  << Bracket(sampledStateVectors.Size()) << " outputs";
+      return;
+   }
+   if (size == 0)
+   {
+      return;
+   }
+
+   const double direction = (timeDeltas[size - 1] < 0.0 ? -1.0 : 1.0);
+   for (std::size_t i = 1; i < size; ++i)
+   {
+      if (direction * (timeDeltas[i] - timeDeltas[i - 1]) < 0.0)
+      {
+         OTL_ERROR() << "Time deltas must be monotonically ordered in the direction of propagation";
+         return;
+      }
+   }
+
+   Integrate(stateVector, mu, timeDeltas[size - 1], timeDeltas, sampledStateVectors);
+}
+
+////////////////////////////////////////////////////////////
+StateVector RungeKuttaPropagator::Integrate(const StateVector& stateVector,
+                                            double mu,
+                                            double seconds,
+                                            const Span<const double>& timeDeltas,
+                                            const Span<StateVector>& sampledStateVectors)
+{
+   // Force models may be shared between propagators starting at different epochs
+   for (const auto& forceModel : m_forceModels)
+   {
+      forceModel->SetEpoch(m_epoch);
+   }
+
+   InitializeState(stateVector, mu, m_state);
+   EvaluateDerivative(0.0, mu, m_state, m_derivative);
+   m_numSteps = 0;
+
+   // Samples at or before the initial time are the initial state
+   const double direction = (seconds < 0.0 ? -1.0 : 1.0);
+   std::size_t sampleIndex = 0;
+   while (sampleIndex < timeDeltas.Size() && direction * timeDeltas[sampleIndex] <= 0.0)
+   {
+      sampledStateVectors[sampleIndex++] = stateVector;
+   }
+
+   double t = 0.0;
+   double h = (seconds == 0.0 ? 0.0 : direction * EstimateInitialStep(mu, seconds));
+   while (direction * (seconds - t) > 0.0)
+   {
+      if (m_numSteps++ >= MAX_STEPS)
+      {
+         OTL_WARN() << "Max steps " << Bracket(MAX_STEPS) << " reached at time " << Bracket(t) << " of " << Bracket(seconds);
+         break;
+      }
+
+      // Do not step past the final time
+      if (direction * (t + h - seconds) > 0.0)
+      {
+         h = seconds - t;
+      }
+
+      double stageTimes[NUM_STAGES];
+      for (int s = 0; s < NUM_STAGES; ++s)
+      {
+         stageTimes[s] = t + DOP853_C[s] * h;
+      }
+      PrepareStep(mu, Span<const double>(stageTimes, NUM_STAGES));
+
+      // Evaluate the stages; the first is the derivative at the start of the step
+      std::copy(m_derivative, m_derivative + STATE_SIZE, m_stages[0]);
+      for (int s = 1; s < NUM_STAGES - 1; ++s)
+      {
+         EvaluateStage(mu, s, h, stageTimes[s]);
+      }
+
+      // Advance with the eighth order solution and estimate its error from the fifth and third order solutions
+      double error5[STATE_SIZE], error3[STATE_SIZE];
+      for (int i = 0; i < STATE_SIZE; ++i)
+      {
+         double sum = 0.0, sum5 = 0.0, sum3 = 0.0;
+         for (int s = 0; s < NUM_STAGES - 1; ++s)
+         {
+            sum += DOP853_A[NUM_STAGES - 1][s] * m_stages[s][i];
+            sum5 += DOP853_E5[s] * m_stages[s][i];
+            sum3 += (DOP853_A[NUM_STAGES - 1][s] - DOP853_BHH[s]) * m_stages[s][i];
+         }
+         m_nextState[i] = m_state[i] + h * sum;
+         error5[i] = sum5;
+         error3[i] = sum3;
+      }
+
+      double scale[STATE_SIZE];
+      GetErrorScale(m_state, m_nextState, scale);
+      const double norm5 = ScaledNorm(error5, scale, m_relativeTolerance, m_absoluteTolerance);
+      const double norm3 = ScaledNorm(error3, scale, m_relativeTolerance, m_absoluteTolerance);
+      const double errorNorm = (norm5 == 0.0 ? 0.0 : std::abs(h) * norm5 * norm5 / sqrt(norm5 * norm5 + 0.01 * norm3 * norm3));
+
+      if (errorNorm <= 1.0)
+      {
+         // The last stage is the derivative at the end of the step
+         const double tNext = t + h;
+         EvaluateDerivative(tNext, mu, m_nextState, m_stages[NUM_STAGES - 1]);
+
+         // Dense output for the samples inside this step
+         bool interpolate = false;
+         while (sampleIndex < timeDeltas.Size() && direction * (timeDeltas[sampleIndex] - tNext) <= 0.0)
+         {
+            if (timeDeltas[sampleIndex] == tNext)
+            {
+               sampledStateVectors[sampleIndex] = GetStateVector(tNext, mu, m_nextState);
+            }
+            else
+            {
+               if (!interpolate)
+               {
+                  PrepareDenseOutput(mu, t, h);
+                  interpolate = true;
+               }
+               InterpolateStep(m_state, m_denseTerms, (timeDeltas[sampleIndex] - t) / h, m_sample);
+               sampledStateVectors[sampleIndex] = GetStateVector(timeDeltas[sampleIndex], mu, m_sample);
+            }
+            ++sampleIndex;
+         }
+
+         t = tNext;
+         std::copy(m_nextState, m_nextState + STATE_SIZE, m_state);
+         std::copy(m_stages[NUM_STAGES - 1], m_stages[NUM_STAGES - 1] + STATE_SIZE, m_derivative);
+         if (Rectify(t, mu, m_state))
+         {
+            EvaluateDerivative(t, mu, m_state, m_derivative);
+         }
+      }
+
+      // Adapt the step size to the error estimate
+      const double factor = (errorNorm == 0.0 ? MAX_STEP_FACTOR : STEP_SAFETY_FACTOR * pow(errorNorm, -1.0 / 8.0));
+      h *= std::min(errorNorm <= 1.0 ? MAX_STEP_FACTOR : 1.0, std::max(MIN_STEP_FACTOR, factor));
+   }
+
+   const StateVector finalStateVector = GetStateVector(t, mu, m_state);
+
+   // Samples beyond an incomplete propagation are left at the last state reached
+   while (sampleIndex < timeDeltas.Size())
+   {
+      sampledStateVectors[sampleIndex++] = finalStateVector;
+   }
+
+   return finalStateVector;
+}
+
+////////////////////////////////////////////////////////////
+void RungeKuttaPropagator::EvaluateStage(double mu, int stage, double h, double seconds)
+{
+   for (int i = 0; i < STATE_SIZE; ++i)
+   {
+      double sum = 0.0;
+      for (int j = 0; j < stage; ++j)
+      {
+         sum += DOP853_A[stage][j] * m_stages[j][i];
+      }
+      m_stageState[i] = m_state[i] + h * sum;
+   }
+   EvaluateDerivative(seconds, mu, m_stageState, m_stages[stage]);
+}
+
+////////////////////////////////////////////////////////////
+void RungeKuttaPropagator::PrepareDenseOutput(double mu, double t, double h)
+{
+   // Three extra stages are only needed for steps that contain samples
+   double stageTimes[NUM_DENSE_STAGES - NUM_STAGES];
+   for (int s = NUM_STAGES; s < NUM_DENSE_STAGES; ++s)
+   {
+      stageTimes[s - NUM_STAGES] = t + DOP853_C[s] * h;
+   }
+   PrepareDenseStages(mu, Span<const double>(stageTimes, NUM_DENSE_STAGES - NUM_STAGES));
+   for (int s = NUM_STAGES; s < NUM_DENSE_STAGES; ++s)
+   {
+      EvaluateStage(mu, s, h, stageTimes[s - NUM_STAGES]);
+   }
+
+   for (int i = 0; i < STATE_SIZE; ++i)
+   {
+      const double delta = m_nextState[i] - m_state[i];
+      m_denseTerms[0][i] = delta;
+      m_denseTerms[1][i] = h * m_stages[0][i] - delta;
+      m_denseTerms[2][i] = 2.0 * delta - h * (m_stages[NUM_STAGES - 1][i] + m_stages[0][i]);
+      for (int k = 0; k < 4; ++k)
+      {
+         double sum = 0.0;
+         for (int s = 0; s < NUM_DENSE_STAGES; ++s)
+         {
+            sum += DOP853_D[k][s] * m_stages[s][i];
+         }
+         m_denseTerms[k + 3][i] = h * sum;
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////
+void RungeKuttaPropagator::InitializeState(const StateVector& stateVector, double mu, double* state)
+{
+   for (int i = 0; i < 3; ++i)
+   {
+      state[i] = stateVector.position[i];
+      state[i + 3] = stateVector.velocity[i];
+   }
+}
+
+////////////////////////////////////////////////////////////
+StateVector RungeKuttaPropagator::GetStateVector(double seconds, double mu, const double* state)
+{
+   return StateVector(Vector3d(state[0], state[1], state[2]), Vector3d(state[3], state[4], state[5]));
+}
+
+////////////////////////////////////////////////////////////
+void RungeKuttaPropagator::EvaluateDerivative(double seconds, double mu, const double* state, double* derivative)
+{
+   const Vector3d position(state[0], state[1], state[2]);
+   const double r = position.norm();
+   Vector3d acceleration = -mu / (r * r * r) * position;
+   if (!m_forceModels.empty())
+   {
+      acceleration += GetPerturbingAcceleration(seconds, position, Vector3d(state[3], state[4], state[5]));
+   }
+
+   for (int i = 0; i < 3; ++i)
+   {
+      derivative[i] = state[i + 3];
+      derivative[i + 3] = acceleration[i];
+   }
+}
+
+////////////////////////////////////////////////////////////
+void RungeKuttaPropagator::GetErrorScale(const double* state, const double* nextState, double* scale)
+{
+   for (int i = 0; i < STATE_SIZE; ++i)
+   {
+      scale[i] = std::max(std::abs(state[i]), std::abs(nextState[i]));
+   }
+}
+
+////////////////////////////////////////////////////////////
+bool RungeKuttaPropagator::Rectify(double seconds, double mu, double* state)
+{
+   return false;
+}
+
+////////////////////////////////////////////////////////////
+void RungeKuttaPropagator::PrepareStep(double mu, const Span<const double>& stageTimes)
+{
+
+}
+
+////////////////////////////////////////////////////////////
+void RungeKuttaPropagator::PrepareDenseStages(double mu, const Span<const double>& stageTimes)
+{
+
+}
+
+////////////////////////////////////////////////////////////
+Vector3d RungeKuttaPropagator::GetPerturbingAcceleration(double seconds, const Vector3d& position, const Vector3d& velocity)
+{
+   Vector3d acceleration = Vector3d::Zero();
+   for (const auto& forceModel : m_forceModels)
+   {
+      acceleration += forceModel->GetAcceleration(seconds, position, velocity);
+   }
+   return acceleration;
+}
+
+////////////////////////////////////////////////////////////
+double RungeKuttaPropagator::EstimateInitialStep(double mu, double seconds)
+{
+   const double maxStep = std::abs(seconds);
+
+   // First guess from the magnitudes of the state and its derivative
+   double scale[STATE_SIZE];
+   GetErrorScale(m_state, m_state, scale);
+   const double d0 = ScaledNorm(m_state, scale, m_relativeTolerance, m_absoluteTolerance);
+   const double d1 = ScaledNorm(m_derivative, scale, m_relativeTolerance, m_absoluteTolerance);
+   double h0 = (d0 < 1.0e-5 || d1 < 1.0e-5 ? 1.0e-6 : 0.01 * d0 / d1);
+   h0 = std::min(h0, maxStep);
+
+   // Refine with the second derivative estimated from an explicit Euler step
+   const double direction = (seconds < 0.0 ? -1.0 : 1.0);
+   for (int i = 0; i < STATE_SIZE; ++i)
+   {
+      m_stageState[i] = m_state[i] + direction * h0 * m_derivative[i];
+   }
+   EvaluateDerivative(direction * h0, mu, m_stageState, m_stages[1]);
+   for (int i = 0; i < STATE_SIZE; ++i)
+   {
+      m_stages[1][i] -= m_derivative[i];
+   }
+   const double d2 = ScaledNorm(m_stages[1], scale, m_relativeTolerance, m_absoluteTolerance) / h0;
+
+   const double dMax = std::max(d1, d2);
+   const double h1 = (dMax <= 1.0e-15 ? std::max(1.0e-6, 1.0e-3 * h0) : pow(0.01 / dMax, 1.0 / 8.0));
+   return std::min(std::min(100.0 * h0, h1), maxStep);
+}
+
+} // namespace otl
@@ -13,7 +13,7 @@ void LoggerImpl::Init(const std::string& logDirectory, const std::string& logFil
 {
    std::string loggerName = "OTL";
    bool auto_flush = true;
-   std::string logFile = logDirectory + "\\" + logFilename;
+   std::string logFile = logDirectory + "/" + logFilename;
 
    gLogLevelMap[LogLevel::Debug] = spdlog::level::debug;
    gLogLevelMap[LogLevel::Info] = spdlog::level::info;
@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////
+//
+// OTL - Orbital Trajectory Library
+// Copyright (C) 2013-2018 Jason Bryan (Jmbryan10@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#include <OTL/Core/TabulatedKeplerSolver.h>
+#include <OTL/Core/KeplersEquations.h>
+#include <OTL/Core/KeplerSolver.h>
+#include <algorithm>
+
+namespace otl
+{
+
+namespace keplerian
+{
+
+const int TabulatedKeplerSolver::DEFAULT_INTERVALS;
+const double TabulatedKeplerSolver::MAX_ECCENTRICITY = 0.9;
+const double TabulatedKeplerSolver::ECCENTRICITY_TOLERANCE = 1.0e-4;
+
+////////////////////////////////////////////////////////////
+TabulatedKeplerSolver::TabulatedKeplerSolver() :
+TabulatedKeplerSolver(0.0)
+{
+}
+
+////////////////////////////////////////////////////////////
+TabulatedKeplerSolver::TabulatedKeplerSolver(double eccentricity, int numIntervals) :
+m_eccentricity(eccentricity),
+m_step(0.0),
+m_inverseStep(0.0),
+m_numIntervals(std::max(numIntervals, 1))
+{
+   if (eccentricity < 0.0 || eccentricity > MAX_ECCENTRICITY)
+   {
+      return;
+   }
+
+   m_step = MATH_PI / m_numIntervals;
+   m_inverseStep = m_numIntervals / MATH_PI;
+   m_anomalies.resize(m_numIntervals + 1);
+   m_slopes.resize(m_numIntervals + 1);
+   for (int k = 0; k <= m_numIntervals; ++k)
+   {
+      const double E = KeplerSolverElliptical::SolveHighOrder(eccentricity, k * m_step).anomaly;
+      m_anomalies[k] = E;
+      m_slopes[k] = m_step / (1.0 - eccentricity * cos(E));
+   }
+}
+
+////////////////////////////////////////////////////////////
+double TabulatedKeplerSolver::GetEccentricity() const
+{
+   return m_eccentricity;
+}
+
+////////////////////////////////////////////////////////////
+bool TabulatedKeplerSolver::IsValidFor(double eccentricity) const
+{
+   return !m_anomalies.empty() && fabs(eccentricity - m_eccentricity) <= ECCENTRICITY_TOLERANCE;
+}
+
+////////////////////////////////////////////////////////////
+double TabulatedKeplerSolver::Solve(double meanAnomaly) const
+{
+   return Solve(m_eccentricity, meanAnomaly);
+}
+
+////////////////////////////////////////////////////////////
+double TabulatedKeplerSolver::Solve(double eccentricity, double meanAnomaly) const
+{
+   if (!IsValidFor(eccentricity))
+   {
+      return SolveKeplersEquation(eccentricity, meanAnomaly);
+   }
+
+   // Reduce to [0, pi] using E(-M) = -E(M) and E(M + 2 pi) = E(M) + 2 pi
+   const double offset = EllipticalAnomalyPolicy::MeanAnomalyOffset(meanAnomaly);
+   const double reduced = meanAnomaly - offset;
+   const double M = fabs(reduced);
+
+   // Cubic Hermite interpolation of the tabulated inverse
+   const double x = M * m_inverseStep;
+   const int k = std::min(static_cast<int>(x), m_numIntervals - 1);
+   const double t = x - k;
+   const double t2 = t * t;
+   const double t3 = t2 * t;
+   double E = (2.0 * t3 - 3.0 * t2 + 1.0) * m_anomalies[k] +
+              (t3 - 2.0 * t2 + t)         * m_slopes[k] +
+              (3.0 * t2 - 2.0 * t3)       * m_anomalies[k + 1] +
+              (t3 - t2)                   * m_slopes[k + 1];
+
+   // Single Danby quartic correction at the requested eccentricity
+   double f[4];
+   EllipticalAnomalyPolicy::HighOrderResidual(eccentricity, E, M, f);
+   E += KeplerSolverElliptical::HighOrderCorrection(f);
+
+   return offset + (reduced < 0.0 ? -E : E);
+}
+
+} // namespace keplerian
+
+} // namespace otl
@@ -0,0 +1,63 @@
+////////////////////////////////////////////////////////////
+//
+// OTL - Orbital Trajectory Library
+// Copyright (C) 2013-2018 Jason Bryan (Jmbryan10@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#pragma once
+#include <thread>
+#include <vector>
+
+namespace otl
+{
+
+// Joins every thread it started when it goes out of scope, so that a
+// worker sharing the caller's stack never outlives it, even if the
+// caller returns early or throws.
+class ThreadGroup
+{
+public:
+   ThreadGroup() {}
+   ThreadGroup(const ThreadGroup& other) = delete;
+   ThreadGroup& operator=(const ThreadGroup&) = delete;
+   ~ThreadGroup() { Join(); }
+
+   template<class Function>
+   void Start(Function function)
+   {
+      m_threads.push_back(std::thread(function));
+   }
+
+   void Join()
+   {
+      for (auto& thread : m_threads)
+      {
+         thread.join();
+      }
+      m_threads.clear();
+   }
+
+private:
+   std::vector<std::thread> m_threads;
+};
+
+} // namespace otl
@@ -0,0 +1,129 @@
+////////////////////////////////////////////////////////////
+//
+// OTL - Orbital Trajectory Library
+// Copyright (C) 2013-2018 Jason Bryan (Jmbryan10@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace otl
+{
+
+// Keeps its worker threads waiting between parallel loops, so that a loop
+// run at every integration step does not start and join threads each time.
+// The workers are joined when the pool is destroyed. Functions run by the
+// pool must not throw.
+class WorkerPool
+{
+public:
+   WorkerPool() : m_function(nullptr), m_generation(0), m_numUnclaimed(0), m_numBusy(0), m_stop(false) {}
+   WorkerPool(const WorkerPool& other) = delete;
+   WorkerPool& operator=(const WorkerPool&) = delete;
+
+   ~WorkerPool()
+   {
+      {
+         std::lock_guard<std::mutex> lock(m_mutex);
+         m_stop = true;
+      }
+      m_wake.notify_all();
+      for (auto& thread : m_threads)
+      {
+         thread.join();
+      }
+   }
+
+   // Run the function on the calling thread and on numThreads - 1 workers,
+   // and return once every call has returned
+   void Run(std::size_t numThreads, const std::function<void()>& function)
+   {
+      if (numThreads > 1)
+      {
+         {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            while (m_threads.size() < numThreads - 1)
+            {
+               const std::size_t generation = m_generation;
+               m_threads.push_back(std::thread([this, generation]() { WorkerLoop(generation); }));
+            }
+            m_function = &function;
+            m_numUnclaimed = numThreads - 1;
+            m_numBusy = numThreads - 1;
+            ++m_generation;
+         }
+         m_wake.notify_all();
+      }
+
+      function();
+
+      if (numThreads > 1)
+      {
+         std::unique_lock<std::mutex> lock(m_mutex);
+         m_done.wait(lock, [this]() { return m_numBusy == 0; });
+         m_function = nullptr;
+      }
+   }
+
+private:
+   void WorkerLoop(std::size_t generation)
+   {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      while (true)
+      {
+         // Workers beyond the number requested skip the run and wait for the next one
+         m_wake.wait(lock, [&]() { return m_stop || (m_generation != generation && m_numUnclaimed > 0); });
+         if (m_stop)
+         {
+            return;
+         }
+         generation = m_generation;
+         --m_numUnclaimed;
+         const std::function<void()>& function = *m_function;
+
+         lock.unlock();
+         function();
+         lock.lock();
+
+         if (--m_numBusy == 0)
+         {
+            m_done.notify_one();
+         }
+      }
+   }
+
+   std::vector<std::thread> m_threads;
+   std::mutex m_mutex;
+   std::condition_variable m_wake;
+   std::condition_variable m_done;
+   const std::function<void()>* m_function;
+   std::size_t m_generation;
+   std::size_t m_numUnclaimed;
+   std::size_t m_numBusy;
+   bool m_stop;
+};
+
+} // namespace otl
@@ -1,5 +1,10 @@
 #include <OTL/Core/Unix/SystemImpl.h>
 #include <OTL/Core/Logger.h>
+#include <OTL/Core/Exceptions.h>
+#include <iostream>
+#include <cerrno>
+#include <cstring>
+#include <sys/stat.h>
 #include <unistd.h>
 #include <time.h>
 
@@ -9,7 +14,12 @@ namespace otl
 ////////////////////////////////////////////////////////////
 void SystemImpl::CreateDirectory(const std::string& directory)
 {
-   OTL_ERROR() << "Not implemented yet";
+   // The logger creates its directory through here, so errors cannot be logged
+   if (mkdir(directory.c_str(), 0755) != 0 && errno != EEXIST)
+   {
+      std::cout << "Error caught when trying to create directory " << Bracket(directory) << ": " << std::strerror(errno) << std::endl;
+      throw Exception("Failed to create directory");
+   }
 }
 
 ////////////////////////////////////////////////////////////
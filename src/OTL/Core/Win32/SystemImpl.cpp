@@ -1,7 +1,11 @@
 #include <OTL/Core/Win32/SystemImpl.h>
 #include <OTL/Core/Logger.h>
+#include <OTL/Core/Exceptions.h>
 #include <windows.h>
 #include <direct.h>
+#include <iostream>
+#include <cerrno>
+#include <cstring>
 
 #ifdef CreateDirectory
 #undef CreateDirectory
@@ -21,7 +25,12 @@ namespace otl
 ////////////////////////////////////////////////////////////
 void SystemImpl::CreateDirectory(const std::string& directory)
 {
-   OTL_ERROR() << "Not implemented yet";
+   // The logger creates its directory through here, so errors cannot be logged
+   if (_mkdir(directory.c_str()) != 0 && errno != EEXIST)
+   {
+      std::cout << "Error caught when trying to create directory " << Bracket(directory) << ": " << std::strerror(errno) << std::endl;
+      throw Exception("Failed to create directory");
+   }
 }
 
 ////////////////////////////////////////////////////////////
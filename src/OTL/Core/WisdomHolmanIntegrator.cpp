@@ -0,0 +1,352 @@
+////////////////////////////////////////////////////////////
+//
+// OTL - Orbital Trajectory Library
+// Copyright (C) 2013-2018 Jason Bryan (Jmbryan10@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#include <OTL/Core/WisdomHolmanIntegrator.h>
+#include <OTL/Core/LagrangianPropagator.h>
+#include <OTL/Core/Logger.h>
+#include <OTL/Core/Threading/ThreadGroup.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+namespace otl
+{
+
+namespace
+{
+
+// Number of steps the massive bodies are integrated ahead of the test particles
+const std::size_t BLOCK_STEPS = 256;
+
+// Number of test particles integrated together by one thread
+const std::size_t TEST_PARTICLE_CHUNK = 64;
+
+// Acceleration of a point at the given position due to the massive bodies
+Vector3d GetInteractionAcceleration(const Vector3d& position, const Vector3d* bodyPositions, const double* bodyMu, std::size_t numBodies)
+{
+   Vector3d acceleration = Vector3d::Zero();
+   for (std::size_t j = 0; j < numBodies; ++j)
+   {
+      const Vector3d separation = bodyPositions[j] - position;
+      const double distanceSquared = separation.squaredNorm();
+      acceleration += bodyMu[j] / (distanceSquared * std::sqrt(distanceSquared)) * separation;
+   }
+   return acceleration;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////
+WisdomHolmanIntegrator::WisdomHolmanIntegrator(double mu) :
+m_mu(mu),
+m_numThreads(0),
+m_time(0.0),
+m_openingAngle(0.0)
+{
+}
+
+////////////////////////////////////////////////////////////
+void WisdomHolmanIntegrator::SetNumThreads(int numThreads)
+{
+   m_numThreads = numThreads;
+   m_gravityModel.SetNumThreads(numThreads);
+}
+
+////////////////////////////////////////////////////////////
+void WisdomHolmanIntegrator::SetOpeningAngle(double openingAngle)
+{
+   m_openingAngle = openingAngle;
+   m_gravityModel.SetOpeningAngle(openingAngle);
+}
+
+////////////////////////////////////////////////////////////
+std::size_t WisdomHolmanIntegrator::AddBody(double mu, const StateVector& stateVector)
+{
+   m_bodyMu.push_back(mu);
+   m_bodies.push_back(stateVector);
+   return m_bodies.size() - 1;
+}
+
+////////////////////////////////////////////////////////////
+void WisdomHolmanIntegrator::AddTestParticles(const Span<const StateVector>& stateVectors)
+{
+   m_testParticles.insert(m_testParticles.end(), stateVectors.Data(), stateVectors.Data() + stateVectors.Size());
+}
+
+////////////////////////////////////////////////////////////
+std::size_t WisdomHolmanIntegrator::GetNumBodies() const
+{
+   return m_bodies.size();
+}
+
+////////////////////////////////////////////////////////////
+std::size_t WisdomHolmanIntegrator::GetNumTestParticles() const
+{
+   return m_testParticles.size();
+}
+
+////////////////////////////////////////////////////////////
+Time WisdomHolmanIntegrator::GetTime() const
+{
+   return Time::Seconds(m_time);
+}
+
+////////////////////////////////////////////////////////////
+StateVector WisdomHolmanIntegrator::GetBodyStateVector(std::size_t index) const
+{
+   return m_bodies[index];
+}
+
+////////////////////////////////////////////////////////////
+StateVector WisdomHolmanIntegrator::GetTestParticleStateVector(std::size_t index) const
+{
+   return m_testParticles[index];
+}
+
+////////////////////////////////////////////////////////////
+double WisdomHolmanIntegrator::GetEnergy() const
+{
+   // Barycentric velocity of the central body
+   double totalMu = m_mu;
+   Vector3d momentum = Vector3d::Zero();
+   for (std::size_t i = 0; i < m_bodies.size(); ++i)
+   {
+      totalMu += m_bodyMu[i];
+      momentum += m_bodyMu[i] * m_bodies[i].velocity;
+   }
+   const Vector3d centralVelocity = -momentum / totalMu;
+
+   double energy = 0.5 * m_mu * centralVelocity.squaredNorm();
+   for (std::size_t i = 0; i < m_bodies.size(); ++i)
+   {
+      energy += 0.5 * m_bodyMu[i] * (m_bodies[i].velocity + centralVelocity).squaredNorm();
+      energy -= m_mu * m_bodyMu[i] / m_bodies[i].position.norm();
+      for (std::size_t j = i + 1; j < m_bodies.size(); ++j)
+      {
+         energy -= m_bodyMu[i] * m_bodyMu[j] / (m_bodies[j].position - m_bodies[i].position).norm();
+      }
+   }
+   return energy;
+}
+
+////////////////////////////////////////////////////////////
+void WisdomHolmanIntegrator::Integrate(const Time& timeDelta, const Time& stepSize)
+{
+   const double seconds = timeDelta.Seconds();
+   const double maxStep = std::abs(stepSize.Seconds());
+   if (maxStep <= 0.0)
+   {
+      OTL_ERROR() << "Invalid step size " << Bracket(stepSize.Seconds());
+      return;
+   }
+   if (seconds == 0.0)
+   {
+      return;
+   }
+
+   const std::size_t totalSteps = static_cast<std::size_t>(std::ceil(std::abs(seconds) / maxStep));
+   const double step = seconds / totalSteps;
+   const double halfStep = 0.5 * step;
+   const std::size_t numBodies = m_bodies.size();
+   const std::size_t numTestParticles = m_testParticles.size();
+
+   // Heliocentric to barycentric velocities
+   double totalMu = m_mu;
+   Vector3d momentum = Vector3d::Zero();
+   for (std::size_t i = 0; i < numBodies; ++i)
+   {
+      totalMu += m_bodyMu[i];
+      momentum += m_bodyMu[i] * m_bodies[i].velocity;
+   }
+   ShiftVelocities(-momentum / totalMu);
+
+   keplerian::LagrangianPropagator propagator;
+   const std::vector<double> bodyTimeDeltas(numBodies, step);
+
+   std::size_t numThreads = (m_numThreads > 0 ? m_numThreads : std::thread::hardware_concurrency());
+   const std::size_t numChunks = (numTestParticles + TEST_PARTICLE_CHUNK - 1) / TEST_PARTICLE_CHUNK;
+   numThreads = std::max<std::size_t>(1, std::min(numThreads, numChunks));
+   m_workerTimeDeltas.resize(numThreads);
+
+   for (std::size_t blockStart = 0; blockStart < totalSteps; blockStart += BLOCK_STEPS)
+   {
+      const std::size_t numSteps = std::min(BLOCK_STEPS, totalSteps - blockStart);
+      m_positionHistory.resize((numSteps + 1) * numBodies);
+      m_jumpHistory.resize(2 * numSteps);
+      for (std::size_t i = 0; i < numBodies; ++i)
+      {
+         m_positionHistory[i] = m_bodies[i].position;
+      }
+
+      // The test particles do not perturb the massive bodies, so the bodies run ahead through the block
+      for (std::size_t s = 0; s < numSteps; ++s)
+      {
+         KickBodies(halfStep);
+
+         const Vector3d jumpBefore = GetJumpVelocity();
+         for (std::size_t i = 0; i < numBodies; ++i)
+         {
+            m_bodies[i].position += halfStep * jumpBefore;
+         }
+
+         propagator.PropagateStateVectors(m_bodies, m_mu, bodyTimeDeltas, m_bodies);
+
+         const Vector3d jumpAfter = GetJumpVelocity();
+         for (std::size_t i = 0; i < numBodies; ++i)
+         {
+            m_bodies[i].position += halfStep * jumpAfter;
+            m_positionHistory[(s + 1) * numBodies + i] = m_bodies[i].position;
+         }
+
+         KickBodies(halfStep);
+
+         m_jumpHistory[2 * s] = jumpBefore;
+         m_jumpHistory[2 * s + 1] = jumpAfter;
+      }
+
+      std::atomic<std::size_t> nextChunk(0);
+      auto worker = [&](std::size_t index)
+      {
+         for (std::size_t c = nextChunk++; c < numChunks; c = nextChunk++)
+         {
+            const std::size_t begin = c * TEST_PARTICLE_CHUNK;
+            IntegrateTestParticles(begin, std::min(begin + TEST_PARTICLE_CHUNK, numTestParticles), numSteps, step, m_workerTimeDeltas[index]);
+         }
+      };
+
+      // The calling thread works alongside the additional threads
+      ThreadGroup threads;
+      for (std::size_t i = 1; i < numThreads; ++i)
+      {
+         threads.Start([&worker, i]() { worker(i); });
+      }
+      worker(0);
+      threads.Join();
+   }
+
+   // Barycentric to heliocentric velocities
+   ShiftVelocities(GetJumpVelocity());
+
+   m_time += seconds;
+}
+
+////////////////////////////////////////////////////////////
+void WisdomHolmanIntegrator::ShiftVelocities(const Vector3d& velocity)
+{
+   for (auto& body : m_bodies)
+   {
+      body.velocity += velocity;
+   }
+   for (auto& testParticle : m_testParticles)
+   {
+      testParticle.velocity += velocity;
+   }
+}
+
+////////////////////////////////////////////////////////////
+Vector3d WisdomHolmanIntegrator::GetJumpVelocity() const
+{
+   Vector3d momentum = Vector3d::Zero();
+   for (std::size_t i = 0; i < m_bodies.size(); ++i)
+   {
+      momentum += m_bodyMu[i] * m_bodies[i].velocity;
+   }
+   return momentum / m_mu;
+}
+
+////////////////////////////////////////////////////////////
+void WisdomHolmanIntegrator::KickBodies(double seconds)
+{
+   const std::size_t numBodies = m_bodies.size();
+   if (m_openingAngle > 0.0)
+   {
+      m_bodyPositions.resize(numBodies);
+      m_bodyAccelerations.resize(numBodies);
+      for (std::size_t i = 0; i < numBodies; ++i)
+      {
+         m_bodyPositions[i] = m_bodies[i].position;
+      }
+
+      // Each body skips itself, and the indirect term is handled by the jump
+      m_gravityModel.SetBodies(m_bodyMu, m_bodyPositions);
+      m_gravityModel.GetAccelerations(m_bodyPositions, m_bodyAccelerations);
+      const Vector3d& indirect = m_gravityModel.GetIndirectAcceleration();
+      for (std::size_t i = 0; i < numBodies; ++i)
+      {
+         m_bodies[i].velocity += seconds * (m_bodyAccelerations[i] + indirect);
+      }
+      return;
+   }
+
+   for (std::size_t i = 0; i < numBodies; ++i)
+   {
+      for (std::size_t j = i + 1; j < numBodies; ++j)
+      {
+         const Vector3d separation = m_bodies[j].position - m_bodies[i].position;
+         const double distanceSquared = separation.squaredNorm();
+         const Vector3d impulse = seconds / (distanceSquared * std::sqrt(distanceSquared)) * separation;
+         m_bodies[i].velocity += m_bodyMu[j] * impulse;
+         m_bodies[j].velocity -= m_bodyMu[i] * impulse;
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////
+void WisdomHolmanIntegrator::IntegrateTestParticles(std::size_t begin, std::size_t end, std::size_t numSteps, double seconds, std::vector<double>& timeDeltas)
+{
+   const std::size_t numBodies = m_bodies.size();
+   const double halfStep = 0.5 * seconds;
+   const Span<StateVector> testParticles(m_testParticles.data() + begin, end - begin);
+   timeDeltas.assign(testParticles.Size(), seconds);
+
+   keplerian::LagrangianPropagator propagator;
+   for (std::size_t s = 0; s < numSteps; ++s)
+   {
+      const Vector3d* positionsBefore = m_positionHistory.data() + s * numBodies;
+      const Vector3d* positionsAfter = positionsBefore + numBodies;
+      const Vector3d& jumpBefore = m_jumpHistory[2 * s];
+      const Vector3d& jumpAfter = m_jumpHistory[2 * s + 1];
+
+      for (std::size_t i = 0; i < testParticles.Size(); ++i)
+      {
+         StateVector& testParticle = testParticles[i];
+         testParticle.velocity += halfStep * GetInteractionAcceleration(testParticle.position, positionsBefore, m_bodyMu.data(), numBodies);
+         testParticle.position += halfStep * jumpBefore;
+      }
+
+      // The batch propagator reads each group of lanes before writing it, so the drift can be done in place
+      propagator.PropagateStateVectors(testParticles, m_mu, timeDeltas, testParticles);
+
+      for (std::size_t i = 0; i < testParticles.Size(); ++i)
+      {
+         StateVector& testParticle = testParticles[i];
+         testParticle.position += halfStep * jumpAfter;
+         testParticle.velocity += halfStep * GetInteractionAcceleration(testParticle.position, positionsAfter, m_bodyMu.data(), numBodies);
+      }
+   }
+}
+
+} // namespace otl
@@ -1,5 +1,11 @@
 #include <OTL/Test/BaseTest.h>
 #include <OTL/Core/Conversion.h>
+#include <OTL/Core/Epoch.h>
+#include <OTL/Core/JplApproximateEphemeris.h>
+#include <OTL/Core/TabulatedKeplerSolver.h>
+#include <cstdio>
+#include <fstream>
+#include <random>
 
 TEST_CASE("StateVector2OrbitalElements, Conversion")
 {
@@ -63,6 +69,45 @@ TEST_CASE("StateVector2OrbitalElements, Conversion")
         CHECK(orbitalElements.lonOfAscendingNode == OTL_APPROX(255.279 * otl::MATH_DEG_TO_RAD)); // [rad]
         CHECK(trueAnomaly                        == OTL_APPROX(28.4456 * otl::MATH_DEG_TO_RAD)); // [rad]
     }
+
+    /// Test StateVector2OrbitalElements() recovers the argument of pericenter of equatorial orbits in every quadrant.
+    SECTION("Equatorial")
+    {
+        mu = otl::ASTRO_MU_EARTH;
+        for (double argOfPericenter : {1.0, 2.5, 4.0, 5.5})
+        {
+            const otl::OrbitalElements expected(10000.0, 0.3, 1.0, 0.0, argOfPericenter, 0.0);
+            stateVector = otl::ConvertOrbitalElements2StateVector(expected, mu);
+
+            orbitalElements = otl::ConvertStateVector2OrbitalElements(stateVector, mu);
+
+            CHECK(orbitalElements.inclination        == 0.0);
+            CHECK(orbitalElements.lonOfAscendingNode == 0.0);
+            CHECK(orbitalElements.argOfPericenter    == OTL_APPROX(argOfPericenter)); // [rad]
+            CHECK(orbitalElements.meanAnomaly        == OTL_APPROX(1.0));             // [rad]
+        }
+    }
+
+    /// Test StateVector2OrbitalElements() recovers the argument of pericenter of retrograde equatorial orbits in every quadrant.
+    SECTION("Retrograde Equatorial")
+    {
+        mu = otl::ASTRO_MU_EARTH;
+        for (double argOfPericenter : {1.0, 2.5, 4.0, 5.5})
+        {
+            // Mirroring the prograde orbit across the x axis gives the orbit with i = pi, keeping the state vector in the plane
+            const otl::OrbitalElements prograde(10000.0, 0.3, 1.0, 0.0, argOfPericenter, 0.0);
+            stateVector = otl::ConvertOrbitalElements2StateVector(prograde, mu);
+            stateVector.position.y() = -stateVector.position.y();
+            stateVector.velocity.y() = -stateVector.velocity.y();
+
+            orbitalElements = otl::ConvertStateVector2OrbitalElements(stateVector, mu);
+
+            CHECK(orbitalElements.inclination        == otl::MATH_PI);                // [rad]
+            CHECK(orbitalElements.lonOfAscendingNode == 0.0);
+            CHECK(orbitalElements.argOfPericenter    == OTL_APPROX(argOfPericenter)); // [rad]
+            CHECK(orbitalElements.meanAnomaly        == OTL_APPROX(1.0));             // [rad]
+        }
+    }
 }
 
 TEST_CASE("OrbitalElements2StateVector, Conversion")
@@ -143,4 +188,144 @@ TEST_CASE("OrbitalElements2StateVector, Conversion")
         CHECK(stateVector.velocity.y() == OTL_APPROX(-4.77192)); // [km/s]
         CHECK(stateVector.velocity.z() == OTL_APPROX(1.74388));  // [km/s]
     }
-}
\ No newline at end of file
+
+    /// Test OrbitalElements2StateVector() with a TabulatedKeplerSolver against Fundamentals of Astrodynamics and Applications 3rd Edition, David Vallado, Example 2-6.
+    SECTION("Truth Case: Vallado 2-6 (tabulated)")
+    {
+        double trueAnomaly = 92.335 * otl::MATH_DEG_TO_RAD;   // [rad]
+
+        orbitalElements.semiMajorAxis      = 36127.343;                     // [km]
+        orbitalElements.eccentricity       = 0.83285;
+        orbitalElements.inclination        = 87.87 * otl::MATH_DEG_TO_RAD;  // [rad]
+        orbitalElements.argOfPericenter    = 53.38 * otl::MATH_DEG_TO_RAD;  // [rad]
+        orbitalElements.lonOfAscendingNode = 227.89 * otl::MATH_DEG_TO_RAD; // [rad]
+        orbitalElements.meanAnomaly        = otl::ConvertTrueAnomaly2MeanAnomaly(orbitalElements.eccentricity, trueAnomaly);
+        mu = otl::ASTRO_MU_EARTH;                                           // [km^3/s^2]
+
+        otl::keplerian::TabulatedKeplerSolver kepler(orbitalElements.eccentricity + 5.0e-5);
+        REQUIRE(kepler.IsValidFor(orbitalElements.eccentricity));
+        stateVector = otl::ConvertOrbitalElements2StateVector(orbitalElements, mu, kepler);
+        otl::StateVector expected = otl::ConvertOrbitalElements2StateVector(orbitalElements, mu);
+
+        CHECK(stateVector.position.x() == OTL_APPROX(6525.344));  // [km]
+        CHECK(stateVector.position.y() == OTL_APPROX(6861.535));  // [km]
+        CHECK(stateVector.position.z() == OTL_APPROX(6449.125));  // [km]
+        CHECK(stateVector.velocity.x() == OTL_APPROX(4.902276));  // [km/s]
+        CHECK(stateVector.velocity.y() == OTL_APPROX(5.533124));  // [km/s]
+        CHECK(stateVector.velocity.z() == OTL_APPROX(-1.975709)); // [km/s]
+        CHECK((stateVector.position - expected.position).norm() < 1.0e-8);
+        CHECK((stateVector.velocity - expected.velocity).norm() < 1.0e-12);
+    }
+
+    /// Test JplApproximateEphemeris::GetStateVector() against the conversion of its orbital elements.
+    SECTION("JplApproximateEphemeris")
+    {
+        // Mars with an exaggerated eccentricity rate, so the Kepler's Equation
+        // table is rebuilt many times across the queried epochs
+        const char* filename = "JplApproximateEphemerisTest.data";
+        {
+            std::ofstream ofs(filename);
+            ofs << "1800 2200\n1\nMars\n"
+                << "1.52371034 0.09339410 1.84969142 -4.55343205 -23.94362959 49.55953891 "
+                << "0.00001847 0.01 -0.00813131 19140.30268499 0.44441088 -0.29257343\n"
+                << "0.0 0.0 0.0 0.0\n";
+        }
+        otl::JplApproximateEphemeris ephemeris(filename);
+        mu = otl::ASTRO_MU_SUN;
+
+        // Forwards and backwards over two centuries
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            for (int day = -36500; day <= 36500; day += 97)
+            {
+                const otl::Epoch epoch = otl::Epoch::MJD2000(pass == 0 ? day : -day);
+                stateVector = ephemeris.GetStateVector("Mars", epoch);
+                const otl::StateVector expected = otl::ConvertOrbitalElements2StateVector(ephemeris.GetOrbitalElements("Mars", epoch), mu);
+                CHECK((stateVector.position - expected.position).norm() < 1.0e-12 * expected.position.norm());
+                CHECK((stateVector.velocity - expected.velocity).norm() < 1.0e-12 * expected.velocity.norm());
+            }
+        }
+        std::remove(filename);
+    }
+}
+
+TEST_CASE("Batch, Conversion")
+{
+    const double mu = otl::ASTRO_MU_EARTH;
+    const std::size_t count = 1000; // spans several conversion passes
+
+    std::mt19937 generator(12345);
+    std::uniform_real_distribution<double> semiMajorAxis(7000.0, 42000.0);
+    std::uniform_real_distribution<double> eccentricity(0.001, 0.9);
+    std::uniform_real_distribution<double> meanAnomaly(0.1, 3.0);
+    std::uniform_real_distribution<double> angle(0.1, 3.0);
+
+    std::vector<double> a(count), e(count), M(count), incl(count), aop(count), lan(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        a[i] = semiMajorAxis(generator);
+        e[i] = eccentricity(generator);
+        M[i] = (i % 2 == 0 ? meanAnomaly(generator) : -meanAnomaly(generator));
+        incl[i] = angle(generator);
+        aop[i] = 2.0 * angle(generator);
+        lan[i] = 2.0 * angle(generator);
+    }
+
+    // Lanes handled by the scalar fallbacks
+    a[10] = -20000.0; e[10] = 1.5;  // hyperbolic
+    incl[20] = 0.0;                  // equatorial
+    e[30] = 0.0;                     // circular
+
+    const otl::OrbitalElementsSpan<double> orbitalElements(a, e, M, incl, aop, lan);
+    std::vector<double> rx(count), ry(count), rz(count), vx(count), vy(count), vz(count);
+    const otl::Vector3Span<double> positions(rx, ry, rz), velocities(vx, vy, vz);
+
+    SECTION("OrbitalElements2StateVector")
+    {
+        otl::ConvertOrbitalElements2StateVectorBatch(orbitalElements, mu, positions, velocities);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const otl::StateVector expected = otl::ConvertOrbitalElements2StateVector(orbitalElements.Get(i), mu);
+            CHECK((positions.Get(i) - expected.position).norm() < 1.0e-8 * expected.position.norm());
+            CHECK((velocities.Get(i) - expected.velocity).norm() < 1.0e-8 * expected.velocity.norm());
+        }
+    }
+
+    SECTION("StateVector2OrbitalElements")
+    {
+        e[30] = 0.5; // the scalar conversion is not well-conditioned for nearly circular state vectors
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const otl::StateVector stateVector = otl::ConvertOrbitalElements2StateVector(orbitalElements.Get(i), mu);
+            positions.Set(i, stateVector.position);
+            velocities.Set(i, stateVector.velocity);
+        }
+
+        std::vector<double> a2(count), e2(count), M2(count), incl2(count), aop2(count), lan2(count);
+        const otl::OrbitalElementsSpan<double> converted(a2, e2, M2, incl2, aop2, lan2);
+        otl::ConvertStateVector2OrbitalElementsBatch(positions, velocities, mu, converted);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const otl::OrbitalElements expected = otl::ConvertStateVector2OrbitalElements(
+                otl::StateVector(positions.Get(i), velocities.Get(i)), mu);
+            CHECK(a2[i] == OTL_APPROX(expected.semiMajorAxis));
+            CHECK(std::abs(e2[i] - expected.eccentricity) < 1.0e-10);
+            CHECK(std::abs(M2[i] - expected.meanAnomaly) < 1.0e-8);
+            CHECK(std::abs(incl2[i] - expected.inclination) < 1.0e-8);
+            CHECK(std::abs(aop2[i] - expected.argOfPericenter) < 1.0e-8);
+            CHECK(std::abs(lan2[i] - expected.lonOfAscendingNode) < 1.0e-8);
+        }
+
+        // Round trip through both batched conversions
+        std::vector<double> rx2(count), ry2(count), rz2(count), vx2(count), vy2(count), vz2(count);
+        const otl::Vector3Span<double> positions2(rx2, ry2, rz2), velocities2(vx2, vy2, vz2);
+        otl::ConvertOrbitalElements2StateVectorBatch(converted, mu, positions2, velocities2);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            CHECK((positions2.Get(i) - positions.Get(i)).norm() < 1.0e-6);
+            CHECK((velocities2.Get(i) - velocities.Get(i)).norm() < 1.0e-9);
+        }
+    }
+}
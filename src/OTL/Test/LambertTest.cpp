@@ -1,5 +1,18 @@
 #include <OTL/Test/BaseTest.h>
+#include <OTL/Core/LambertCache.h>
 #include <OTL/Core/LambertExponentialSinusoid.h>
+#include <OTL/Core/LambertExponentialSinusoidSingleRev.h>
+#include <OTL/Core/LambertHouseholder.h>
+#include <OTL/Core/LagrangianPropagator.h>
+#include <OTL/Core/Porkchop.h>
+#include <OTL/Core/PreparedLambertGeometry.h>
+#include <OTL/Core/UserDefinedBody.h>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <thread>
 
 TEST_CASE("ExponentialSinusoidLambert", "Lambert")
 {
@@ -164,4 +177,927 @@ TEST_CASE("ExponentialSinusoidLambert", "Lambert")
             CHECK(finalVelocity.z()   == OTL_APPROX(0.250135563));    // [VU]
         }
     }
-}
\ No newline at end of file
+
+    SECTION("EvaluateBatch")
+    {
+        /// Test ExponentialSinusoidLambert.EvaluateBatch() reproduces ExponentialSinusoidLambert.Evaluate() for every element.
+        SECTION("Batch Matches Scalar")
+        {
+            const std::size_t size = 21; // deliberately not a multiple of the lane width
+            std::vector<double> r1x(size), r1y(size), r1z(size);
+            std::vector<double> r2x(size), r2y(size), r2z(size);
+            std::vector<double> v1x(size), v1y(size), v1z(size);
+            std::vector<double> v2x(size), v2y(size), v2z(size);
+            std::vector<double> timeDeltas(size);
+            std::vector<int> numRevolutions(size);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                double angle = 0.3 + 0.25 * i;
+                r1x[i] = 1.0;                         r1y[i] = 0.0;                         r1z[i] = 0.0;
+                r2x[i] = (1.2 + 0.1 * i) * cos(angle); r2y[i] = (1.2 + 0.1 * i) * sin(angle); r2z[i] = 0.05 * i;
+                numRevolutions[i] = static_cast<int>(i % 3 == 2);
+                timeDeltas[i] = 1.5 + 0.2 * i + otl::MATH_2_PI * 1.6 * numRevolutions[i];
+            }
+            mu = 1.0;
+
+            lambert.EvaluateBatch(otl::Vector3Span<const double>(r1x, r1y, r1z),
+                                  otl::Vector3Span<const double>(r2x, r2y, r2z),
+                                  timeDeltas,
+                                  numRevolutions,
+                                  direction,
+                                  mu,
+                                  otl::Vector3Span<double>(v1x, v1y, v1z),
+                                  otl::Vector3Span<double>(v2x, v2y, v2z));
+
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                lambert.Evaluate(otl::Vector3d(r1x[i], r1y[i], r1z[i]),
+                                 otl::Vector3d(r2x[i], r2y[i], r2z[i]),
+                                 otl::Time::Seconds(timeDeltas[i]),
+                                 direction,
+                                 numRevolutions[i],
+                                 mu,
+                                 initialVelocity,
+                                 finalVelocity);
+
+                CHECK(v1x[i] == initialVelocity.x());
+                CHECK(v1y[i] == initialVelocity.y());
+                CHECK(v1z[i] == initialVelocity.z());
+                CHECK(v2x[i] == finalVelocity.x());
+                CHECK(v2y[i] == finalVelocity.y());
+                CHECK(v2z[i] == finalVelocity.z());
+            }
+        }
+
+        /// Test ExponentialSinusoidLambert.EvaluateBatch() reproduces ExponentialSinusoidLambert.Evaluate() when the initial secant residuals are equal.
+        SECTION("Equal Initial Residuals")
+        {
+            // A zero time of flight makes both initial residuals infinite, so
+            // the scalar solver takes no secant step. The other lanes iterate.
+            std::vector<double> r1x = { 1.0, 1.0, 1.0 }, r1y = { 0.0, 0.0, 0.0 }, r1z = { 0.0, 0.0, 0.0 };
+            std::vector<double> r2x = { -0.8, -0.8, 0.2 }, r2y = { 1.1, 1.1, 1.4 }, r2z = { 0.1, 0.1, 0.0 };
+            std::vector<double> timeDeltas = { 2.5, 0.0, 3.0 };
+            std::vector<int> numRevolutions = { 0, 0, 0 };
+            std::vector<double> v1x(3), v1y(3), v1z(3), v2x(3), v2y(3), v2z(3);
+            mu = 1.0;
+
+            lambert.EvaluateBatch(otl::Vector3Span<const double>(r1x, r1y, r1z),
+                                  otl::Vector3Span<const double>(r2x, r2y, r2z),
+                                  timeDeltas,
+                                  numRevolutions,
+                                  direction,
+                                  mu,
+                                  otl::Vector3Span<double>(v1x, v1y, v1z),
+                                  otl::Vector3Span<double>(v2x, v2y, v2z));
+
+            for (std::size_t i = 0; i < timeDeltas.size(); ++i)
+            {
+                lambert.Evaluate(otl::Vector3d(r1x[i], r1y[i], r1z[i]),
+                                 otl::Vector3d(r2x[i], r2y[i], r2z[i]),
+                                 otl::Time::Seconds(timeDeltas[i]),
+                                 direction,
+                                 numRevolutions[i],
+                                 mu,
+                                 initialVelocity,
+                                 finalVelocity);
+
+                REQUIRE(std::isfinite(initialVelocity.norm()));
+                CHECK(v1x[i] == initialVelocity.x());
+                CHECK(v1y[i] == initialVelocity.y());
+                CHECK(v1z[i] == initialVelocity.z());
+                CHECK(v2x[i] == finalVelocity.x());
+                CHECK(v2y[i] == finalVelocity.y());
+                CHECK(v2z[i] == finalVelocity.z());
+            }
+        }
+    }
+
+    SECTION("EvaluateScreening")
+    {
+        /// Test ExponentialSinusoidLambert.EvaluateScreening() agrees with ExponentialSinusoidLambert.Evaluate() to screening accuracy.
+        SECTION("Reduced and Single Precision")
+        {
+            initialPosition = otl::Vector3d({ 1.0, 0.0, 0.0 });  // [DU]
+            mu = 1.0;
+
+            const otl::SolverAccuracy accuracies[] = { otl::SolverAccuracy::Full, otl::SolverAccuracy::Reduced, otl::SolverAccuracy::Single };
+            otl::Vector3d screenedInitialVelocity, screenedFinalVelocity;
+            for (int i = 0; i < 20; ++i)
+            {
+                double angle = 0.3 + 0.25 * i;
+                finalPosition = otl::Vector3d({ 1.5 * cos(angle), 1.5 * sin(angle), 0.1 }); // [DU]
+                int numRevolutions = i % 2;
+                timeOfFlight = otl::Time::Seconds(2.0 + 0.1 * i + otl::MATH_2_PI * 1.6 * numRevolutions); // [TU]
+
+                lambert.Evaluate(initialPosition,
+                                 finalPosition,
+                                 timeOfFlight,
+                                 direction,
+                                 numRevolutions,
+                                 mu,
+                                 initialVelocity,
+                                 finalVelocity);
+
+                for (auto accuracy : accuracies)
+                {
+                    lambert.EvaluateScreening(initialPosition,
+                                              finalPosition,
+                                              timeOfFlight,
+                                              direction,
+                                              numRevolutions,
+                                              mu,
+                                              accuracy,
+                                              otl::MATH_SCREENING_TOLERANCE,
+                                              screenedInitialVelocity,
+                                              screenedFinalVelocity);
+
+                    CHECK((screenedInitialVelocity - initialVelocity).norm() < 1.0e-3 * initialVelocity.norm());
+                    CHECK((screenedFinalVelocity - finalVelocity).norm() < 1.0e-3 * finalVelocity.norm());
+                }
+            }
+        }
+    }
+
+    SECTION("EvaluateJacobian")
+    {
+        /// Test ExponentialSinusoidLambert.EvaluateBatch() with jacobians reproduces ExponentialSinusoidLambert.EvaluateJacobian() for every element.
+        SECTION("Batch Matches Scalar")
+        {
+            const std::size_t size = 11;
+            std::vector<double> r1x(size, 1.0), r1y(size, 0.0), r1z(size, 0.0);
+            std::vector<double> r2x(size), r2y(size), r2z(size);
+            std::vector<double> v1x(size), v1y(size), v1z(size);
+            std::vector<double> v2x(size), v2y(size), v2z(size);
+            std::vector<double> timeDeltas(size);
+            std::vector<int> numRevolutions(size, 0);
+            std::vector<otl::keplerian::LambertJacobian> jacobians(size);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                double angle = 0.5 + 0.3 * i;
+                r2x[i] = 1.5 * cos(angle); r2y[i] = 1.5 * sin(angle); r2z[i] = 0.1;
+                timeDeltas[i] = 2.0 + 0.1 * i;
+            }
+            mu = 1.0;
+
+            lambert.EvaluateBatch(otl::Vector3Span<const double>(r1x, r1y, r1z),
+                                  otl::Vector3Span<const double>(r2x, r2y, r2z),
+                                  timeDeltas,
+                                  numRevolutions,
+                                  direction,
+                                  mu,
+                                  otl::Vector3Span<double>(v1x, v1y, v1z),
+                                  otl::Vector3Span<double>(v2x, v2y, v2z),
+                                  jacobians);
+
+            otl::keplerian::LambertJacobian jacobian;
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                lambert.EvaluateJacobian(otl::Vector3d(r1x[i], r1y[i], r1z[i]),
+                                         otl::Vector3d(r2x[i], r2y[i], r2z[i]),
+                                         otl::Time::Seconds(timeDeltas[i]),
+                                         direction,
+                                         numRevolutions[i],
+                                         mu,
+                                         initialVelocity,
+                                         finalVelocity,
+                                         jacobian);
+
+                CHECK(v1x[i] == initialVelocity.x());
+                CHECK(v2z[i] == finalVelocity.z());
+                CHECK(jacobians[i] == jacobian);
+            }
+        }
+    }
+
+    SECTION("EvaluateWarmStart")
+    {
+        /// Test ExponentialSinusoidLambert.EvaluateWarmStart() matches ExponentialSinusoidLambert.Evaluate() along a sweep in time of flight with fewer iterations.
+        SECTION("Time of Flight Sweep")
+        {
+            initialPosition = otl::Vector3d({ 1.0, 0.0, 0.0 });  // [DU]
+            finalPosition = otl::Vector3d({ -0.8, 1.1, 0.1 });   // [DU]
+            mu = 1.0;
+
+            otl::keplerian::LambertSolverState coldState, warmState;
+            int coldIterations = 0, warmIterations = 0;
+            otl::Vector3d warmInitialVelocity, warmFinalVelocity;
+            for (int i = 0; i < 50; ++i)
+            {
+                timeOfFlight = otl::Time::Seconds(2.0 + 0.02 * i); // [TU]
+
+                lambert.Evaluate(initialPosition,
+                                 finalPosition,
+                                 timeOfFlight,
+                                 direction,
+                                 maxRevolutions,
+                                 mu,
+                                 initialVelocity,
+                                 finalVelocity);
+
+                // An invalid state falls back to the cold start
+                coldState.valid = false;
+                lambert.EvaluateWarmStart(initialPosition,
+                                          finalPosition,
+                                          timeOfFlight,
+                                          direction,
+                                          maxRevolutions,
+                                          mu,
+                                          coldState,
+                                          warmInitialVelocity,
+                                          warmFinalVelocity);
+                coldIterations += coldState.iterations;
+
+                lambert.EvaluateWarmStart(initialPosition,
+                                          finalPosition,
+                                          timeOfFlight,
+                                          direction,
+                                          maxRevolutions,
+                                          mu,
+                                          warmState,
+                                          warmInitialVelocity,
+                                          warmFinalVelocity);
+                warmIterations += warmState.iterations;
+
+                CHECK(warmState.valid);
+                CHECK(warmInitialVelocity.x() == OTL_APPROX(initialVelocity.x()));
+                CHECK(warmInitialVelocity.y() == OTL_APPROX(initialVelocity.y()));
+                CHECK(warmInitialVelocity.z() == OTL_APPROX(initialVelocity.z()));
+                CHECK(warmFinalVelocity.x()   == OTL_APPROX(finalVelocity.x()));
+                CHECK(warmFinalVelocity.y()   == OTL_APPROX(finalVelocity.y()));
+                CHECK(warmFinalVelocity.z()   == OTL_APPROX(finalVelocity.z()));
+            }
+
+            CHECK(2 * warmIterations <= coldIterations);
+        }
+    }
+}
+
+TEST_CASE("ExponentialSinusoidSingleRevLambert", "Lambert")
+{
+    auto lambert = otl::keplerian::LambertExponentialSinusoid();
+    auto singleRevLambert = otl::keplerian::LambertExponentialSinusoidSingleRev();
+
+    otl::Vector3d initialPosition, finalPosition;
+    otl::Vector3d initialVelocity, finalVelocity;
+    otl::Vector3d singleRevInitialVelocity, singleRevFinalVelocity;
+    otl::Time timeOfFlight;
+    double mu = 1.0;
+    otl::keplerian::Orbit::Direction direction = otl::keplerian::Orbit::Direction::Prograde;
+
+    /// Test ExponentialSinusoidSingleRevLambert.Evaluate() reproduces ExponentialSinusoidLambert.Evaluate() exactly.
+    SECTION("Evaluate Matches General Solver")
+    {
+        initialPosition = otl::Vector3d({ 1.0, 0.0, 0.0 }); // [DU]
+        for (int i = 0; i < 20; ++i)
+        {
+            double angle = 0.3 + 0.3 * i;
+            finalPosition = otl::Vector3d({ 1.4 * cos(angle), 1.4 * sin(angle), 0.05 * i }); // [DU]
+            int numRevolutions = static_cast<int>(i % 4 == 3);
+            timeOfFlight = otl::Time::Seconds(1.5 + 0.2 * i + otl::MATH_2_PI * 1.6 * numRevolutions); // [TU]
+
+            lambert.Evaluate(initialPosition, finalPosition, timeOfFlight, direction, numRevolutions, mu, initialVelocity, finalVelocity);
+            singleRevLambert.Evaluate(initialPosition, finalPosition, timeOfFlight, direction, numRevolutions, mu, singleRevInitialVelocity, singleRevFinalVelocity);
+
+            CHECK(singleRevInitialVelocity == initialVelocity);
+            CHECK(singleRevFinalVelocity == finalVelocity);
+        }
+    }
+}
+
+TEST_CASE("LambertCache", "Lambert")
+{
+    auto lambert = std::make_shared<otl::keplerian::LambertExponentialSinusoid>();
+    otl::keplerian::LambertCache cache(lambert, 4);
+
+    const otl::Vector3d initialPosition({ 1.0, 0.0, 0.0 }); // [DU]
+    otl::Vector3d finalPosition({ -0.8, 1.1, 0.1 });        // [DU]
+    const otl::keplerian::Orbit::Direction direction = otl::keplerian::Orbit::Direction::Prograde;
+    const double mu = 1.0;
+
+    otl::Vector3d initialVelocity, finalVelocity;
+    otl::Vector3d cachedInitialVelocity, cachedFinalVelocity;
+
+    /// Test LambertCache.Evaluate() returns the solution of the wrapped algorithm and counts hits and misses.
+    SECTION("Hits and Misses")
+    {
+        lambert->Evaluate(initialPosition, finalPosition, otl::Time::Seconds(2.0), direction, 0, mu, initialVelocity, finalVelocity);
+
+        cache.Evaluate(initialPosition, finalPosition, otl::Time::Seconds(2.0), direction, 0, mu, cachedInitialVelocity, cachedFinalVelocity);
+        CHECK(cache.GetMisses() == 1);
+        CHECK(cache.GetHits() == 0);
+        CHECK(cachedInitialVelocity == initialVelocity);
+        CHECK(cachedFinalVelocity == finalVelocity);
+
+        // Inputs within the resolution share the entry
+        cache.Evaluate(initialPosition, finalPosition, otl::Time::Seconds(2.0 * (1.0 + 1.0e-13)), direction, 0, mu, cachedInitialVelocity, cachedFinalVelocity);
+        CHECK(cache.GetMisses() == 1);
+        CHECK(cache.GetHits() == 1);
+        CHECK(cachedInitialVelocity == initialVelocity);
+        CHECK(cachedFinalVelocity == finalVelocity);
+
+        // Different revolutions, directions or times of flight are separate entries
+        cache.Evaluate(initialPosition, finalPosition, otl::Time::Seconds(2.0), otl::keplerian::Orbit::Direction::Retrograde, 0, mu, cachedInitialVelocity, cachedFinalVelocity);
+        cache.Evaluate(initialPosition, finalPosition, otl::Time::Seconds(2.1), direction, 0, mu, cachedInitialVelocity, cachedFinalVelocity);
+        CHECK(cache.GetMisses() == 3);
+        CHECK(cache.GetSize() == 3);
+
+        cache.Clear();
+        CHECK(cache.GetSize() == 0);
+        CHECK(cache.GetHits() == 0);
+        CHECK(cache.GetMisses() == 0);
+    }
+
+    /// Test LambertCache.Evaluate() evicts the least recently used solution once full.
+    SECTION("Bounded Size")
+    {
+        for (int i = 0; i < 10; ++i)
+        {
+            cache.Evaluate(initialPosition, finalPosition, otl::Time::Seconds(2.0 + 0.1 * i), direction, 0, mu, cachedInitialVelocity, cachedFinalVelocity);
+        }
+        CHECK(cache.GetSize() == 4);
+        CHECK(cache.GetMisses() == 10);
+
+        // The most recent solution is still cached, the first was evicted
+        cache.Evaluate(initialPosition, finalPosition, otl::Time::Seconds(2.9), direction, 0, mu, cachedInitialVelocity, cachedFinalVelocity);
+        CHECK(cache.GetHits() == 1);
+        cache.Evaluate(initialPosition, finalPosition, otl::Time::Seconds(2.0), direction, 0, mu, cachedInitialVelocity, cachedFinalVelocity);
+        CHECK(cache.GetMisses() == 11);
+        CHECK(cache.GetSize() == 4);
+    }
+
+    /// Test LambertCache.Evaluate() may be called from several threads.
+    SECTION("Concurrent Evaluate")
+    {
+        const int numEvaluations = 200;
+        auto worker = [&]()
+        {
+            otl::Vector3d v1, v2;
+            for (int i = 0; i < numEvaluations; ++i)
+            {
+                cache.Evaluate(initialPosition, finalPosition, otl::Time::Seconds(2.0 + 0.1 * (i % 6)), direction, 0, mu, v1, v2);
+            }
+        };
+        std::thread first(worker), second(worker);
+        first.join();
+        second.join();
+
+        CHECK(cache.GetHits() + cache.GetMisses() == 2 * numEvaluations);
+        CHECK(cache.GetSize() <= cache.GetCapacity());
+    }
+}
+
+TEST_CASE("HouseholderLambert", "Lambert")
+{
+    auto lambert = otl::keplerian::LambertHouseholder();
+
+    otl::Vector3d initialPosition, finalPosition;
+    otl::Vector3d initialVelocity, finalVelocity;
+    otl::Time timeOfFlight = otl::Time::Days(1);
+    double mu;
+
+    int maxRevolutions = 0;
+    otl::keplerian::Orbit::Direction direction = otl::keplerian::Orbit::Direction::Prograde;
+
+    SECTION("Evaluate")
+    {
+        /// Test HouseholderLambert.Evaluate() against Fundamentals of Astrodynamics and Applications 3rd Edition, David Vallado, Example 7-5.
+        SECTION("Truth Case: Vallado 7-5")
+        {
+            initialPosition = otl::Vector3d({ 15945.34, 0.0, 0.0 });          // [km]
+            finalPosition = otl::Vector3d({ 12214.83899, 10249.46731, 0.0 }); // [km]
+            timeOfFlight = otl::Time::Minutes(76.0);                          // [s]
+            mu = otl::ASTRO_MU_EARTH;
+
+            lambert.Evaluate(initialPosition,
+                             finalPosition,
+                             timeOfFlight,
+                             direction,
+                             maxRevolutions,
+                             mu,
+                             initialVelocity,
+                             finalVelocity);
+
+            CHECK(initialVelocity.x() == OTL_APPROX(2.058913));  // [km/s]
+            CHECK(initialVelocity.y() == OTL_APPROX(2.915965));  // [km/s]
+            CHECK(initialVelocity.z() == OTL_APPROX(0.0));       // [km/s]
+            CHECK(finalVelocity.x()   == OTL_APPROX(-3.451565)); // [km/s]
+            CHECK(finalVelocity.y()   == OTL_APPROX(0.910315));  // [km/s]
+            CHECK(finalVelocity.z()   == OTL_APPROX(0.0));       // [km/s]
+        }
+
+        /// Test HouseholderLambert.Evaluate() against Orbital Mechanics for Engineering Students 1st Edition, Howard Curtis, Example 5.2.
+        SECTION("Truth Case: Curtis 5.2")
+        {
+            initialPosition = otl::Vector3d({ 5000.0, 10000.0, 2100.0 }); // [km]
+            finalPosition = otl::Vector3d({ -14600.0, 2500.0, 7000.0 });  // [km]
+            timeOfFlight = otl::Time::Hours(1.0);                         // [s]
+            mu = 398600.0;                                                // [km^3/s^2]
+
+            lambert.Evaluate(initialPosition,
+                             finalPosition,
+                             timeOfFlight,
+                             direction,
+                             maxRevolutions,
+                             mu,
+                             initialVelocity,
+                             finalVelocity);
+
+            CHECK(initialVelocity.x() == OTL_APPROX(-5.9925));  // [km/s]
+            CHECK(initialVelocity.y() == OTL_APPROX(1.9254));   // [km/s]
+            CHECK(initialVelocity.z() == OTL_APPROX(3.2456));   // [km/s]
+            CHECK(finalVelocity.x()   == OTL_APPROX(-3.3125));  // [km/s]
+            CHECK(finalVelocity.y()   == OTL_APPROX(-4.1966));  // [km/s]
+            CHECK(finalVelocity.z()   == OTL_APPROX(-0.38529)); // [km/s]
+        }
+
+        /// Test HouseholderLambert.Evaluate() against Fundamentals of Astrodynamics 1st Edition, Bate Mueller & White, Example 5.3.1.
+        SECTION("Truth Case: BMW 5.3.1 (short way)")
+        {
+            initialPosition = otl::Vector3d({ 0.5, 0.6, 0.7 }); // [DU]
+            finalPosition = otl::Vector3d({ 0.0, 1.0, 0.0 });   // [DU]
+            timeOfFlight = otl::Time::Seconds(0.9667663);       // [TU]
+            mu = 1.0;
+            direction = otl::keplerian::Orbit::Direction::Prograde;
+
+            lambert.Evaluate(initialPosition,
+                             finalPosition,
+                             timeOfFlight,
+                             direction,
+                             maxRevolutions,
+                             mu,
+                             initialVelocity,
+                             finalVelocity);
+
+            CHECK(initialVelocity.x() == OTL_APPROX(-0.361677496)); // [VU]
+            CHECK(initialVelocity.y() == OTL_APPROX(0.76973587));   // [VU]
+            CHECK(initialVelocity.z() == OTL_APPROX(-0.50634848));  // [VU]
+            CHECK(finalVelocity.x()   == OTL_APPROX(-0.60187442));  // [VU]
+            CHECK(finalVelocity.y()   == OTL_APPROX(-0.02234181));  // [VU]
+            CHECK(finalVelocity.z()   == OTL_APPROX(-0.84262419));  // [VU]
+        }
+
+        /// Test HouseholderLambert.Evaluate() against Fundamentals of Astrodynamics 1st Edition, Bate Mueller & White, Example 5.3.1.
+        SECTION("Truth Case: BMW 5.3.1 (long way)")
+        {
+            initialPosition = otl::Vector3d({ 0.5, 0.6, 0.7 }); // [DU]
+            finalPosition = otl::Vector3d({ 0.0, 1.0, 0.0 });   // [DU]
+            timeOfFlight = otl::Time::Seconds(0.9667663);       // [TU]
+            mu = 1.0;
+            direction = otl::keplerian::Orbit::Direction::Retrograde;
+
+            lambert.Evaluate(initialPosition,
+                             finalPosition,
+                             timeOfFlight,
+                             direction,
+                             maxRevolutions,
+                             mu,
+                             initialVelocity,
+                             finalVelocity);
+
+            CHECK(initialVelocity.x() == OTL_APPROX(-0.6304918096));  // [VU]
+            CHECK(initialVelocity.y() == OTL_APPROX(-1.11392096659)); // [VU]
+            CHECK(initialVelocity.z() == OTL_APPROX(-0.8826885334));  // [VU]
+            CHECK(finalVelocity.x()   == OTL_APPROX(0.1786653974));   // [VU]
+            CHECK(finalVelocity.y()   == OTL_APPROX(1.5544139777));   // [VU]
+            CHECK(finalVelocity.z()   == OTL_APPROX(0.250135563));    // [VU]
+        }
+    }
+
+    SECTION("EvaluateWarmStart")
+    {
+        /// Test HouseholderLambert.EvaluateWarmStart() only marks the state valid when the iteration converges.
+        SECTION("Invalid Warm Start")
+        {
+            initialPosition = otl::Vector3d({ 1.0, 0.0, 0.0 });  // [DU]
+            finalPosition = otl::Vector3d({ -0.8, 1.1, 0.1 });   // [DU]
+            timeOfFlight = otl::Time::Seconds(2.5);              // [TU]
+            mu = 1.0;
+
+            lambert.Evaluate(initialPosition, finalPosition, timeOfFlight, direction, maxRevolutions, mu, initialVelocity, finalVelocity);
+
+            otl::keplerian::LambertSolverState state;
+            state.x = std::numeric_limits<double>::quiet_NaN();
+            state.numRevolutions = maxRevolutions;
+            state.valid = true;
+
+            otl::Vector3d warmInitialVelocity, warmFinalVelocity;
+            lambert.EvaluateWarmStart(initialPosition, finalPosition, timeOfFlight, direction, maxRevolutions, mu, state, warmInitialVelocity, warmFinalVelocity);
+            CHECK_FALSE(state.valid);
+
+            // The invalid state falls back to the cold start
+            lambert.EvaluateWarmStart(initialPosition, finalPosition, timeOfFlight, direction, maxRevolutions, mu, state, warmInitialVelocity, warmFinalVelocity);
+            CHECK(state.valid);
+            CHECK(warmInitialVelocity.x() == OTL_APPROX(initialVelocity.x()));
+            CHECK(warmInitialVelocity.y() == OTL_APPROX(initialVelocity.y()));
+            CHECK(warmFinalVelocity.z()   == OTL_APPROX(finalVelocity.z()));
+        }
+    }
+
+    /// Test HouseholderLambert returns NaN velocities when the time of flight is too short for the number of revolutions.
+    SECTION("Infeasible Revolutions")
+    {
+        initialPosition = otl::Vector3d({ 1.0, 0.0, 0.0 });  // [DU]
+        finalPosition = otl::Vector3d({ -0.8, 1.1, 0.1 });   // [DU]
+        timeOfFlight = otl::Time::Seconds(2.5);              // [TU]
+        mu = 1.0;
+        const int numRevolutions = 3;
+
+        // Outputs left over from a previous solve must not survive
+        lambert.Evaluate(initialPosition, finalPosition, timeOfFlight, direction, 0, mu, initialVelocity, finalVelocity);
+        REQUIRE(std::isfinite(initialVelocity.norm()));
+
+        lambert.Evaluate(initialPosition, finalPosition, timeOfFlight, direction, numRevolutions, mu, initialVelocity, finalVelocity);
+        CHECK(std::isnan(initialVelocity.norm()));
+        CHECK(std::isnan(finalVelocity.norm()));
+
+        lambert.Evaluate(initialPosition, finalPosition, timeOfFlight, direction, 0, mu, initialVelocity, finalVelocity);
+        lambert.EvaluateScreening(initialPosition, finalPosition, timeOfFlight, direction, numRevolutions, mu, otl::SolverAccuracy::Reduced, 1.0e-6, initialVelocity, finalVelocity);
+        CHECK(std::isnan(initialVelocity.norm()));
+        CHECK(std::isnan(finalVelocity.norm()));
+
+        otl::keplerian::LambertSolverState state;
+        state.valid = false;
+        lambert.Evaluate(initialPosition, finalPosition, timeOfFlight, direction, 0, mu, initialVelocity, finalVelocity);
+        lambert.EvaluateWarmStart(initialPosition, finalPosition, timeOfFlight, direction, numRevolutions, mu, state, initialVelocity, finalVelocity);
+        CHECK_FALSE(state.valid);
+        CHECK(std::isnan(initialVelocity.norm()));
+        CHECK(std::isnan(finalVelocity.norm()));
+    }
+}
+
+TEST_CASE("LambertEvaluateAll", "Lambert")
+{
+    const otl::Vector3d initialPosition({ 1.0, 0.0, 0.0 });  // [DU]
+    const otl::Vector3d finalPosition({ -0.8, 1.1, 0.1 });   // [DU]
+    const otl::Time timeOfFlight = otl::Time::Seconds(30.0); // [TU]
+    const double mu = 1.0;
+    const int maxRevolutions = 5;
+    const otl::keplerian::Orbit::Direction direction = otl::keplerian::Orbit::Direction::Prograde;
+
+    otl::keplerian::LambertExponentialSinusoid exponentialSinusoid;
+    otl::keplerian::LambertHouseholder householder;
+    otl::keplerian::ILambertAlgorithm* algorithms[] = { &exponentialSinusoid, &householder };
+
+    std::vector<otl::Vector3d> initialVelocities[2], finalVelocities[2];
+    for (int k = 0; k < 2; ++k)
+    {
+        algorithms[k]->EvaluateAll(initialPosition,
+                                   finalPosition,
+                                   timeOfFlight,
+                                   direction,
+                                   maxRevolutions,
+                                   mu,
+                                   initialVelocities[k],
+                                   finalVelocities[k]);
+    }
+
+    /// Test every ILambertAlgorithm.EvaluateAll() solution reaches the final position after the time of flight.
+    SECTION("Multiple Revolutions")
+    {
+        otl::keplerian::LagrangianPropagator propagator;
+        for (int k = 0; k < 2; ++k)
+        {
+            REQUIRE(initialVelocities[k].size() == 7); // Zero revolution and both branches for 1, 2 and 3 revolutions
+
+            for (std::size_t i = 0; i < initialVelocities[k].size(); ++i)
+            {
+                // Propagate one time unit at a time to stay well within a single revolution per step
+                otl::StateVector stateVector(initialPosition, initialVelocities[k][i]);
+                for (int step = 0; step < 30; ++step)
+                {
+                    stateVector = propagator.PropagateStateVector(stateVector, mu, otl::Time::Seconds(1.0));
+                }
+                CHECK(stateVector.position.x() == OTL_APPROX(finalPosition.x()));
+                CHECK(stateVector.position.y() == OTL_APPROX(finalPosition.y()));
+                CHECK(stateVector.position.z() == OTL_APPROX(finalPosition.z()));
+                CHECK(stateVector.velocity.x() == OTL_APPROX(finalVelocities[k][i].x()));
+                CHECK(stateVector.velocity.y() == OTL_APPROX(finalVelocities[k][i].y()));
+                CHECK(stateVector.velocity.z() == OTL_APPROX(finalVelocities[k][i].z()));
+            }
+        }
+    }
+
+    /// Test every ILambertAlgorithm.EvaluateAll() returns the solutions in the same order.
+    SECTION("Branch Order")
+    {
+        REQUIRE(initialVelocities[0].size() == initialVelocities[1].size());
+        for (std::size_t i = 0; i < initialVelocities[0].size(); ++i)
+        {
+            CHECK(initialVelocities[1][i].x() == OTL_APPROX(initialVelocities[0][i].x()));
+            CHECK(initialVelocities[1][i].y() == OTL_APPROX(initialVelocities[0][i].y()));
+            CHECK(initialVelocities[1][i].z() == OTL_APPROX(initialVelocities[0][i].z()));
+        }
+
+        // Long period solution precedes the short period solution of each revolution count
+        for (int k = 0; k < 2; ++k)
+        {
+            for (std::size_t i = 1; i + 1 < initialVelocities[k].size(); i += 2)
+            {
+                CHECK(initialVelocities[k][i].norm() > initialVelocities[k][i + 1].norm());
+            }
+        }
+    }
+}
+
+TEST_CASE("LambertJacobian", "Lambert")
+{
+    const otl::Vector3d initialPosition({ 1.0, 0.0, 0.0 });  // [DU]
+    const otl::Vector3d finalPosition({ -0.8, 1.1, 0.1 });   // [DU]
+    const double mu = 1.0;
+    const otl::keplerian::Orbit::Direction direction = otl::keplerian::Orbit::Direction::Prograde;
+
+    otl::keplerian::LambertExponentialSinusoid exponentialSinusoid;
+    otl::keplerian::LambertHouseholder householder;
+    otl::keplerian::ILambertAlgorithm* algorithms[] = { &exponentialSinusoid, &householder };
+
+    /// Test ILambertAlgorithm.EvaluateJacobian() against central finite differences of Evaluate().
+    SECTION("Analytic Matches Finite Difference")
+    {
+        for (auto lambert : algorithms)
+        {
+            for (int numRevolutions = 0; numRevolutions <= 1; ++numRevolutions)
+            {
+                const double seconds = 2.5 + otl::MATH_2_PI * 1.6 * numRevolutions; // [TU]
+
+                otl::Vector3d initialVelocity, finalVelocity;
+                otl::keplerian::LambertJacobian jacobian;
+                lambert->EvaluateJacobian(initialPosition,
+                                          finalPosition,
+                                          otl::Time::Seconds(seconds),
+                                          direction,
+                                          numRevolutions,
+                                          mu,
+                                          initialVelocity,
+                                          finalVelocity,
+                                          jacobian);
+
+                // Perturb each of [r1; r2; timeDelta] in turn
+                const double step = 1.0e-6;
+                otl::Vector3d v1Plus, v2Plus, v1Minus, v2Minus;
+                for (int j = 0; j < 7; ++j)
+                {
+                    otl::Vector3d r1Plus = initialPosition, r1Minus = initialPosition;
+                    otl::Vector3d r2Plus = finalPosition, r2Minus = finalPosition;
+                    double tPlus = seconds, tMinus = seconds;
+                    if (j < 3)
+                    {
+                        r1Plus(j) += step;
+                        r1Minus(j) -= step;
+                    }
+                    else if (j < 6)
+                    {
+                        r2Plus(j - 3) += step;
+                        r2Minus(j - 3) -= step;
+                    }
+                    else
+                    {
+                        tPlus += step;
+                        tMinus -= step;
+                    }
+                    lambert->Evaluate(r1Plus, r2Plus, otl::Time::Seconds(tPlus), direction, numRevolutions, mu, v1Plus, v2Plus);
+                    lambert->Evaluate(r1Minus, r2Minus, otl::Time::Seconds(tMinus), direction, numRevolutions, mu, v1Minus, v2Minus);
+
+                    for (int i = 0; i < 3; ++i)
+                    {
+                        CHECK(jacobian(i, j) == OTL_APPROX((v1Plus(i) - v1Minus(i)) / (2.0 * step)));
+                        CHECK(jacobian(i + 3, j) == OTL_APPROX((v2Plus(i) - v2Minus(i)) / (2.0 * step)));
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("PreparedLambertGeometry", "Lambert")
+{
+    auto lambert = otl::keplerian::LambertExponentialSinusoid();
+
+    otl::Vector3d initialPosition = otl::Vector3d({ 0.5, 0.6, 0.7 }); // [DU]
+    otl::Vector3d finalPosition = otl::Vector3d({ 0.0, 1.0, 0.0 });   // [DU]
+    otl::Vector3d initialVelocity, finalVelocity;
+    double mu = 1.0;
+    otl::keplerian::Orbit::Direction direction = otl::keplerian::Orbit::Direction::Retrograde;
+
+    otl::keplerian::PreparedLambertGeometry geometry(initialPosition, finalPosition, direction, mu);
+
+    std::vector<double> timeDeltas;
+    for (int i = 0; i < 40; ++i)
+    {
+        timeDeltas.push_back(0.6 + 0.05 * i); // [TU]
+    }
+
+    SECTION("Solve")
+    {
+        /// Test PreparedLambertGeometry.Solve() reproduces ExponentialSinusoidLambert.Evaluate().
+        SECTION("Single Time of Flight")
+        {
+            otl::Vector3d preparedInitialVelocity, preparedFinalVelocity;
+            for (double timeDelta : timeDeltas)
+            {
+                lambert.Evaluate(initialPosition, finalPosition, otl::Time::Seconds(timeDelta), direction, 0, mu, initialVelocity, finalVelocity);
+                geometry.Solve(otl::Time::Seconds(timeDelta), 0, preparedInitialVelocity, preparedFinalVelocity);
+
+                CHECK(preparedInitialVelocity.x() == initialVelocity.x());
+                CHECK(preparedInitialVelocity.y() == initialVelocity.y());
+                CHECK(preparedInitialVelocity.z() == initialVelocity.z());
+                CHECK(preparedFinalVelocity.x()   == finalVelocity.x());
+                CHECK(preparedFinalVelocity.y()   == finalVelocity.y());
+                CHECK(preparedFinalVelocity.z()   == finalVelocity.z());
+            }
+        }
+
+        /// Test PreparedLambertGeometry.Solve() over a span of times of flight agrees with ExponentialSinusoidLambert.Evaluate().
+        SECTION("Time of Flight Sweep")
+        {
+            const std::size_t size = timeDeltas.size();
+            std::vector<double> v1x(size), v1y(size), v1z(size);
+            std::vector<double> v2x(size), v2y(size), v2z(size);
+            geometry.Solve(timeDeltas, 0, otl::Vector3Span<double>(v1x, v1y, v1z), otl::Vector3Span<double>(v2x, v2y, v2z));
+
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                lambert.Evaluate(initialPosition, finalPosition, otl::Time::Seconds(timeDeltas[i]), direction, 0, mu, initialVelocity, finalVelocity);
+
+                CHECK(v1x[i] == OTL_APPROX(initialVelocity.x()));
+                CHECK(v1y[i] == OTL_APPROX(initialVelocity.y()));
+                CHECK(v1z[i] == OTL_APPROX(initialVelocity.z()));
+                CHECK(v2x[i] == OTL_APPROX(finalVelocity.x()));
+                CHECK(v2y[i] == OTL_APPROX(finalVelocity.y()));
+                CHECK(v2z[i] == OTL_APPROX(finalVelocity.z()));
+            }
+        }
+    }
+}
+
+TEST_CASE("PorkchopEngine", "Lambert")
+{
+    // Earth and Mars like orbits so the test does not depend on ephemeris data files
+    otl::UserDefinedBody earth("Earth", otl::PhysicalProperties(), otl::ASTRO_MU_SUN,
+                               otl::OrbitalElements(1.0 * otl::ASTRO_AU_TO_KM, 0.0167, 0.1, 0.0, 1.8, 0.0),
+                               otl::Epoch::MJD2000(0.0));
+    otl::UserDefinedBody mars("Mars", otl::PhysicalProperties(), otl::ASTRO_MU_SUN,
+                              otl::OrbitalElements(1.524 * otl::ASTRO_AU_TO_KM, 0.0934, 2.5, 0.032, 5.0, 0.86),
+                              otl::Epoch::MJD2000(0.0));
+
+    const otl::Epoch departureBegin = otl::Epoch::MJD2000(0.0);
+    const otl::Epoch departureEnd = otl::Epoch::MJD2000(90.0);
+    const otl::Epoch arrivalBegin = otl::Epoch::MJD2000(80.0);
+    const otl::Epoch arrivalEnd = otl::Epoch::MJD2000(400.0);
+    const otl::Time resolution = otl::Time::Days(10.0);
+
+    otl::keplerian::PorkchopOptions options;
+    options.numThreads = 3;
+    options.tileSize = 4; // several partial tiles
+
+    otl::keplerian::PorkchopEngine engine(options);
+    auto grid = engine.Evaluate(earth, mars, departureBegin, departureEnd, arrivalBegin, arrivalEnd, resolution);
+
+    REQUIRE(grid.departureEpochs.size() == 10);
+    REQUIRE(grid.arrivalEpochs.size() == 33);
+    REQUIRE(grid.totalDeltaV.size() == 330);
+
+    /// Test PorkchopEngine.Evaluate() matches a direct evaluation of every cell.
+    SECTION("Evaluate")
+    {
+        otl::keplerian::LambertExponentialSinusoid lambert;
+        otl::Vector3d initialVelocity, finalVelocity;
+        for (std::size_t i = 0; i < grid.departureEpochs.size(); ++i)
+        {
+            const otl::StateVector departureState = earth.GetStateVectorAt(grid.departureEpochs[i]);
+            for (std::size_t j = 0; j < grid.arrivalEpochs.size(); ++j)
+            {
+                const std::size_t index = grid.GetIndex(i, j);
+                const otl::Time timeOfFlight = grid.arrivalEpochs[j] - grid.departureEpochs[i];
+                if (timeOfFlight.Seconds() <= 0.0)
+                {
+                    CHECK(grid.totalDeltaV[index] != grid.totalDeltaV[index]); // NaN
+                    continue;
+                }
+
+                const otl::StateVector arrivalState = mars.GetStateVectorAt(grid.arrivalEpochs[j]);
+                lambert.Evaluate(departureState.position,
+                                 arrivalState.position,
+                                 timeOfFlight,
+                                 otl::keplerian::Orbit::Direction::Prograde,
+                                 0,
+                                 otl::ASTRO_MU_SUN,
+                                 initialVelocity,
+                                 finalVelocity);
+
+                const double departureVinf = (initialVelocity - departureState.velocity).norm();
+                const double arrivalVinf = (arrivalState.velocity - finalVelocity).norm();
+                CHECK(grid.departureC3[index] == OTL_APPROX(departureVinf * departureVinf));
+                CHECK(grid.arrivalVinf[index] == OTL_APPROX(arrivalVinf));
+                CHECK(grid.totalDeltaV[index] == OTL_APPROX(departureVinf + arrivalVinf));
+            }
+        }
+    }
+
+    /// Test PorkchopEngine.Evaluate() streams every tile of the grid to disk.
+    SECTION("Stream To Disk")
+    {
+        const std::string filename = "PorkchopEngineTest.bin";
+        options.outputFilename = filename;
+        engine.SetOptions(options);
+        auto streamed = engine.Evaluate(earth, mars, departureBegin, departureEnd, arrivalBegin, arrivalEnd, resolution);
+        CHECK(streamed.departureEpochs.size() == grid.departureEpochs.size());
+        CHECK(streamed.arrivalEpochs.size() == grid.arrivalEpochs.size());
+        CHECK(streamed.totalDeltaV.empty());
+
+        std::size_t numCells = 0;
+        std::ifstream stream(filename, std::ios::in | std::ios::binary);
+        std::int32_t header[4];
+        while (stream.read(reinterpret_cast<char*>(header), sizeof(header)))
+        {
+            const std::size_t size = header[2] * header[3];
+            std::vector<double> c3(size), vinf(size), deltaV(size);
+            stream.read(reinterpret_cast<char*>(c3.data()), size * sizeof(double));
+            stream.read(reinterpret_cast<char*>(vinf.data()), size * sizeof(double));
+            stream.read(reinterpret_cast<char*>(deltaV.data()), size * sizeof(double));
+            for (int row = 0; row < header[2]; ++row)
+            {
+                for (int column = 0; column < header[3]; ++column)
+                {
+                    const std::size_t index = grid.GetIndex(header[0] + row, header[1] + column);
+                    const std::size_t tileIndex = row * header[3] + column;
+                    if (grid.totalDeltaV[index] == grid.totalDeltaV[index])
+                    {
+                        CHECK(c3[tileIndex] == grid.departureC3[index]);
+                        CHECK(vinf[tileIndex] == grid.arrivalVinf[index]);
+                        CHECK(deltaV[tileIndex] == grid.totalDeltaV[index]);
+                    }
+                }
+            }
+            numCells += size;
+        }
+        stream.close();
+        std::remove(filename.c_str());
+
+        CHECK(numCells == grid.totalDeltaV.size());
+    }
+
+    /// Test PorkchopEngine.Evaluate() holds NaN in multiple revolution cells whose time of flight is too short.
+    SECTION("Multiple Revolutions")
+    {
+        options.lambertType = otl::LambertType::Householder;
+        options.numRevolutions = 1;
+        engine.SetOptions(options);
+
+        // Arrivals long enough after departure for some one revolution transfers to exist
+        const otl::Time multiRevResolution = otl::Time::Days(40.0);
+        auto multiRev = engine.Evaluate(earth, mars, departureBegin, departureEnd,
+                                        otl::Epoch::MJD2000(80.0), otl::Epoch::MJD2000(1100.0), multiRevResolution);
+        REQUIRE(multiRev.totalDeltaV.size() == multiRev.departureEpochs.size() * multiRev.arrivalEpochs.size());
+
+        otl::keplerian::LambertHouseholder lambert;
+        otl::Vector3d initialVelocity, finalVelocity;
+        std::size_t numInfeasible = 0, numFeasible = 0;
+        for (std::size_t i = 0; i < multiRev.departureEpochs.size(); ++i)
+        {
+            const otl::StateVector departureState = earth.GetStateVectorAt(multiRev.departureEpochs[i]);
+            for (std::size_t j = 0; j < multiRev.arrivalEpochs.size(); ++j)
+            {
+                const std::size_t index = multiRev.GetIndex(i, j);
+                const otl::Time timeOfFlight = multiRev.arrivalEpochs[j] - multiRev.departureEpochs[i];
+                if (timeOfFlight.Seconds() <= 0.0)
+                {
+                    CHECK(std::isnan(multiRev.totalDeltaV[index]));
+                    continue;
+                }
+
+                // A cold warm start solves each cell independently without logging infeasible transfers
+                const otl::StateVector arrivalState = mars.GetStateVectorAt(multiRev.arrivalEpochs[j]);
+                otl::keplerian::LambertSolverState state;
+                lambert.EvaluateWarmStart(departureState.position,
+                                          arrivalState.position,
+                                          timeOfFlight,
+                                          otl::keplerian::Orbit::Direction::Prograde,
+                                          options.numRevolutions,
+                                          otl::ASTRO_MU_SUN,
+                                          state,
+                                          initialVelocity,
+                                          finalVelocity);
+
+                if (!initialVelocity.allFinite())
+                {
+                    CHECK(std::isnan(multiRev.departureC3[index]));
+                    CHECK(std::isnan(multiRev.arrivalVinf[index]));
+                    CHECK(std::isnan(multiRev.totalDeltaV[index]));
+                    ++numInfeasible;
+                    continue;
+                }
+
+                const double departureVinf = (initialVelocity - departureState.velocity).norm();
+                const double arrivalVinf = (arrivalState.velocity - finalVelocity).norm();
+                CHECK(multiRev.departureC3[index] == OTL_APPROX(departureVinf * departureVinf));
+                CHECK(multiRev.arrivalVinf[index] == OTL_APPROX(arrivalVinf));
+                CHECK(multiRev.totalDeltaV[index] == OTL_APPROX(departureVinf + arrivalVinf));
+                ++numFeasible;
+            }
+        }
+
+        // The grid spans both sides of the minimum one revolution time of flight
+        CHECK(numInfeasible > 0);
+        CHECK(numFeasible > 0);
+    }
+}
@@ -1,7 +1,19 @@
 #include <OTL/Test/BaseTest.h>
 #include <OTL/Core/KeplerianPropagator.h>
+#include <OTL/Core/KeplersEquations.h>
+#include <OTL/Core/KeplerSolver.h>
 #include <OTL/Core/LagrangianPropagator.h>
+#include <OTL/Core/RungeKuttaPropagator.h>
+#include <OTL/Core/TabulatedKeplerSolver.h>
 #include <OTL/Core/Conversion.h>
+#include <OTL/Core/EnckePropagator.h>
+#include <OTL/Core/ForceModel.h>
+#include <OTL/Core/J2SecularPropagator.h>
+#include <OTL/Core/Orbit.h>
+#include <OTL/Core/UserDefinedBody.h>
+#include <OTL/Core/WisdomHolmanIntegrator.h>
+#include <cstdio>
+#include <fstream>
 
 TEST_CASE("Propagator", "")
 {
@@ -218,4 +230,1085 @@ TEST_CASE("Propagator", "")
             }      
         }
     }
-}
\ No newline at end of file
+
+    /// Test LagrangianPropagator.PropagateStateVectors() against PropagateStateVector() for a mix of orbit types and multi-revolution propagations.
+    SECTION("PropagateStateVectors")
+    {
+        mu = otl::ASTRO_MU_EARTH;
+        std::vector<otl::StateVector> stateVectors;
+        std::vector<double> timeDeltas;
+        for (int i = 0; i < 21; ++i)
+        {
+            const double speed = 4.0 + 0.5 * i; // [km/s] spans circular, elliptical, and hyperbolic orbits
+            otl::StateVector stateVector;
+            stateVector.position = otl::Vector3d(7000.0 + 100.0 * i, -1000.0 * (i % 3), 500.0 * (i % 5)); // [km]
+            stateVector.velocity = otl::Vector3d(0.1 * (i % 4), speed, 1.0 - 0.1 * i);                   // [km/s]
+            stateVectors.push_back(stateVector);
+            timeDeltas.push_back((i % 2 == 0 ? 1.0 : -1.0) * (600.0 + 900.0 * i)); // [s]
+        }
+        for (int i = 0; i < 3; ++i)
+        {
+            otl::StateVector stateVector;
+            stateVector.position = otl::Vector3d(7000.0, 0.0, 0.0);          // [km]
+            stateVector.velocity = otl::Vector3d(0.0, 7.5 + 0.5 * i, 0.5); // [km/s] elliptical orbits
+            stateVectors.push_back(stateVector);
+            timeDeltas.push_back(otl::MATH_DAY_TO_SEC * (10.0 + 5.0 * i));  // [s] a hundred or more revolutions
+        }
+
+        std::vector<otl::StateVector> expectedStateVectors;
+        for (std::size_t i = 0; i < stateVectors.size(); ++i)
+        {
+            expectedStateVectors.push_back(propagator.PropagateStateVector(stateVectors[i], mu, otl::Time::Seconds(timeDeltas[i])));
+        }
+
+        SECTION("StateVector")
+        {
+            std::vector<otl::StateVector> propagatedStateVectors(stateVectors.size());
+            propagator.PropagateStateVectors(stateVectors, mu, timeDeltas, propagatedStateVectors);
+
+            for (std::size_t i = 0; i < stateVectors.size(); ++i)
+            {
+                for (int k = 0; k < 3; ++k)
+                {
+                    CHECK(propagatedStateVectors[i].position[k] == Approx(expectedStateVectors[i].position[k]).epsilon(otl::MATH_TOLERANCE));
+                    CHECK(propagatedStateVectors[i].velocity[k] == Approx(expectedStateVectors[i].velocity[k]).epsilon(otl::MATH_TOLERANCE));
+                }
+            }
+        }
+
+        SECTION("Structure of arrays")
+        {
+            const std::size_t size = stateVectors.size();
+            std::vector<double> rx(size), ry(size), rz(size), vx(size), vy(size), vz(size);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                rx[i] = stateVectors[i].position.x(); ry[i] = stateVectors[i].position.y(); rz[i] = stateVectors[i].position.z();
+                vx[i] = stateVectors[i].velocity.x(); vy[i] = stateVectors[i].velocity.y(); vz[i] = stateVectors[i].velocity.z();
+            }
+            std::vector<double> frx(size), fry(size), frz(size), fvx(size), fvy(size), fvz(size);
+            const otl::Vector3Span<const double> positions(rx, ry, rz);
+            const otl::Vector3Span<const double> velocities(vx, vy, vz);
+            const otl::Vector3Span<double> finalPositions(frx, fry, frz);
+            const otl::Vector3Span<double> finalVelocities(fvx, fvy, fvz);
+            propagator.PropagateStateVectors(positions, velocities, mu, timeDeltas, finalPositions, finalVelocities);
+
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                const otl::Vector3d position = finalPositions.Get(i);
+                const otl::Vector3d velocity = finalVelocities.Get(i);
+                for (int k = 0; k < 3; ++k)
+                {
+                    CHECK(position[k] == Approx(expectedStateVectors[i].position[k]).epsilon(otl::MATH_TOLERANCE));
+                    CHECK(velocity[k] == Approx(expectedStateVectors[i].velocity[k]).epsilon(otl::MATH_TOLERANCE));
+                }
+            }
+        }
+    }
+
+    /// Test the analytic state transition matrix against central finite differences of PropagateStateVector().
+    SECTION("StateTransitionMatrix")
+    {
+       mu = otl::ASTRO_MU_EARTH;
+       const double speeds[] = { 7.5, 8.5, 10.7, 13.0 }; // [km/s] near circular, elliptical, near parabolic, and hyperbolic
+       const double times[] = { 1800.0, -5400.0, 40000.0 }; // [s]
+       for (double speed : speeds)
+       {
+          for (double seconds : times)
+          {
+             initialStateVector.position = otl::Vector3d(7000.0, -1000.0, 500.0); // [km]
+             initialStateVector.velocity = otl::Vector3d(0.3, speed, 1.0);         // [km/s]
+             timeOfFlight = otl::Time::Seconds(seconds);
+
+             otl::keplerian::StateTransitionMatrix stm;
+             finalStateVector = propagator.PropagateStateVector(initialStateVector, mu, timeOfFlight, stm);
+             finalExpectedStateVector = propagator.PropagateStateVector(initialStateVector, mu, timeOfFlight);
+             CHECK(finalStateVector.position.x() == finalExpectedStateVector.position.x());
+             CHECK(finalStateVector.velocity.z() == finalExpectedStateVector.velocity.z());
+
+             otl::Matrix6d finiteDifference;
+             for (int j = 0; j < 6; ++j)
+             {
+                const double step = (j < 3 ? 1.0e-3 : 1.0e-6); // [km] or [km/s]
+                otl::StateVector plus = initialStateVector, minus = initialStateVector;
+                (j < 3 ? plus.position : plus.velocity)[j % 3] += step;
+                (j < 3 ? minus.position : minus.velocity)[j % 3] -= step;
+                const otl::StateVector finalPlus = propagator.PropagateStateVector(plus, mu, timeOfFlight);
+                const otl::StateVector finalMinus = propagator.PropagateStateVector(minus, mu, timeOfFlight);
+                finiteDifference.block<3, 1>(0, j) = (finalPlus.position - finalMinus.position) / (2.0 * step);
+                finiteDifference.block<3, 1>(3, j) = (finalPlus.velocity - finalMinus.velocity) / (2.0 * step);
+             }
+
+             // Compare each block relative to its own scale
+             for (int i = 0; i < 2; ++i)
+             {
+                for (int j = 0; j < 2; ++j)
+                {
+                   const otl::Matrix3d expected = finiteDifference.block<3, 3>(3 * i, 3 * j);
+                   const otl::Matrix3d analytic = stm.block<3, 3>(3 * i, 3 * j);
+                   CHECK((analytic - expected).norm() <= 1.0e-6 * expected.norm());
+                }
+             }
+          }
+       }
+    }
+
+    /// Test LagrangianPropagator.SampleStateVectors() against PropagateStateVector() for elliptical and hyperbolic orbits.
+    SECTION("SampleStateVectors")
+    {
+       mu = otl::ASTRO_MU_EARTH;
+       const double speeds[] = { 7.0, 9.0, 12.0 }; // [km/s] near circular, elliptical, and hyperbolic
+       for (double speed : speeds)
+       {
+          initialStateVector.position = otl::Vector3d(7000.0, -1000.0, 500.0); // [km]
+          initialStateVector.velocity = otl::Vector3d(0.2, speed, 1.0);         // [km/s]
+
+          std::vector<double> timeDeltas;
+          for (int i = 0; i <= 200; ++i)
+          {
+             timeDeltas.push_back(-3650.0 + 300.0 * i); // [s]
+          }
+
+          std::vector<otl::StateVector> sampledStateVectors(timeDeltas.size());
+          propagator.SampleStateVectors(initialStateVector, mu, timeDeltas, sampledStateVectors);
+
+          for (std::size_t i = 0; i < timeDeltas.size(); ++i)
+          {
+             finalExpectedStateVector = propagator.PropagateStateVector(initialStateVector, mu, otl::Time::Seconds(timeDeltas[i]));
+             CHECK((sampledStateVectors[i].position - finalExpectedStateVector.position).norm() <= otl::MATH_TOLERANCE * finalExpectedStateVector.position.norm());
+             CHECK((sampledStateVectors[i].velocity - finalExpectedStateVector.velocity).norm() <= otl::MATH_TOLERANCE * finalExpectedStateVector.velocity.norm());
+          }
+       }
+    }
+}
+
+namespace
+{
+
+// Initial state vector of the numerical propagator tests
+otl::StateVector MakeTestStateVector(double speed)
+{
+    return otl::StateVector(otl::Vector3d(7000.0, -1000.0, 500.0),   // [km]
+                            otl::Vector3d(0.3, speed, 1.0));         // [km/s]
+}
+
+// Check the position and velocity of a state vector to a relative tolerance
+void CheckStateVector(const otl::StateVector& actual, const otl::StateVector& expected, double tolerance)
+{
+    CHECK((actual.position - expected.position).norm() <= tolerance * expected.position.norm());
+    CHECK((actual.velocity - expected.velocity).norm() <= tolerance * expected.velocity.norm());
+}
+
+// Constant perturbing acceleration
+class ConstantAccelerationModel : public otl::IForceModel
+{
+public:
+    explicit ConstantAccelerationModel(const otl::Vector3d& acceleration) : m_acceleration(acceleration) {}
+
+    virtual otl::Vector3d GetAcceleration(double seconds, const otl::Vector3d& position, const otl::Vector3d& velocity)
+    {
+        return m_acceleration;
+    }
+
+private:
+    otl::Vector3d m_acceleration;
+};
+
+// Position function of a body held at a fixed position
+otl::PositionFunction FixedPosition(const otl::Vector3d& position)
+{
+    return [position](const otl::Epoch&) { return position; };
+}
+
+// Counts the calls to the virtual hooks of the elliptical Kepler's Equation
+class CountingKeplersEquation : public otl::keplerian::KeplersEquationElliptical
+{
+public:
+    CountingKeplersEquation() : initialGuesses(0), derivatives(0) {}
+
+    int initialGuesses;
+    int derivatives;
+
+protected:
+    virtual double CalculateInitialGuess(double eccentricity, double meanAnomaly)
+    {
+        ++initialGuesses;
+        return KeplersEquationElliptical::CalculateInitialGuess(eccentricity, meanAnomaly);
+    }
+
+    virtual double SolveInverseDerivative(double eccentricity, double eccentricAnomaly)
+    {
+        ++derivatives;
+        return KeplersEquationElliptical::SolveInverseDerivative(eccentricity, eccentricAnomaly);
+    }
+};
+
+} // namespace
+
+TEST_CASE("KeplersEquation", "")
+{
+    /// Test KeplerSolver matches the virtual IKeplersEquation iteration exactly and reports its status.
+    SECTION("KeplerSolver")
+    {
+        using namespace otl::keplerian;
+        KeplersEquationElliptical elliptical;
+        KeplersEquationHyperbolic hyperbolic;
+        for (int i = 0; i < 20; ++i)
+        {
+            const double meanAnomaly = 0.1 + 0.3 * i;
+
+            const double ellipticalEccentricity = 0.05 * i;
+            KeplerSolution solution = KeplerSolverElliptical::Solve(ellipticalEccentricity, meanAnomaly);
+            CHECK(solution.IsConverged());
+            CHECK(solution.anomaly == elliptical.Evaluate(ellipticalEccentricity, meanAnomaly));
+            CHECK(solution.anomaly == SolveKeplersEquation(ellipticalEccentricity, meanAnomaly));
+
+            const double hyperbolicEccentricity = 1.1 + 0.5 * i;
+            solution = KeplerSolverHyperbolic::Solve(hyperbolicEccentricity, meanAnomaly);
+            CHECK(solution.IsConverged());
+            CHECK(solution.anomaly == hyperbolic.Evaluate(hyperbolicEccentricity, meanAnomaly));
+            CHECK(solution.anomaly == SolveKeplersEquation(hyperbolicEccentricity, meanAnomaly));
+        }
+
+        KeplerSolution solution = KeplerSolverElliptical::Solve(0.9, 0.1, 1);
+        CHECK(solution.status == KeplerSolverStatus::MaxIterations);
+        CHECK(solution.iterations == 1);
+
+        // Evaluate() still dispatches through the virtual hooks
+        CountingKeplersEquation counting;
+        solution = KeplerSolverElliptical::Solve(0.5, 1.0);
+        CHECK(counting.Evaluate(0.5, 1.0) == solution.anomaly);
+        CHECK(counting.initialGuesses == 1);
+        CHECK(counting.derivatives == solution.iterations);
+    }
+
+    /// Test SolveKeplersEquationBatch() matches SolveKeplersEquation() for elliptical and mixed batches.
+    SECTION("SolveKeplersEquationBatch")
+    {
+        const int count = 37;
+        std::vector<double> ellipticalEccentricities(count), mixedEccentricities(count), meanAnomalies(count);
+        std::vector<double> ellipticalAnomalies(count), mixedAnomalies(count);
+        for (int i = 0; i < count; ++i)
+        {
+            meanAnomalies[i] = 0.05 + 0.17 * i;
+            ellipticalEccentricities[i] = 0.025 * i;
+            mixedEccentricities[i] = (i % 3 == 0 ? 0.02 * i : (i % 3 == 1 ? 1.0 + 0.1 * i : 1.0));
+        }
+
+        otl::keplerian::SolveKeplersEquationBatch(ellipticalEccentricities, meanAnomalies, ellipticalAnomalies);
+        otl::keplerian::SolveKeplersEquationBatch(mixedEccentricities, meanAnomalies, mixedAnomalies);
+        for (int i = 0; i < count; ++i)
+        {
+            CHECK(ellipticalAnomalies[i] == Approx(otl::keplerian::SolveKeplersEquation(ellipticalEccentricities[i], meanAnomalies[i])).epsilon(otl::MATH_TOLERANCE));
+            CHECK(mixedAnomalies[i] == Approx(otl::keplerian::SolveKeplersEquation(mixedEccentricities[i], meanAnomalies[i])).epsilon(otl::MATH_TOLERANCE));
+        }
+    }
+
+    /// Test TabulatedKeplerSolver matches KeplerSolver::SolveHighOrder() at and near the tabulated eccentricity.
+    SECTION("TabulatedKeplerSolver")
+    {
+        using namespace otl::keplerian;
+        const double eccentricities[] = { 0.0, 0.0167, 0.2056, 0.5, 0.8, 0.9, 0.95 };
+        for (double e : eccentricities)
+        {
+            TabulatedKeplerSolver kepler(e);
+            CHECK(kepler.IsValidFor(e) == (e <= TabulatedKeplerSolver::MAX_ECCENTRICITY));
+            CHECK_FALSE(kepler.IsValidFor(e + 2.0 * TabulatedKeplerSolver::ECCENTRICITY_TOLERANCE));
+            for (int i = 0; i < 200; ++i)
+            {
+                const double meanAnomaly = -10.0 + 0.1 * i + 1.0e-3;
+                CHECK(kepler.Solve(meanAnomaly) == Approx(KeplerSolverElliptical::SolveHighOrder(e, meanAnomaly).anomaly).epsilon(1.0e-14));
+
+                const double drifted = e + 0.5 * TabulatedKeplerSolver::ECCENTRICITY_TOLERANCE;
+                CHECK(kepler.Solve(drifted, meanAnomaly) == Approx(KeplerSolverElliptical::SolveHighOrder(drifted, meanAnomaly).anomaly).epsilon(1.0e-14));
+            }
+        }
+    }
+
+    /// Test KeplerSolver::SolveHighOrder() converges within the iteration cap, including near-parabolic orbits.
+    SECTION("KeplerSolverHighOrder")
+    {
+        using namespace otl::keplerian;
+        const double ellipticalEccentricities[] = { 0.0, 0.1, 0.5, 0.9, 0.99, 0.999999, 1.0 - 1.0e-12 };
+        const double hyperbolicEccentricities[] = { 1.0 + 1.0e-9, 1.0001, 1.1, 2.0, 10.0, 1000.0 };
+        for (int i = 0; i < 40; ++i)
+        {
+            const double meanAnomaly = -20.0 + 1.0 * i + 1.0e-6;
+            for (double e : ellipticalEccentricities)
+            {
+                KeplerSolution solution = KeplerSolverElliptical::SolveHighOrder(e, meanAnomaly);
+                CHECK(solution.IsConverged());
+                CHECK(solution.iterations < KeplerSolverElliptical::HIGH_ORDER_MAX_ITERATIONS);
+                CHECK(solution.anomaly - e * sin(solution.anomaly) == Approx(meanAnomaly).epsilon(1.0e-14));
+                if (e < 0.99)
+                {
+                    CHECK(solution.anomaly == Approx(KeplerSolverElliptical::Solve(e, meanAnomaly).anomaly).epsilon(1.0e-12));
+                }
+            }
+            for (double e : hyperbolicEccentricities)
+            {
+                KeplerSolution solution = KeplerSolverHyperbolic::SolveHighOrder(e, meanAnomaly);
+                CHECK(solution.IsConverged());
+                CHECK(solution.iterations < KeplerSolverHyperbolic::HIGH_ORDER_MAX_ITERATIONS);
+                CHECK(e * sinh(solution.anomaly) - solution.anomaly == Approx(meanAnomaly).epsilon(1.0e-14));
+            }
+        }
+    }
+
+    /// Test SolveKeplersEquation() at every SolverAccuracy satisfies Kepler's Equation to the requested tolerance.
+    SECTION("SolverAccuracy")
+    {
+        const otl::SolverAccuracy accuracies[] = { otl::SolverAccuracy::Full, otl::SolverAccuracy::Reduced, otl::SolverAccuracy::Single };
+        for (auto accuracy : accuracies)
+        {
+            for (int i = 0; i < 20; ++i)
+            {
+                const double meanAnomaly = 0.1 + 0.3 * i;
+
+                const double ellipticalEccentricity = 0.05 * i;
+                double eccentricAnomaly = otl::keplerian::SolveKeplersEquation(ellipticalEccentricity, meanAnomaly, accuracy, otl::MATH_SCREENING_TOLERANCE);
+                CHECK(eccentricAnomaly - ellipticalEccentricity * sin(eccentricAnomaly) == Approx(meanAnomaly).epsilon(1.0e-4));
+
+                const double hyperbolicEccentricity = 1.1 + 0.5 * i;
+                double hyperbolicAnomaly = otl::keplerian::SolveKeplersEquation(hyperbolicEccentricity, meanAnomaly, accuracy, otl::MATH_SCREENING_TOLERANCE);
+                CHECK(hyperbolicEccentricity * sinh(hyperbolicAnomaly) - hyperbolicAnomaly == Approx(meanAnomaly).epsilon(1.0e-4));
+            }
+        }
+    }
+}
+
+TEST_CASE("RungeKuttaPropagator", "")
+{
+    otl::RungeKuttaPropagator propagator;
+    otl::keplerian::LagrangianPropagator lagrangian;
+    const double mu = otl::ASTRO_MU_EARTH;
+
+    /// Test RungeKuttaPropagator.PropagateStateVector() against the two-body LagrangianPropagator.
+    SECTION("TwoBody")
+    {
+        const double speeds[] = { 7.5, 9.0, 12.0 }; // [km/s] near circular, elliptical, and hyperbolic
+        const double times[] = { 3600.0, -20000.0, 86400.0 }; // [s]
+        for (double speed : speeds)
+        {
+            for (double seconds : times)
+            {
+                const otl::StateVector initialStateVector = MakeTestStateVector(speed);
+                const otl::StateVector expected = lagrangian.PropagateStateVector(initialStateVector, mu, otl::Time::Seconds(seconds));
+                const otl::StateVector actual = propagator.PropagateStateVector(initialStateVector, mu, otl::Time::Seconds(seconds));
+
+                CheckStateVector(actual, expected, 1.0e-8);
+                CHECK(propagator.GetNumSteps() > 0);
+            }
+        }
+    }
+
+    /// Test RungeKuttaPropagator.SampleStateVectors() dense output against the two-body LagrangianPropagator.
+    SECTION("SampleStateVectors")
+    {
+        const otl::StateVector initialStateVector = MakeTestStateVector(9.0);
+        std::vector<double> timeDeltas;
+        for (int i = 0; i <= 100; ++i)
+        {
+            timeDeltas.push_back(-137.0 * i); // [s]
+        }
+        std::vector<otl::StateVector> sampledStateVectors(timeDeltas.size());
+        propagator.SampleStateVectors(initialStateVector, mu, timeDeltas, sampledStateVectors);
+
+        for (std::size_t i = 0; i < timeDeltas.size(); ++i)
+        {
+            const otl::StateVector expected = (timeDeltas[i] == 0.0 ? initialStateVector :
+               lagrangian.PropagateStateVector(initialStateVector, mu, otl::Time::Seconds(timeDeltas[i])));
+            CheckStateVector(sampledStateVectors[i], expected, 1.0e-9);
+
+            // The dense output is as accurate as integrating to each sample
+            const otl::StateVector integrated = propagator.PropagateStateVector(initialStateVector, mu, otl::Time::Seconds(timeDeltas[i]));
+            CheckStateVector(sampledStateVectors[i], integrated, 1.0e-10);
+        }
+
+        // The final sample is the end of the last step rather than interpolated
+        const otl::StateVector finalStateVector = propagator.PropagateStateVector(initialStateVector, mu, otl::Time::Seconds(timeDeltas.back()));
+        CHECK(sampledStateVectors.back().position.x() == finalStateVector.position.x());
+        CHECK(sampledStateVectors.back().velocity.y() == finalStateVector.velocity.y());
+    }
+
+    /// Test force models are added to the equations of motion using a constant acceleration without central body gravity.
+    SECTION("ForceModel")
+    {
+        const otl::Vector3d acceleration(1.0e-3, -2.0e-3, 5.0e-4); // [km/s^2]
+        propagator.AddForceModel(std::make_shared<ConstantAccelerationModel>(acceleration));
+
+        const otl::StateVector initialStateVector = MakeTestStateVector(9.0);
+        const double seconds = 5000.0;
+        const otl::StateVector actual = propagator.PropagateStateVector(initialStateVector, 0.0, otl::Time::Seconds(seconds));
+        const otl::StateVector expected(initialStateVector.position + seconds * initialStateVector.velocity + 0.5 * otl::SQR(seconds) * acceleration,
+                                        initialStateVector.velocity + seconds * acceleration);
+        CheckStateVector(actual, expected, 1.0e-10);
+
+        propagator.ClearForceModels();
+        const otl::StateVector unperturbed = propagator.PropagateStateVector(initialStateVector, 0.0, otl::Time::Seconds(seconds));
+        CHECK(unperturbed.velocity.x() == OTL_APPROX(initialStateVector.velocity.x()));
+    }
+
+    /// Test GravityModel third body acceleration along the line to the external body.
+    SECTION("GravityModel")
+    {
+        const double bodyMu = 4902.8;                           // [km^3/s^2]
+        const otl::Vector3d bodyPosition(384400.0, 0.0, 0.0);   // [km]
+        otl::GravityModel gravity;
+        gravity.AddExternalBody(bodyMu, FixedPosition(bodyPosition));
+
+        const otl::Vector3d zero = gravity.GetAcceleration(0.0, otl::Vector3d::Zero(), otl::Vector3d::Zero());
+        CHECK(zero.norm() == OTL_APPROX(0.0));
+
+        const double x = 42000.0; // [km]
+        const otl::Vector3d a = gravity.GetAcceleration(0.0, otl::Vector3d(x, 0.0, 0.0), otl::Vector3d::Zero());
+        CHECK(a.x() == OTL_APPROX(bodyMu / otl::SQR(bodyPosition.x() - x) - bodyMu / otl::SQR(bodyPosition.x())));
+        CHECK(a.y() == OTL_APPROX(0.0));
+    }
+
+    /// Test GravityModel evaluates an orbital body at the epoch of each acceleration.
+    SECTION("GravityModelEphemeris")
+    {
+        const otl::Epoch epoch = otl::Epoch::MJD2000(100.0);
+        auto moon = std::make_shared<otl::UserDefinedBody>("Moon", otl::PhysicalProperties(4902.8 / otl::ASTRO_GRAVITATIONAL_CONSTANT, 1737.4), mu,
+                                                           otl::OrbitalElements(384400.0, 0.0549, 0.09, 0.5, 1.0, 2.0), epoch);
+        auto gravity = std::make_shared<otl::GravityModel>();
+        gravity->AddExternalBody(moon);
+        propagator.AddForceModel(gravity);
+        propagator.SetEpoch(epoch);
+
+        // The propagator passes its epoch to the force models
+        const otl::StateVector initialStateVector = MakeTestStateVector(9.0);
+        propagator.PropagateStateVector(initialStateVector, mu, otl::Time::Days(1.0));
+        CHECK(gravity->GetEpoch() == epoch);
+
+        // A week later the Moon has moved a quarter of its orbit
+        const otl::Vector3d position(42164.0, 0.0, 0.0); // [km]
+        const double seconds = 7.0 * 86400.0;
+        const otl::Vector3d moonPosition = moon->GetStateVectorAt(epoch + otl::Time::Seconds(seconds)).position;
+        const otl::Vector3d relativePosition = moonPosition - position;
+        const otl::Vector3d expected = 4902.8 * (relativePosition / std::pow(relativePosition.norm(), 3.0) - moonPosition / std::pow(moonPosition.norm(), 3.0));
+        const otl::Vector3d actual = gravity->GetAcceleration(seconds, position, otl::Vector3d::Zero());
+        CHECK((actual - expected).norm() <= 1.0e-12 * expected.norm());
+        CHECK((actual - gravity->GetAcceleration(0.0, position, otl::Vector3d::Zero())).norm() > 0.5 * expected.norm());
+    }
+}
+
+TEST_CASE("EnckePropagator", "")
+{
+    otl::EnckePropagator propagator;
+    const double mu = otl::ASTRO_MU_EARTH;
+    const otl::StateVector initialStateVector = MakeTestStateVector(9.0);
+
+    /// Test EnckePropagator.PropagateStateVector() follows the reference conic exactly without perturbations.
+    SECTION("TwoBody")
+    {
+        otl::keplerian::LagrangianPropagator lagrangian;
+        const double seconds = 86400.0;
+        const otl::StateVector expected = lagrangian.PropagateStateVector(initialStateVector, mu, otl::Time::Seconds(seconds));
+        const otl::StateVector actual = propagator.PropagateStateVector(initialStateVector, mu, otl::Time::Seconds(seconds));
+
+        CheckStateVector(actual, expected, 1.0e-12);
+        CHECK(propagator.GetNumRectifications() == 0);
+    }
+
+    /// Test EnckePropagator.PropagateStateVector() against Cowell's method with RungeKuttaPropagator.
+    SECTION("Perturbed")
+    {
+        auto forceModel = std::make_shared<ConstantAccelerationModel>(otl::Vector3d(1.0e-7, -2.0e-7, 5.0e-8)); // [km/s^2]
+        otl::RungeKuttaPropagator cowell;
+        cowell.AddForceModel(forceModel);
+        propagator.AddForceModel(forceModel);
+
+        const double thresholds[] = { 0.01, 1.0e-4 };
+        const double times[] = { 86400.0, -40000.0 }; // [s]
+        for (double seconds : times)
+        {
+            const otl::StateVector expected = cowell.PropagateStateVector(initialStateVector, mu, otl::Time::Seconds(seconds));
+            int numRectifications[2];
+            for (int i = 0; i < 2; ++i)
+            {
+                propagator.SetRectificationThreshold(thresholds[i]);
+                const otl::StateVector actual = propagator.PropagateStateVector(initialStateVector, mu, otl::Time::Seconds(seconds));
+                numRectifications[i] = propagator.GetNumRectifications();
+
+                // Each rectification accumulates the universal variable tolerance of the reference conic
+                CheckStateVector(actual, expected, 1.0e-7);
+                CHECK(propagator.GetNumSteps() < cowell.GetNumSteps());
+            }
+            CHECK(numRectifications[1] > numRectifications[0]);
+        }
+
+        /// Dense output includes the reference conic
+        propagator.SetRectificationThreshold(0.01);
+        std::vector<double> timeDeltas;
+        for (int i = 0; i <= 50; ++i)
+        {
+            timeDeltas.push_back(611.0 * i); // [s]
+        }
+        std::vector<otl::StateVector> expectedStateVectors(timeDeltas.size()), sampledStateVectors(timeDeltas.size());
+        cowell.SampleStateVectors(initialStateVector, mu, timeDeltas, expectedStateVectors);
+        propagator.SampleStateVectors(initialStateVector, mu, timeDeltas, sampledStateVectors);
+        for (std::size_t i = 0; i < timeDeltas.size(); ++i)
+        {
+            CheckStateVector(sampledStateVectors[i], expectedStateVectors[i], 1.0e-9);
+        }
+    }
+}
+
+TEST_CASE("WisdomHolmanIntegrator", "")
+{
+    const double mu = otl::ASTRO_MU_SUN;
+    auto circularStateVector = [&](double radius, double phase, double inclination)
+    {
+        const double speed = std::sqrt(mu / radius);
+        return otl::StateVector(otl::Vector3d(radius * std::cos(phase), radius * std::sin(phase), 0.0),
+                                otl::Vector3d(-speed * std::sin(phase) * std::cos(inclination), speed * std::cos(phase) * std::cos(inclination), speed * std::sin(inclination)));
+    };
+    const otl::StateVector jupiter = circularStateVector(5.2 * otl::ASTRO_AU_TO_KM, 0.0, 0.0);
+    const otl::StateVector saturn = circularStateVector(9.5 * otl::ASTRO_AU_TO_KM, 2.0, 0.04);
+
+    std::vector<otl::StateVector> asteroids;
+    for (int i = 0; i < 100; ++i)
+    {
+        otl::StateVector asteroid = circularStateVector((2.2 + 0.01 * i) * otl::ASTRO_AU_TO_KM, 0.37 * i, 0.002 * i);
+        asteroid.velocity *= 1.0 + 0.001 * (i % 7); // eccentric
+        asteroids.push_back(asteroid);
+    }
+
+    /// Test WisdomHolmanIntegrator.Integrate() reduces to Kepler's problem without perturbing masses.
+    SECTION("TwoBody")
+    {
+        otl::WisdomHolmanIntegrator integrator(mu);
+        integrator.AddBody(0.0, jupiter);
+        integrator.AddTestParticles(asteroids);
+        const double seconds = 10.0 * 365.25 * 86400.0;
+        integrator.Integrate(otl::Time::Seconds(seconds), otl::Time::Days(30.0));
+        CHECK(integrator.GetTime().Seconds() == seconds);
+
+        otl::keplerian::LagrangianPropagator propagator;
+        for (std::size_t i = 0; i < asteroids.size(); ++i)
+        {
+            const otl::StateVector expected = propagator.PropagateStateVector(asteroids[i], mu, otl::Time::Seconds(seconds));
+            const otl::StateVector actual = integrator.GetTestParticleStateVector(i);
+            CheckStateVector(actual, expected, 1.0e-8);
+        }
+    }
+
+    /// Test WisdomHolmanIntegrator.Integrate() integrates test particles like massless bodies on any number of threads.
+    SECTION("TestParticles")
+    {
+        otl::WisdomHolmanIntegrator integrators[2] = { otl::WisdomHolmanIntegrator(mu), otl::WisdomHolmanIntegrator(mu) };
+        for (int k = 0; k < 2; ++k)
+        {
+            integrators[k].SetNumThreads(k == 0 ? 1 : 4);
+            integrators[k].AddBody(otl::ASTRO_MU_JUPITER, jupiter);
+            integrators[k].AddBody(otl::ASTRO_MU_SATURN, saturn);
+            integrators[k].AddTestParticles(asteroids);
+        }
+        for (int k = 0; k < 2; ++k)
+        {
+            integrators[k].Integrate(otl::Time::Days(3000.0), otl::Time::Days(10.0));
+        }
+
+        otl::WisdomHolmanIntegrator massless(mu);
+        massless.AddBody(otl::ASTRO_MU_JUPITER, jupiter);
+        massless.AddBody(otl::ASTRO_MU_SATURN, saturn);
+        massless.AddBody(0.0, asteroids[3]);
+        massless.Integrate(otl::Time::Days(3000.0), otl::Time::Days(10.0));
+
+        for (std::size_t i = 0; i < asteroids.size(); ++i)
+        {
+            const otl::StateVector singleThreaded = integrators[0].GetTestParticleStateVector(i);
+            const otl::StateVector multiThreaded = integrators[1].GetTestParticleStateVector(i);
+            CHECK(singleThreaded.position == multiThreaded.position);
+            CHECK(singleThreaded.velocity == multiThreaded.velocity);
+        }
+
+        const otl::StateVector expected = massless.GetBodyStateVector(2);
+        const otl::StateVector actual = integrators[0].GetTestParticleStateVector(3);
+        CheckStateVector(actual, expected, 1.0e-10);
+    }
+
+    /// Test WisdomHolmanIntegrator.Integrate() bounds the energy error and is time reversible.
+    SECTION("Symplectic")
+    {
+        otl::WisdomHolmanIntegrator integrator(mu);
+        integrator.AddBody(otl::ASTRO_MU_JUPITER, jupiter);
+        integrator.AddBody(otl::ASTRO_MU_SATURN, saturn);
+        const double initialEnergy = integrator.GetEnergy();
+
+        double maxEnergyError = 0.0;
+        for (int i = 0; i < 100; ++i)
+        {
+            integrator.Integrate(otl::Time::Days(3652.5), otl::Time::Days(20.0));
+            maxEnergyError = std::max(maxEnergyError, std::abs(integrator.GetEnergy() / initialEnergy - 1.0));
+        }
+        CHECK(maxEnergyError < 1.0e-6);
+
+        integrator.Integrate(otl::Time::Seconds(-integrator.GetTime().Seconds()), otl::Time::Days(20.0));
+        CHECK(std::abs(integrator.GetTime().Seconds()) < 1.0e-3);
+        // Reversal is exact apart from the round-off and universal variable tolerance accumulated over every step
+        CHECK((integrator.GetBodyStateVector(0).position - jupiter.position).norm() <= 1.0e-6 * jupiter.position.norm());
+        CHECK((integrator.GetBodyStateVector(1).position - saturn.position).norm() <= 1.0e-6 * saturn.position.norm());
+    }
+}
+
+TEST_CASE("BarnesHutGravityModel", "")
+{
+    // Asteroid belt like swarm with a dense cluster
+    std::vector<double> mu;
+    std::vector<otl::Vector3d> positions;
+    otl::GravityModel direct;
+    for (int i = 0; i < 2000; ++i)
+    {
+        const double radius = (i % 10 == 0 ? 3.0 + 1.0e-4 * i : 2.0 + 1.5 * std::fmod(0.618034 * i, 1.0)) * otl::ASTRO_AU_TO_KM;
+        const double angle = (i % 10 == 0 ? 1.0e-5 * i : 2.39996 * i);
+        mu.push_back(1.0 + std::fmod(0.7548777 * i, 1.0)); // [km^3/s^2]
+        positions.push_back(otl::Vector3d(radius * std::cos(angle), radius * std::sin(angle), 1.0e6 * std::sin(7.0 * i)));
+        direct.AddExternalBody(mu.back(), FixedPosition(positions.back()));
+    }
+    std::vector<otl::Vector3d> queries;
+    for (int i = 0; i < 200; ++i)
+    {
+        const double radius = (1.0 + 0.015 * i) * otl::ASTRO_AU_TO_KM;
+        queries.push_back(otl::Vector3d(radius * std::cos(1.3 * i), radius * std::sin(1.3 * i), 1.0e5 * i));
+    }
+
+    otl::BarnesHutGravityModel gravity;
+    gravity.SetBodies(mu, positions);
+
+    /// Test BarnesHutGravityModel.GetAcceleration() against the direct sum of GravityModel.
+    SECTION("DirectSum")
+    {
+        const double openingAngles[] = { 0.0, 0.3, 0.5, 1.0 };
+        const double tolerances[] = { 1.0e-12, 1.0e-3, 1.0e-2, 1.0e-1 };
+        for (int k = 0; k < 4; ++k)
+        {
+            gravity.SetOpeningAngle(openingAngles[k]);
+            double maxError = 0.0, sumError = 0.0;
+            for (const auto& position : queries)
+            {
+                const otl::Vector3d expected = direct.GetAcceleration(0.0, position, otl::Vector3d::Zero());
+                const otl::Vector3d actual = gravity.GetAcceleration(0.0, position, otl::Vector3d::Zero());
+                const double error = (actual - expected).norm() / expected.norm();
+                maxError = std::max(maxError, error);
+                sumError += error;
+            }
+            CHECK(maxError < tolerances[k]);
+            CHECK(sumError / queries.size() < 0.1 * tolerances[k]);
+        }
+    }
+
+    /// Test BarnesHutGravityModel.GetAccelerations() matches GetAcceleration() on any number of threads.
+    SECTION("Batch")
+    {
+        std::vector<otl::Vector3d> accelerations(positions.size());
+        gravity.SetNumThreads(3);
+        gravity.GetAccelerations(positions, accelerations);
+        for (std::size_t i = 0; i < positions.size(); ++i)
+        {
+            // A body does not attract itself
+            const otl::Vector3d expected = gravity.GetAcceleration(0.0, positions[i], otl::Vector3d::Zero());
+            CHECK(accelerations[i] == expected);
+            CHECK(std::isfinite(expected.norm()));
+        }
+
+        // Massless bodies are ignored
+        mu[0] = 0.0;
+        gravity.SetBodies(mu, positions);
+        gravity.SetOpeningAngle(0.0);
+        otl::GravityModel remaining;
+        for (std::size_t i = 1; i < positions.size(); ++i)
+        {
+            remaining.AddExternalBody(mu[i], FixedPosition(positions[i]));
+        }
+        const otl::Vector3d expected = remaining.GetAcceleration(0.0, positions[0], otl::Vector3d::Zero());
+        const otl::Vector3d actual = gravity.GetAcceleration(0.0, positions[0], otl::Vector3d::Zero());
+        CHECK((actual - expected).norm() <= 1.0e-12 * expected.norm());
+    }
+
+    /// Test WisdomHolmanIntegrator.Integrate() with tree kicks against the direct sum of every pair of massive bodies.
+    SECTION("WisdomHolmanIntegrator")
+    {
+        // Heavier bodies on circular orbits, few enough to avoid close encounters over the integration
+        const std::size_t numBodies = 500;
+        const otl::Time timeDelta = otl::Time::Days(200.0);
+        std::vector<otl::StateVector> bodies;
+        for (std::size_t i = 0; i < numBodies; ++i)
+        {
+            const double speed = std::sqrt(otl::ASTRO_MU_SUN / positions[i].norm());
+            bodies.push_back(otl::StateVector(positions[i], speed * otl::Vector3d::UnitZ().cross(positions[i]).normalized()));
+        }
+
+        otl::WisdomHolmanIntegrator integrators[2] = { otl::WisdomHolmanIntegrator(otl::ASTRO_MU_SUN), otl::WisdomHolmanIntegrator(otl::ASTRO_MU_SUN) };
+        integrators[1].SetOpeningAngle(0.3);
+        for (int k = 0; k < 2; ++k)
+        {
+            for (std::size_t i = 0; i < numBodies; ++i)
+            {
+                integrators[k].AddBody(1.0e4 * mu[i], bodies[i]);
+            }
+            integrators[k].Integrate(timeDelta, otl::Time::Days(10.0));
+        }
+
+        // Compare the change of velocity due to the interactions rather than the dominant Keplerian motion
+        otl::keplerian::LagrangianPropagator propagator;
+        std::vector<double> errors;
+        for (std::size_t i = 0; i < numBodies; ++i)
+        {
+            const otl::Vector3d kepler = propagator.PropagateStateVector(bodies[i], otl::ASTRO_MU_SUN, timeDelta).velocity;
+            const otl::Vector3d expected = integrators[0].GetBodyStateVector(i).velocity - kepler;
+            const otl::Vector3d actual = integrators[1].GetBodyStateVector(i).velocity - kepler;
+            errors.push_back((actual - expected).norm() / expected.norm());
+        }
+        std::sort(errors.begin(), errors.end());
+        CHECK(errors[numBodies / 2] < 1.0e-5);
+        CHECK(errors.back() < 1.0e-3);
+    }
+}
+
+TEST_CASE("SphericalHarmonicGravityModel", "")
+{
+    const double mu = otl::ASTRO_MU_EARTH;
+    const double radius = otl::ASTRO_RADIUS_EARTH;
+    const double j2 = 1.08262668e-3;
+    const otl::Vector3d position(4000.0, -5000.0, 3000.0); // [km]
+
+    // Low degree field with a few significant terms
+    otl::SphericalHarmonicGravityModel gravity(mu, radius);
+    gravity.SetCoefficient(2, 0, -j2 / std::sqrt(5.0), 0.0);
+    gravity.SetCoefficient(2, 2, 2.4e-6, -1.4e-6);
+    gravity.SetCoefficient(3, 0, 9.6e-7, 0.0);
+    gravity.SetCoefficient(3, 1, 2.0e-6, 2.5e-7);
+    gravity.SetCoefficient(4, 3, 9.9e-7, -2.0e-7);
+    gravity.SetCoefficient(5, 5, 1.7e-7, -6.7e-7);
+    CHECK(gravity.GetMaxDegree() == 5);
+
+    /// Test SphericalHarmonicGravityModel.GetAcceleration() against the closed form J2 acceleration.
+    SECTION("J2")
+    {
+        const double r = position.norm();
+        const double zRatio = 5.0 * otl::SQR(position.z() / r);
+        const double scale = -1.5 * j2 * mu * otl::SQR(radius) / std::pow(r, 5.0);
+        const otl::Vector3d expected(scale * position.x() * (1.0 - zRatio),
+                                     scale * position.y() * (1.0 - zRatio),
+                                     scale * position.z() * (3.0 - zRatio));
+        otl::SphericalHarmonicGravityModel zonal(mu, radius);
+        zonal.SetCoefficient(2, 0, -j2 / std::sqrt(5.0), 0.0);
+        const otl::Vector3d actual = zonal.GetAcceleration(position, 2);
+        CHECK((actual - expected).norm() <= 1.0e-12 * expected.norm());
+
+        // Above the pole
+        const otl::Vector3d pole(0.0, 0.0, 7000.0);
+        const otl::Vector3d polar = zonal.GetAcceleration(pole, 2);
+        CHECK(polar.z() == OTL_APPROX(-3.0 * j2 * mu * otl::SQR(radius) / std::pow(pole.z(), 4.0)));
+        CHECK(polar.x() == 0.0);
+        CHECK(polar.y() == 0.0);
+
+        // Higher degrees are only evaluated when selected
+        gravity.SetDegree(2);
+        CHECK(gravity.GetAcceleration(0.0, position, otl::Vector3d::Zero()) == gravity.GetAcceleration(position, 2));
+        CHECK(gravity.GetAcceleration(position, 2) != gravity.GetAcceleration(position, 3));
+        gravity.SetDegree(100);
+        CHECK(gravity.GetAcceleration(0.0, position, otl::Vector3d::Zero()) == gravity.GetAcceleration(position, 5));
+    }
+
+    /// Test SphericalHarmonicGravityModel.GetAcceleration() is the gradient of GetPotential().
+    SECTION("Gradient")
+    {
+        const double step = 1.0e-3; // [km]
+        const otl::Vector3d actual = gravity.GetAcceleration(position, 5);
+        for (int k = 0; k < 3; ++k)
+        {
+            otl::Vector3d offset = otl::Vector3d::Zero();
+            offset[k] = step;
+            const double expected = (gravity.GetPotential(position + offset, 5) - gravity.GetPotential(position - offset, 5)) / (2.0 * step);
+            CHECK(std::abs(actual[k] - expected) <= 1.0e-6 * actual.norm());
+        }
+    }
+
+    /// Test SphericalHarmonicGravityModel.GetAcceleration() remains stable at high degree.
+    SECTION("HighDegree")
+    {
+        otl::SphericalHarmonicGravityModel field(mu, radius);
+        field.SetMaxDegree(360);
+        for (int n = 2; n <= 360; ++n)
+        {
+            for (int m = 0; m <= n; ++m)
+            {
+                field.SetCoefficient(n, m, 1.0e-5 / (n * n) * std::cos(n + 3.0 * m), 1.0e-5 / (n * n) * std::sin(2.0 * n + m));
+            }
+        }
+        const otl::Vector3d surface = 1.01 * radius / position.norm() * position;
+        const otl::Vector3d low = field.GetAcceleration(surface, 10);
+        const otl::Vector3d high = field.GetAcceleration(surface, 360);
+        CHECK(std::isfinite(high.norm()));
+        CHECK((high - low).norm() < low.norm());
+
+        const double step = 1.0e-4; // [km]
+        const otl::Vector3d offset(0.0, 0.0, step);
+        const double expected = (field.GetPotential(surface + offset, 360) - field.GetPotential(surface - offset, 360)) / (2.0 * step);
+        CHECK(std::abs(high.z() - expected) <= 1.0e-4 * high.norm());
+    }
+
+    /// Test SphericalHarmonicGravityModel.SetRotation() evaluates the field in the body fixed frame.
+    SECTION("Rotation")
+    {
+        const double rate = 7.292115e-5; // [rad/s]
+        const double seconds = 0.25 * otl::MATH_PI / rate;
+        gravity.SetDegree(5);
+        gravity.SetRotation(rate, 0.25 * otl::MATH_PI);
+        const otl::Vector3d inertialPosition(-position.y(), position.x(), position.z()); // rotated by 90 degrees
+        const otl::Vector3d bodyFixed = gravity.GetAcceleration(position, 5);
+        const otl::Vector3d actual = gravity.GetAcceleration(seconds, inertialPosition, otl::Vector3d::Zero());
+        CHECK((actual - otl::Vector3d(-bodyFixed.y(), bodyFixed.x(), bodyFixed.z())).norm() <= 1.0e-12 * bodyFixed.norm());
+    }
+
+    /// Test SphericalHarmonicGravityModel.LoadDataFile() reads ICGEM and plain coefficient files.
+    SECTION("LoadDataFile")
+    {
+        const char* filename = "SphericalHarmonicGravityModelTest.gfc";
+        {
+            std::ofstream ofs(filename);
+            ofs << "product_type          gravity_field\n"
+                << "earth_gravity_constant 0.3986004415E+15\n"
+                << "radius                 0.63781363E+07\n"
+                << "max_degree             3\n"
+                << "norm                   fully_normalized\n"
+                << "end_of_head ==============================================\n"
+                << "gfc   0    0  1.0D+00  0.0D+00  0.0  0.0\n"
+                << "gfc   2    0 -0.484165143790815E-03  0.000000000000000E+00  0.0  0.0\n"
+                << "gfc   3    1  0.203013720000000E-05  0.248130798255610E-06  0.0  0.0\n";
+        }
+        otl::SphericalHarmonicGravityModel field(1.0, 1.0);
+        field.LoadDataFile(filename);
+        std::remove(filename);
+
+        CHECK(field.GetMaxDegree() == 3);
+        otl::SphericalHarmonicGravityModel expected(398600.4415, 6378.1363);
+        expected.SetCoefficient(2, 0, -0.484165143790815e-3, 0.0);
+        expected.SetCoefficient(3, 1, 0.203013720000000e-5, 0.248130798255610e-6);
+        CHECK((field.GetAcceleration(position, 3) - expected.GetAcceleration(position, 3)).norm() <= 1.0e-12 * expected.GetAcceleration(position, 3).norm());
+
+        {
+            std::ofstream ofs(filename);
+            ofs << "# n m C S\n2 0 -0.484165143790815E-03 0.0\n";
+        }
+        field.LoadDataFile(filename);
+        std::remove(filename);
+        CHECK(field.GetMaxDegree() == 2);
+        CHECK((field.GetAcceleration(position, 3) - expected.GetAcceleration(position, 2)).norm() <= 1.0e-12 * expected.GetAcceleration(position, 2).norm());
+
+        // Unnormalized coefficients are converted, with N(2,0) = sqrt(5) and N(3,1) = sqrt(7 / 6)
+        {
+            std::ofstream ofs(filename);
+            ofs << "earth_gravity_constant 0.3986004415E+15\n"
+                << "radius                 0.63781363E+07\n"
+                << "norm                   unnormalized\n"
+                << "end_of_head ==============================================\n"
+                << "gfc   2    0 -0.108262668000000E-02  0.000000000000000E+00  0.0  0.0\n"
+                << "gfc   3    1  0.216024689946929E-05  0.270030862433661E-06  0.0  0.0\n";
+        }
+        otl::SphericalHarmonicGravityModel unnormalizedField(1.0, 1.0);
+        unnormalizedField.SetDegree(2);
+        unnormalizedField.LoadDataFile(filename);
+        std::remove(filename);
+
+        // The degree set before loading is kept
+        CHECK(unnormalizedField.GetMaxDegree() == 3);
+        otl::SphericalHarmonicGravityModel normalized(398600.4415, 6378.1363);
+        normalized.SetCoefficient(2, 0, -j2 / std::sqrt(5.0), 0.0);
+        normalized.SetCoefficient(3, 1, 2.0e-6, 2.5e-7);
+        CHECK((unnormalizedField.GetAcceleration(position, 3) - normalized.GetAcceleration(position, 3)).norm() <= 1.0e-12 * normalized.GetAcceleration(position, 3).norm());
+        const otl::Vector3d velocity(0.0, 7.0, 0.0); // [km/s]
+        CHECK((unnormalizedField.GetAcceleration(0.0, position, velocity) - normalized.GetAcceleration(position, 2)).norm() <= 1.0e-12 * normalized.GetAcceleration(position, 2).norm());
+    }
+}
+
+TEST_CASE("J2SecularPropagator", "")
+{
+    otl::keplerian::J2SecularPropagator propagator;
+    const double mu = otl::ASTRO_MU_EARTH;
+    const double day = 86400.0; // [s]
+
+    /// Test J2SecularPropagator.PropagateOrbitalElements() reduces to Keplerian motion without oblateness.
+    SECTION("Keplerian")
+    {
+        const otl::OrbitalElements orbitalElements(7000.0, 0.01, 0.3, 0.9, 1.2, 2.1);
+        otl::keplerian::LagrangianPropagator lagrangian;
+        propagator.SetJ2(0.0, otl::ASTRO_RADIUS_EARTH);
+        const otl::OrbitalElements expected = lagrangian.PropagateOrbitalElements(orbitalElements, mu, otl::Time::Days(3.0));
+        const otl::OrbitalElements actual = propagator.PropagateOrbitalElements(orbitalElements, mu, otl::Time::Days(3.0));
+        CHECK(actual.meanAnomaly == OTL_APPROX(expected.meanAnomaly));
+        CHECK(actual.lonOfAscendingNode == orbitalElements.lonOfAscendingNode);
+        CHECK(actual.argOfPericenter == orbitalElements.argOfPericenter);
+    }
+
+    /// Test J2SecularPropagator.PropagateOrbitalElements() nodal and apsidal rates of well known orbits.
+    SECTION("SecularRates")
+    {
+        // Sun synchronous orbit at 700 km
+        const double a = otl::ASTRO_RADIUS_EARTH + 700.0;
+        const double inclination = 98.19 * otl::MATH_DEG_TO_RAD;
+        const otl::OrbitalElements sunSynchronous(a, 0.0, 0.0, inclination, 0.0, 0.0);
+        const otl::OrbitalElements drifted = propagator.PropagateOrbitalElements(sunSynchronous, mu, otl::Time::Days(1.0));
+        CHECK(drifted.lonOfAscendingNode * otl::MATH_RAD_TO_DEG == Approx(360.0 / 365.2422).epsilon(0.003));
+        CHECK(drifted.semiMajorAxis == sunSynchronous.semiMajorAxis);
+        CHECK(drifted.inclination == sunSynchronous.inclination);
+
+        // The periapsis is frozen at the critical inclination
+        const otl::OrbitalElements molniya(26600.0, 0.74, 0.0, std::acos(std::sqrt(0.2)), 0.0, -0.5 * otl::MATH_PI);
+        CHECK(std::abs(propagator.PropagateOrbitalElements(molniya, mu, otl::Time::Days(365.0)).argOfPericenter - molniya.argOfPericenter) < 1.0e-12);
+
+        // Batch propagation in place
+        std::vector<otl::OrbitalElements> orbitalElements = { sunSynchronous, molniya };
+        const std::vector<double> timeDeltas = { day, 365.0 * day };
+        propagator.PropagateOrbitalElements(orbitalElements, mu, timeDeltas, orbitalElements);
+        CHECK(orbitalElements[0] == drifted);
+        CHECK(orbitalElements[1] == propagator.PropagateOrbitalElements(molniya, mu, otl::Time::Days(365.0)));
+    }
+
+    /// Test J2SecularPropagator.PropagateStateVector() follows the mean drift of a numerically integrated J2 orbit.
+    SECTION("Integrated")
+    {
+        const otl::OrbitalElements orbitalElements(otl::ASTRO_RADIUS_EARTH + 500.0, 0.001, 1.0, 0.9, 0.4, 2.0);
+        const otl::StateVector initialStateVector = otl::ConvertOrbitalElements2StateVector(orbitalElements, mu);
+        const double seconds = 5.0 * day;
+
+        auto gravity = std::make_shared<otl::SphericalHarmonicGravityModel>(mu, otl::ASTRO_RADIUS_EARTH);
+        gravity->SetCoefficient(2, 0, -otl::ASTRO_J2_EARTH / std::sqrt(5.0), 0.0);
+        otl::RungeKuttaPropagator cowell;
+        cowell.SetTolerance(1.0e-10, 1.0e-10);
+        cowell.AddForceModel(gravity);
+        const otl::OrbitalElements expected = otl::ConvertStateVector2OrbitalElements(cowell.PropagateStateVector(initialStateVector, mu, otl::Time::Seconds(seconds)), mu);
+        const otl::OrbitalElements actual = otl::ConvertStateVector2OrbitalElements(propagator.PropagateStateVector(initialStateVector, mu, otl::Time::Seconds(seconds)), mu);
+
+        // The osculating elements differ from the mean elements by the short periodic terms
+        const double nodeDrift = actual.lonOfAscendingNode - orbitalElements.lonOfAscendingNode;
+        CHECK(std::abs(nodeDrift) > 0.1);
+        CHECK(std::abs(actual.lonOfAscendingNode - expected.lonOfAscendingNode) < 0.01 * std::abs(nodeDrift));
+        CHECK(std::abs(actual.semiMajorAxis - expected.semiMajorAxis) < 20.0);
+    }
+}
+
+TEST_CASE("Orbit", "")
+{
+    const double mu = otl::ASTRO_MU_EARTH;
+    const otl::OrbitalElements orbitalElements(12000.0, 0.1, 1.0, 0.5, 0.3, 0.7);
+    otl::Time timeDelta = otl::Time::Minutes(40.0);
+    const double meanMotion = sqrt(mu / pow(orbitalElements.semiMajorAxis, 3.0));
+
+    otl::OrbitalElements propagatedOrbitalElements = orbitalElements;
+    propagatedOrbitalElements.meanAnomaly += meanMotion * timeDelta.Seconds();
+    const otl::StateVector stateVector = otl::ConvertOrbitalElements2StateVector(orbitalElements, mu);
+    const otl::StateVector propagatedStateVector = otl::ConvertOrbitalElements2StateVector(propagatedOrbitalElements, mu);
+
+    otl::keplerian::Orbit orbit(mu, orbitalElements);
+
+    SECTION("Properties")
+    {
+        const auto& properties = orbit.GetOrbitProperties();
+        CHECK(properties.type == otl::keplerian::Orbit::Type::Elliptical);
+        CHECK(properties.meanMotion == OTL_APPROX(meanMotion));
+        CHECK(properties.period == OTL_APPROX(otl::MATH_2_PI / meanMotion));
+        CHECK(properties.semiparameter == OTL_APPROX(12000.0 * (1.0 - 0.01)));
+        CHECK(properties.specificAngularMomentum == OTL_APPROX(stateVector.position.cross(stateVector.velocity).norm()));
+        CHECK(properties.radius == OTL_APPROX(stateVector.position.norm()));
+        CHECK(properties.trueAnomaly == OTL_APPROX(otl::ConvertMeanAnomaly2TrueAnomaly(0.1, 1.0)));
+        CHECK(properties.anomaly - 0.1 * sin(properties.anomaly) == OTL_APPROX(1.0));
+        CHECK(properties.timeSincePerapsis == OTL_APPROX(1.0 / meanMotion));
+        CHECK(orbit.GetMeanMotion() == OTL_APPROX(meanMotion));
+        CHECK(orbit.GetPeriod() == OTL_APPROX(otl::MATH_2_PI / meanMotion));
+
+        const auto fromStateVector = otl::keplerian::ComputeOrbitProperties(mu, stateVector);
+        CHECK(fromStateVector.trueAnomaly == OTL_APPROX(properties.trueAnomaly));
+        CHECK(fromStateVector.radius == OTL_APPROX(properties.radius));
+        CHECK(fromStateVector.period == OTL_APPROX(properties.period));
+
+        const otl::OrbitalElements hyperbolicElements(-20000.0, 1.5, 0.5, 0.5, 0.3, 0.7);
+        const otl::StateVector hyperbolicStateVector = otl::ConvertOrbitalElements2StateVector(hyperbolicElements, mu);
+        const auto hyperbolic = otl::keplerian::ComputeOrbitProperties(mu, hyperbolicElements);
+        CHECK(hyperbolic.type == otl::keplerian::Orbit::Type::Hyperbolic);
+        CHECK(std::isinf(hyperbolic.period));
+        CHECK(hyperbolic.radius == OTL_APPROX(hyperbolicStateVector.position.norm()));
+        CHECK(hyperbolic.specificAngularMomentum == OTL_APPROX(hyperbolicStateVector.position.cross(hyperbolicStateVector.velocity).norm()));
+    }
+
+    SECTION("Propagate")
+    {
+        CheckStateVector(orbit.GetStateVector(), stateVector, 1.0e-10);
+        const double period = orbit.GetPeriod();
+
+        orbit.Propagate(timeDelta);
+        CHECK(orbit.GetOrbitalElements().meanAnomaly == OTL_APPROX(propagatedOrbitalElements.meanAnomaly));
+        CheckStateVector(orbit.GetStateVector(), propagatedStateVector, 1.0e-10);
+        CHECK(orbit.GetOrbitProperties().radius == OTL_APPROX(propagatedStateVector.position.norm()));
+        CHECK(orbit.GetPeriod() == period);
+
+        // Resetting the elements must not return the stale propagated state vector
+        orbit.SetOrbitalElements(orbitalElements);
+        CheckStateVector(orbit.GetStateVector(), stateVector, 1.0e-10);
+        CHECK(orbit.GetOrbitProperties().radius == OTL_APPROX(stateVector.position.norm()));
+
+        orbit.Propagate(timeDelta);
+        CheckStateVector(orbit.GetStateVector(), propagatedStateVector, 1.0e-10);
+        orbit.Propagate(-timeDelta);
+        CheckStateVector(orbit.GetStateVector(), stateVector, 1.0e-10);
+
+        orbit.PropagateToTrueAnomaly(orbit.GetOrbitProperties().trueAnomaly + 0.5);
+        CHECK(orbit.GetOrbitProperties().trueAnomaly == OTL_APPROX(otl::ConvertMeanAnomaly2TrueAnomaly(0.1, 1.0) + 0.5));
+    }
+
+    SECTION("SetOrbitalElements")
+    {
+        orbit.GetOrbitProperties();
+        otl::OrbitalElements modifiedOrbitalElements = orbitalElements;
+        modifiedOrbitalElements.semiMajorAxis = 24000.0;
+        orbit.SetOrbitalElements(modifiedOrbitalElements);
+        CHECK(orbit.GetMeanMotion() == OTL_APPROX(sqrt(mu / pow(24000.0, 3.0))));
+        CheckStateVector(orbit.GetStateVector(), otl::ConvertOrbitalElements2StateVector(modifiedOrbitalElements, mu), 1.0e-10);
+
+        modifiedOrbitalElements.inclination = 2.0;
+        orbit.SetOrbitalElements(modifiedOrbitalElements);
+        CheckStateVector(orbit.GetStateVector(), otl::ConvertOrbitalElements2StateVector(modifiedOrbitalElements, mu), 1.0e-10);
+    }
+
+    /// Test Orbit.SetGravitationalParameterCentralBody() keeps the orbital elements and recomputes the state vector.
+    SECTION("SetGravitationalParameterCentralBody")
+    {
+        // Elements derived from a state vector must be kept as well
+        otl::keplerian::Orbit stateVectorOrbit(mu, stateVector);
+        stateVectorOrbit.SetGravitationalParameterCentralBody(4.0 * mu);
+        const otl::OrbitalElements& keptOrbitalElements = stateVectorOrbit.GetOrbitalElements();
+        CHECK(keptOrbitalElements.semiMajorAxis == OTL_APPROX(orbitalElements.semiMajorAxis));
+        CHECK(keptOrbitalElements.eccentricity == OTL_APPROX(orbitalElements.eccentricity));
+        CHECK(keptOrbitalElements.inclination == OTL_APPROX(orbitalElements.inclination));
+        CHECK(keptOrbitalElements.argOfPericenter == OTL_APPROX(orbitalElements.argOfPericenter));
+        CHECK(keptOrbitalElements.lonOfAscendingNode == OTL_APPROX(orbitalElements.lonOfAscendingNode));
+        CHECK(keptOrbitalElements.meanAnomaly == OTL_APPROX(orbitalElements.meanAnomaly));
+
+        // Same position, with the velocity scaled by sqrt(4 mu / mu)
+        const otl::StateVector& scaledStateVector = stateVectorOrbit.GetStateVector();
+        CheckStateVector(scaledStateVector, otl::StateVector(stateVector.position, 2.0 * stateVector.velocity), 1.0e-10);
+        CHECK(stateVectorOrbit.GetMeanMotion() == OTL_APPROX(2.0 * meanMotion));
+
+        orbit.GetStateVector();
+        orbit.SetGravitationalParameterCentralBody(4.0 * mu);
+        CHECK(orbit.GetMeanMotion() == OTL_APPROX(2.0 * meanMotion));
+        CheckStateVector(orbit.GetStateVector(), otl::ConvertOrbitalElements2StateVector(orbitalElements, 4.0 * mu), 1.0e-10);
+
+        // Setting the same value again keeps the state vector
+        orbit.SetGravitationalParameterCentralBody(4.0 * mu);
+        CheckStateVector(orbit.GetStateVector(), otl::ConvertOrbitalElements2StateVector(orbitalElements, 4.0 * mu), 1.0e-10);
+    }
+
+    SECTION("SetStateVector")
+    {
+        orbit.SetStateVector(propagatedStateVector);
+        CHECK(orbit.GetOrbitalElements().meanAnomaly == OTL_APPROX(propagatedOrbitalElements.meanAnomaly));
+        CHECK(orbit.GetOrbitProperties().radius == OTL_APPROX(propagatedStateVector.position.norm()));
+
+        orbit.Propagate(-timeDelta);
+        CheckStateVector(orbit.GetStateVector(), stateVector, 1.0e-10);
+    }
+}